@@ -0,0 +1,283 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/Batch.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+#include "wjh/chat/conversation/Message.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace wjh::chat {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+nlohmann::json
+usage_json(TokenUsage const & usage)
+{
+    return {
+        {"prompt_tokens", json_value(usage.prompt_tokens)},
+        {"completion_tokens", json_value(usage.completion_tokens)},
+        {"total_tokens", json_value(usage.total_tokens)},
+        {"cached_tokens", json_value(usage.cached_tokens)},
+        {"cache_write_tokens", json_value(usage.cache_write_tokens)}};
+}
+
+Result<std::vector<BatchJob>>
+read_jobs(std::string const & path)
+{
+    std::ifstream in(path);
+    if (not in) {
+        return make_error("Cannot open batch input '{}'", path);
+    }
+
+    std::vector<BatchJob> jobs;
+    std::unordered_set<std::string> ids;
+    std::string line;
+    for (std::size_t line_number = 1; std::getline(in, line); ++line_number) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        auto job = parse_batch_job(line, line_number);
+        if (not job) {
+            return make_error("{}:{}: {}", path, line_number, job.error());
+        }
+        if (not ids.insert(job->id).second) {
+            return make_error(
+                "{}:{}: duplicate job id '{}'", path, line_number, job->id);
+        }
+        jobs.push_back(std::move(*job));
+    }
+    return jobs;
+}
+
+/// Ids of jobs a previous run finished; none if there is no checkpoint.
+std::unordered_set<std::string>
+read_checkpoint(std::string const & path)
+{
+    std::unordered_set<std::string> done;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (not line.empty()) {
+            done.insert(std::move(line));
+        }
+    }
+    return done;
+}
+
+} // anonymous namespace
+
+Result<BatchJob>
+parse_batch_job(std::string_view line, std::size_t line_number)
+{
+    try {
+        auto const json = nlohmann::json::parse(line);
+        if (not json.is_object()) {
+            return make_error("job is not a JSON object");
+        }
+
+        auto job = BatchJob{.id = std::to_string(line_number)};
+        if (auto it = json.find("id"); it != json.end()) {
+            job.id = it->is_string() ? it->get<std::string>() : it->dump();
+        }
+        if (auto it = json.find("system"); it != json.end()) {
+            job.conversation.set_system_prompt(
+                SystemPrompt{it->get<std::string>()});
+        }
+        if (auto it = json.find("model"); it != json.end()) {
+            job.model = ModelId{it->get<std::string>()};
+        }
+        if (auto it = json.find("max_tokens"); it != json.end()) {
+            auto const max_tokens = it->get<std::uint32_t>();
+            if (max_tokens == 0u) {
+                return make_error("max_tokens must be positive");
+            }
+            job.max_tokens = MaxTokens{max_tokens};
+        }
+        if (auto it = json.find("temperature"); it != json.end()) {
+            job.temperature = Temperature{it->get<float>()};
+        }
+
+        auto const messages = json.find("messages");
+        if (messages == json.end() or not messages->is_array()
+            or messages->empty())
+        {
+            return make_error("job has no messages");
+        }
+        for (auto const & message : *messages) {
+            auto const role = message.at("role").get<std::string>();
+            auto content = message.at("content").get<std::string>();
+            if (role == "system") {
+                job.conversation.set_system_prompt(
+                    SystemPrompt{std::move(content)});
+            } else if (role == "user") {
+                job.conversation.add_message(UserInput{std::move(content)});
+            } else if (role == "assistant") {
+                job.conversation.add_message(
+                    AssistantResponse{std::move(content)});
+            } else {
+                return make_error("unsupported message role '{}'", role);
+            }
+        }
+        return job;
+    } catch (nlohmann::json::exception const & e) {
+        return make_error("invalid job: {}", e.what());
+    }
+}
+
+void
+BatchSummary::
+report(std::ostream & out) const
+{
+    auto const seconds =
+        static_cast<double>(elapsed.count()) / 1000.0;
+    auto const finished = succeeded + failed;
+    out << std::format(
+        "Batch: {} succeeded, {} failed, {} skipped (checkpoint)",
+        succeeded,
+        failed,
+        skipped);
+    if (cancelled > 0) {
+        out << std::format(", {} not finished", cancelled);
+    }
+    out << std::format(
+        "\n  Tokens: {} prompt + {} completion\n"
+        "  Elapsed: {:.1f} s ({:.2f} jobs/s)\n",
+        prompt_tokens,
+        completion_tokens,
+        seconds,
+        seconds > 0.0 ? static_cast<double>(finished) / seconds : 0.0);
+}
+
+Result<BatchSummary>
+run_batch(
+    BatchConfig const & config,
+    BatchClientFactory const & make_client,
+    std::stop_token stop)
+{
+    auto jobs = read_jobs(config.input);
+    if (not jobs) {
+        return make_error("{}", jobs.error());
+    }
+
+    auto summary = BatchSummary{};
+    auto const done = read_checkpoint(config.checkpoint);
+    std::erase_if(*jobs, [&](BatchJob const & job) {
+        if (done.contains(job.id)) {
+            ++summary.skipped;
+            return true;
+        }
+        return false;
+    });
+
+    std::ofstream output(config.output, std::ios::app);
+    if (not output) {
+        return make_error("Cannot open batch output '{}'", config.output);
+    }
+    std::ofstream checkpoint(config.checkpoint, std::ios::app);
+    if (not checkpoint) {
+        return make_error(
+            "Cannot open batch checkpoint '{}'", config.checkpoint);
+    }
+
+    std::mutex mutex;
+    std::atomic<std::size_t> next{0};
+    auto const start = Clock::now();
+
+    auto const work = [&] {
+        while (not stop.stop_requested()) {
+            auto const index = next.fetch_add(1);
+            if (index >= jobs->size()) {
+                return;
+            }
+            auto const & job = (*jobs)[index];
+
+            // An exception escaping the thread would end every job in
+            // flight, so it fails just this one, to be retried next run.
+            auto const job_start = Clock::now();
+            auto result = [&]() -> Result<ChatResponse> {
+                try {
+                    auto client = make_client(job);
+                    return client->send_message(job.conversation, stop);
+                } catch (std::exception const & e) {
+                    return make_error("{}", e.what());
+                }
+            }();
+            auto const latency =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    Clock::now() - job_start);
+
+            // A job cut short by the stop is neither a result nor done.
+            if (not result and stop.stop_requested()) {
+                return;
+            }
+
+            auto record = nlohmann::json::object();
+            record["id"] = job.id;
+            if (job.model) {
+                record["model"] = json_value(*job.model);
+            }
+            if (result) {
+                record["response"] = json_value(result->response);
+                if (result->usage) {
+                    record["usage"] = usage_json(*result->usage);
+                }
+            } else {
+                record["error"] = result.error();
+            }
+            record["latency_ms"] = latency.count();
+
+            // Results and checkpoint entries are flushed one job at a
+            // time, so a crash loses at most the jobs in flight; the
+            // result goes first, so a checkpointed job always has one.
+            std::lock_guard<std::mutex> lock(mutex);
+            output << record.dump() << '\n' << std::flush;
+            if (not result) {
+                ++summary.failed;
+                continue;
+            }
+            checkpoint << job.id << '\n' << std::flush;
+            ++summary.succeeded;
+            if (result->usage) {
+                summary.prompt_tokens +=
+                    json_value(result->usage->prompt_tokens);
+                summary.completion_tokens +=
+                    json_value(result->usage->completion_tokens);
+            }
+        }
+    };
+
+    {
+        auto const count =
+            std::min(std::max<std::size_t>(config.workers, 1), jobs->size());
+        std::vector<std::jthread> workers;
+        workers.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            workers.emplace_back(work);
+        }
+    }
+
+    summary.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::now() - start);
+    summary.cancelled = jobs->size()
+        - std::min(jobs->size(), summary.succeeded + summary.failed);
+    return summary;
+}
+
+} // namespace wjh::chat
@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_B65945C44F4B40248D151E48897DEF8D
+#define WJH_CHAT_B65945C44F4B40248D151E48897DEF8D
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/types.hpp"
+#include "wjh/chat/client/IClient.hpp"
+#include "wjh/chat/conversation/Conversation.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat {
+
+/**
+ * One independent conversation from a batch input file.
+ */
+struct BatchJob
+{
+    /// Identifies the job in results and the checkpoint; the 1-based
+    /// input line number when the job has no "id".
+    std::string id;
+
+    /// System prompt and messages; the last message is normally the
+    /// user's.
+    conversation::Conversation conversation{};
+
+    /// Per-job overrides of the configured request settings.
+    std::optional<ModelId> model{};
+    std::optional<MaxTokens> max_tokens{};
+    std::optional<Temperature> temperature{};
+};
+
+/**
+ * Parse one line of a batch input file:
+ *
+ *   {"id": "q1", "system": "...", "model": "...", "max_tokens": 256,
+ *    "temperature": 0.2,
+ *    "messages": [{"role": "user", "content": "..."}, ...]}
+ *
+ * Only "messages" is required; roles are "system", "user" and
+ * "assistant".
+ */
+[[nodiscard]]
+Result<BatchJob> parse_batch_job(
+    std::string_view line,
+    std::size_t line_number);
+
+/**
+ * Configuration for a batch run.
+ */
+struct BatchConfig
+{
+    /// JSONL jobs, one per line; blank lines are skipped.
+    std::string input;
+
+    /// JSONL results, appended in completion order.
+    std::string output;
+
+    /// Ids of finished jobs, one per line; jobs listed here are skipped,
+    /// so an interrupted run resumes where it stopped.
+    std::string checkpoint;
+
+    /// Jobs in flight at once.
+    std::size_t workers = 4;
+};
+
+/**
+ * Outcome of a batch run.
+ */
+struct BatchSummary
+{
+    std::size_t succeeded = 0;
+    std::size_t failed = 0;
+
+    /// Jobs already in the checkpoint.
+    std::size_t skipped = 0;
+
+    /// Jobs left unfinished because the run was stopped.
+    std::size_t cancelled = 0;
+
+    std::uint64_t prompt_tokens = 0;
+    std::uint64_t completion_tokens = 0;
+    std::chrono::milliseconds elapsed{0};
+
+    /**
+     * Print job counts, token totals and throughput.
+     */
+    void report(std::ostream & out) const;
+};
+
+/**
+ * Creates the client that runs @p job; called once per job, possibly
+ * from several threads at once.
+ */
+using BatchClientFactory =
+    std::function<std::unique_ptr<client::IClient>(BatchJob const & job)>;
+
+/**
+ * Run every job in config.input not yet in config.checkpoint, on
+ * config.workers threads.
+ *
+ * Each finished job appends one JSON line to config.output:
+ *
+ *   {"id": ..., "response": ..., "usage": {...}, "latency_ms": ...}
+ *
+ * or, when the request failed, {"id": ..., "error": ...}.  Only
+ * successful jobs are checkpointed, so a rerun retries failed ones;
+ * the last result line for an id is the one that counts.  A stop
+ * request lets jobs in flight finish (or cancels them through their
+ * stop token) and starts no new ones.
+ *
+ * Fails without running anything if the input cannot be read or a line
+ * is not a valid job.
+ */
+[[nodiscard]]
+Result<BatchSummary> run_batch(
+    BatchConfig const & config,
+    BatchClientFactory const & make_client,
+    std::stop_token stop = {});
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_B65945C44F4B40248D151E48897DEF8D
@@ -6,17 +6,271 @@
 // ----------------------------------------------------------------------
 #include "wjh/chat/ChatLoop.hpp"
 
+#include "wjh/chat/Batch.hpp"
 #include "wjh/chat/CommandLine.hpp"
+#include "wjh/chat/Interrupt.hpp"
+#include "wjh/chat/TurnClassifier.hpp"
 #include "wjh/chat/json_convert.hpp"
 #include "wjh/chat/client/OpenRouterClient.hpp"
+#include "wjh/chat/tools/ApprovalPolicy.hpp"
+#include "wjh/chat/tools/FileWatcher.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <format>
+#include <memory>
+#include <sstream>
 #include <string>
 
 #include <iostream>
 
 namespace wjh::chat {
 
+namespace {
+
+TokenUsage
+sum_usage(std::vector<TurnUsage> const & history)
+{
+    auto total = TokenUsage{};
+    for (auto const & turn : history) {
+        total += turn.usage;
+    }
+    return total;
+}
+
+/// ", tools: bash 120 ms, read_file 2 ms", or nothing without tools.
+std::string
+tool_times(std::vector<ToolTiming> const & tools)
+{
+    std::string result;
+    for (auto const & tool : tools) {
+        result += std::format(
+            "{}{} {} ms",
+            result.empty() ? ", tools: " : ", ",
+            tool.name,
+            tool.elapsed.count());
+    }
+    return result;
+}
+
+/// Share of prompt tokens that were served from the prompt cache.
+double
+cache_hit_percent(TokenUsage const & usage)
+{
+    auto const prompt = json_value(usage.prompt_tokens);
+    if (prompt == 0u) {
+        return 0.0;
+    }
+    return 100.0 * static_cast<double>(json_value(usage.cached_tokens))
+        / static_cast<double>(prompt);
+}
+
+/// Tool approval rules: command-line denials, then allowances, then
+/// the policy file.
+Result<std::shared_ptr<tools::ApprovalPolicy const>>
+make_tool_policy(Config const & config)
+{
+    auto policy = std::make_shared<tools::ApprovalPolicy>();
+    for (auto const & rule : config.deny_tools) {
+        if (auto added = policy->add(tools::Approval::deny, json_value(rule));
+            not added)
+        {
+            return make_error("--deny-tool: {}", added.error());
+        }
+    }
+    for (auto const & rule : config.allow_tools) {
+        if (auto added = policy->add(tools::Approval::allow, json_value(rule));
+            not added)
+        {
+            return make_error("--allow-tool: {}", added.error());
+        }
+    }
+    if (config.tool_policy) {
+        if (auto loaded = policy->load(json_value(*config.tool_policy));
+            not loaded)
+        {
+            return make_error("{}", loaded.error());
+        }
+    }
+    if (config.tool_default) {
+        policy->set_default(
+            *tools::parse_approval(json_value(*config.tool_default)));
+    }
+    return policy;
+}
+
+/// Client settings shared by the REPL and every batch job.
+Result<client::OpenRouterClientConfig>
+make_client_config(Config const & config)
+{
+    std::shared_ptr<client::ResponseCache> response_cache;
+    if (config.response_cache_dir) {
+        response_cache = std::make_shared<client::ResponseCache>(
+            client::ResponseCacheConfig{
+                .directory = json_value(*config.response_cache_dir),
+                .offline = static_cast<bool>(config.offline)});
+    }
+
+    std::optional<client::HedgeConfig> hedge_config;
+    if (config.hedge) {
+        hedge_config.emplace();
+        if (config.hedge_provider) {
+            hedge_config->provider = json_value(*config.hedge_provider);
+        }
+    }
+
+    auto rate_limiter = std::make_shared<client::RateLimiter>(
+        client::RateLimiterConfig{
+            .requests = json_value(config.requests_per_minute),
+            .tokens = json_value(config.tokens_per_minute)});
+
+    auto circuit_breaker = std::make_shared<client::CircuitBreaker>(
+        client::CircuitBreakerConfig{
+            .failure_rate = json_value(config.circuit_failure_rate),
+            .consecutive_timeouts = json_value(config.circuit_timeouts)});
+
+    std::optional<client::Hostname> fallback_host;
+    if (config.fallback_host) {
+        fallback_host = client::Hostname{json_value(*config.fallback_host)};
+    }
+
+    auto routing = client::RouterConfig{
+        .models = {json_value(config.model)},
+        .ttft_slo = std::chrono::milliseconds{json_value(config.ttft_slo)}};
+    if (config.fallback_models) {
+        for (auto & model :
+             client::split_list(json_value(*config.fallback_models)))
+        {
+            if (std::ranges::find(routing.models, model)
+                == routing.models.end())
+            {
+                routing.models.push_back(std::move(model));
+            }
+        }
+    }
+    if (config.route_log) {
+        routing.log_path = json_value(*config.route_log);
+    }
+
+    client::ProviderPreferences provider;
+    if (config.provider_sort) {
+        provider.sort = json_value(*config.provider_sort);
+    }
+    if (config.provider_only) {
+        provider.only = client::split_list(json_value(*config.provider_only));
+    }
+    if (config.provider_ignore) {
+        provider.ignore =
+            client::split_list(json_value(*config.provider_ignore));
+    }
+
+    client::OpenRouterClientConfig client_config{
+        .api_key = config.api_key,
+        .model = config.model,
+        .max_tokens = config.max_tokens,
+        .system_prompt = config.system_prompt,
+        .temperature = config.temperature,
+        .prompt_caching = config.prompt_caching,
+        .response_cache = std::move(response_cache),
+        .retry = client::RetryPolicyConfig{
+            .max_retries = json_value(config.max_retries),
+            .session_budget = json_value(config.retry_budget)},
+        .hedge = std::move(hedge_config),
+        .rate_limiter = std::move(rate_limiter),
+        .circuit_breaker = std::move(circuit_breaker),
+        .fallback_host = std::move(fallback_host),
+        .prewarm = config.prewarm,
+        .routing = std::move(routing),
+        .provider = std::move(provider)};
+    if (config.fast_model) {
+        client_config.fast_model = ModelId{json_value(*config.fast_model)};
+    }
+    client_config.limits = client::AgentLimits{
+        .max_iterations = json_value(config.max_iterations),
+        .deadline = std::chrono::seconds{json_value(config.turn_deadline)},
+        .token_budget = json_value(config.turn_token_budget)};
+
+    auto tool_policy = make_tool_policy(config);
+    if (not tool_policy) {
+        return make_error("{}", tool_policy.error());
+    }
+    client_config.tool_policy = std::move(*tool_policy);
+    // Without a watcher, cached file results are checked with stat(2).
+    if (config.watch_dir) {
+        client_config.file_watcher = std::make_shared<tools::FileWatcher>(
+            std::filesystem::path(json_value(*config.watch_dir)));
+    }
+    client_config.sandbox = tools::SandboxLimits{
+        .cpus = json_value(config.tool_cpus),
+        .memory_bytes =
+            std::uint64_t{json_value(config.tool_memory)} * 1024 * 1024,
+        .max_pids = json_value(config.tool_pids)};
+
+    if (config.base_url) {
+        auto endpoint = client::parse_base_url(json_value(*config.base_url));
+        if (not endpoint) {
+            return make_error("{}", endpoint.error());
+        }
+        client_config.endpoint = std::move(*endpoint);
+    }
+
+    return client_config;
+}
+
+/// Run config.batch_input's jobs instead of the REPL.
+ExitCode
+run_batch_mode(Config const & config, client::OpenRouterClientConfig base)
+{
+    // Jobs share connections and limits; each gets its own client, so
+    // model, token and temperature overrides stay per job.
+    base.connection_pool = std::make_shared<client::ConnectionPool>();
+    base.prewarm = PrewarmConnections{false};
+    auto const make_client = [&base](BatchJob const & job) {
+        auto job_config = base;
+        if (job.model) {
+            auto const & model = json_value(*job.model);
+            auto & models = job_config.routing.models;
+            std::erase(models, model);
+            models.insert(models.begin(), model);
+            job_config.model = *job.model;
+        }
+        if (job.max_tokens) {
+            job_config.max_tokens = *job.max_tokens;
+        }
+        if (job.temperature) {
+            job_config.temperature = *job.temperature;
+        }
+        if (job.conversation.system_prompt()) {
+            job_config.system_prompt = job.conversation.system_prompt();
+        }
+        return std::unique_ptr<client::IClient>(
+            std::make_unique<client::OpenRouterClient>(std::move(job_config)));
+    };
+
+    auto const batch_config = BatchConfig{
+        .input = json_value(*config.batch_input),
+        .output = json_value(*config.batch_output),
+        .checkpoint = json_value(*config.batch_checkpoint),
+        .workers = json_value(config.batch_workers)};
+
+    // Ctrl-C stops the batch; rerunning it resumes from the checkpoint.
+    InterruptGuard interrupt;
+    auto summary = run_batch(batch_config, make_client, interrupt.token());
+    if (not summary) {
+        std::cerr << "Error: " << summary.error() << "\n";
+        return ExitCode::error;
+    }
+    summary->report(std::cerr);
+    if (summary->failed > 0 or summary->cancelled > 0) {
+        return ExitCode::error;
+    }
+    return ExitCode::success;
+}
+
+} // anonymous namespace
+
 // ------------------------------------------------------------------
 // ChatLoop construction / destruction
 // ------------------------------------------------------------------
@@ -51,6 +305,9 @@ run()
     do_display_welcome();
 
     while (true) {
+        // Connect in the background while the user types, so the
+        // request does not wait for connection setup.
+        client_->warm_up();
         auto line = do_read_input();
         if (not line) {
             break;
@@ -68,7 +325,12 @@ run()
             continue;
         }
 
+        // Ctrl-C cancels the turn and returns to the prompt, instead
+        // of ending the session.
+        InterruptGuard interrupt;
+        turn_stop_ = interrupt.token();
         do_process_input(UserInput{std::move(*line)});
+        turn_stop_ = {};
     }
 
     return ExitCode::success;
@@ -90,6 +352,7 @@ handle_builtin_command(std::string_view cmd)
     if (cmd == "/clear") {
         conversation_.clear();
         usage_history_.clear();
+        tier_history_.clear();
         out_ << "Conversation cleared.\n\n";
         return CommandResult::handled;
     }
@@ -102,29 +365,51 @@ handle_builtin_command(std::string_view cmd)
 
         out_ << "Per-turn token usage:\n"
             << std::format(
-                   "  {:>4s}  {:>8s}  {:>10s}  {:>7s}\n",
-                   "Turn", "Prompt", "Completion", "Total");
+                   "  {:>4s}  {:>8s}  {:>10s}  {:>7s}  {:>8s}\n",
+                   "Turn", "Prompt", "Completion", "Total", "Cached");
 
-        auto cumulative = TokenUsage{};
         for (std::size_t i = 0; i < usage_history_.size(); ++i) {
-            auto const & u = usage_history_[i];
+            auto const & turn = usage_history_[i];
+            auto const & u = turn.usage;
             out_ << std::format(
-                "  {:>4d}  {:>8d}  {:>10d}  {:>7d}\n",
+                "  {:>4d}  {:>8d}  {:>10d}  {:>7d}  {:>8d}\n",
                 i + 1,
                 json_value(u.prompt_tokens),
                 json_value(u.completion_tokens),
-                json_value(u.total_tokens));
-            cumulative.prompt_tokens += u.prompt_tokens;
-            cumulative.completion_tokens += u.completion_tokens;
-            cumulative.total_tokens += u.total_tokens;
+                json_value(u.total_tokens),
+                json_value(u.cached_tokens));
+
+            // A turn that used tools: one row per model request.
+            if (turn.iterations.size() < 2) {
+                continue;
+            }
+            for (std::size_t j = 0; j < turn.iterations.size(); ++j) {
+                auto const & iteration = turn.iterations[j];
+                auto const it = iteration.usage.value_or(TokenUsage{});
+                out_ << std::format(
+                    "  {:>4s}  {:>8d}  {:>10d}  {:>7d}  {:>8d}  {} ms{}\n",
+                    std::format("{}.{}", i + 1, j + 1),
+                    json_value(it.prompt_tokens),
+                    json_value(it.completion_tokens),
+                    json_value(it.total_tokens),
+                    json_value(it.cached_tokens),
+                    iteration.latency.count(),
+                    tool_times(iteration.tools));
+            }
         }
 
+        auto const cumulative = sum_usage(usage_history_);
         out_ << std::format(
             "\nCumulative: {} prompt + {} completion"
-            " = {} total tokens\n\n",
+            " = {} total tokens\n"
+            "Prompt cache: {:.1f}% hit rate"
+            " ({} read, {} written)\n\n",
             json_value(cumulative.prompt_tokens),
             json_value(cumulative.completion_tokens),
-            json_value(cumulative.total_tokens));
+            json_value(cumulative.total_tokens),
+            cache_hit_percent(cumulative),
+            json_value(cumulative.cached_tokens),
+            json_value(cumulative.cache_write_tokens));
         return CommandResult::handled;
     }
 
@@ -134,23 +419,76 @@ handle_builtin_command(std::string_view cmd)
             return CommandResult::handled;
         }
 
-        auto cumulative = TokenUsage{};
-        for (auto const & u : usage_history_) {
-            cumulative.prompt_tokens += u.prompt_tokens;
-            cumulative.completion_tokens += u.completion_tokens;
-            cumulative.total_tokens += u.total_tokens;
+        auto const cumulative = sum_usage(usage_history_);
+        auto requests = std::size_t{0};
+        for (auto const & turn : usage_history_) {
+            requests += std::max<std::size_t>(turn.iterations.size(), 1);
         }
-
         out_ << std::format(
-            "Token usage ({} turn{}):\n"
+            "Token usage ({} turn{}{}):\n"
             "  Prompt:     {}\n"
             "  Completion: {}\n"
-            "  Total:      {}\n\n",
+            "  Total:      {}\n"
+            "  Cache hit:  {:.1f}% ({} read, {} written)\n",
             usage_history_.size(),
             usage_history_.size() == 1 ? "" : "s",
+            requests > usage_history_.size()
+                ? std::format(", {} model requests", requests)
+                : "",
             json_value(cumulative.prompt_tokens),
             json_value(cumulative.completion_tokens),
-            json_value(cumulative.total_tokens));
+            json_value(cumulative.total_tokens),
+            cache_hit_percent(cumulative),
+            json_value(cumulative.cached_tokens),
+            json_value(cumulative.cache_write_tokens));
+        report_tiers();
+        out_ << "\n";
+        return CommandResult::handled;
+    }
+
+    if (cmd == "/tier" or cmd.starts_with("/tier ")) {
+        if (not config_.fast_model) {
+            out_ << "Model tiers are off; set --fast-model or "
+                    "LLM_FAST_MODEL to enable them.\n\n";
+            return CommandResult::handled;
+        }
+        auto const arg = cmd.substr(std::min(cmd.size(), std::size_t{6}));
+        if (arg == "auto") {
+            tier_override_.reset();
+        } else if (arg == "fast") {
+            tier_override_ = client::ModelTier::fast;
+        } else if (arg == "strong") {
+            tier_override_ = client::ModelTier::strong;
+        } else if (not arg.empty()) {
+            out_ << "Usage: /tier [auto|fast|strong]\n\n";
+            return CommandResult::handled;
+        }
+        out_ << std::format(
+            "Model tier: {} (fast model: {})\n\n",
+            tier_override_ ? client::to_string(*tier_override_) : "auto",
+            json_value(*config_.fast_model));
+        return CommandResult::handled;
+    }
+
+    if (cmd == "/stats") {
+        std::ostringstream stats;
+        client_->report_stats(stats);
+        if (stats.str().empty()) {
+            out_ << "No client statistics available.\n\n";
+        } else {
+            out_ << stats.str() << "\n";
+        }
+        return CommandResult::handled;
+    }
+
+    if (cmd == "/status") {
+        std::ostringstream status;
+        client_->report_status(status);
+        if (status.str().empty()) {
+            out_ << "No endpoint status available.\n\n";
+        } else {
+            out_ << status.str() << "\n";
+        }
         return CommandResult::handled;
     }
 
@@ -159,14 +497,68 @@ handle_builtin_command(std::string_view cmd)
             << "  /exit, /quit  Exit the chat\n"
             << "  /clear        Clear conversation history\n"
             << "  /usage        Show cumulative token usage\n"
-            << "  /usage all    Show per-turn token usage\n"
-            << "  /help         Show this help\n\n";
+            << "  /usage all    Show per-turn and per-request token usage\n"
+            << "  /tier [mode]  Show or set model tier (auto, fast, strong)\n"
+            << "  /stats        Show client statistics\n"
+            << "  /status       Show endpoint health\n"
+            << "  /help         Show this help\n"
+            << "  Ctrl-C        Cancel the pending response\n\n";
         return CommandResult::handled;
     }
 
     return CommandResult::unrecognized;
 }
 
+client::ModelTier
+ChatLoop::
+select_tier(std::string_view input) const
+{
+    if (not config_.fast_model) {
+        return client::ModelTier::strong;
+    }
+    if (tier_override_) {
+        return *tier_override_;
+    }
+    return classify_turn(input, conversation_.size()).tier;
+}
+
+void
+ChatLoop::
+report_tiers()
+{
+    if (tier_history_.empty()) {
+        return;
+    }
+
+    out_ << "  By tier:\n";
+    for (auto const tier : {client::ModelTier::fast, client::ModelTier::strong})
+    {
+        std::size_t turns = 0;
+        std::chrono::milliseconds latency{0};
+        std::uint64_t tokens = 0;
+        for (auto const & turn : tier_history_) {
+            if (turn.tier != tier) {
+                continue;
+            }
+            ++turns;
+            latency += turn.latency;
+            if (turn.usage) {
+                tokens += json_value(turn.usage->total_tokens);
+            }
+        }
+        if (turns == 0) {
+            continue;
+        }
+        out_ << std::format(
+            "    {:<7s} {} turn{}, {} ms average, {} tokens\n",
+            client::to_string(tier),
+            turns,
+            turns == 1 ? "" : "s",
+            latency.count() / static_cast<std::int64_t>(turns),
+            tokens);
+    }
+}
+
 // ------------------------------------------------------------------
 // Default NVI implementations
 // ------------------------------------------------------------------
@@ -204,9 +596,20 @@ void
 ChatLoop::
 do_process_input(UserInput input)
 {
+    auto const tier = select_tier(json_value(input));
     conversation_.add_message(input);
-    auto result = client_->send_message(conversation_);
-
+    auto const start = std::chrono::steady_clock::now();
+    auto result = client_->send_message(conversation_, turn_stop_, tier);
+    auto const latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    // A response that raced the cancellation is kept; otherwise the
+    // turn is dropped from the history, as a failed one is.
+    if (not result and turn_stop_.stop_requested()) {
+        out_ << "\n[Cancelled]\n\n";
+        conversation_.pop_back();
+        return;
+    }
     if (not result) {
         do_handle_error(result.error());
         return;
@@ -215,7 +618,12 @@ do_process_input(UserInput input)
     auto & chat_response = *result;
 
     if (chat_response.usage) {
-        usage_history_.push_back(*chat_response.usage);
+        usage_history_.push_back(TurnUsage{
+            .usage = *chat_response.usage,
+            .iterations = chat_response.iterations});
+    }
+    if (config_.fast_model) {
+        tier_history_.push_back({tier, latency, chat_response.usage});
     }
 
     do_display_response(chat_response.response);
@@ -274,13 +682,18 @@ run(int argc, char * argv[])
         return ExitCode::success;
     }
 
+    auto client_config = make_client_config(config);
+    if (not client_config) {
+        std::cerr << "Error: " << client_config.error() << "\n";
+        return ExitCode::error;
+    }
+
+    if (config.batch_input) {
+        return run_batch_mode(config, std::move(*client_config));
+    }
+
     auto client = std::make_unique<client::OpenRouterClient>(
-        client::OpenRouterClientConfig{
-            .api_key = config.api_key,
-            .model = config.model,
-            .max_tokens = config.max_tokens,
-            .system_prompt = config.system_prompt,
-            .temperature = config.temperature});
+        std::move(*client_config));
 
     return run(config, std::move(client), std::cin, std::cout);
 }
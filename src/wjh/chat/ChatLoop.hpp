@@ -12,10 +12,12 @@
 #include "wjh/chat/client/IClient.hpp"
 #include "wjh/chat/conversation/Conversation.hpp"
 
+#include <chrono>
 #include <istream>
 #include <memory>
 #include <optional>
 #include <ostream>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -41,6 +43,16 @@ enum class CommandResult
     unrecognized ///< Input is not a command.
 };
 
+/**
+ * Token usage of one answered turn, with one entry per model request
+ * the agent loop made for it.
+ */
+struct TurnUsage
+{
+    TokenUsage usage;
+    std::vector<IterationStats> iterations{};
+};
+
 /**
  * Chat loop with NVI extension points.
  *
@@ -103,10 +115,28 @@ protected:
         return out_;
     }
 
+    /**
+     * Model tier for the next turn: the /tier override if one is set,
+     * otherwise classify_turn()'s pick.  Always strong when no fast
+     * model is configured.
+     */
+    [[nodiscard]]
+    client::ModelTier select_tier(std::string_view input) const;
+
+    /**
+     * Stop token of the turn being processed; Ctrl-C requests a stop.
+     */
+    [[nodiscard]]
+    std::stop_token turn_stop() const
+    {
+        return turn_stop_;
+    }
+
     /// @}
 
     /**
-     * Handle built-in commands (/exit, /quit, /clear, /help).
+     * Handle built-in commands (/exit, /quit, /clear, /usage, /tier,
+     * /stats, /help).
      *
      * Derived classes can call this as a fallback after checking
      * their own commands in do_handle_command().
@@ -139,8 +169,9 @@ private:
 
     /**
      * Process user input: send to LLM and handle result.
-     * Default: sends message, dispatches to
-     * do_display_response() or do_handle_error().
+     * Default: sends message with turn_stop(), dispatches to
+     * do_display_response() or do_handle_error(), and drops a
+     * cancelled turn from the conversation.
      */
     virtual void do_process_input(UserInput input);
 
@@ -158,10 +189,27 @@ private:
 
     /// @}
 
+    /**
+     * One answered turn, for the per-tier /usage breakdown.
+     */
+    struct TierTurn
+    {
+        client::ModelTier tier;
+        std::chrono::milliseconds latency;
+        std::optional<TokenUsage> usage;
+    };
+
+    void report_tiers();
+
     Config config_;
     std::unique_ptr<client::IClient> client_;
     conversation::Conversation conversation_;
-    std::vector<TokenUsage> usage_history_;
+    std::vector<TurnUsage> usage_history_;
+    std::stop_token turn_stop_;
+
+    /// Tier forced by /tier; classified per turn when empty.
+    std::optional<client::ModelTier> tier_override_;
+    std::vector<TierTurn> tier_history_;
     std::istream & in_;
     std::ostream & out_;
 };
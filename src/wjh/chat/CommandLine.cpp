@@ -11,6 +11,22 @@
 
 namespace wjh::chat {
 
+namespace {
+
+Result<std::uint32_t>
+parse_count(std::string_view flag, std::string_view val)
+{
+    std::uint32_t count = 0;
+    auto [ptr, ec] =
+        std::from_chars(val.data(), val.data() + val.size(), count);
+    if (ec != std::errc{} or ptr != val.data() + val.size()) {
+        return make_error("Invalid number for {}: '{}'", flag, val);
+    }
+    return count;
+}
+
+} // anonymous namespace
+
 Result<CommandLineArgs>
 parse_args(std::span<char const * const> args)
 {
@@ -30,6 +46,238 @@ parse_args(std::span<char const * const> args)
             continue;
         }
 
+        if (arg == "--no-prompt-cache") {
+            result.prompt_caching = PromptCaching{false};
+            continue;
+        }
+
+        if (arg == "--response-cache") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            result.response_cache_dir = ResponseCacheDir{args[++i]};
+            continue;
+        }
+
+        if (arg == "--offline") {
+            result.offline = OfflineMode{true};
+            continue;
+        }
+
+        if (arg == "--max-retries" or arg == "--retry-budget") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            auto count = parse_count(arg, args[++i]);
+            if (not count) {
+                return make_error("{}", count.error());
+            }
+            if (arg == "--max-retries") {
+                result.max_retries = MaxRetries{*count};
+            } else {
+                result.retry_budget = RetryBudget{*count};
+            }
+            continue;
+        }
+
+        if (arg == "--hedge") {
+            result.hedge = HedgeRequests{true};
+            continue;
+        }
+
+        if (arg == "--hedge-provider") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            result.hedge_provider = HedgeProvider{args[++i]};
+            continue;
+        }
+
+        if (arg == "--rpm" or arg == "--tpm") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            auto count = parse_count(arg, args[++i]);
+            if (not count) {
+                return make_error("{}", count.error());
+            }
+            if (arg == "--rpm") {
+                result.requests_per_minute = RequestsPerMinute{*count};
+            } else {
+                result.tokens_per_minute = TokensPerMinute{*count};
+            }
+            continue;
+        }
+
+        if (arg == "--circuit-failure-rate" or arg == "--circuit-timeouts") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            auto count = parse_count(arg, args[++i]);
+            if (not count) {
+                return make_error("{}", count.error());
+            }
+            if (arg == "--circuit-failure-rate") {
+                result.circuit_failure_rate = CircuitFailureRate{*count};
+            } else {
+                result.circuit_timeouts = CircuitTimeouts{*count};
+            }
+            continue;
+        }
+
+        if (arg == "--fallback-host") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            result.fallback_host = FallbackHost{args[++i]};
+            continue;
+        }
+
+        if (arg == "--base-url") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            result.base_url = ApiBaseUrl{args[++i]};
+            continue;
+        }
+
+        if (arg == "--fallback-models" or arg == "--provider-sort"
+            or arg == "--provider-only" or arg == "--provider-ignore"
+            or arg == "--route-log" or arg == "--fast-model")
+        {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            auto value = std::string(args[++i]);
+            if (arg == "--fallback-models") {
+                result.fallback_models = FallbackModels{std::move(value)};
+            } else if (arg == "--provider-sort") {
+                result.provider_sort = ProviderSort{std::move(value)};
+            } else if (arg == "--provider-only") {
+                result.provider_only = ProviderOnly{std::move(value)};
+            } else if (arg == "--provider-ignore") {
+                result.provider_ignore = ProviderIgnore{std::move(value)};
+            } else if (arg == "--route-log") {
+                result.route_log = RouteLogPath{std::move(value)};
+            } else {
+                result.fast_model = FastModel{std::move(value)};
+            }
+            continue;
+        }
+
+        if (arg == "--batch" or arg == "--batch-output"
+            or arg == "--batch-checkpoint")
+        {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            auto value = std::string(args[++i]);
+            if (arg == "--batch") {
+                result.batch_input = BatchInput{std::move(value)};
+            } else if (arg == "--batch-output") {
+                result.batch_output = BatchOutput{std::move(value)};
+            } else {
+                result.batch_checkpoint = BatchCheckpoint{std::move(value)};
+            }
+            continue;
+        }
+
+        if (arg == "--batch-workers") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            auto count = parse_count(arg, args[++i]);
+            if (not count) {
+                return make_error("{}", count.error());
+            }
+            result.batch_workers = BatchWorkers{*count};
+            continue;
+        }
+
+        if (arg == "--max-iterations" or arg == "--turn-deadline"
+            or arg == "--turn-token-budget")
+        {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            auto count = parse_count(arg, args[++i]);
+            if (not count) {
+                return make_error("{}", count.error());
+            }
+            if (arg == "--max-iterations") {
+                result.max_iterations = AgentMaxIterations{*count};
+            } else if (arg == "--turn-deadline") {
+                result.turn_deadline = TurnDeadline{*count};
+            } else {
+                result.turn_token_budget = TurnTokenBudget{*count};
+            }
+            continue;
+        }
+
+        if (arg == "--tool-policy" or arg == "--allow-tool"
+            or arg == "--deny-tool" or arg == "--tool-default")
+        {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            auto value = std::string(args[++i]);
+            if (arg == "--tool-policy") {
+                result.tool_policy = ToolPolicyFile{std::move(value)};
+            } else if (arg == "--allow-tool") {
+                result.allow_tools.emplace_back(std::move(value));
+            } else if (arg == "--deny-tool") {
+                result.deny_tools.emplace_back(std::move(value));
+            } else {
+                result.tool_default = ToolDefault{std::move(value)};
+            }
+            continue;
+        }
+
+        if (arg == "--tool-cpus" or arg == "--tool-memory"
+            or arg == "--tool-pids")
+        {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            auto count = parse_count(arg, args[++i]);
+            if (not count) {
+                return make_error("{}", count.error());
+            }
+            if (arg == "--tool-cpus") {
+                result.tool_cpus = ToolCpus{*count};
+            } else if (arg == "--tool-memory") {
+                result.tool_memory = ToolMemoryMb{*count};
+            } else {
+                result.tool_pids = ToolPids{*count};
+            }
+            continue;
+        }
+
+        if (arg == "--watch-dir") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            result.watch_dir = WatchDir{args[++i]};
+            continue;
+        }
+
+        if (arg == "--ttft-slo") {
+            if (i + 1 >= args.size()) {
+                return make_error("Missing argument for {}", arg);
+            }
+            auto count = parse_count(arg, args[++i]);
+            if (not count) {
+                return make_error("{}", count.error());
+            }
+            result.ttft_slo = TtftSlo{*count};
+            continue;
+        }
+
+        if (arg == "--no-prewarm") {
+            result.prewarm = PrewarmConnections{false};
+            continue;
+        }
+
         if (arg == "-m" or arg == "--model") {
             if (i + 1 >= args.size()) {
                 return make_error("Missing argument for {}", arg);
@@ -99,6 +347,42 @@ Options:
   -s, --system-prompt <text>  System prompt
   -t, --max-tokens <n>        Max response tokens (default: 4096)
   --temperature <value>       LLM temperature (0.0-2.0)
+  --no-prompt-cache           Disable prompt-cache breakpoints
+  --response-cache <dir>      Cache temperature-0 responses in <dir>
+  --offline                   Serve responses only from the response cache
+  --max-retries <n>           Retries per failed API request (default: 3)
+  --retry-budget <n>          Retries allowed per session (default: 20)
+  --hedge                     Duplicate API requests slower than usual
+  --hedge-provider <name>     Route hedge duplicates to this provider
+  --rpm <n>                   Max API requests per minute (default: unlimited)
+  --tpm <n>                   Max API tokens per minute (default: unlimited)
+  --circuit-failure-rate <pct>  Failure % that opens the circuit (default: 50)
+  --circuit-timeouts <n>      Consecutive timeouts that open it (default: 3)
+  --fallback-host <host>      Host to use while the circuit is open
+  --base-url <url>            Base URL (default: https://openrouter.ai/api/v1)
+  --no-prewarm                Connect only when a request is sent
+  --fallback-models <m1,m2>   Models to fail over to, in order
+  --provider-sort <order>     Provider order: throughput, latency, or price
+  --provider-only <p1,p2>     Route only to these providers
+  --provider-ignore <p1,p2>   Never route to these providers
+  --ttft-slo <ms>             Fail over when time to first token exceeds this
+  --route-log <file>          Append routing decisions to this JSONL file
+  --fast-model <id>           Send turns that look simple to this model
+  --batch <jobs.jsonl>        Run independent jobs instead of the REPL
+  --batch-output <file>       Batch results (default: <jobs>.results.jsonl)
+  --batch-checkpoint <file>   Finished jobs (default: <output>.checkpoint)
+  --batch-workers <n>         Batch jobs run concurrently (default: 4)
+  --max-iterations <n>        Tool-calling steps per turn (default: 20)
+  --turn-deadline <s>         Seconds per turn before answering (default: none)
+  --turn-token-budget <n>     Tokens per turn before answering (default: none)
+  --tool-policy <file>        Tool approval rules ("allow bash ^make", ...)
+  --allow-tool <rule>         Run matching calls without asking (repeatable)
+  --deny-tool <rule>          Refuse matching tool calls (repeatable)
+  --tool-default <decision>   Other non-read-only calls: allow, deny, or ask
+  --tool-cpus <n>             CPUs tool processes may use (default: none)
+  --tool-memory <MB>          Memory tool processes may use (default: none)
+  --tool-pids <n>             Processes tools may run at once (default: none)
+  --watch-dir <dir>           Watch <dir> for edits to cached files (opt-in)
   --show-config               Display resolved config and exit
   -h, --help                  Show this help message
 
@@ -108,11 +392,47 @@ Environment variables:
   MAX_TOKENS                  Max tokens override
   TEMPERATURE                 LLM temperature override
   SYSTEM_PROMPT               System prompt
+  PROMPT_CACHE                Prompt-cache breakpoints (on/off, default on)
+  RESPONSE_CACHE_DIR          Response cache directory
+  RESPONSE_CACHE_OFFLINE      Serve responses only from the cache (on/off)
+  MAX_RETRIES                 Retries per failed API request
+  RETRY_BUDGET                Retries allowed per session
+  HEDGE_REQUESTS              Hedge slow API requests (on/off)
+  HEDGE_PROVIDER              Provider that hedge requests are routed to
+  RATE_LIMIT_RPM              Max API requests per minute
+  RATE_LIMIT_TPM              Max API tokens per minute
+  CIRCUIT_FAILURE_RATE        Failure % that opens the circuit (0 = off)
+  CIRCUIT_TIMEOUTS            Consecutive timeouts that open it (0 = off)
+  FALLBACK_HOST               Host to use while the circuit is open
+  API_BASE_URL                API base URL (http://, https://, unix://)
+  PREWARM_CONNECTIONS         Connect while the user types (on/off, default on)
+  LLM_FALLBACK_MODELS         Models to fail over to, comma-separated
+  PROVIDER_SORT               Provider order: throughput, latency, or price
+  PROVIDER_ONLY               Providers to route to, comma-separated
+  PROVIDER_IGNORE             Providers never to route to, comma-separated
+  TTFT_SLO_MS                 Time-to-first-token objective in ms (0 = none)
+  ROUTE_LOG                   File routing decisions are appended to
+  LLM_FAST_MODEL              Model for turns that look simple
+  BATCH_WORKERS               Batch jobs run concurrently
+  AGENT_MAX_ITERATIONS        Tool-calling steps per turn
+  TURN_DEADLINE_SECONDS       Seconds per turn (0 = none)
+  TURN_TOKEN_BUDGET           Tokens per turn (0 = none)
+  TOOL_POLICY                 Tool approval rules file
+  TOOL_DEFAULT                Other non-read-only calls: allow, deny, or ask
+  TOOL_CPUS                   CPUs tool processes may use (0 = no limit)
+  TOOL_MEMORY_MB              Megabytes tool processes may use (0 = no limit)
+  TOOL_PIDS                   Processes tools may run at once (0 = no limit)
+  WATCH_DIR                   Directory watched for edits to cached files
 
 REPL commands:
   /exit, /quit                Exit the chat
   /clear                      Clear conversation history
+  /usage [all]                Show token usage and prompt-cache hit rate
+  /tier [auto|fast|strong]    Show or force the model tier for turns
+  /stats                      Show client statistics
+  /status                     Show endpoint health
   /help                       Show REPL commands
+  Ctrl-C                      Cancel the pending response
 )";
     return HelpText{std::format(fmt, program_name)};
 }
@@ -13,6 +13,7 @@
 #include <optional>
 #include <span>
 #include <string>
+#include <vector>
 
 namespace wjh::chat {
 
@@ -28,6 +29,42 @@ struct CommandLineArgs
     std::optional<SystemPrompt> system_prompt;
     std::optional<MaxTokens> max_tokens;
     std::optional<Temperature> temperature;
+    std::optional<PromptCaching> prompt_caching;
+    std::optional<ResponseCacheDir> response_cache_dir;
+    std::optional<OfflineMode> offline;
+    std::optional<MaxRetries> max_retries;
+    std::optional<RetryBudget> retry_budget;
+    std::optional<HedgeRequests> hedge;
+    std::optional<HedgeProvider> hedge_provider;
+    std::optional<RequestsPerMinute> requests_per_minute;
+    std::optional<TokensPerMinute> tokens_per_minute;
+    std::optional<CircuitFailureRate> circuit_failure_rate;
+    std::optional<CircuitTimeouts> circuit_timeouts;
+    std::optional<FallbackHost> fallback_host;
+    std::optional<ApiBaseUrl> base_url;
+    std::optional<PrewarmConnections> prewarm;
+    std::optional<FallbackModels> fallback_models;
+    std::optional<ProviderSort> provider_sort;
+    std::optional<ProviderOnly> provider_only;
+    std::optional<ProviderIgnore> provider_ignore;
+    std::optional<TtftSlo> ttft_slo;
+    std::optional<RouteLogPath> route_log;
+    std::optional<FastModel> fast_model;
+    std::optional<BatchInput> batch_input;
+    std::optional<BatchOutput> batch_output;
+    std::optional<BatchCheckpoint> batch_checkpoint;
+    std::optional<BatchWorkers> batch_workers;
+    std::optional<AgentMaxIterations> max_iterations;
+    std::optional<TurnDeadline> turn_deadline;
+    std::optional<TurnTokenBudget> turn_token_budget;
+    std::optional<ToolPolicyFile> tool_policy;
+    std::vector<ToolRule> allow_tools;
+    std::vector<ToolRule> deny_tools;
+    std::optional<ToolDefault> tool_default;
+    std::optional<ToolCpus> tool_cpus;
+    std::optional<ToolMemoryMb> tool_memory;
+    std::optional<ToolPids> tool_pids;
+    std::optional<WatchDir> watch_dir;
     ShowConfig show_config;
     ShowHelp help;
 };
@@ -40,6 +77,42 @@ struct CommandLineArgs
  *   -s, --system-prompt <text> System prompt
  *   -t, --max-tokens <n>      Max response tokens
  *   --temperature <value>      LLM temperature (0.0-2.0)
+ *   --no-prompt-cache          Disable prompt-cache breakpoints
+ *   --response-cache <dir>     Enable the local response cache
+ *   --offline                  Serve responses only from the cache
+ *   --max-retries <n>          Retries per failed API request
+ *   --retry-budget <n>         Retries allowed over the whole session
+ *   --hedge                    Hedge slow API requests
+ *   --hedge-provider <name>    Route hedge requests to this provider
+ *   --rpm <n>                  Client-side requests-per-minute limit
+ *   --tpm <n>                  Client-side tokens-per-minute limit
+ *   --circuit-failure-rate <pct>  Failure rate that opens the circuit
+ *   --circuit-timeouts <n>     Consecutive timeouts that open the circuit
+ *   --fallback-host <host>     Host used while the circuit is open
+ *   --base-url <url>           API base URL (http, https, or unix socket)
+ *   --no-prewarm               Do not open connections ahead of requests
+ *   --fallback-models <list>   Models to fail over to, in order
+ *   --provider-sort <order>    OpenRouter provider sort order
+ *   --provider-only <list>     OpenRouter providers to allow
+ *   --provider-ignore <list>   OpenRouter providers to deny
+ *   --ttft-slo <ms>            Time-to-first-token objective
+ *   --route-log <file>         Log routing decisions as JSON lines
+ *   --fast-model <id>          Model for turns judged simple
+ *   --batch <file>             Run JSONL jobs instead of the REPL
+ *   --batch-output <file>      Where batch results are appended
+ *   --batch-checkpoint <file>  Finished batch jobs, for resuming
+ *   --batch-workers <n>        Batch jobs run concurrently
+ *   --max-iterations <n>       Tool-calling steps per turn
+ *   --turn-deadline <s>        Wall-clock seconds per turn
+ *   --turn-token-budget <n>    Tokens per turn
+ *   --tool-policy <file>       Tool approval rules
+ *   --allow-tool <rule>        Run matching tool calls without asking
+ *   --deny-tool <rule>         Refuse matching tool calls
+ *   --tool-default <decision>  allow, deny or ask for other calls
+ *   --tool-cpus <n>            CPUs tool processes may use
+ *   --tool-memory <MB>         Memory tool processes may use
+ *   --tool-pids <n>            Processes tools may run at once
+ *   --watch-dir <dir>          Tree watched for changes to cached files
  *   --show-config              Display resolved config and exit
  *   -h, --help                 Show help
  */
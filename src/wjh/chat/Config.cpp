@@ -7,6 +7,8 @@
 #include "wjh/chat/Config.hpp"
 
 #include "wjh/chat/json_convert.hpp"
+#include "wjh/chat/client/HttpClient.hpp"
+#include "wjh/chat/client/ModelRouter.hpp"
 
 #include <charconv>
 #include <cstdlib>
@@ -14,6 +16,7 @@
 #include <format>
 #include <fstream>
 #include <string>
+#include <string_view>
 
 #include <dotenv.h>
 
@@ -39,6 +42,30 @@ get_env(char const * name)
     return std::nullopt;
 }
 
+std::optional<bool>
+parse_bool(std::string_view value)
+{
+    if (value == "1" or value == "true" or value == "on" or value == "yes") {
+        return true;
+    }
+    if (value == "0" or value == "false" or value == "off" or value == "no") {
+        return false;
+    }
+    return std::nullopt;
+}
+
+std::optional<std::uint32_t>
+parse_uint32(std::string_view value)
+{
+    std::uint32_t result = 0;
+    auto [ptr, ec] =
+        std::from_chars(value.data(), value.data() + value.size(), result);
+    if (ec != std::errc{} or ptr != value.data() + value.size()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
 } // anonymous namespace
 
 void
@@ -121,6 +148,338 @@ resolve_config(CommandLineArgs const & args)
         config.temperature = Temperature{val};
     }
 
+    // Resolve prompt caching: CLI > env > default (on)
+    if (args.prompt_caching) {
+        config.prompt_caching = *args.prompt_caching;
+    } else if (auto env = get_env("PROMPT_CACHE")) {
+        auto val = parse_bool(*env);
+        if (not val) {
+            return make_error("Invalid PROMPT_CACHE value: '{}'", *env);
+        }
+        config.prompt_caching = PromptCaching{*val};
+    }
+
+    // Resolve response cache: CLI > env > disabled
+    if (args.response_cache_dir) {
+        config.response_cache_dir = *args.response_cache_dir;
+    } else if (auto env = get_env("RESPONSE_CACHE_DIR")) {
+        config.response_cache_dir = ResponseCacheDir{std::move(*env)};
+    }
+
+    if (args.offline) {
+        config.offline = *args.offline;
+    } else if (auto env = get_env("RESPONSE_CACHE_OFFLINE")) {
+        auto val = parse_bool(*env);
+        if (not val) {
+            return make_error(
+                "Invalid RESPONSE_CACHE_OFFLINE value: '{}'", *env);
+        }
+        config.offline = OfflineMode{*val};
+    }
+
+    // Resolve retry limits: CLI > env > default
+    if (args.max_retries) {
+        config.max_retries = *args.max_retries;
+    } else if (auto env = get_env("MAX_RETRIES")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid MAX_RETRIES value: '{}'", *env);
+        }
+        config.max_retries = MaxRetries{*val};
+    }
+
+    if (args.retry_budget) {
+        config.retry_budget = *args.retry_budget;
+    } else if (auto env = get_env("RETRY_BUDGET")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid RETRY_BUDGET value: '{}'", *env);
+        }
+        config.retry_budget = RetryBudget{*val};
+    }
+
+    // Resolve request hedging: CLI > env > default (off)
+    if (args.hedge) {
+        config.hedge = *args.hedge;
+    } else if (auto env = get_env("HEDGE_REQUESTS")) {
+        auto val = parse_bool(*env);
+        if (not val) {
+            return make_error("Invalid HEDGE_REQUESTS value: '{}'", *env);
+        }
+        config.hedge = HedgeRequests{*val};
+    }
+
+    if (args.hedge_provider) {
+        config.hedge_provider = *args.hedge_provider;
+    } else if (auto env = get_env("HEDGE_PROVIDER")) {
+        config.hedge_provider = HedgeProvider{std::move(*env)};
+    }
+
+    // Resolve client-side rate limits: CLI > env > default (unlimited)
+    if (args.requests_per_minute) {
+        config.requests_per_minute = *args.requests_per_minute;
+    } else if (auto env = get_env("RATE_LIMIT_RPM")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid RATE_LIMIT_RPM value: '{}'", *env);
+        }
+        config.requests_per_minute = RequestsPerMinute{*val};
+    }
+
+    if (args.tokens_per_minute) {
+        config.tokens_per_minute = *args.tokens_per_minute;
+    } else if (auto env = get_env("RATE_LIMIT_TPM")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid RATE_LIMIT_TPM value: '{}'", *env);
+        }
+        config.tokens_per_minute = TokensPerMinute{*val};
+    }
+
+    // Resolve circuit breaker thresholds: CLI > env > default
+    if (args.circuit_failure_rate) {
+        config.circuit_failure_rate = *args.circuit_failure_rate;
+    } else if (auto env = get_env("CIRCUIT_FAILURE_RATE")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error(
+                "Invalid CIRCUIT_FAILURE_RATE value: '{}'", *env);
+        }
+        config.circuit_failure_rate = CircuitFailureRate{*val};
+    }
+    if (config.circuit_failure_rate > CircuitFailureRate{100u}) {
+        return make_error(
+            "Circuit failure rate must be a percentage (0-100), got {}",
+            json_value(config.circuit_failure_rate));
+    }
+
+    if (args.circuit_timeouts) {
+        config.circuit_timeouts = *args.circuit_timeouts;
+    } else if (auto env = get_env("CIRCUIT_TIMEOUTS")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid CIRCUIT_TIMEOUTS value: '{}'", *env);
+        }
+        config.circuit_timeouts = CircuitTimeouts{*val};
+    }
+
+    if (args.fallback_host) {
+        config.fallback_host = *args.fallback_host;
+    } else if (auto env = get_env("FALLBACK_HOST")) {
+        config.fallback_host = FallbackHost{std::move(*env)};
+    }
+    if (config.fallback_host and json_value(*config.fallback_host).empty()) {
+        config.fallback_host.reset();
+    }
+
+    // Resolve API base URL: CLI > env > default (OpenRouter)
+    if (args.base_url) {
+        config.base_url = *args.base_url;
+    } else if (auto env = get_env("API_BASE_URL")) {
+        config.base_url = ApiBaseUrl{std::move(*env)};
+    }
+    if (config.base_url) {
+        auto endpoint = client::parse_base_url(json_value(*config.base_url));
+        if (not endpoint) {
+            return make_error("{}", endpoint.error());
+        }
+    }
+
+    // Resolve connection pre-warming: CLI > env > default (on)
+    if (args.prewarm) {
+        config.prewarm = *args.prewarm;
+    } else if (auto env = get_env("PREWARM_CONNECTIONS")) {
+        auto val = parse_bool(*env);
+        if (not val) {
+            return make_error(
+                "Invalid PREWARM_CONNECTIONS value: '{}'", *env);
+        }
+        config.prewarm = PrewarmConnections{*val};
+    }
+
+    // Resolve model and provider routing: CLI > env > none
+    if (args.fallback_models) {
+        config.fallback_models = *args.fallback_models;
+    } else if (auto env = get_env("LLM_FALLBACK_MODELS")) {
+        config.fallback_models = FallbackModels{std::move(*env)};
+    }
+    if (args.provider_sort) {
+        config.provider_sort = *args.provider_sort;
+    } else if (auto env = get_env("PROVIDER_SORT")) {
+        config.provider_sort = ProviderSort{std::move(*env)};
+    }
+    if (config.provider_sort and json_value(*config.provider_sort).empty()) {
+        config.provider_sort.reset();
+    }
+    if (config.provider_sort
+        and not client::is_provider_sort(json_value(*config.provider_sort)))
+    {
+        return make_error(
+            "Invalid provider sort '{}': expected throughput, latency, "
+            "or price",
+            *config.provider_sort);
+    }
+    if (args.provider_only) {
+        config.provider_only = *args.provider_only;
+    } else if (auto env = get_env("PROVIDER_ONLY")) {
+        config.provider_only = ProviderOnly{std::move(*env)};
+    }
+    if (args.provider_ignore) {
+        config.provider_ignore = *args.provider_ignore;
+    } else if (auto env = get_env("PROVIDER_IGNORE")) {
+        config.provider_ignore = ProviderIgnore{std::move(*env)};
+    }
+    if (args.ttft_slo) {
+        config.ttft_slo = *args.ttft_slo;
+    } else if (auto env = get_env("TTFT_SLO_MS")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid TTFT_SLO_MS value: '{}'", *env);
+        }
+        config.ttft_slo = TtftSlo{*val};
+    }
+    if (args.route_log) {
+        config.route_log = *args.route_log;
+    } else if (auto env = get_env("ROUTE_LOG")) {
+        config.route_log = RouteLogPath{std::move(*env)};
+    }
+    if (args.fast_model) {
+        config.fast_model = *args.fast_model;
+    } else if (auto env = get_env("LLM_FAST_MODEL")) {
+        config.fast_model = FastModel{std::move(*env)};
+    }
+    if (config.fast_model and json_value(*config.fast_model).empty()) {
+        config.fast_model.reset();
+    }
+
+    // Resolve agent-loop limits: CLI > env > default
+    if (args.max_iterations) {
+        config.max_iterations = *args.max_iterations;
+    } else if (auto env = get_env("AGENT_MAX_ITERATIONS")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error(
+                "Invalid AGENT_MAX_ITERATIONS value: '{}'", *env);
+        }
+        config.max_iterations = AgentMaxIterations{*val};
+    }
+    if (config.max_iterations == AgentMaxIterations{0u}) {
+        return make_error("Agent max iterations must be at least 1");
+    }
+    if (args.turn_deadline) {
+        config.turn_deadline = *args.turn_deadline;
+    } else if (auto env = get_env("TURN_DEADLINE_SECONDS")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error(
+                "Invalid TURN_DEADLINE_SECONDS value: '{}'", *env);
+        }
+        config.turn_deadline = TurnDeadline{*val};
+    }
+    if (args.turn_token_budget) {
+        config.turn_token_budget = *args.turn_token_budget;
+    } else if (auto env = get_env("TURN_TOKEN_BUDGET")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid TURN_TOKEN_BUDGET value: '{}'", *env);
+        }
+        config.turn_token_budget = TurnTokenBudget{*val};
+    }
+
+    // Resolve tool approval: CLI > env; rules come only from the
+    // command line or the policy file
+    if (args.tool_policy) {
+        config.tool_policy = *args.tool_policy;
+    } else if (auto env = get_env("TOOL_POLICY")) {
+        config.tool_policy = ToolPolicyFile{std::move(*env)};
+    }
+    config.allow_tools = args.allow_tools;
+    config.deny_tools = args.deny_tools;
+    if (args.tool_default) {
+        config.tool_default = *args.tool_default;
+    } else if (auto env = get_env("TOOL_DEFAULT")) {
+        config.tool_default = ToolDefault{std::move(*env)};
+    }
+    if (config.tool_default) {
+        auto const & value = json_value(*config.tool_default);
+        if (value != "allow" and value != "deny" and value != "ask") {
+            return make_error(
+                "Tool default must be allow, deny or ask, not '{}'", value);
+        }
+    }
+
+    // Resolve tool process limits: CLI > env > default
+    if (args.tool_cpus) {
+        config.tool_cpus = *args.tool_cpus;
+    } else if (auto env = get_env("TOOL_CPUS")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid TOOL_CPUS value: '{}'", *env);
+        }
+        config.tool_cpus = ToolCpus{*val};
+    }
+    if (args.tool_memory) {
+        config.tool_memory = *args.tool_memory;
+    } else if (auto env = get_env("TOOL_MEMORY_MB")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid TOOL_MEMORY_MB value: '{}'", *env);
+        }
+        config.tool_memory = ToolMemoryMb{*val};
+    }
+    if (args.tool_pids) {
+        config.tool_pids = *args.tool_pids;
+    } else if (auto env = get_env("TOOL_PIDS")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid TOOL_PIDS value: '{}'", *env);
+        }
+        config.tool_pids = ToolPids{*val};
+    }
+
+    // Resolve the watched workspace: CLI > env; none by default
+    if (args.watch_dir) {
+        config.watch_dir = *args.watch_dir;
+    } else if (auto env = get_env("WATCH_DIR")) {
+        config.watch_dir = WatchDir{std::move(*env)};
+    }
+
+    // Resolve batch mode: CLI > env > default; output and checkpoint
+    // default to files next to the input
+    if (args.batch_workers) {
+        config.batch_workers = *args.batch_workers;
+    } else if (auto env = get_env("BATCH_WORKERS")) {
+        auto val = parse_uint32(*env);
+        if (not val) {
+            return make_error("Invalid BATCH_WORKERS value: '{}'", *env);
+        }
+        config.batch_workers = BatchWorkers{*val};
+    }
+    if (config.batch_workers == BatchWorkers{0u}) {
+        return make_error("Batch workers must be at least 1");
+    }
+    if (args.batch_input) {
+        config.batch_input = *args.batch_input;
+        config.batch_output = args.batch_output.value_or(BatchOutput{
+            std::filesystem::path(json_value(*args.batch_input))
+                .replace_extension(".results.jsonl")
+                .string()});
+        config.batch_checkpoint = args.batch_checkpoint.value_or(
+            BatchCheckpoint{std::filesystem::path(
+                                json_value(*config.batch_output))
+                                .replace_extension(".checkpoint")
+                                .string()});
+    } else if (args.batch_output or args.batch_checkpoint) {
+        return make_error(
+            "--batch-output and --batch-checkpoint require --batch");
+    }
+
+    if (config.offline and not config.response_cache_dir) {
+        return make_error(
+            "Offline mode requires a response cache directory "
+            "(--response-cache or RESPONSE_CACHE_DIR).");
+    }
+
     return config;
 }
 
@@ -131,6 +490,114 @@ print_config(Config const & config, std::ostream & out)
         << "  Model:      " << config.model << "\n"
         << "  Max tokens: " << config.max_tokens << "\n"
         << "  API key:    " << config.api_key.substr(0u, 12u) << "...\n";
+    out << "  Prompt cache: " << (config.prompt_caching ? "on" : "off")
+        << "\n";
+    if (config.response_cache_dir) {
+        out << "  Response cache: " << *config.response_cache_dir
+            << (config.offline ? " (offline)" : "") << "\n";
+    }
+    out << "  Retries:    " << config.max_retries << " per request, "
+        << config.retry_budget << " per session\n";
+    if (config.hedge) {
+        out << "  Hedging:    on";
+        if (config.hedge_provider) {
+            out << " (via " << *config.hedge_provider << ")";
+        }
+        out << "\n";
+    }
+    if (config.requests_per_minute != RequestsPerMinute{}
+        or config.tokens_per_minute != TokensPerMinute{})
+    {
+        out << "  Rate limit: " << config.requests_per_minute
+            << " requests, " << config.tokens_per_minute
+            << " tokens per minute (0 = unlimited)\n";
+    }
+    out << "  Circuit:    opens at " << config.circuit_failure_rate
+        << "% failures or " << config.circuit_timeouts
+        << " timeouts in a row (0 = off)\n";
+    if (config.fallback_host) {
+        out << "  Fallback:   " << *config.fallback_host << "\n";
+    }
+    if (config.base_url) {
+        out << "  Base URL:   " << *config.base_url << "\n";
+    }
+    out << "  Prewarm:    " << (config.prewarm ? "on" : "off") << "\n";
+    if (config.fallback_models) {
+        out << "  Fallbacks:  " << *config.fallback_models << "\n";
+    }
+    if (config.provider_sort or config.provider_only
+        or config.provider_ignore)
+    {
+        out << "  Providers: ";
+        if (config.provider_sort) {
+            out << " sort=" << *config.provider_sort;
+        }
+        if (config.provider_only) {
+            out << " only=" << *config.provider_only;
+        }
+        if (config.provider_ignore) {
+            out << " ignore=" << *config.provider_ignore;
+        }
+        out << "\n";
+    }
+    if (config.ttft_slo != TtftSlo{}) {
+        out << "  TTFT SLO:   " << config.ttft_slo << " ms\n";
+    }
+    if (config.route_log) {
+        out << "  Route log:  " << *config.route_log << "\n";
+    }
+    if (config.fast_model) {
+        out << "  Fast model: " << *config.fast_model << "\n";
+    }
+    out << "  Turn limit: " << config.max_iterations << " steps";
+    if (config.turn_deadline != TurnDeadline{}) {
+        out << ", " << config.turn_deadline << " s";
+    }
+    if (config.turn_token_budget != TurnTokenBudget{}) {
+        out << ", " << config.turn_token_budget << " tokens";
+    }
+    out << "\n";
+    if (config.tool_policy or not config.allow_tools.empty()
+        or not config.deny_tools.empty() or config.tool_default)
+    {
+        out << "  Tools:     ";
+        if (config.tool_policy) {
+            out << " policy=" << *config.tool_policy;
+        }
+        for (auto const & rule : config.allow_tools) {
+            out << " allow=\"" << rule << '"';
+        }
+        for (auto const & rule : config.deny_tools) {
+            out << " deny=\"" << rule << '"';
+        }
+        if (config.tool_default) {
+            out << " default=" << *config.tool_default;
+        }
+        out << "\n";
+    }
+    if (config.tool_cpus != ToolCpus{} or config.tool_memory != ToolMemoryMb{}
+        or config.tool_pids != ToolPids{})
+    {
+        out << "  Tool limits:";
+        if (config.tool_cpus != ToolCpus{}) {
+            out << " " << config.tool_cpus << " CPUs";
+        }
+        if (config.tool_memory != ToolMemoryMb{}) {
+            out << " " << config.tool_memory << " MB";
+        }
+        if (config.tool_pids != ToolPids{}) {
+            out << " " << config.tool_pids << " pids";
+        }
+        out << "\n";
+    }
+    if (config.watch_dir) {
+        out << "  Watching:   " << *config.watch_dir << "\n";
+    }
+    if (config.batch_input) {
+        out << "  Batch:      " << *config.batch_input << " -> "
+            << *config.batch_output << " (" << config.batch_workers
+            << " workers, checkpoint " << *config.batch_checkpoint << ")\n";
+    }
     if (config.temperature) {
         out << "  Temperature: " << *config.temperature << "\n";
     }
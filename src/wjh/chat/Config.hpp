@@ -14,6 +14,7 @@
 #include <filesystem>
 #include <optional>
 #include <ostream>
+#include <vector>
 
 namespace wjh::chat {
 
@@ -28,6 +29,42 @@ struct Config
     std::optional<SystemPrompt> system_prompt;
     std::optional<Temperature> temperature;
     ShowConfig show_config;
+    PromptCaching prompt_caching{};
+    std::optional<ResponseCacheDir> response_cache_dir{};
+    OfflineMode offline{};
+    MaxRetries max_retries{};
+    RetryBudget retry_budget{};
+    HedgeRequests hedge{};
+    std::optional<HedgeProvider> hedge_provider{};
+    RequestsPerMinute requests_per_minute{};
+    TokensPerMinute tokens_per_minute{};
+    CircuitFailureRate circuit_failure_rate{};
+    CircuitTimeouts circuit_timeouts{};
+    std::optional<FallbackHost> fallback_host{};
+    std::optional<ApiBaseUrl> base_url{};
+    PrewarmConnections prewarm{};
+    std::optional<FallbackModels> fallback_models{};
+    std::optional<ProviderSort> provider_sort{};
+    std::optional<ProviderOnly> provider_only{};
+    std::optional<ProviderIgnore> provider_ignore{};
+    TtftSlo ttft_slo{};
+    std::optional<RouteLogPath> route_log{};
+    std::optional<FastModel> fast_model{};
+    std::optional<BatchInput> batch_input{};
+    std::optional<BatchOutput> batch_output{};
+    std::optional<BatchCheckpoint> batch_checkpoint{};
+    BatchWorkers batch_workers{};
+    AgentMaxIterations max_iterations{};
+    TurnDeadline turn_deadline{};
+    TurnTokenBudget turn_token_budget{};
+    std::optional<ToolPolicyFile> tool_policy{};
+    std::vector<ToolRule> allow_tools{};
+    std::vector<ToolRule> deny_tools{};
+    std::optional<ToolDefault> tool_default{};
+    ToolCpus tool_cpus{};
+    ToolMemoryMb tool_memory{};
+    ToolPids tool_pids{};
+    std::optional<WatchDir> watch_dir{};
 };
 
 /**
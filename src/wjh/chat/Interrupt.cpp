@@ -0,0 +1,94 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/Interrupt.hpp"
+
+#include <cerrno>
+#include <csignal>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace wjh::chat {
+
+namespace {
+
+/// Write end of the live guard's pipe.
+volatile std::sig_atomic_t interrupt_fd = -1;
+
+/// SIGINTs seen by the live guard.
+volatile std::sig_atomic_t interrupt_count = 0;
+
+struct sigaction previous_action{};
+
+void
+on_sigint(int)
+{
+    interrupt_count = interrupt_count + 1;
+    if (interrupt_count > 1) {
+        ::sigaction(SIGINT, &previous_action, nullptr);
+        ::raise(SIGINT);
+        return;
+    }
+    auto const saved = errno;
+    char const byte = 'i';
+    [[maybe_unused]] auto const n = ::write(interrupt_fd, &byte, 1);
+    errno = saved;
+}
+
+} // anonymous namespace
+
+InterruptGuard::
+InterruptGuard()
+{
+    // Without a pipe, Ctrl-C keeps its previous behavior.
+    if (::pipe2(pipe_, O_CLOEXEC) != 0) {
+        pipe_[0] = pipe_[1] = -1;
+        return;
+    }
+
+    watcher_ = std::jthread([fd = pipe_[0], source = source_]() mutable {
+        for (;;) {
+            char byte = 0;
+            auto const n = ::read(fd, &byte, 1);
+            if (n < 0 and errno == EINTR) {
+                continue;
+            }
+            if (n <= 0 or byte == 'q') {
+                return;
+            }
+            source.request_stop();
+        }
+    });
+
+    interrupt_count = 0;
+    interrupt_fd = pipe_[1];
+    struct sigaction action{};
+    action.sa_handler = on_sigint;
+    ::sigemptyset(&action.sa_mask);
+
+    // Restart interrupted reads; the approval prompt polls for the stop.
+    action.sa_flags = SA_RESTART;
+    ::sigaction(SIGINT, &action, &previous_action);
+}
+
+InterruptGuard::
+~InterruptGuard()
+{
+    if (pipe_[1] < 0) {
+        return;
+    }
+    ::sigaction(SIGINT, &previous_action, nullptr);
+    interrupt_fd = -1;
+
+    char const quit = 'q';
+    [[maybe_unused]] auto const n = ::write(pipe_[1], &quit, 1);
+    watcher_.join();
+    ::close(pipe_[0]);
+    ::close(pipe_[1]);
+}
+
+} // namespace wjh::chat
@@ -0,0 +1,52 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_084B9F44F5FD4548B3F610E707347A56
+#define WJH_CHAT_084B9F44F5FD4548B3F610E707347A56
+
+#include <stop_token>
+#include <thread>
+
+namespace wjh::chat {
+
+/**
+ * Turns Ctrl-C into a stop request for as long as it is alive.
+ *
+ * While an InterruptGuard exists, SIGINT requests a stop on token()
+ * instead of terminating the process; the previous disposition is
+ * restored on destruction.  The signal handler only writes to a pipe
+ * and a watcher thread calls request_stop(), so stop callbacks
+ * (shutting down sockets, killing child processes) never run in
+ * signal context.
+ *
+ * A second SIGINT while the guard is alive gets the previous
+ * disposition, so a turn that does not wind down can still be killed.
+ * At most one guard may exist at a time.
+ */
+class InterruptGuard
+{
+public:
+    InterruptGuard();
+    ~InterruptGuard();
+
+    InterruptGuard(InterruptGuard const &) = delete;
+    InterruptGuard & operator = (InterruptGuard const &) = delete;
+
+    [[nodiscard]]
+    std::stop_token token() const
+    {
+        return source_.get_token();
+    }
+
+private:
+    std::stop_source source_;
+    int pipe_[2] = {-1, -1};
+    std::jthread watcher_;
+};
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_084B9F44F5FD4548B3F610E707347A56
@@ -9,30 +9,77 @@
 
 #include "wjh/chat/types.hpp"
 
+#include <chrono>
 #include <optional>
+#include <string>
+#include <vector>
 
 namespace wjh::chat {
 
 /**
  * Token usage statistics from a single API response.
+ *
+ * The cache counters are subsets of prompt_tokens: the portion read
+ * from, or written to, the provider's prompt cache.
  */
 struct TokenUsage
 {
     PromptTokens prompt_tokens{};
     CompletionTokens completion_tokens{};
     TotalTokens total_tokens{};
+    CachedTokens cached_tokens{};
+    CacheWriteTokens cache_write_tokens{};
+};
+
+/**
+ * Add @p rhs's counters to @p lhs's.
+ */
+inline TokenUsage &
+operator += (TokenUsage & lhs, TokenUsage const & rhs)
+{
+    lhs.prompt_tokens += rhs.prompt_tokens;
+    lhs.completion_tokens += rhs.completion_tokens;
+    lhs.total_tokens += rhs.total_tokens;
+    lhs.cached_tokens += rhs.cached_tokens;
+    lhs.cache_write_tokens += rhs.cache_write_tokens;
+    return lhs;
+}
+
+/**
+ * How long one tool call took.
+ */
+struct ToolTiming
+{
+    std::string name;
+    std::chrono::milliseconds elapsed{0};
+};
+
+/**
+ * One model request of a turn, and the tool calls it asked for.
+ */
+struct IterationStats
+{
+    std::optional<TokenUsage> usage;
+
+    /// Time until the model's response arrived.
+    std::chrono::milliseconds latency{0};
+
+    std::vector<ToolTiming> tools{};
 };
 
 /**
  * Full response from the LLM client.
  *
  * Bundles the assistant's text with optional token usage
- * statistics (not all providers return usage data).
+ * statistics (not all providers return usage data).  For a turn that
+ * took several model requests, usage is the sum over all of them and
+ * iterations has one entry per request.
  */
 struct ChatResponse
 {
     AssistantResponse response;
     std::optional<TokenUsage> usage;
+    std::vector<IterationStats> iterations{};
 };
 
 } // namespace wjh::chat
@@ -0,0 +1,115 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/TurnClassifier.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <format>
+
+namespace wjh::chat {
+
+namespace {
+
+/// Words that usually mean the model will want to run a tool.
+constexpr std::array<std::string_view, 24> tool_words{
+    "build",   "compile", "run",    "test",     "tests",   "debug",
+    "fix",     "implement", "refactor", "write", "edit",   "create",
+    "change",  "update",  "install", "delete",  "rename",  "file",
+    "files",   "directory", "repo", "commit",  "grep",    "patch"};
+
+/// File extensions that mark a word as a path.
+constexpr std::array<std::string_view, 14> source_extensions{
+    ".c",  ".cc",  ".cpp", ".h",    ".hpp", ".py",  ".js",
+    ".ts", ".rs",  ".go",  ".json", ".md",  ".txt", ".cmake"};
+
+bool
+is_word_char(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) or c == '_';
+}
+
+std::string
+lowercase(std::string_view s)
+{
+    std::string result(s);
+    std::ranges::transform(result, result.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return result;
+}
+
+/// The first whitespace-separated token that is a tool word or looks
+/// like a path, if any.
+std::string_view
+tool_signal(std::string_view input)
+{
+    std::size_t pos = 0;
+    while (pos < input.size()) {
+        while (pos < input.size()
+               and std::isspace(static_cast<unsigned char>(input[pos])))
+        {
+            ++pos;
+        }
+        auto const end =
+            std::min(input.find_first_of(" \t\n", pos), input.size());
+        auto const token = input.substr(pos, end - pos);
+        pos = end;
+
+        if (token.find('/') != std::string_view::npos
+            and token.find("://") == std::string_view::npos)
+        {
+            return token;
+        }
+        for (auto const ext : source_extensions) {
+            if (token.size() > ext.size() and token.ends_with(ext)) {
+                return token;
+            }
+        }
+
+        auto first = std::ranges::find_if(token, is_word_char);
+        auto last = std::ranges::find_if_not(first, token.end(), is_word_char);
+        auto const word = lowercase(std::string_view(first, last));
+        if (std::ranges::find(tool_words, word) != tool_words.end()) {
+            return token;
+        }
+    }
+    return {};
+}
+
+} // anonymous namespace
+
+TurnTier
+classify_turn(
+    std::string_view input,
+    std::size_t depth,
+    TurnClassifierConfig const & config)
+{
+    using client::ModelTier;
+
+    if (input.find("```") != std::string_view::npos) {
+        return {ModelTier::strong, "contains code"};
+    }
+    if (input.size() > config.max_fast_chars) {
+        return {
+            ModelTier::strong,
+            std::format("long prompt ({} chars)", input.size())};
+    }
+    if (depth > config.max_fast_depth) {
+        return {
+            ModelTier::strong,
+            std::format("deep conversation ({} messages)", depth)};
+    }
+    if (auto const signal = tool_signal(input); not signal.empty()) {
+        return {
+            ModelTier::strong,
+            std::format("likely needs tools (\"{}\")", signal)};
+    }
+    return {ModelTier::fast, "short question"};
+}
+
+} // namespace wjh::chat
@@ -0,0 +1,55 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_95CE1A35C28840AF8B4FA7FB8365D03C
+#define WJH_CHAT_95CE1A35C28840AF8B4FA7FB8365D03C
+
+#include "wjh/chat/client/IClient.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat {
+
+/**
+ * Limits beyond which a turn goes to the strong model.
+ */
+struct TurnClassifierConfig
+{
+    /// Longer prompts usually carry a real task.
+    std::size_t max_fast_chars = 280;
+
+    /// Messages already in the conversation; deep sessions have built
+    /// up context a small model handles poorly.
+    std::size_t max_fast_depth = 8;
+};
+
+/**
+ * Tier chosen for a turn, and the signal that decided it.
+ */
+struct TurnTier
+{
+    client::ModelTier tier = client::ModelTier::strong;
+    std::string reason{};
+};
+
+/**
+ * Pick a model tier for @p input from cheap local signals: its length,
+ * whether it looks like it needs tools (code, paths, or words like
+ * "build" and "edit"), and how many messages the conversation already
+ * holds.  Anything that is not clearly simple goes to the strong
+ * tier.
+ */
+[[nodiscard]]
+TurnTier classify_turn(
+    std::string_view input,
+    std::size_t depth,
+    TurnClassifierConfig const & config = {});
+
+} // namespace wjh::chat
+
+#endif // WJH_CHAT_95CE1A35C28840AF8B4FA7FB8365D03C
@@ -0,0 +1,211 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/CircuitBreaker.hpp"
+
+#include <algorithm>
+#include <format>
+
+namespace wjh::chat::client {
+
+std::string_view
+to_string(CircuitState state)
+{
+    switch (state) {
+    case CircuitState::closed:
+        return "closed";
+    case CircuitState::open:
+        return "open";
+    case CircuitState::half_open:
+        return "half-open";
+    }
+    return "unknown";
+}
+
+CircuitBreaker::
+CircuitBreaker(CircuitBreakerConfig config)
+: config_(config)
+{ }
+
+bool
+CircuitBreaker::
+allow(std::string const & endpoint)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto & circuit = circuits_[endpoint];
+    switch (circuit.state) {
+    case CircuitState::closed:
+        return true;
+    case CircuitState::open:
+        if (Clock::now() < circuit.reopen_at) {
+            ++stats_.rejected;
+            return false;
+        }
+        circuit.state = CircuitState::half_open;
+        circuit.probing = false;
+        [[fallthrough]];
+    case CircuitState::half_open:
+        if (circuit.probing) {
+            ++stats_.rejected;
+            return false;
+        }
+        circuit.probing = true;
+        ++stats_.probes;
+        return true;
+    }
+    return true;
+}
+
+void
+CircuitBreaker::
+record(std::string const & endpoint, CallOutcome outcome)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto const now = Clock::now();
+    auto & circuit = circuits_[endpoint];
+    auto const failed = outcome == CallOutcome::failure
+        or outcome == CallOutcome::timeout;
+
+    switch (circuit.state) {
+    case CircuitState::open:
+        // A call allowed before the circuit opened; already counted.
+        return;
+    case CircuitState::half_open:
+        circuit.probing = false;
+        if (outcome == CallOutcome::cancelled) {
+            return;
+        }
+        if (failed) {
+            trip(circuit, now);
+        } else {
+            circuit = Circuit{};
+        }
+        return;
+    case CircuitState::closed:
+        break;
+    }
+
+    if (outcome == CallOutcome::cancelled) {
+        return;
+    }
+
+    circuit.calls.push_back(failed);
+    while (circuit.calls.size() > std::max<std::size_t>(config_.window, 1u)) {
+        circuit.calls.pop_front();
+    }
+    circuit.timeouts =
+        outcome == CallOutcome::timeout ? circuit.timeouts + 1 : 0;
+
+    if (config_.consecutive_timeouts > 0
+        and circuit.timeouts >= config_.consecutive_timeouts)
+    {
+        trip(circuit, now);
+        return;
+    }
+
+    auto const calls = circuit.calls.size();
+    if (config_.failure_rate > 0
+        and calls >= std::max<std::size_t>(config_.min_calls, 1u))
+    {
+        auto const failures = static_cast<std::size_t>(
+            std::ranges::count(circuit.calls, true));
+        if (failures * 100u >= config_.failure_rate * calls) {
+            trip(circuit, now);
+        }
+    }
+}
+
+void
+CircuitBreaker::
+trip(Circuit & circuit, Clock::time_point now)
+{
+    circuit = Circuit{
+        .state = CircuitState::open,
+        .reopen_at = now + config_.open_duration};
+    ++stats_.trips;
+}
+
+void
+CircuitBreaker::
+record_fallback()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.fallbacks;
+}
+
+CircuitState
+CircuitBreaker::
+state(std::string const & endpoint) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto const it = circuits_.find(endpoint);
+    return it == circuits_.end() ? CircuitState::closed : it->second.state;
+}
+
+CircuitBreakerStats
+CircuitBreaker::
+stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void
+CircuitBreaker::
+report(std::ostream & out) const
+{
+    auto const s = stats();
+    if (s.trips == 0 and s.rejected == 0) {
+        return;
+    }
+
+    out << std::format(
+        "Circuit breaker:\n"
+        "  Trips:      {} ({} probes)\n"
+        "  Rejected:   {} calls failed fast ({} sent to fallback)\n",
+        s.trips,
+        s.probes,
+        s.rejected,
+        s.fallbacks);
+}
+
+void
+CircuitBreaker::
+status(std::ostream & out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (circuits_.empty()) {
+        return;
+    }
+
+    auto const now = Clock::now();
+    out << "Endpoints:\n";
+    for (auto const & [endpoint, circuit] : circuits_) {
+        std::string detail;
+        switch (circuit.state) {
+        case CircuitState::closed:
+            detail = std::format(
+                "{} of {} recent calls failed",
+                std::ranges::count(circuit.calls, true),
+                circuit.calls.size());
+            break;
+        case CircuitState::open:
+            detail = std::format(
+                "probe in {} s",
+                std::chrono::ceil<std::chrono::seconds>(
+                    std::max(Clock::duration::zero(), circuit.reopen_at - now))
+                    .count());
+            break;
+        case CircuitState::half_open:
+            detail = circuit.probing ? "probing" : "awaiting probe";
+            break;
+        }
+        out << std::format(
+            "  {}  {} ({})\n", endpoint, to_string(circuit.state), detail);
+    }
+}
+
+} // namespace wjh::chat::client
@@ -0,0 +1,174 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_663364D9007E4901932C5F2A11C766B1
+#define WJH_CHAT_663364D9007E4901932C5F2A11C766B1
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::client {
+
+/**
+ * State of one endpoint's circuit.
+ */
+enum class CircuitState
+{
+    /// Calls flow normally.
+    closed,
+
+    /// Calls fail fast until the open period ends.
+    open,
+
+    /// A single probe call decides whether to close or reopen.
+    half_open
+};
+
+[[nodiscard]]
+std::string_view to_string(CircuitState state);
+
+/**
+ * How a call through the breaker ended.
+ */
+enum class CallOutcome
+{
+    /// The endpoint answered; client errors such as 429 count here.
+    success,
+
+    /// Connection failure or server error.
+    failure,
+
+    /// Connect or read timeout.
+    timeout,
+
+    /// Aborted by the caller; says nothing about the endpoint.
+    cancelled
+};
+
+/**
+ * Configuration for the circuit breaker.
+ */
+struct CircuitBreakerConfig
+{
+    /// Failure percentage over the window that opens a circuit;
+    /// 0 disables this criterion.
+    std::uint32_t failure_rate = 50;
+
+    /// Number of recent calls the failure rate is computed over.
+    std::size_t window = 20;
+
+    /// Calls required in the window before the failure rate applies.
+    std::size_t min_calls = 5;
+
+    /// Consecutive timeouts that open a circuit; 0 disables this
+    /// criterion.
+    std::uint32_t consecutive_timeouts = 3;
+
+    /// How long a circuit stays open before a probe is let through.
+    std::chrono::milliseconds open_duration{30'000};
+};
+
+/**
+ * Counters reported by CircuitBreaker::stats().
+ */
+struct CircuitBreakerStats
+{
+    /// Times a circuit opened.
+    std::size_t trips = 0;
+
+    /// Calls refused by an open circuit.
+    std::size_t rejected = 0;
+
+    /// Half-open probe calls let through.
+    std::size_t probes = 0;
+
+    /// Calls diverted to a fallback endpoint.
+    std::size_t fallbacks = 0;
+};
+
+/**
+ * Per-endpoint circuit breaker.
+ *
+ * Each endpoint (conventionally "host:port") has its own circuit.  A
+ * circuit opens when too large a share of recent calls fail, or after
+ * a run of consecutive timeouts, so callers stop waiting out timeouts
+ * against an endpoint that is down.  Once the open period ends, a
+ * single probe call is allowed: success closes the circuit, failure
+ * opens it again.
+ *
+ * All member functions are thread-safe.
+ */
+class CircuitBreaker
+{
+public:
+    explicit CircuitBreaker(CircuitBreakerConfig config = {});
+
+    /**
+     * Whether a call to @p endpoint may proceed.
+     *
+     * Every allowed call must be followed by record().
+     */
+    [[nodiscard]]
+    bool allow(std::string const & endpoint);
+
+    /**
+     * Record how an allowed call to @p endpoint ended.
+     */
+    void record(std::string const & endpoint, CallOutcome outcome);
+
+    /**
+     * Note that a call was diverted to a fallback endpoint.
+     */
+    void record_fallback();
+
+    [[nodiscard]]
+    CircuitState state(std::string const & endpoint) const;
+
+    [[nodiscard]]
+    CircuitBreakerStats stats() const;
+
+    /**
+     * Print trip and rejection counters.
+     */
+    void report(std::ostream & out) const;
+
+    /**
+     * Print the state of every endpoint called so far.
+     */
+    void status(std::ostream & out) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Circuit
+    {
+        CircuitState state = CircuitState::closed;
+
+        /// Recent outcomes, true for failures.
+        std::deque<bool> calls{};
+        std::uint32_t timeouts = 0;
+        Clock::time_point reopen_at{};
+        bool probing = false;
+    };
+
+    void trip(Circuit & circuit, Clock::time_point now);
+
+    CircuitBreakerConfig config_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Circuit> circuits_;
+    CircuitBreakerStats stats_;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_663364D9007E4901932C5F2A11C766B1
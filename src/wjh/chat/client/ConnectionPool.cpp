@@ -0,0 +1,192 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/ConnectionPool.hpp"
+
+#include <algorithm>
+#include <format>
+#include <utility>
+
+#include <httplib.h>
+
+namespace wjh::chat::client {
+
+ConnectionPool::
+ConnectionPool(ConnectionPoolConfig config)
+: config_(config)
+{ }
+
+ConnectionPool::
+~ConnectionPool()
+{
+    warmer_.request_stop();
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto * connection : pinging_) {
+        connection->stop();
+    }
+}
+
+ConnectionPool::Connection
+ConnectionPool::
+acquire(std::string const & endpoint, Factory const & factory)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto & idle = endpoints_[endpoint].idle;
+        if (not idle.empty()) {
+            auto connection = std::move(idle.back());
+            idle.pop_back();
+            ++stats_.reused;
+            return connection;
+        }
+        ++stats_.opened;
+    }
+    return factory();
+}
+
+void
+ConnectionPool::
+release(std::string const & endpoint, Connection connection)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto & idle = endpoints_[endpoint].idle;
+    if (idle.size() < config_.max_idle) {
+        idle.push_back(std::move(connection));
+    }
+}
+
+void
+ConnectionPool::
+warm_up(std::string const & endpoint, Factory factory, Ping ping)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto & state = endpoints_[endpoint];
+    state.factory = std::move(factory);
+    state.ping = std::move(ping);
+    state.warm_until = Clock::now() + config_.keep_warm;
+    if (state.idle.empty()) {
+        // Connect now rather than at the next ping.
+        state.next_ping = Clock::time_point{};
+    }
+    ++generation_;
+    if (not warmer_.joinable()) {
+        warmer_ = std::jthread([this](std::stop_token stop) {
+            keep_warm(stop);
+        });
+    }
+    cv_.notify_all();
+}
+
+void
+ConnectionPool::
+keep_warm(std::stop_token stop)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (not stop.stop_requested()) {
+        auto const now = Clock::now();
+        auto wake = now + config_.keep_warm;
+        auto due = endpoints_.end();
+        for (auto it = endpoints_.begin(); it != endpoints_.end(); ++it) {
+            auto const & state = it->second;
+            if (not state.ping or state.warm_until <= now) {
+                continue;
+            }
+            if (state.next_ping <= now) {
+                due = it;
+                break;
+            }
+            wake = std::min(wake, state.next_ping);
+        }
+
+        if (due == endpoints_.end()) {
+            auto const seen = generation_;
+            cv_.wait_until(lock, stop, wake, [&] {
+                return generation_ != seen;
+            });
+            continue;
+        }
+
+        auto & state = due->second;
+        state.next_ping = now + config_.ping_interval;
+        auto connections = std::move(state.idle);
+        state.idle.clear();
+        auto const fresh = connections.empty();
+        if (fresh) {
+            connections.push_back(state.factory());
+        }
+        auto const ping = state.ping;
+        for (auto const & connection : connections) {
+            pinging_.push_back(connection.get());
+        }
+        lock.unlock();
+
+        std::vector<Connection> alive;
+        for (auto & connection : connections) {
+            if (stop.stop_requested()) {
+                break;
+            }
+            if (ping(*connection)) {
+                alive.push_back(std::move(connection));
+            }
+        }
+
+        lock.lock();
+        pinging_.clear();
+        auto const failures = connections.size() - alive.size();
+        if (fresh) {
+            stats_.warmed += alive.size();
+        } else {
+            stats_.pings += connections.size();
+        }
+        stats_.ping_failures += failures;
+
+        auto & idle = due->second.idle;
+        for (auto & connection : alive) {
+            if (idle.size() < config_.max_idle) {
+                idle.push_back(std::move(connection));
+            }
+        }
+    }
+}
+
+std::size_t
+ConnectionPool::
+idle(std::string const & endpoint) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto const it = endpoints_.find(endpoint);
+    return it == endpoints_.end() ? 0u : it->second.idle.size();
+}
+
+ConnectionPoolStats
+ConnectionPool::
+stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void
+ConnectionPool::
+report(std::ostream & out) const
+{
+    auto const s = stats();
+    if (s.reused + s.opened == 0) {
+        return;
+    }
+
+    out << std::format(
+        "Connections:\n"
+        "  Reused:     {} of {} requests\n"
+        "  Warmed:     {} opened ahead of use ({} pings, {} failed)\n",
+        s.reused,
+        s.reused + s.opened,
+        s.warmed,
+        s.pings,
+        s.ping_failures);
+}
+
+} // namespace wjh::chat::client
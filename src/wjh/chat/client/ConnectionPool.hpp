@@ -0,0 +1,156 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_672EA9D4B8754AA1BB5F945E59E5E281
+#define WJH_CHAT_672EA9D4B8754AA1BB5F945E59E5E281
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace httplib {
+class Client;
+} // namespace httplib
+
+namespace wjh::chat::client {
+
+/**
+ * Configuration for the connection pool.
+ */
+struct ConnectionPoolConfig
+{
+    /// Idle connections kept per endpoint.
+    std::size_t max_idle = 4;
+
+    /// How often idle connections are pinged to keep them open.
+    std::chrono::milliseconds ping_interval{15'000};
+
+    /// How long after the last warm_up() connections are kept warm.
+    std::chrono::milliseconds keep_warm{300'000};
+};
+
+/**
+ * Counters reported by ConnectionPool::stats().
+ */
+struct ConnectionPoolStats
+{
+    /// Requests sent on an already open connection.
+    std::size_t reused = 0;
+
+    /// Requests that had to open a new connection.
+    std::size_t opened = 0;
+
+    /// Connections opened in the background ahead of a request.
+    std::size_t warmed = 0;
+
+    /// Keep-alive pings sent, and how many of them failed.
+    std::size_t pings = 0;
+    std::size_t ping_failures = 0;
+};
+
+/**
+ * Keep-alive HTTP connections, per endpoint, shared by every copy of
+ * an HttpClient.
+ *
+ * A connection is owned by one request at a time: acquire() hands out
+ * an idle connection (or a new one) and release() returns it once the
+ * exchange succeeded.  warm_up() opens a connection in the background
+ * before it is needed and keeps idle connections open with periodic
+ * pings, so a request typically goes out on an established socket
+ * instead of paying for DNS, TCP and TLS setup.
+ *
+ * All member functions are thread-safe.
+ */
+class ConnectionPool
+{
+public:
+    using Connection = std::unique_ptr<httplib::Client>;
+
+    /// Creates a configured, not yet connected, client.
+    using Factory = std::function<Connection()>;
+
+    /// Sends a cheap request on a connection; false if it failed.
+    using Ping = std::function<bool(httplib::Client &)>;
+
+    explicit ConnectionPool(ConnectionPoolConfig config = {});
+    ~ConnectionPool();
+
+    ConnectionPool(ConnectionPool const &) = delete;
+    ConnectionPool & operator = (ConnectionPool const &) = delete;
+
+    /**
+     * An idle connection to @p endpoint, or a new one from @p factory.
+     */
+    [[nodiscard]]
+    Connection acquire(std::string const & endpoint, Factory const & factory);
+
+    /**
+     * Return a connection that completed its exchange; dropped if
+     * enough connections are already idle.
+     */
+    void release(std::string const & endpoint, Connection connection);
+
+    /**
+     * In the background, open a connection to @p endpoint unless one is
+     * idle, then ping idle connections every ping_interval until
+     * keep_warm has passed without another warm_up().
+     */
+    void warm_up(std::string const & endpoint, Factory factory, Ping ping);
+
+    [[nodiscard]]
+    std::size_t idle(std::string const & endpoint) const;
+
+    [[nodiscard]]
+    ConnectionPoolStats stats() const;
+
+    /**
+     * Print connection reuse and warm-up counters.
+     */
+    void report(std::ostream & out) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Endpoint
+    {
+        std::vector<Connection> idle;
+        Factory factory;
+        Ping ping;
+        Clock::time_point warm_until{};
+        Clock::time_point next_ping{};
+    };
+
+    void keep_warm(std::stop_token stop);
+
+    ConnectionPoolConfig config_;
+    mutable std::mutex mutex_;
+    std::condition_variable_any cv_;
+    std::map<std::string, Endpoint> endpoints_;
+    ConnectionPoolStats stats_;
+
+    /// Bumped by warm_up() to wake the warmer.
+    std::uint64_t generation_ = 0;
+
+    /// Connections the warmer is pinging, stopped on destruction.
+    std::vector<httplib::Client *> pinging_;
+
+    /// Started by the first warm_up(); stopped and joined on destruction.
+    std::jthread warmer_;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_672EA9D4B8754AA1BB5F945E59E5E281
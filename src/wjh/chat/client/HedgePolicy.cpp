@@ -0,0 +1,245 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/HedgePolicy.hpp"
+
+#include "wjh/chat/client/RetryPolicy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace wjh::chat::client {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+} // anonymous namespace
+
+/// State shared between post() and the threads of its two requests.
+/// The policy keeps it, and so the threads, until both have finished.
+struct HedgePolicy::Race
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::array<std::optional<Result<HttpResponse>>, 2> results;
+    std::array<Clock::time_point, 2> started;
+    std::array<Clock::time_point, 2> finished;
+    std::array<std::stop_source, 2> stops;
+
+    /// Declared last, so they are joined before the rest goes away.
+    std::array<std::jthread, 2> requests;
+
+    ~Race()
+    {
+        for (auto & source : stops) {
+            source.request_stop();
+        }
+    }
+
+    [[nodiscard]]
+    bool succeeded(std::size_t i) const
+    {
+        return results[i] and *results[i]
+            and classify_status((*results[i])->status) == ErrorClass::none;
+    }
+
+    /// Whether every request started has finished; locks the mutex.
+    [[nodiscard]]
+    bool done()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            if (requests[i].joinable() and not results[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Start request @p index on a thread of its own.  The client is
+    /// copied, since a losing request may outlive the post() call.
+    void launch(
+        std::size_t index,
+        HttpClient client,
+        HttpPath path,
+        HttpBody body,
+        HttpHeaders headers)
+    {
+        started[index] = Clock::now();
+        requests[index] = std::jthread([this,
+                                        index,
+                                        client = std::move(client),
+                                        path = std::move(path),
+                                        body = std::move(body),
+                                        headers = std::move(headers),
+                                        stop = stops[index].get_token()] {
+            auto result = client.post(path, body, headers, stop);
+            std::lock_guard<std::mutex> lock(mutex);
+            results[index] = std::move(result);
+            finished[index] = Clock::now();
+            cv.notify_all();
+        });
+    }
+};
+
+HedgePolicy::
+HedgePolicy(HedgeConfig config)
+: config_(std::move(config))
+{ }
+
+// Destroying the races cancels their requests and joins the threads.
+HedgePolicy::
+~HedgePolicy() = default;
+
+std::chrono::milliseconds
+HedgePolicy::
+threshold() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (latencies_.size() < std::max<std::size_t>(config_.min_samples, 1u)) {
+        return config_.initial_delay;
+    }
+
+    std::vector<std::chrono::milliseconds> sorted(
+        latencies_.begin(), latencies_.end());
+    auto const rank = static_cast<std::size_t>(std::ceil(
+        std::clamp(config_.percentile, 0.0, 1.0)
+        * static_cast<double>(sorted.size())));
+    auto const nth = sorted.begin()
+        + static_cast<std::ptrdiff_t>(std::max<std::size_t>(rank, 1u) - 1u);
+    std::nth_element(sorted.begin(), nth, sorted.end());
+    return std::max(config_.min_delay, *nth);
+}
+
+void
+HedgePolicy::
+record_latency(std::chrono::milliseconds latency)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    latencies_.push_back(latency);
+    while (latencies_.size() > config_.window) {
+        latencies_.pop_front();
+    }
+}
+
+HedgeOutcome
+HedgePolicy::
+post(
+    HttpClient const & client,
+    HttpPath const & path,
+    HttpBody const & body,
+    HttpBody const & hedge_body,
+    HttpHeaders const & headers,
+    std::stop_token stop)
+{
+    auto const delay = threshold();
+    auto race = std::make_unique<Race>();
+
+    // A cancelled request finishes early, so the waits below end too.
+    std::optional<std::stop_callback<std::function<void()>>> cancel;
+    cancel.emplace(stop, [&race] {
+        for (auto & source : race->stops) {
+            source.request_stop();
+        }
+    });
+    race->launch(0, client, path, body, headers);
+
+    std::unique_lock<std::mutex> lock(race->mutex);
+    auto const primary_done = [&race] { return race->results[0].has_value(); };
+    bool const hedged = not race->cv.wait_for(lock, delay, primary_done);
+    if (hedged) {
+        lock.unlock();
+        race->launch(1, client, path, hedge_body, headers);
+        lock.lock();
+        race->cv.wait(lock, [&race] {
+            return race->succeeded(0) or race->succeeded(1)
+                or (race->results[0] and race->results[1]);
+        });
+    }
+
+    // When the hedge wins, the primary's latency is unknown but at
+    // least as long as it had run by then; recording that keeps the
+    // slow tail in the window instead of only the hedge's fast answer.
+    auto const winner = race->succeeded(0) or not race->succeeded(1) ? 0u : 1u;
+    auto result = std::move(*race->results[winner]);
+    auto const latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        race->finished[winner] - race->started[0]);
+    lock.unlock();
+
+    if (hedged) {
+        race->stops[1u - winner].request_stop();
+    }
+    if (result) {
+        record_latency(latency);
+    }
+    cancel.reset();
+
+    std::lock_guard<std::mutex> stats_lock(mutex_);
+    std::erase_if(races_, [](auto const & r) { return r->done(); });
+    races_.push_back(std::move(race));
+    ++stats_.requests;
+    if (hedged) {
+        ++stats_.hedged;
+        if (winner == 1u) {
+            ++stats_.hedge_wins;
+        }
+    }
+    return HedgeOutcome{.response = std::move(result), .hedged = hedged};
+}
+
+void
+HedgePolicy::
+charge(std::uint32_t prompt_tokens)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.extra_prompt_tokens += prompt_tokens;
+}
+
+HedgeStats
+HedgePolicy::
+stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void
+HedgePolicy::
+report(std::ostream & out) const
+{
+    auto const s = stats();
+    auto const rate = s.requests == 0
+        ? 0.0
+        : 100.0 * static_cast<double>(s.hedged)
+            / static_cast<double>(s.requests);
+
+    out << std::format(
+        "Hedging{}:\n"
+        "  Hedged:     {:.1f}% ({} of {} requests, {} won by the hedge)\n"
+        "  Threshold:  {} ms (p{:.0f} of recent latency)\n"
+        "  Extra cost: <= {} prompt tokens\n",
+        config_.provider ? std::format(" (via {})", *config_.provider) : "",
+        rate,
+        s.hedged,
+        s.requests,
+        s.hedge_wins,
+        threshold().count(),
+        config_.percentile * 100.0,
+        s.extra_prompt_tokens);
+}
+
+} // namespace wjh::chat::client
@@ -0,0 +1,164 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_E7B2A61C93D84F0EA5C1D8F4372B6A90
+#define WJH_CHAT_E7B2A61C93D84F0EA5C1D8F4372B6A90
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/client/HttpClient.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+namespace wjh::chat::client {
+
+/**
+ * Configuration for request hedging.
+ */
+struct HedgeConfig
+{
+    /// Latency quantile after which a duplicate request is sent.
+    double percentile = 0.95;
+
+    /// Hedge delay used until enough latencies have been observed.
+    std::chrono::milliseconds initial_delay{15'000};
+
+    /// Never hedge sooner than this, however fast recent requests were.
+    std::chrono::milliseconds min_delay{2'000};
+
+    /// Number of recent latencies the quantile is computed over.
+    std::size_t window = 64;
+
+    /// Latencies required before the quantile replaces initial_delay.
+    std::size_t min_samples = 8;
+
+    /// OpenRouter provider to route the duplicate to; the same route
+    /// as the original when empty.
+    std::optional<std::string> provider{};
+};
+
+/**
+ * Counters reported by HedgePolicy::stats().
+ */
+struct HedgeStats
+{
+    std::size_t requests = 0;
+
+    /// Requests for which a duplicate was sent.
+    std::size_t hedged = 0;
+
+    /// Hedged requests answered first by the duplicate.
+    std::size_t hedge_wins = 0;
+
+    /// Prompt tokens sent a second time by duplicates.  An upper bound
+    /// on the extra cost: cancelled requests may not be billed.
+    std::uint64_t extra_prompt_tokens = 0;
+};
+
+/**
+ * Result of HedgePolicy::post().
+ */
+struct HedgeOutcome
+{
+    Result<HttpResponse> response;
+    bool hedged = false;
+};
+
+/**
+ * Sends a duplicate of a slow request and keeps whichever answers
+ * first.
+ *
+ * The hedge delay adapts to the configured quantile of recent request
+ * latencies, so only the slow tail is duplicated.  The losing request
+ * is cancelled through its stop token.  Each request runs on a thread
+ * the policy owns; a cancelled loser may still be winding down when
+ * post() returns, and is joined by a later post() or the destructor.
+ *
+ * All member functions are thread-safe.
+ */
+class HedgePolicy
+{
+public:
+    explicit HedgePolicy(HedgeConfig config = {});
+
+    /**
+     * Cancel and join any requests still running.
+     */
+    ~HedgePolicy();
+
+    HedgePolicy(HedgePolicy const &) = delete;
+    HedgePolicy & operator = (HedgePolicy const &) = delete;
+
+    [[nodiscard]]
+    HedgeConfig const & config() const
+    {
+        return config_;
+    }
+
+    /**
+     * Current delay before a duplicate request is sent.
+     */
+    [[nodiscard]]
+    std::chrono::milliseconds threshold() const;
+
+    /**
+     * Add an observed request latency to the window.
+     */
+    void record_latency(std::chrono::milliseconds latency);
+
+    /**
+     * POST @p body, and @p hedge_body as well if no successful
+     * response has arrived within threshold().
+     *
+     * The first successful response wins; if both requests fail, the
+     * original's error is returned.  @p stop cancels both requests.
+     */
+    [[nodiscard]]
+    HedgeOutcome post(
+        HttpClient const & client,
+        HttpPath const & path,
+        HttpBody const & body,
+        HttpBody const & hedge_body,
+        HttpHeaders const & headers,
+        std::stop_token stop = {});
+
+    /**
+     * Account for the prompt tokens a hedged request sent twice.
+     */
+    void charge(std::uint32_t prompt_tokens);
+
+    [[nodiscard]]
+    HedgeStats stats() const;
+
+    /**
+     * Print hedge rate, current threshold, and extra token cost.
+     */
+    void report(std::ostream & out) const;
+
+private:
+    struct Race;
+
+    HedgeConfig config_;
+    mutable std::mutex mutex_;
+    std::deque<std::chrono::milliseconds> latencies_;
+    HedgeStats stats_;
+
+    /// Races whose request threads may not all have finished.
+    std::vector<std::unique_ptr<Race>> races_;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_E7B2A61C93D84F0EA5C1D8F4372B6A90
@@ -7,51 +7,482 @@
 #include "wjh/chat/client/HttpClient.hpp"
 
 #include "wjh/chat/json_convert.hpp"
+#include "wjh/chat/client/CircuitBreaker.hpp"
+#include "wjh/chat/client/ConnectionPool.hpp"
+#include "wjh/chat/client/NetworkStats.hpp"
+#include "wjh/chat/client/RetryPolicy.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
 
 #include <httplib.h>
 
 namespace wjh::chat::client {
 
+namespace {
+
+/// Transport failures worth retrying; certificate and protocol
+/// errors will fail the same way every time.
+bool
+is_retryable(httplib::Error err)
+{
+    return err == httplib::Error::Connection
+        or err == httplib::Error::ConnectionTimeout
+        or err == httplib::Error::Read
+        or err == httplib::Error::Write
+        or err == httplib::Error::SSLConnection;
+}
+
+/// httplib reports an expired read timeout as a read error.
+CallOutcome
+transport_outcome(httplib::Error err)
+{
+    if (err == httplib::Error::ConnectionTimeout
+        or err == httplib::Error::Read)
+    {
+        return CallOutcome::timeout;
+    }
+    return CallOutcome::failure;
+}
+
+/// Only server errors say the endpoint is unhealthy; 4xx responses,
+/// including rate limiting, come from a working server.
+CallOutcome
+status_outcome(HttpStatusCode status)
+{
+    return json_value(status) >= 500
+        ? CallOutcome::failure
+        : CallOutcome::success;
+}
+
+using Clock = std::chrono::steady_clock;
+
+/// Monotonic timestamps taken during one attempt.  A phase whose end
+/// was not observed (no body to send, say) is folded into the next.
+struct Marks
+{
+    Clock::time_point start;
+    std::optional<Clock::time_point> resolved{};
+    std::optional<Clock::time_point> connected{};
+    std::optional<Clock::time_point> sent{};
+    std::optional<Clock::time_point> first_byte{};
+
+    [[nodiscard]]
+    HttpTiming timing(Clock::time_point done) const
+    {
+        auto const us = [](Clock::duration d) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(d);
+        };
+        auto const resolved_at = resolved.value_or(start);
+        auto const connected_at = connected.value_or(resolved_at);
+        auto const sent_at = sent.value_or(connected_at);
+        auto const first_byte_at = first_byte.value_or(done);
+        return HttpTiming{
+            .dns = us(resolved_at - start),
+            .connect = us(connected_at - resolved_at),
+            .send = us(sent_at - connected_at),
+            .wait = us(first_byte_at - sent_at),
+            .receive = us(done - first_byte_at),
+            .total = us(done - start)};
+    }
+};
+
+/// Circuit breaker key: "host:port", or the path of a socket.
+std::string
+endpoint_key(HttpEndpoint const & endpoint)
+{
+    if (endpoint.scheme == HttpScheme::unix_socket) {
+        return json_value(endpoint.host);
+    }
+    return std::format(
+        "{}:{}", json_value(endpoint.host), json_value(endpoint.port));
+}
+
+std::unique_ptr<httplib::Client>
+connect(HttpEndpoint const & endpoint)
+{
+    auto const & host = json_value(endpoint.host);
+    auto const port = json_value(endpoint.port);
+    switch (endpoint.scheme) {
+    case HttpScheme::https: {
+        auto const literal = host.find(':') == std::string::npos
+            ? host
+            : std::format("[{}]", host);
+        auto client = std::make_unique<httplib::Client>(
+            std::format("https://{}:{}", literal, port));
+        client->enable_server_certificate_verification(true);
+        return client;
+    }
+    case HttpScheme::unix_socket: {
+        auto client = std::make_unique<httplib::Client>(host, port);
+        client->set_address_family(AF_UNIX);
+        return client;
+    }
+    case HttpScheme::http:
+        break;
+    }
+    return std::make_unique<httplib::Client>(host, port);
+}
+
+/// A client for the connection pool, which keeps its socket open
+/// between requests.
+std::unique_ptr<httplib::Client>
+open(HttpEndpoint const & endpoint)
+{
+    auto client = connect(endpoint);
+    client->set_keep_alive(true);
+    return client;
+}
+
+std::optional<char>
+hex_digit(char c)
+{
+    if (c >= '0' and c <= '9') {
+        return static_cast<char>(c - '0');
+    }
+    if (c >= 'a' and c <= 'f') {
+        return static_cast<char>(c - 'a' + 10);
+    }
+    if (c >= 'A' and c <= 'F') {
+        return static_cast<char>(c - 'A' + 10);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string>
+percent_decode(std::string_view s)
+{
+    std::string result;
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        if (s[i] != '%') {
+            result += s[i];
+            continue;
+        }
+        if (i + 2 >= s.size()) {
+            return std::nullopt;
+        }
+        auto const high = hex_digit(s[i + 1]);
+        auto const low = hex_digit(s[i + 2]);
+        if (not high or not low) {
+            return std::nullopt;
+        }
+        result += static_cast<char>(*high * 16 + *low);
+        i += 2;
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+Result<HttpEndpoint>
+parse_base_url(std::string_view url)
+{
+    auto const separator = url.find("://");
+    if (separator == std::string_view::npos) {
+        return make_error(
+            "Invalid base URL '{}': expected scheme://host[:port][/prefix]",
+            url);
+    }
+    auto const scheme = url.substr(0, separator);
+    auto rest = url.substr(separator + 3);
+
+    if (scheme == "unix") {
+        if (not rest.starts_with('/')) {
+            return make_error(
+                "Invalid base URL '{}': socket path must be absolute", url);
+        }
+        return HttpEndpoint{
+            .scheme = HttpScheme::unix_socket,
+            .host = Hostname{std::string(rest)},
+            .port = PortNumber{80}};
+    }
+
+    auto kind = HttpScheme::https;
+    int port = 443;
+    if (scheme == "http") {
+        kind = HttpScheme::http;
+        port = 80;
+    } else if (scheme == "http+unix") {
+        kind = HttpScheme::unix_socket;
+        port = 80;
+    } else if (scheme != "https") {
+        return make_error(
+            "Invalid base URL '{}': unsupported scheme '{}'", url, scheme);
+    }
+
+    auto const slash = rest.find('/');
+    auto authority = rest.substr(0, slash);
+    std::string prefix;
+    if (slash != std::string_view::npos) {
+        auto path = rest.substr(slash);
+        while (path.ends_with('/')) {
+            path.remove_suffix(1);
+        }
+        prefix = std::string(path);
+    }
+
+    if (kind == HttpScheme::unix_socket) {
+        auto socket = percent_decode(authority);
+        if (not socket or socket->empty()) {
+            return make_error(
+                "Invalid base URL '{}': expected a percent-encoded "
+                "socket path",
+                url);
+        }
+        return HttpEndpoint{
+            .scheme = kind,
+            .host = Hostname{std::move(*socket)},
+            .port = PortNumber{port},
+            .path_prefix = std::move(prefix)};
+    }
+
+    // The port follows the last colon, outside any IPv6 brackets.
+    auto const colon = authority.rfind(':');
+    if (colon != std::string_view::npos
+        and authority.find(']', colon) == std::string_view::npos)
+    {
+        auto const digits = authority.substr(colon + 1);
+        auto [ptr, ec] = std::from_chars(
+            digits.data(), digits.data() + digits.size(), port);
+        if (ec != std::errc{} or ptr != digits.data() + digits.size()
+            or port < 1 or port > 65535)
+        {
+            return make_error(
+                "Invalid base URL '{}': bad port '{}'", url, digits);
+        }
+        authority = authority.substr(0, colon);
+    }
+    if (authority.starts_with('[') and authority.ends_with(']')) {
+        authority = authority.substr(1, authority.size() - 2);
+    }
+    if (authority.empty()) {
+        return make_error("Invalid base URL '{}': missing host", url);
+    }
+    return HttpEndpoint{
+        .scheme = kind,
+        .host = Hostname{std::string(authority)},
+        .port = PortNumber{port},
+        .path_prefix = std::move(prefix)};
+}
+
 HttpClient::
 HttpClient(Hostname host, PortNumber port)
-: host_(std::move(host))
-, port_(port)
+: HttpClient(HttpEndpoint{.host = std::move(host), .port = port})
 { }
 
+HttpClient::
+HttpClient(HttpEndpoint endpoint)
+: endpoint_(std::move(endpoint))
+, pool_(std::make_shared<ConnectionPool>())
+{ }
+
+std::optional<std::string>
+HttpHeaders::
+find(std::string_view key) const
+{
+    auto const same = [key](std::string const & name) {
+        return std::ranges::equal(name, key, [](char a, char b) {
+            return std::tolower(static_cast<unsigned char>(a))
+                == std::tolower(static_cast<unsigned char>(b));
+        });
+    };
+    for (auto const & [name, value] : headers_) {
+        if (same(name)) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
 Result<HttpResponse>
 HttpClient::
-post(HttpPath const & path, HttpBody const & body, HttpHeaders const & headers)
+post(
+    HttpPath const & path,
+    HttpBody const & body,
+    HttpHeaders const & headers,
+    std::stop_token stop) const
 {
-    httplib::SSLClient client(json_value(host_), json_value(port_));
-    client.set_connection_timeout(json_value(connection_timeout_), 0);
-    client.set_read_timeout(json_value(read_timeout_), 0);
-    client.enable_server_certificate_verification(true);
+    Marks marks;
+    auto const primary_key = endpoint_key(endpoint_);
+    auto const fallback_key = fallback_ ? endpoint_key(*fallback_) : "";
 
     httplib::Headers http_headers;
     for (auto const & [key, value] : headers) {
         http_headers.emplace(key, value);
     }
+    if (not headers.find("Content-Type")) {
+        http_headers.emplace("Content-Type", "application/json");
+    }
+    auto const & payload = json_value(body);
 
-    auto result = client.Post(
-        json_value(path),
-        http_headers,
-        json_value(body),
-        "application/json");
+    for (std::uint32_t retry = 0;; ++retry) {
+        if (stop.stop_requested()) {
+            return make_error("HTTP request cancelled");
+        }
 
-    if (not result) {
-        auto err = result.error();
-        return make_error("HTTP request failed: {}", httplib::to_string(err));
-    }
+        auto const * target = &endpoint_;
+        auto const * endpoint = &primary_key;
+        if (circuit_breaker_ and not circuit_breaker_->allow(primary_key)) {
+            if (fallback_ and circuit_breaker_->allow(fallback_key)) {
+                circuit_breaker_->record_fallback();
+                target = &*fallback_;
+                endpoint = &fallback_key;
+            } else {
+                if (retry_policy_) {
+                    retry_policy_->record(retry, false);
+                }
+                return make_error(
+                    "Circuit open for {}; failing fast", primary_key);
+            }
+        }
+
+        // A pooled connection skips name resolution and connect(), so
+        // only a new one ever calls the socket options hook.
+        marks = Marks{.start = Clock::now()};
+        auto client = pool_->acquire(*endpoint, [target] {
+            return open(*target);
+        });
+        client->set_connection_timeout(json_value(connection_timeout_), 0);
+        client->set_read_timeout(json_value(read_timeout_), 0);
+        client->set_socket_options([&marks](httplib::socket_t sock) {
+            httplib::default_socket_options(sock);
+            marks.resolved = Clock::now();
+        });
+
+        // stop() shuts down the socket of a request in flight, which
+        // makes the blocking send() below return early.
+        auto * const in_flight = client.get();
+        std::optional<std::stop_callback<std::function<void()>>> on_stop;
+        on_stop.emplace(stop, [in_flight] { in_flight->stop(); });
 
-    HttpResponse response;
-    response.status = HttpStatusCode{result->status};
-    response.body = HttpBody{result->body};
+        // The body goes through a content provider, which httplib
+        // first calls once connected (and past the TLS handshake), and
+        // the response handler runs between the headers and the body.
+        httplib::Request request;
+        request.method = "POST";
+        request.path = target->path_prefix + json_value(path);
+        request.headers = http_headers;
+        request.content_length_ = payload.size();
+        request.content_provider_ = [&](std::size_t offset,
+                                        std::size_t length,
+                                        httplib::DataSink & sink) {
+            if (not marks.connected) {
+                marks.connected = Clock::now();
+            }
+            if (not sink.write(payload.data() + offset, length)) {
+                return false;
+            }
+            if (offset + length >= payload.size()) {
+                marks.sent = Clock::now();
+            }
+            return true;
+        };
+        request.response_handler = [&marks](httplib::Response const &) {
+            marks.first_byte = Clock::now();
+            return true;
+        };
 
-    for (auto const & [key, value] : result->headers) {
-        response.headers.add(HeaderName{key}, HeaderValue{value});
+        auto result = client->send(request);
+        auto const done = Clock::now();
+        on_stop.reset();
+        if (stop.stop_requested()) {
+            if (circuit_breaker_) {
+                circuit_breaker_->record(*endpoint, CallOutcome::cancelled);
+            }
+            return make_error("HTTP request cancelled");
+        }
+
+        // Only a connection that completed its exchange is known to be
+        // in a state the next request can use.
+        if (result) {
+            client->set_socket_options(httplib::default_socket_options);
+            pool_->release(*endpoint, std::move(client));
+        }
+
+        auto error_class = ErrorClass::none;
+        HttpResponse response;
+        if (not result) {
+            error_class = is_retryable(result.error())
+                ? ErrorClass::retryable
+                : ErrorClass::fatal;
+        } else {
+            response.status = HttpStatusCode{result->status};
+            response.body = HttpBody{result->body};
+            for (auto const & [key, value] : result->headers) {
+                response.headers.add(HeaderName{key}, HeaderValue{value});
+            }
+            response.timing = marks.timing(done);
+            response.timing.request_bytes = payload.size();
+            response.timing.response_bytes = result->body.size();
+            if (network_stats_) {
+                network_stats_->record(response.timing);
+            }
+            error_class = classify_status(response.status);
+        }
+
+        if (circuit_breaker_) {
+            circuit_breaker_->record(
+                *endpoint,
+                result ? status_outcome(response.status)
+                       : transport_outcome(result.error()));
+        }
+
+        if (retry_policy_) {
+            if (error_class == ErrorClass::retryable) {
+                auto const delay = retry_policy_->next_delay(
+                    retry, result ? &response.headers : nullptr);
+                // A stopped wait ends at the cancellation check above.
+                if (delay) {
+                    retry_policy_->wait(*delay, stop);
+                    continue;
+                }
+            }
+            retry_policy_->record(retry, error_class == ErrorClass::none);
+        }
+
+        if (not result) {
+            auto const err = httplib::to_string(result.error());
+            if (retry > 0) {
+                return make_error(
+                    "HTTP request failed after {} retries: {}", retry, err);
+            }
+            return make_error("HTTP request failed: {}", err);
+        }
+        return response;
     }
+}
 
-    return response;
+void
+HttpClient::
+warm_up() const
+{
+    auto const connection_timeout = json_value(connection_timeout_);
+    pool_->warm_up(
+        endpoint_key(endpoint_),
+        [endpoint = endpoint_, connection_timeout] {
+            auto client = open(endpoint);
+            client->set_connection_timeout(connection_timeout, 0);
+            client->set_read_timeout(connection_timeout, 0);
+            return client;
+        },
+        [path = endpoint_.path_prefix + "/models"](httplib::Client & client) {
+            return static_cast<bool>(client.Head(path));
+        });
+}
+
+void
+HttpClient::
+report_connections(std::ostream & out) const
+{
+    pool_->report(out);
 }
 
 void
@@ -68,4 +499,41 @@ set_read_timeout(TimeoutSeconds seconds)
     read_timeout_ = seconds;
 }
 
+void
+HttpClient::
+set_retry_policy(std::shared_ptr<RetryPolicy> policy)
+{
+    retry_policy_ = std::move(policy);
+}
+
+void
+HttpClient::
+set_circuit_breaker(std::shared_ptr<CircuitBreaker> breaker)
+{
+    circuit_breaker_ = std::move(breaker);
+}
+
+void
+HttpClient::
+set_connection_pool(std::shared_ptr<ConnectionPool> pool)
+{
+    if (pool) {
+        pool_ = std::move(pool);
+    }
+}
+
+void
+HttpClient::
+set_network_stats(std::shared_ptr<NetworkStats> stats)
+{
+    network_stats_ = std::move(stats);
+}
+
+void
+HttpClient::
+set_fallback(HttpEndpoint endpoint)
+{
+    fallback_ = std::move(endpoint);
+}
+
 } // namespace wjh::chat::client
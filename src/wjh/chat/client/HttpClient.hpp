@@ -10,13 +10,25 @@
 #include "wjh/chat/Result.hpp"
 #include "wjh/chat/client/types.hpp"
 
+#include <chrono>
+#include <cstddef>
 #include <initializer_list>
 #include <map>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stop_token>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace wjh::chat::client {
 
+class CircuitBreaker;
+class ConnectionPool;
+class NetworkStats;
+class RetryPolicy;
+
 /**
  * Semantic type for HTTP header key-value pairs.
  *
@@ -70,10 +82,42 @@ public:
         return headers_.empty();
     }
 
+    /// Look up a header by name, ignoring case as HTTP requires.
+    [[nodiscard]]
+    std::optional<std::string> find(std::string_view key) const;
+
 private:
     std::map<std::string, std::string> headers_;
 };
 
+/**
+ * Where the time of one HTTP exchange went, from monotonic
+ * timestamps taken as the request progressed.
+ */
+struct HttpTiming
+{
+    /// Name resolution, until the socket was created.
+    std::chrono::microseconds dns{0};
+
+    /// TCP connect and TLS handshake; httplib does not separate them.
+    std::chrono::microseconds connect{0};
+
+    /// Writing the request.
+    std::chrono::microseconds send{0};
+
+    /// Waiting for the response headers, i.e. server processing.
+    std::chrono::microseconds wait{0};
+
+    /// Reading the response body.
+    std::chrono::microseconds receive{0};
+
+    /// The whole exchange.
+    std::chrono::microseconds total{0};
+
+    std::size_t request_bytes = 0;
+    std::size_t response_bytes = 0;
+};
+
 /**
  * HTTP response containing status, headers, and body.
  */
@@ -82,36 +126,111 @@ struct HttpResponse
     HttpStatusCode status;
     HttpHeaders headers;
     HttpBody body;
+
+    /// Timing of the attempt that produced this response.
+    HttpTiming timing{};
 };
 
+/**
+ * Transport used to reach an HttpEndpoint.
+ */
+enum class HttpScheme
+{
+    http,
+    https,
+
+    /// Plain HTTP over a Unix domain socket.
+    unix_socket
+};
+
+/**
+ * Where an HttpClient sends its requests.
+ */
+struct HttpEndpoint
+{
+    HttpScheme scheme = HttpScheme::https;
+
+    /// Hostname, or the socket path for HttpScheme::unix_socket.
+    Hostname host;
+    PortNumber port{443};
+
+    /// Prepended to every request path, e.g. "/api/v1"; may be empty.
+    std::string path_prefix{};
+};
+
+/**
+ * Parse an API base URL.
+ *
+ * Accepted forms:
+ *   https://openrouter.ai/api/v1
+ *   http://localhost:8080/v1
+ *   unix:///run/gateway.sock              (no path prefix)
+ *   http+unix://%2Frun%2Fgateway.sock/v1  (percent-encoded socket path)
+ *
+ * @return The endpoint, or an error describing what is malformed
+ */
+[[nodiscard]]
+Result<HttpEndpoint> parse_base_url(std::string_view url);
+
 /**
  * Simple HTTP client abstraction using cpp-httplib.
  *
- * This provides a basic interface for making HTTPS requests,
- * primarily for the OpenRouter API.
+ * This provides a basic interface for making HTTP(S) requests,
+ * primarily for the OpenRouter API or a local OpenAI-compatible
+ * stand-in.
  */
 class HttpClient
 {
 public:
     /**
-     * Construct a client for the given host.
+     * Construct an HTTPS client for the given host.
      * @param host The hostname (e.g., "openrouter.ai")
      * @param port The port (default 443 for HTTPS)
      */
     explicit HttpClient(Hostname host, PortNumber port = PortNumber{443});
 
+    /**
+     * Construct a client for @p endpoint, whose path prefix is
+     * prepended to every request path.
+     */
+    explicit HttpClient(HttpEndpoint endpoint);
+
     /**
      * Make a POST request.
+     *
+     * With a retry policy installed, transport errors and retryable
+     * status codes are retried as the policy allows; the response of
+     * the last attempt is returned.
+     *
+     * With a circuit breaker installed, an attempt whose endpoint's
+     * circuit is open goes to the fallback endpoint, if one is set and
+     * its own circuit allows, and otherwise fails immediately.
+     *
      * @param path The request path
      * @param body The request body
      * @param headers Additional headers to include
+     * @param stop Aborts the request, in flight or between retries
      * @return Response or error message
      */
     [[nodiscard]]
     Result<HttpResponse> post(
         HttpPath const & path,
         HttpBody const & body,
-        HttpHeaders const & headers);
+        HttpHeaders const & headers,
+        std::stop_token stop = {}) const;
+
+    /**
+     * Open a connection to the endpoint in the background, and keep it
+     * open with periodic pings, so that the next post() need not wait
+     * for DNS, TCP and TLS setup.  Cheap to call repeatedly; each call
+     * extends how long connections are kept warm.
+     */
+    void warm_up() const;
+
+    /**
+     * Print connection reuse and warm-up counters.
+     */
+    void report_connections(std::ostream & out) const;
 
     /**
      * Set connection timeout in seconds.
@@ -123,11 +242,47 @@ public:
      */
     void set_read_timeout(TimeoutSeconds seconds);
 
+    /**
+     * Retry transient failures as @p policy allows; nullptr (the
+     * default) disables retries.
+     */
+    void set_retry_policy(std::shared_ptr<RetryPolicy> policy);
+
+    /**
+     * Track endpoint health in @p breaker; nullptr (the default)
+     * disables the breaker.
+     */
+    void set_circuit_breaker(std::shared_ptr<CircuitBreaker> breaker);
+
+    /**
+     * Record the timing of every completed exchange in @p stats;
+     * nullptr (the default) records nothing.
+     */
+    void set_network_stats(std::shared_ptr<NetworkStats> stats);
+
+    /**
+     * Endpoint serving the same API, used while the primary endpoint's
+     * circuit is open.
+     */
+    void set_fallback(HttpEndpoint endpoint);
+
+    /**
+     * Take connections from @p pool, which other clients may share, so
+     * they reuse each other's connections; nullptr is ignored.
+     */
+    void set_connection_pool(std::shared_ptr<ConnectionPool> pool);
+
 private:
-    Hostname host_;
-    PortNumber port_;
+    HttpEndpoint endpoint_;
+    std::optional<HttpEndpoint> fallback_;
     TimeoutSeconds connection_timeout_{30};
     TimeoutSeconds read_timeout_{120};
+    std::shared_ptr<RetryPolicy> retry_policy_;
+    std::shared_ptr<CircuitBreaker> circuit_breaker_;
+    std::shared_ptr<NetworkStats> network_stats_;
+
+    /// Shared by copies, so they reuse each other's connections.
+    std::shared_ptr<ConnectionPool> pool_;
 };
 
 } // namespace wjh::chat::client
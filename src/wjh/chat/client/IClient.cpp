@@ -11,4 +11,19 @@ namespace wjh::chat::client {
 IClient::
 ~IClient() = default;
 
+void
+IClient::
+do_report_stats(std::ostream &) const
+{ }
+
+void
+IClient::
+do_report_status(std::ostream &) const
+{ }
+
+void
+IClient::
+do_warm_up()
+{ }
+
 } // namespace wjh::chat::client
@@ -12,15 +12,39 @@
 #include "wjh/chat/types.hpp"
 #include "wjh/chat/conversation/Conversation.hpp"
 
+#include <ostream>
+#include <stop_token>
+#include <string_view>
+#include <utility>
+
 namespace wjh::chat::client {
 
+/**
+ * Which class of model should answer a turn.
+ */
+enum class ModelTier
+{
+    strong, ///< The configured model; the default.
+    fast ///< A smaller, lower-latency model for simple turns.
+};
+
+[[nodiscard]]
+constexpr std::string_view
+to_string(ModelTier tier)
+{
+    return tier == ModelTier::fast ? "fast" : "strong";
+}
+
 /**
  * Abstract interface for LLM API clients.
  *
  * This interface allows for dependency injection and mocking in tests.
  *
  * This interface uses the Non-Virtual Interface (NVI) pattern. Derived
- * classes must override the private virtual do_send_message function.
+ * classes must override the private virtual do_send_message function,
+ * and may override do_report_stats and do_report_status to expose
+ * client-side statistics and endpoint health, and do_warm_up to
+ * prepare for a request that is about to be sent.
  */
 class IClient
 {
@@ -30,18 +54,68 @@ public:
     /**
      * Send a conversation and get a response.
      * @param conversation The conversation history
+     * @param stop Abandons the turn: requests in flight, tool commands
+     *        and any further agent-loop iterations
+     * @param tier Model class to answer with; clients without a fast
+     *        model ignore it
      * @return Chat response with text and optional usage, or error
      */
     [[nodiscard]]
     Result<ChatResponse> send_message(
-        conversation::Conversation const & conversation)
+        conversation::Conversation const & conversation,
+        std::stop_token stop = {},
+        ModelTier tier = ModelTier::strong)
+    {
+        return do_send_message(conversation, std::move(stop), tier);
+    }
+
+    /**
+     * Write human-readable client statistics (caches, retries, etc.).
+     * @param out Destination stream
+     */
+    void report_stats(std::ostream & out) const
+    {
+        do_report_stats(out);
+    }
+
+    /**
+     * Write the current health of the endpoints the client talks to.
+     * @param out Destination stream
+     */
+    void report_status(std::ostream & out) const
+    {
+        do_report_status(out);
+    }
+
+    /**
+     * Hint that a request is likely soon, e.g. while the user types, so
+     * connections can be opened ahead of it.  Must not block.
+     */
+    void warm_up()
     {
-        return do_send_message(conversation);
+        do_warm_up();
     }
 
 private:
     virtual Result<ChatResponse> do_send_message(
-        conversation::Conversation const & conversation) = 0;
+        conversation::Conversation const & conversation,
+        std::stop_token stop,
+        ModelTier tier) = 0;
+
+    /**
+     * Default: reports nothing.
+     */
+    virtual void do_report_stats(std::ostream & out) const;
+
+    /**
+     * Default: reports nothing.
+     */
+    virtual void do_report_status(std::ostream & out) const;
+
+    /**
+     * Default: does nothing.
+     */
+    virtual void do_warm_up();
 };
 
 } // namespace wjh::chat::client
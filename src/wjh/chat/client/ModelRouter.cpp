@@ -0,0 +1,239 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/ModelRouter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <utility>
+
+namespace wjh::chat::client {
+
+namespace {
+
+using std::chrono::microseconds;
+
+constexpr std::array<std::string_view, 3> provider_sorts{
+    "throughput", "latency", "price"};
+
+double
+to_ms(microseconds duration)
+{
+    return static_cast<double>(duration.count()) / 1000.0;
+}
+
+/// Time until the first response byte: everything but the body.
+microseconds
+time_to_first_byte(HttpTiming const & timing)
+{
+    return timing.total - timing.receive;
+}
+
+std::string
+route_key(std::string const & model, std::string const & provider)
+{
+    return std::format(
+        "{} via {}", model, provider.empty() ? "-" : provider);
+}
+
+} // anonymous namespace
+
+std::vector<std::string>
+split_list(std::string_view list)
+{
+    std::vector<std::string> result;
+    while (not list.empty()) {
+        auto const comma = list.find(',');
+        auto item = list.substr(0, comma);
+        while (not item.empty() and item.front() == ' ') {
+            item.remove_prefix(1);
+        }
+        while (not item.empty() and item.back() == ' ') {
+            item.remove_suffix(1);
+        }
+        if (not item.empty()) {
+            result.emplace_back(item);
+        }
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        list.remove_prefix(comma + 1);
+    }
+    return result;
+}
+
+nlohmann::json
+ProviderPreferences::
+to_json() const
+{
+    auto result = nlohmann::json::object();
+    if (not sort.empty()) {
+        result["sort"] = sort;
+    }
+    if (not only.empty()) {
+        result["only"] = only;
+    }
+    if (not ignore.empty()) {
+        result["ignore"] = ignore;
+    }
+    return result;
+}
+
+bool
+is_provider_sort(std::string_view sort)
+{
+    return std::ranges::find(provider_sorts, sort) != provider_sorts.end();
+}
+
+ModelRouter::
+ModelRouter(RouterConfig config)
+: config_(std::move(config))
+{
+    if (not config_.log_path.empty()) {
+        log_.open(config_.log_path, std::ios::app);
+    }
+}
+
+std::vector<std::string>
+ModelRouter::
+candidates() const
+{
+    auto const now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto const cooling = [&](std::string const & model) {
+        auto const it = health_.find(model);
+        return it != health_.end() and it->second.cooling_until
+            and *it->second.cooling_until > now;
+    };
+
+    // Healthy models keep their configured order, ahead of the rest.
+    auto result = config_.models;
+    std::ranges::stable_partition(result, [&](std::string const & model) {
+        return not cooling(model);
+    });
+    return result;
+}
+
+void
+ModelRouter::
+record_success(RouteObservation const & observation)
+{
+    auto const ttft = time_to_first_byte(observation.timing);
+    auto const breach = config_.ttft_slo.count() > 0
+        and ttft > microseconds{config_.ttft_slo};
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto & stats = stats_[route_key(observation.model, observation.provider)];
+    ++stats.requests;
+    stats.ttft.record(ttft);
+    stats.completion_tokens += observation.completion_tokens;
+    stats.generation_time += observation.timing.total;
+
+    auto & health = health_[observation.model];
+    auto demoted = false;
+    if (breach) {
+        ++stats.slo_breaches;
+        if (++health.consecutive_breaches >= config_.breach_limit) {
+            health.consecutive_breaches = 0;
+            health.cooling_until = Clock::now() + config_.cooldown;
+            demoted = true;
+        }
+    } else {
+        health = Health{};
+    }
+
+    auto const seconds = to_ms(observation.timing.total) / 1000.0;
+    log({{"event", "success"},
+         {"model", observation.model},
+         {"provider", observation.provider},
+         {"ttft_ms", to_ms(ttft)},
+         {"total_ms", to_ms(observation.timing.total)},
+         {"tokens_per_s",
+          seconds > 0.0 ? observation.completion_tokens / seconds : 0.0},
+         {"slo_breach", breach}});
+    if (demoted) {
+        log({{"event", "demoted"},
+             {"model", observation.model},
+             {"reason",
+              std::format(
+                  "time to first byte over {} ms {} times in a row",
+                  config_.ttft_slo.count(),
+                  config_.breach_limit)}});
+    }
+}
+
+void
+ModelRouter::
+record_failure(std::string const & model, std::string_view error)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_[route_key(model, "")].failures;
+    auto & health = health_[model];
+    health.consecutive_breaches = 0;
+    health.cooling_until = Clock::now() + config_.cooldown;
+    log({{"event", "failure"}, {"model", model}, {"error", error}});
+}
+
+std::map<std::string, RouteStats>
+ModelRouter::
+stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void
+ModelRouter::
+report(std::ostream & out) const
+{
+    auto const stats = this->stats();
+    if (stats.empty()) {
+        return;
+    }
+
+    out << "Routing";
+    if (config_.ttft_slo.count() > 0) {
+        out << std::format(
+            " (time-to-first-byte objective {} ms)", config_.ttft_slo.count());
+    }
+    out << std::format(
+        ":\n  {:<40s} {:>5s} {:>5s} {:>7s} {:>7s} {:>7s}\n",
+        "Model via provider",
+        "reqs",
+        "fails",
+        "p50 ms",
+        "p90 ms",
+        "tok/s");
+    for (auto const & [key, s] : stats) {
+        auto const seconds = to_ms(s.generation_time) / 1000.0;
+        out << std::format(
+            "  {:<40s} {:>5} {:>5} {:>7.0f} {:>7.0f} {:>7.1f}\n",
+            key,
+            s.requests,
+            s.failures,
+            to_ms(s.ttft.percentile(0.50)),
+            to_ms(s.ttft.percentile(0.90)),
+            seconds > 0.0
+                ? static_cast<double>(s.completion_tokens) / seconds
+                : 0.0);
+    }
+}
+
+void
+ModelRouter::
+log(nlohmann::json entry)
+{
+    if (not log_.is_open()) {
+        return;
+    }
+    entry["time_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+    log_ << entry.dump() << '\n' << std::flush;
+}
+
+} // namespace wjh::chat::client
@@ -0,0 +1,196 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_26D34478B0C64E089725E32EF4E63B8F
+#define WJH_CHAT_26D34478B0C64E089725E32EF4E63B8F
+
+#include "wjh/chat/client/HttpClient.hpp"
+#include "wjh/chat/client/NetworkStats.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::client {
+
+/**
+ * Split a comma-separated list, trimming blanks and dropping empty
+ * entries.
+ */
+[[nodiscard]]
+std::vector<std::string> split_list(std::string_view list);
+
+/**
+ * OpenRouter provider routing preferences, sent as the request's
+ * `provider` object.
+ */
+struct ProviderPreferences
+{
+    /// "throughput", "latency" or "price"; OpenRouter's default
+    /// load balancing when empty.
+    std::string sort{};
+
+    /// Providers requests may go to; any when empty.
+    std::vector<std::string> only{};
+
+    /// Providers requests must not go to.
+    std::vector<std::string> ignore{};
+
+    [[nodiscard]]
+    bool empty() const
+    {
+        return sort.empty() and only.empty() and ignore.empty();
+    }
+
+    [[nodiscard]]
+    nlohmann::json to_json() const;
+};
+
+/**
+ * Whether @p sort is a provider sort order OpenRouter accepts.
+ */
+[[nodiscard]]
+bool is_provider_sort(std::string_view sort);
+
+/**
+ * Configuration for model routing.
+ */
+struct RouterConfig
+{
+    /// Models in order of preference; the first is the configured
+    /// model, the rest are fallbacks.
+    std::vector<std::string> models{};
+
+    /// Time-to-first-byte objective; none when zero.
+    std::chrono::milliseconds ttft_slo{0};
+
+    /// Consecutive SLO breaches after which a model is demoted.
+    std::size_t breach_limit = 3;
+
+    /// How long a failed or demoted model is tried only after the
+    /// healthy ones.
+    std::chrono::milliseconds cooldown{60'000};
+
+    /// File routing decisions are appended to as JSON lines; no log
+    /// when empty.
+    std::string log_path{};
+};
+
+/**
+ * One completed request, as seen by the router.
+ */
+struct RouteObservation
+{
+    std::string model;
+
+    /// Provider OpenRouter chose, from the response's `provider` field.
+    std::string provider;
+
+    HttpTiming timing{};
+    std::uint32_t completion_tokens = 0;
+};
+
+/**
+ * Latency and throughput of one model served by one provider.
+ */
+struct RouteStats
+{
+    std::size_t requests = 0;
+    std::size_t failures = 0;
+    std::size_t slo_breaches = 0;
+
+    /// Time until the first response byte.
+    LatencyHistogram ttft{};
+
+    /// Completion tokens and the time spent producing them, for the
+    /// overall tokens per second.
+    std::uint64_t completion_tokens = 0;
+    std::chrono::microseconds generation_time{0};
+};
+
+/**
+ * Picks the model for each request from an ordered list, and fails
+ * over to the next one on errors or when a model keeps missing its
+ * time-to-first-token objective.
+ *
+ * A model that fails, or breaches the objective breach_limit times in
+ * a row, is tried after the healthy models until its cooldown ends;
+ * when every model is cooling down the configured order is used.  Per
+ * model and provider, the router tracks time to first byte and tokens
+ * per second, and each decision can be logged for tuning.
+ *
+ * All member functions are thread-safe.
+ */
+class ModelRouter
+{
+public:
+    explicit ModelRouter(RouterConfig config);
+
+    [[nodiscard]]
+    RouterConfig const & config() const
+    {
+        return config_;
+    }
+
+    /**
+     * Models to try for the next request, in order.
+     */
+    [[nodiscard]]
+    std::vector<std::string> candidates() const;
+
+    /**
+     * Record a request answered by @p observation.model.
+     */
+    void record_success(RouteObservation const & observation);
+
+    /**
+     * Record a request to @p model that failed with @p error; the next
+     * candidate, if any, is tried next.
+     */
+    void record_failure(std::string const & model, std::string_view error);
+
+    /**
+     * Statistics keyed by "model via provider".
+     */
+    [[nodiscard]]
+    std::map<std::string, RouteStats> stats() const;
+
+    /**
+     * Print per-model and per-provider latency and throughput.
+     */
+    void report(std::ostream & out) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Health
+    {
+        std::size_t consecutive_breaches = 0;
+        std::optional<Clock::time_point> cooling_until{};
+    };
+
+    void log(nlohmann::json entry);
+
+    RouterConfig config_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Health> health_;
+    std::map<std::string, RouteStats> stats_;
+    std::ofstream log_;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_26D34478B0C64E089725E32EF4E63B8F
@@ -0,0 +1,191 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/NetworkStats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::client {
+
+namespace {
+
+using std::chrono::microseconds;
+
+constexpr std::array<std::string_view, 6> phase_names{
+    "dns", "connect", "send", "wait", "receive", "total"};
+
+std::string
+format_ms(microseconds duration)
+{
+    if (duration < microseconds{1000}) {
+        return "<1";
+    }
+    return std::format("{}", duration.count() / 1000);
+}
+
+std::string
+format_bytes(std::uint64_t bytes)
+{
+    if (bytes < 1024u) {
+        return std::format("{} B", bytes);
+    }
+    if (bytes < 1024u * 1024u) {
+        return std::format("{:.1f} KiB", static_cast<double>(bytes) / 1024.0);
+    }
+    return std::format(
+        "{:.1f} MiB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+}
+
+} // anonymous namespace
+
+void
+LatencyHistogram::
+record(microseconds duration)
+{
+    auto const ms = static_cast<std::uint64_t>(
+        std::max<microseconds::rep>(duration.count(), 0) / 1000);
+    auto const bucket = std::min<std::size_t>(
+        static_cast<std::size_t>(std::bit_width(ms)), bucket_count - 1);
+    ++buckets_[bucket];
+    ++count_;
+    max_ = std::max(max_, duration);
+}
+
+microseconds
+LatencyHistogram::
+percentile(double q) const
+{
+    if (count_ == 0) {
+        return microseconds{0};
+    }
+    auto const rank = std::max<std::size_t>(
+        static_cast<std::size_t>(
+            std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count_))),
+        1u);
+    std::size_t seen = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        if (seen + buckets_[i] >= rank) {
+            // Assume the bucket's values are spread evenly across it.
+            auto const lower = i == 0
+                ? microseconds{0}
+                : microseconds{upper_bound(i - 1)};
+            auto const fraction = static_cast<double>(rank - seen)
+                / static_cast<double>(buckets_[i]);
+            auto const estimate = lower
+                + std::chrono::duration_cast<microseconds>(
+                    (microseconds{upper_bound(i)} - lower) * fraction);
+            return std::min(estimate, max_);
+        }
+        seen += buckets_[i];
+    }
+    return max_;
+}
+
+std::chrono::milliseconds
+LatencyHistogram::
+upper_bound(std::size_t i)
+{
+    return std::chrono::milliseconds{std::int64_t{1} << i};
+}
+
+void
+NetworkStats::
+record(HttpTiming const & timing)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto const phases = std::array{
+        timing.dns,
+        timing.connect,
+        timing.send,
+        timing.wait,
+        timing.receive,
+        timing.total};
+    for (std::size_t i = 0; i < phase_count; ++i) {
+        histograms_[i].record(phases[i]);
+    }
+    ++totals_.requests;
+    totals_.request_bytes += timing.request_bytes;
+    totals_.response_bytes += timing.response_bytes;
+}
+
+LatencyHistogram
+NetworkStats::
+histogram(NetworkPhase phase) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return histograms_[static_cast<std::size_t>(phase)];
+}
+
+NetworkTotals
+NetworkStats::
+totals() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return totals_;
+}
+
+void
+NetworkStats::
+report(std::ostream & out) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto const histograms = histograms_;
+    auto const totals = totals_;
+    lock.unlock();
+
+    if (totals.requests == 0) {
+        return;
+    }
+
+    out << std::format(
+        "Network timing ({} requests, {} sent, {} received):\n"
+        "  {:<8s} {:>7s} {:>7s} {:>7s} {:>7s}  (ms)\n",
+        totals.requests,
+        format_bytes(totals.request_bytes),
+        format_bytes(totals.response_bytes),
+        "Phase",
+        "p50",
+        "p90",
+        "p99",
+        "max");
+    for (std::size_t i = 0; i < phase_count; ++i) {
+        auto const & h = histograms[i];
+        out << std::format(
+            "  {:<8s} {:>7s} {:>7s} {:>7s} {:>7s}\n",
+            phase_names[i],
+            format_ms(h.percentile(0.50)),
+            format_ms(h.percentile(0.90)),
+            format_ms(h.percentile(0.99)),
+            format_ms(h.max()));
+    }
+
+    auto const & total = histograms.back();
+    auto const peak = *std::ranges::max_element(total.buckets());
+    out << "  Total request time:\n";
+    for (std::size_t i = 0; i < LatencyHistogram::bucket_count; ++i) {
+        auto const n = total.buckets()[i];
+        if (n == 0) {
+            continue;
+        }
+        auto const last = i + 1 == LatencyHistogram::bucket_count;
+        auto const label = std::format(
+            "{} {} ms",
+            last ? ">=" : "<",
+            LatencyHistogram::upper_bound(last ? i - 1 : i).count());
+        out << std::format(
+            "    {:>11s}  {:<30s} {}\n",
+            label,
+            std::string(std::max<std::size_t>(n * 30 / peak, 1), '#'),
+            n);
+    }
+}
+
+} // namespace wjh::chat::client
@@ -0,0 +1,130 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_D64F749B6AC9443394AD189654351E54
+#define WJH_CHAT_D64F749B6AC9443394AD189654351E54
+
+#include "wjh/chat/client/HttpClient.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+namespace wjh::chat::client {
+
+/**
+ * Log-scale histogram of durations.
+ *
+ * Bucket 0 holds durations below 1 ms and bucket i those below 2^i ms;
+ * the last bucket is open-ended.  Percentiles are interpolated within
+ * the bucket they fall in, so they are accurate to within a factor of
+ * two, which is enough to tell a slow DNS lookup from a slow server.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr std::size_t bucket_count = 18;
+
+    void record(std::chrono::microseconds duration);
+
+    [[nodiscard]]
+    std::size_t count() const
+    {
+        return count_;
+    }
+
+    [[nodiscard]]
+    std::chrono::microseconds max() const
+    {
+        return max_;
+    }
+
+    /**
+     * Estimate of quantile @p q, never more than max().
+     */
+    [[nodiscard]]
+    std::chrono::microseconds percentile(double q) const;
+
+    [[nodiscard]]
+    std::array<std::size_t, bucket_count> const & buckets() const
+    {
+        return buckets_;
+    }
+
+    /**
+     * Exclusive upper bound of bucket @p i.
+     */
+    [[nodiscard]]
+    static std::chrono::milliseconds upper_bound(std::size_t i);
+
+private:
+    std::array<std::size_t, bucket_count> buckets_{};
+    std::size_t count_ = 0;
+    std::chrono::microseconds max_{0};
+};
+
+/**
+ * Phases of an HTTP exchange, in the order they happen.
+ */
+enum class NetworkPhase
+{
+    dns,
+    connect,
+    send,
+    wait,
+    receive,
+    total
+};
+
+/**
+ * Counters reported by NetworkStats::totals().
+ */
+struct NetworkTotals
+{
+    std::size_t requests = 0;
+    std::uint64_t request_bytes = 0;
+    std::uint64_t response_bytes = 0;
+};
+
+/**
+ * Per-session latency histograms for each phase of an HTTP exchange.
+ *
+ * All member functions are thread-safe.
+ */
+class NetworkStats
+{
+public:
+    /**
+     * Add the timing of one completed exchange.
+     */
+    void record(HttpTiming const & timing);
+
+    [[nodiscard]]
+    LatencyHistogram histogram(NetworkPhase phase) const;
+
+    [[nodiscard]]
+    NetworkTotals totals() const;
+
+    /**
+     * Print a percentile table per phase and the distribution of total
+     * request time.
+     */
+    void report(std::ostream & out) const;
+
+private:
+    static constexpr std::size_t phase_count = 6;
+
+    mutable std::mutex mutex_;
+    std::array<LatencyHistogram, phase_count> histograms_{};
+    NetworkTotals totals_;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_D64F749B6AC9443394AD189654351E54
@@ -8,13 +8,15 @@
 
 #include "wjh/chat/json_convert.hpp"
 #include "wjh/chat/stdfmt.hpp"
+#include "wjh/chat/client/PromptCache.hpp"
 #include "wjh/chat/conversation/Message.hpp"
+#include "wjh/chat/tools/Tools.hpp"
 
-#include <array>
+#include <chrono>
 #include <cstdio>
-#include <filesystem>
-#include <fstream>
+#include <format>
 #include <iostream>
+#include <vector>
 
 namespace {
 
@@ -33,343 +35,151 @@ void debug_json(
     }
 }
 
-nlohmann::json make_tools_json()
+std::uint32_t
+usage_count(nlohmann::json const & object, char const * key)
 {
-    auto bash_tool = nlohmann::json{
-        {"type", "function"},
-        {"function",
-         {{"name", "bash"},
-          {"description",
-           "Execute a bash command. Use this to run "
-           "shell commands, compile code, run tests, "
-           "and other terminal operations."},
-          {"parameters",
-           {{"type", "object"},
-            {"properties",
-             {{"command",
-               {{"type", "string"},
-                {"description",
-                 "The bash command to execute"}}}}},
-            {"required", {"command"}}}}}}};
-
-    auto read_file_tool = nlohmann::json{
-        {"type", "function"},
-        {"function",
-         {{"name", "read_file"},
-          {"description",
-           "Read the contents of a file. Returns "
-           "lines with line numbers. Use this "
-           "instead of bash cat/head/tail."},
-          {"parameters",
-           {{"type", "object"},
-            {"properties",
-             {{"file_path",
-               {{"type", "string"},
-                {"description",
-                 "Path to the file to read"}}},
-              {"offset",
-               {{"type", "integer"},
-                {"description",
-                 "1-indexed line number to start "
-                 "from (optional)"}}},
-              {"limit",
-               {{"type", "integer"},
-                {"description",
-                 "Maximum number of lines to read "
-                 "(optional)"}}}}},
-            {"required", {"file_path"}}}}}}};
-
-    auto write_file_tool = nlohmann::json{
-        {"type", "function"},
-        {"function",
-         {{"name", "write_file"},
-          {"description",
-           "Write content to a file. Creates parent "
-           "directories if needed. Use this instead "
-           "of bash echo/cat with redirects."},
-          {"parameters",
-           {{"type", "object"},
-            {"properties",
-             {{"file_path",
-               {{"type", "string"},
-                {"description",
-                 "Path to the file to write"}}},
-              {"content",
-               {{"type", "string"},
-                {"description",
-                 "The content to write to the "
-                 "file"}}}}},
-            {"required",
-             {"file_path", "content"}}}}}}};
-
-    auto edit_file_tool = nlohmann::json{
-        {"type", "function"},
-        {"function",
-         {{"name", "edit_file"},
-          {"description",
-           "Make a targeted edit to a file by "
-           "replacing an exact string. The old_string"
-           " must appear exactly once in the file. "
-           "Use this instead of bash sed."},
-          {"parameters",
-           {{"type", "object"},
-            {"properties",
-             {{"file_path",
-               {{"type", "string"},
-                {"description",
-                 "Path to the file to edit"}}},
-              {"old_string",
-               {{"type", "string"},
-                {"description",
-                 "The exact string to find and "
-                 "replace (must be unique)"}}},
-              {"new_string",
-               {{"type", "string"},
-                {"description",
-                 "The replacement string"}}}}},
-            {"required",
-             {"file_path", "old_string",
-              "new_string"}}}}}}};
-
-    return {bash_tool, read_file_tool,
-            write_file_tool, edit_file_tool};
+    if (object.is_object() and object.contains(key)
+        and object[key].is_number_unsigned())
+    {
+        return object[key].get<std::uint32_t>();
+    }
+    return 0u;
 }
 
-std::string execute_bash(std::string const & command)
+/// The first choice's message in @p response, or nullptr if it has
+/// none.
+nlohmann::json const *
+first_message(nlohmann::json const & response)
 {
-    std::cerr << "\n[tool] bash: " << command
-              << "\n[y/n]> " << std::flush;
-    std::string answer;
-    std::getline(std::cin, answer);
-    if (answer.empty()
-        or (answer[0] != 'y' and answer[0] != 'Y'))
+    auto const choices = response.find("choices");
+    if (choices == response.end() or not choices->is_array()
+        or choices->empty())
     {
-        return "Command skipped by user";
+        return nullptr;
     }
-
-    std::string full_cmd = command + " 2>&1";
-    std::array<char, 4096> buffer;
-    std::string result;
-
-    auto * pipe = popen(full_cmd.c_str(), "r");
-    if (not pipe) {
-        return "Error: failed to execute command";
+    auto const message = choices->front().find("message");
+    if (message == choices->front().end() or not message->is_object()) {
+        return nullptr;
     }
+    return &*message;
+}
 
-    while (fgets(buffer.data(), buffer.size(), pipe)) {
-        result += buffer.data();
-        if (result.size() > 100'000) {
-            result += "\n... [truncated at 100KB]";
-            break;
-        }
-    }
+/// Whether @p request explicitly turns sampling off, so the same
+/// request should always get the same answer.
+bool
+is_deterministic(nlohmann::json const & request)
+{
+    auto const temperature = request.find("temperature");
+    return temperature != request.end() and temperature->is_number()
+        and temperature->get<double>() == 0.0;
+}
 
-    auto status = pclose(pipe);
-    result +=
-        "\n[exit code: "
-        + std::to_string(WEXITSTATUS(status)) + "]";
-    return result;
+/// Whether a request that failed with HTTP @p status might succeed with
+/// another model: the provider failed, timed out or is rate limited,
+/// or has no endpoint for this model.  Bad keys, exhausted credits and
+/// requests that are invalid or too long fail the same way anywhere.
+bool
+model_at_fault(int status)
+{
+    return status == 404 or status == 408 or status == 429 or status >= 500;
 }
 
-std::string execute_read_file(
-    nlohmann::json const & args)
+/// Pre-flight token estimate for the rate limiter: roughly four bytes
+/// of JSON per prompt token, plus the full completion allowance.
+std::uint32_t
+estimate_tokens(std::string const & body, nlohmann::json const & request)
 {
-    auto path =
-        args["file_path"].get<std::string>();
+    return static_cast<std::uint32_t>(body.size() / 4)
+        + usage_count(request, "max_tokens");
+}
 
-    std::ifstream file(path);
-    if (not file.is_open()) {
-        return "Error: Cannot open file: " + path;
-    }
+} // anonymous namespace
 
-    int offset = 1;
-    int limit = std::numeric_limits<int>::max();
-    if (args.contains("offset")) {
-        offset = args["offset"].get<int>();
-    }
-    if (args.contains("limit")) {
-        limit = args["limit"].get<int>();
-    }
+namespace wjh::chat::client {
 
-    std::string result;
-    std::string line;
-    int line_num = 0;
-    int lines_read = 0;
+TokenUsage
+parse_token_usage(nlohmann::json const & usage)
+{
+    auto result = TokenUsage{
+        .prompt_tokens = PromptTokens{usage.value("prompt_tokens", 0u)},
+        .completion_tokens = CompletionTokens{
+            usage.value("completion_tokens", 0u)},
+        .total_tokens = TotalTokens{usage.value("total_tokens", 0u)}};
 
-    while (std::getline(file, line)) {
-        ++line_num;
-        if (line_num < offset) {
-            continue;
-        }
-        if (lines_read >= limit) {
-            break;
-        }
-        result += std::format(
-            "{:>6}\t{}\n", line_num, line);
-        ++lines_read;
-        if (result.size() > 100'000) {
-            result += "\n... [truncated at 100KB]";
-            break;
-        }
+    auto const details = usage.value(
+        "prompt_tokens_details", nlohmann::json::object());
+    auto cached = usage_count(details, "cached_tokens");
+    if (cached == 0u) {
+        cached = usage_count(usage, "cache_read_input_tokens");
     }
-
-    if (result.empty()) {
-        return "File is empty or offset is past end";
+    auto written = usage_count(details, "cache_write_tokens");
+    if (written == 0u) {
+        written = usage_count(usage, "cache_creation_input_tokens");
     }
+
+    result.cached_tokens = CachedTokens{cached};
+    result.cache_write_tokens = CacheWriteTokens{written};
     return result;
 }
 
-std::string execute_write_file(
-    nlohmann::json const & args)
+std::optional<std::string>
+agent_limit_reached(
+    AgentLimits const & limits,
+    std::size_t iterations,
+    std::chrono::milliseconds elapsed,
+    std::uint64_t tokens)
 {
-    auto path =
-        args["file_path"].get<std::string>();
-    auto content =
-        args["content"].get<std::string>();
-
-    std::cerr
-        << "\n[tool] write_file: " << path
-        << " (" << content.size() << " bytes)"
-        << "\n[y/n]> " << std::flush;
-    std::string answer;
-    std::getline(std::cin, answer);
-    if (answer.empty()
-        or (answer[0] != 'y' and answer[0] != 'Y'))
-    {
-        return "Write skipped by user";
+    if (iterations >= limits.max_iterations) {
+        return std::format(
+            "the limit of {} tool-calling steps", limits.max_iterations);
     }
-
-    auto parent =
-        std::filesystem::path(path).parent_path();
-    if (not parent.empty()) {
-        std::error_code ec;
-        std::filesystem::create_directories(
-            parent, ec);
-        if (ec) {
-            return "Error: Cannot create directory: "
-                + parent.string();
-        }
-    }
-
-    std::ofstream file(path);
-    if (not file.is_open()) {
-        return "Error: Cannot open file for "
-               "writing: " + path;
+    if (limits.deadline.count() > 0 and elapsed >= limits.deadline) {
+        return std::format(
+            "the time limit of {} s", limits.deadline.count() / 1000);
     }
-
-    file << content;
-    if (not file.good()) {
-        return "Error: Write failed";
+    if (limits.token_budget > 0 and tokens >= limits.token_budget) {
+        return std::format(
+            "the budget of {} tokens ({} used)", limits.token_budget, tokens);
     }
-
-    return "Wrote " + std::to_string(content.size())
-        + " bytes to " + path;
+    return std::nullopt;
 }
 
-std::string execute_edit_file(
-    nlohmann::json const & args)
+OpenRouterClient::
+OpenRouterClient(OpenRouterClientConfig config)
+: config_(std::move(config))
+, http_client_(config_.endpoint)
+, retry_policy_(std::make_shared<RetryPolicy>(config_.retry))
+, network_stats_(std::make_shared<NetworkStats>())
 {
-    auto path =
-        args["file_path"].get<std::string>();
-    auto old_string =
-        args["old_string"].get<std::string>();
-    auto new_string =
-        args["new_string"].get<std::string>();
-
-    // Read the entire file
-    std::ifstream file(path);
-    if (not file.is_open()) {
-        return "Error: Cannot open file: " + path;
-    }
-    std::string contents(
-        (std::istreambuf_iterator<char>(file)),
-        std::istreambuf_iterator<char>());
-    file.close();
-
-    // Check uniqueness before prompting
-    std::size_t count = 0;
-    std::size_t pos = 0;
-    std::size_t found_pos = std::string::npos;
-    while ((pos = contents.find(old_string, pos))
-           != std::string::npos)
-    {
-        ++count;
-        found_pos = pos;
-        pos += old_string.size();
-    }
-
-    if (count == 0) {
-        return "Error: old_string not found in "
-            + path;
-    }
-    if (count > 1) {
-        return "Error: old_string is not unique in "
-            + path + " (found "
-            + std::to_string(count)
-            + " occurrences)";
-    }
-
-    // Show diff preview and prompt
-    std::cerr
-        << "\n[tool] edit_file: " << path
-        << "\n--- old ---\n" << old_string
-        << "\n--- new ---\n" << new_string
-        << "\n[y/n]> " << std::flush;
-    std::string answer;
-    std::getline(std::cin, answer);
-    if (answer.empty()
-        or (answer[0] != 'y' and answer[0] != 'Y'))
-    {
-        return "Edit skipped by user";
+    http_client_.set_retry_policy(retry_policy_);
+    http_client_.set_network_stats(network_stats_);
+    http_client_.set_circuit_breaker(config_.circuit_breaker);
+    http_client_.set_connection_pool(config_.connection_pool);
+    tool_dispatcher_.set_echo(&std::cerr);
+    if (config_.tool_policy) {
+        tool_dispatcher_.set_policy(config_.tool_policy);
     }
-
-    // Apply the replacement
-    contents.replace(
-        found_pos, old_string.size(), new_string);
-
-    // Write back
-    std::ofstream out(path);
-    if (not out.is_open()) {
-        return "Error: Cannot write file: " + path;
+    if (config_.file_watcher) {
+        tool_dispatcher_.watch(config_.file_watcher);
     }
-    out << contents;
-    if (not out.good()) {
-        return "Error: Write failed";
+    if (config_.sandbox.any()) {
+        tool_dispatcher_.set_sandbox(
+            std::make_shared<tools::Sandbox const>(config_.sandbox));
     }
-
-    return "Applied edit to " + path;
-}
-
-std::string dispatch_tool(
-    std::string const & name,
-    nlohmann::json const & args)
-{
-    if (name == "bash") {
-        return execute_bash(
-            args["command"].get<std::string>());
+    if (config_.fallback_host) {
+        auto fallback = config_.endpoint;
+        fallback.host = *config_.fallback_host;
+        http_client_.set_fallback(std::move(fallback));
     }
-    if (name == "read_file") {
-        return execute_read_file(args);
+    if (config_.hedge) {
+        hedge_policy_ = std::make_shared<HedgePolicy>(*config_.hedge);
     }
-    if (name == "write_file") {
-        return execute_write_file(args);
+    if (config_.routing.models.empty()) {
+        config_.routing.models.push_back(json_value(config_.model));
     }
-    if (name == "edit_file") {
-        return execute_edit_file(args);
-    }
-    return "Error: unknown tool: " + name;
+    router_ = std::make_shared<ModelRouter>(config_.routing);
 }
 
-} // anonymous namespace
-
-namespace wjh::chat::client {
-
-OpenRouterClient::
-OpenRouterClient(OpenRouterClientConfig config)
-: config_(std::move(config))
-, http_client_(Hostname{"openrouter.ai"}, PortNumber{443})
-{ }
-
 nlohmann::json
 OpenRouterClient::
 convert_messages_to_openai(
@@ -408,7 +218,11 @@ build_request(conversation::Conversation const & conversation) const
             json_value(*config_.temperature);
     }
 
-    request["tools"] = make_tools_json();
+    request["tools"] = tools::make_tools_json();
+
+    if (config_.prompt_caching) {
+        add_cache_breakpoints(request);
+    }
 
     return request;
 }
@@ -444,15 +258,8 @@ parse_response(nlohmann::json const & json) const
         // Extract token usage if present (needed by both
         // tool-call and text-content paths)
         std::optional<TokenUsage> usage;
-        if (json.contains("usage")) {
-            auto const & u = json["usage"];
-            usage = TokenUsage{
-                .prompt_tokens = PromptTokens{
-                    u.value("prompt_tokens", 0u)},
-                .completion_tokens = CompletionTokens{
-                    u.value("completion_tokens", 0u)},
-                .total_tokens = TotalTokens{
-                    u.value("total_tokens", 0u)}};
+        if (json.contains("usage") and json["usage"].is_object()) {
+            usage = parse_token_usage(json["usage"]);
         }
 
         // Check for tool calls
@@ -500,8 +307,49 @@ parse_response(nlohmann::json const & json) const
 
 Result<nlohmann::json>
 OpenRouterClient::
-send_api_request(nlohmann::json const & request)
+send_api_request(
+    nlohmann::json const & request,
+    std::stop_token stop,
+    HttpTiming * timing,
+    Failure * failure)
 {
+    auto const body = request.dump();
+    // Failures before the request reaches a model are the request's.
+    auto const fail = [failure](Failure kind) {
+        if (failure) {
+            *failure = kind;
+        }
+    };
+    fail(Failure::request);
+
+    // Only a request that asks for no sampling may get an earlier
+    // answer back; any other would replay one random draw as fresh.
+    auto const cacheable = config_.response_cache
+        and is_deterministic(request);
+    if (config_.response_cache and config_.response_cache->offline()
+        and not cacheable)
+    {
+        return make_error(
+            "Offline mode: only requests with temperature 0 are cached");
+    }
+
+    std::string cache_key;
+    if (cacheable) {
+        cache_key = ResponseCache::key_for(body);
+        if (auto cached = config_.response_cache->lookup(cache_key)) {
+            try {
+                return nlohmann::json::parse(*cached);
+            } catch (nlohmann::json::parse_error const &) {
+                // Fall through and refetch a corrupt entry.
+            }
+        }
+        if (config_.response_cache->offline()) {
+            return make_error(
+                "Offline mode: no cached response for request {}",
+                cache_key);
+        }
+    }
+
     HttpHeaders headers{
         {HeaderName{"Authorization"},
          HeaderValue{
@@ -509,17 +357,68 @@ send_api_request(nlohmann::json const & request)
         {HeaderName{"Content-Type"},
          HeaderValue{"application/json"}}};
 
-    auto result = http_client_.post(
-        HttpPath{"/api/v1/chat/completions"},
-        HttpBody{request.dump()},
-        headers);
+    // Hand the unused estimate back however the request ends; failed
+    // requests are assumed not to count against the token limit.
+    struct Reservation
+    {
+        RateLimiter * limiter = nullptr;
+        std::uint32_t estimate = 0;
+        std::uint32_t actual = 0;
+
+        ~Reservation()
+        {
+            if (limiter) {
+                limiter->reconcile(estimate, actual);
+            }
+        }
+    } reservation;
+    if (auto const & limiter = config_.rate_limiter) {
+        auto const estimate = estimate_tokens(body, request);
+        if (not limiter->acquire(estimate, stop)) {
+            return make_error("Rate limiter wait was cancelled");
+        }
+        reservation.limiter = limiter.get();
+        reservation.estimate = estimate;
+    }
+
+    auto const path = HttpPath{"/chat/completions"};
+    auto const start = std::chrono::steady_clock::now();
+    auto hedged = false;
+    auto result = [&] {
+        if (not hedge_policy_) {
+            return http_client_.post(path, HttpBody{body}, headers, stop);
+        }
+        auto hedge_request = request;
+        if (auto const & provider = hedge_policy_->config().provider) {
+            hedge_request["provider"]["order"] = {*provider};
+        }
+        auto outcome = hedge_policy_->post(
+            http_client_,
+            path,
+            HttpBody{body},
+            HttpBody{hedge_request.dump()},
+            headers,
+            stop);
+        hedged = outcome.hedged;
+        return std::move(outcome.response);
+    }();
     if (not result) {
+        fail(Failure::model);
         return make_error("{}", result.error());
     }
 
     auto const & response = *result;
+    if (timing) {
+        *timing = response.timing;
+    }
+    if (config_.rate_limiter) {
+        config_.rate_limiter->learn(response.headers);
+    }
 
     if (response.status != HttpStatusCode{200}) {
+        if (model_at_fault(json_value(response.status))) {
+            fail(Failure::model);
+        }
         try {
             auto err = nlohmann::json::parse(
                 json_value(response.body));
@@ -541,89 +440,260 @@ send_api_request(nlohmann::json const & request)
     }
 
     try {
-        return nlohmann::json::parse(
+        auto json = nlohmann::json::parse(
             json_value(response.body));
+        if (json.contains("usage") and json["usage"].is_object()) {
+            auto const usage = parse_token_usage(json["usage"]);
+            reservation.actual = json_value(usage.total_tokens);
+            if (hedged) {
+                hedge_policy_->charge(json_value(usage.prompt_tokens));
+            }
+        }
+        if (cacheable) {
+            config_.response_cache->store(
+                cache_key,
+                json_value(response.body),
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start));
+        }
+        return json;
     } catch (nlohmann::json::parse_error const & e) {
+        fail(Failure::model);
         return make_error(
             "Failed to parse response JSON: {}",
             e.what());
     }
 }
 
+Result<nlohmann::json>
+OpenRouterClient::
+send_routed(
+    nlohmann::json request,
+    std::stop_token stop,
+    ModelTier tier)
+{
+    auto models = router_->candidates();
+    // A simple turn tries the fast model first; the configured models
+    // stay behind it as fallbacks.
+    if (tier == ModelTier::fast and config_.fast_model) {
+        auto const & fast = json_value(*config_.fast_model);
+        std::erase(models, fast);
+        models.insert(models.begin(), fast);
+    }
+    std::string error;
+    for (std::size_t i = 0; i < models.size(); ++i) {
+        auto const & model = models[i];
+        request["model"] = model;
+        auto timing = HttpTiming{};
+        auto failure = Failure::model;
+        auto result = send_api_request(request, stop, &timing, &failure);
+        if (result) {
+            if (timing.total.count() > 0) {
+                auto const usage = result->value("usage", nlohmann::json{});
+                router_->record_success(RouteObservation{
+                    .model = model,
+                    .provider = result->value("provider", ""),
+                    .timing = timing,
+                    .completion_tokens = usage_count(
+                        usage, "completion_tokens")});
+            }
+            return result;
+        }
+        if (stop.stop_requested() or failure == Failure::request) {
+            return result;
+        }
+
+        router_->record_failure(model, result.error());
+        error = std::move(result.error());
+        if (i + 1 < models.size()) {
+            std::cerr << "[route] " << model << " failed (" << error
+                      << "); trying " << models[i + 1] << "\n";
+        }
+    }
+    return make_error("{}", error);
+}
+
 Result<ChatResponse>
 OpenRouterClient::
 do_send_message(
-    conversation::Conversation const & conversation)
+    conversation::Conversation const & conversation,
+    std::stop_token stop,
+    ModelTier tier)
 {
     auto messages =
         convert_messages_to_openai(conversation);
-    auto const tools = make_tools_json();
+    auto const tool_specs = tools::make_tools_json();
+    tool_dispatcher_.begin_turn();
+
+    using Clock = std::chrono::steady_clock;
+    auto const elapsed_since = [](Clock::time_point from) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now() - from);
+    };
+
+    // Every request of the turn counts, not just the one that answers.
+    std::vector<IterationStats> iterations;
+    std::uint64_t tokens = 0;
+    auto const answer = [&](nlohmann::json const & json) {
+        auto response = parse_response(json);
+        if (response) {
+            auto usage = std::optional<TokenUsage>{};
+            for (auto const & iteration : iterations) {
+                if (not iteration.usage) {
+                    continue;
+                }
+                if (usage) {
+                    *usage += *iteration.usage;
+                } else {
+                    usage = iteration.usage;
+                }
+            }
+            response->usage = std::move(usage);
+            response->iterations = std::move(iterations);
+        }
+        return response;
+    };
+
+    auto const start = Clock::now();
+    for (std::size_t i = 0;; ++i) {
+        if (stop.stop_requested()) {
+            return make_error("Cancelled");
+        }
+
+        // Out of steps, time or tokens: keep the work done so far by
+        // asking for an answer from it, with tools turned off.
+        auto const limit = agent_limit_reached(
+            config_.limits,
+            i,
+            elapsed_since(start),
+            tokens);
+        if (limit) {
+            std::cerr << "[agent] Reached " << *limit
+                      << "; asking for a final answer\n";
+            messages.push_back(
+                {{"role", "user"},
+                 {"content",
+                  std::format(
+                      "You have reached {} for this request. Do not call "
+                      "any more tools. Reply now with your best answer: "
+                      "summarize what you did and found, and what is "
+                      "left to do.",
+                      *limit)}});
+        }
 
-    for (int i = 0; i < 20; ++i) {
         auto request = nlohmann::json{
             {"model", json_value(config_.model)},
             {"max_tokens",
              json_value(config_.max_tokens)},
             {"messages", messages},
-            {"tools", tools}};
+            {"tools", tool_specs}};
 
         if (config_.temperature) {
             request["temperature"] =
                 json_value(*config_.temperature);
         }
+        if (not config_.provider.empty()) {
+            request["provider"] = config_.provider.to_json();
+        }
+        if (limit) {
+            request["tool_choice"] = "none";
+        }
+
+        // The messages array is only ever appended to, so everything
+        // before the previous iteration's checkpoint stays byte-stable.
+        if (config_.prompt_caching) {
+            add_cache_breakpoints(request);
+        }
 
         debug_json("request", request);
 
-        auto result = send_api_request(request);
+        auto const request_start = Clock::now();
+        auto result = send_routed(std::move(request), stop, tier);
         if (not result) {
             return make_error("{}", result.error());
         }
 
         debug_json("response", *result);
+        auto & iteration = iterations.emplace_back(IterationStats{
+            .usage = std::nullopt, .latency = elapsed_since(request_start)});
+        if (auto const usage = result->find("usage");
+            usage != result->end() and usage->is_object())
+        {
+            iteration.usage = parse_token_usage(*usage);
+            tokens += json_value(iteration.usage->total_tokens);
+        }
 
-        auto const & choice = (*result)["choices"][0];
-        auto const & message = choice["message"];
+        auto const * const found = first_message(*result);
+        if (not found) {
+            return make_error("API response contains no message");
+        }
+        auto const & message = *found;
+        auto const content = message.find("content");
+        auto const has_text = content != message.end()
+            and content->is_string()
+            and not content->get<std::string>().empty();
+
+        if (limit) {
+            if (has_text) {
+                return answer(*result);
+            }
+            return make_error(
+                "Agent loop reached {} without a final answer", *limit);
+        }
 
         // Tool calls: execute and loop
         if (message.contains("tool_calls")
             and not message["tool_calls"].empty())
         {
+            // A call the model garbled fails the request rather than
+            // throwing out of it.
+            std::vector<tools::ToolCall> calls;
+            std::vector<nlohmann::json> ids;
+            try {
+                for (auto const & tc : message.at("tool_calls")) {
+                    auto const & fn = tc.at("function");
+                    calls.push_back(
+                        {.name = fn.at("name").get<std::string>(),
+                         .args = nlohmann::json::parse(
+                             fn.at("arguments").get<std::string>())});
+                    ids.push_back(tc.at("id"));
+                }
+            } catch (nlohmann::json::exception const & e) {
+                return make_error(
+                    "Malformed tool call from model: {}", e.what());
+            }
             messages.push_back(message);
 
-            for (auto const & tc :
-                 message["tool_calls"])
-            {
-                auto name =
-                    tc["function"]["name"]
-                        .get<std::string>();
-                auto args = nlohmann::json::parse(
-                    tc["function"]["arguments"]
-                        .get<std::string>());
+            // One approval prompt covers every call of the message.
+            auto const approvals = stop.stop_requested()
+                ? std::vector<tools::ToolApproval>(calls.size())
+                : tool_dispatcher_.approve(calls, stop);
 
+            for (std::size_t n = 0; n < calls.size(); ++n) {
+                // A cancelled tool still gets a result, so the
+                // transcript stays well-formed up to the last call.
+                auto const tool_start = Clock::now();
                 auto output =
-                    dispatch_tool(name, args);
-                std::cerr << output << std::endl;
+                    tool_dispatcher_.dispatch(calls[n], approvals[n], stop);
+                iteration.tools.push_back(
+                    {.name = calls[n].name,
+                     .elapsed = elapsed_since(tool_start)});
 
                 messages.push_back(
                     {{"role", "tool"},
-                     {"tool_call_id", tc["id"]},
+                     {"tool_call_id", ids[n]},
                      {"content", output}});
             }
             continue;
         }
 
         // Text content: return to user
-        if (message.contains("content")
-            and not message["content"].is_null()
-            and not message["content"]
-                        .get<std::string>()
-                        .empty())
-        {
-            return parse_response(*result);
+        if (has_text) {
+            return answer(*result);
         }
 
         // Empty/null content: nudge the model
-        if (message.contains("content")) {
+        if (content != message.end()) {
             messages.push_back(message);
         }
         messages.push_back(
@@ -632,9 +702,51 @@ do_send_message(
               "Please use your tools or respond "
               "with text."}});
     }
+}
 
-    return make_error(
-        "Agent loop exceeded 20 iterations");
+void
+OpenRouterClient::
+do_report_stats(std::ostream & out) const
+{
+    if (config_.response_cache) {
+        config_.response_cache->report(out);
+    }
+    retry_policy_->report(out);
+    if (config_.circuit_breaker) {
+        config_.circuit_breaker->report(out);
+    }
+    if (config_.rate_limiter) {
+        config_.rate_limiter->report(out);
+    }
+    if (hedge_policy_) {
+        hedge_policy_->report(out);
+    }
+    network_stats_->report(out);
+    router_->report(out);
+    http_client_.report_connections(out);
+    tool_dispatcher_.report(out);
+}
+
+void
+OpenRouterClient::
+do_report_status(std::ostream & out) const
+{
+    if (config_.circuit_breaker) {
+        config_.circuit_breaker->status(out);
+    }
+}
+
+void
+OpenRouterClient::
+do_warm_up()
+{
+    // Offline mode must not touch the network at all.
+    if (not config_.prewarm
+        or (config_.response_cache and config_.response_cache->offline()))
+    {
+        return;
+    }
+    http_client_.warm_up();
 }
 
 } // namespace wjh::chat::client
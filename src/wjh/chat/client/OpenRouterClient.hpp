@@ -8,16 +8,59 @@
 #define WJH_CHAT_32E18E993AE1467299AB1E45EEC3991D
 
 #include "wjh/chat/Result.hpp"
+#include "wjh/chat/TokenUsage.hpp"
 #include "wjh/chat/types.hpp"
+#include "wjh/chat/client/CircuitBreaker.hpp"
+#include "wjh/chat/client/ConnectionPool.hpp"
+#include "wjh/chat/client/HedgePolicy.hpp"
 #include "wjh/chat/client/HttpClient.hpp"
 #include "wjh/chat/client/IClient.hpp"
+#include "wjh/chat/client/ModelRouter.hpp"
+#include "wjh/chat/client/NetworkStats.hpp"
+#include "wjh/chat/client/RateLimiter.hpp"
+#include "wjh/chat/client/ResponseCache.hpp"
+#include "wjh/chat/client/RetryPolicy.hpp"
+#include "wjh/chat/tools/ToolDispatcher.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <string>
 
 namespace wjh::chat::client {
 
+/**
+ * Limits on one turn of the agent loop.  A turn that reaches one is
+ * asked for a final answer without tools, instead of failing.
+ */
+struct AgentLimits
+{
+    /// Tool-calling requests per turn.
+    std::size_t max_iterations = 20;
+
+    /// Wall-clock time per turn; none when zero.
+    std::chrono::milliseconds deadline{0};
+
+    /// Total tokens per turn, over all of its requests; none when zero.
+    std::uint64_t token_budget = 0;
+};
+
+/**
+ * The limit a turn has reached after @p iterations tool-calling
+ * requests, @p elapsed time and @p tokens total tokens, described for
+ * the model; empty while the turn is within its limits.
+ */
+[[nodiscard]]
+std::optional<std::string> agent_limit_reached(
+    AgentLimits const & limits,
+    std::size_t iterations,
+    std::chrono::milliseconds elapsed,
+    std::uint64_t tokens);
+
 /**
  * Configuration for the OpenRouter client.
  */
@@ -28,8 +71,82 @@ struct OpenRouterClientConfig
     MaxTokens max_tokens;
     std::optional<SystemPrompt> system_prompt;
     std::optional<Temperature> temperature;
+    PromptCaching prompt_caching{};
+
+    /// API base URL; chat completions are posted to
+    /// "<path_prefix>/chat/completions".
+    HttpEndpoint endpoint{
+        .scheme = HttpScheme::https,
+        .host = Hostname{"openrouter.ai"},
+        .port = PortNumber{443},
+        .path_prefix = "/api/v1"};
+
+    /// Optional response cache consulted before every API request
+    /// with temperature 0; others always go to the API.
+    std::shared_ptr<ResponseCache> response_cache{};
+
+    /// Retry limits and backoff for transient API failures.
+    RetryPolicyConfig retry{};
+
+    /// Hedge slow requests with a duplicate; disabled when empty.
+    std::optional<HedgeConfig> hedge{};
+
+    /// Request and token limiter, shared by every client of the same
+    /// account; unlimited when null.
+    std::shared_ptr<RateLimiter> rate_limiter{};
+
+    /// Endpoint health tracking; calls are never refused when null.
+    std::shared_ptr<CircuitBreaker> circuit_breaker{};
+
+    /// Keep-alive connections shared with other clients; the client
+    /// keeps its own when null.
+    std::shared_ptr<ConnectionPool> connection_pool{};
+
+    /// Host serving the same API, reached with the endpoint's scheme,
+    /// port and path prefix while the endpoint's circuit is open.
+    std::optional<Hostname> fallback_host{};
+
+    /// Open and keep alive a connection to the endpoint while the user
+    /// is typing, instead of connecting when the request is sent.
+    PrewarmConnections prewarm{};
+
+    /// Models to fail over between; just `model` when empty.
+    RouterConfig routing{};
+
+    /// OpenRouter provider preferences sent with every request.
+    ProviderPreferences provider{};
+
+    /// Model for turns sent with ModelTier::fast; the routed models
+    /// remain its fallbacks.  Every turn uses the routed models when
+    /// empty.
+    std::optional<ModelId> fast_model{};
+
+    /// When the agent loop stops calling tools and answers.
+    AgentLimits limits{};
+
+    /// Which tool calls run without asking; the dispatcher's default
+    /// (ask about all but read-only calls) when null.
+    std::shared_ptr<tools::ApprovalPolicy const> tool_policy{};
+
+    /// Workspace changes that invalidate cached tool results, shared
+    /// with other clients; cached file reads are stat'ed on every hit
+    /// when null.
+    std::shared_ptr<tools::FileWatcher> file_watcher{};
+
+    /// Limits on the processes tools start; each client confines its
+    /// own in a Sandbox of its own, unless there are none.
+    tools::SandboxLimits sandbox{};
 };
 
+/**
+ * Parse the `usage` object of an OpenAI-format response.
+ *
+ * Prompt-cache counters are read from `prompt_tokens_details`
+ * (OpenRouter) or the Anthropic-native `cache_*_input_tokens` fields.
+ */
+[[nodiscard]]
+TokenUsage parse_token_usage(nlohmann::json const & usage);
+
 /**
  * Client for the OpenRouter API.
  *
@@ -43,7 +160,7 @@ public:
     explicit OpenRouterClient(OpenRouterClientConfig config);
 
     /**
-     * Get the current model being used.
+     * Get the configured (preferred) model.
      */
     [[nodiscard]]
     ModelId const & model() const
@@ -53,10 +170,23 @@ public:
 
 private:
     Result<ChatResponse> do_send_message(
-        conversation::Conversation const & conversation) override;
+        conversation::Conversation const & conversation,
+        std::stop_token stop,
+        ModelTier tier) override;
+
+    void do_report_stats(std::ostream & out) const override;
+
+    void do_report_status(std::ostream & out) const override;
+
+    void do_warm_up() override;
 
     OpenRouterClientConfig config_;
     HttpClient http_client_;
+    std::shared_ptr<RetryPolicy> retry_policy_;
+    std::shared_ptr<NetworkStats> network_stats_;
+    std::shared_ptr<HedgePolicy> hedge_policy_;
+    std::shared_ptr<ModelRouter> router_;
+    tools::ToolDispatcher tool_dispatcher_;
 
     /**
      * Build request JSON in OpenAI format.
@@ -70,12 +200,40 @@ private:
     Result<ChatResponse> parse_response(
         nlohmann::json const & json) const;
 
+    /**
+     * Whether a failed request might succeed with another model.
+     */
+    enum class Failure
+    {
+        model, ///< Transport, timeout, 404, 429 or 5xx: try another.
+        request ///< Key, credits, a bad request, or offline: give up.
+    };
+
     /**
      * Send a JSON request to the API and return parsed
-     * response JSON.
+     * response JSON.  Consults the response cache, if any.
+     * @p stop abandons the rate-limiter wait or the request.
+     * @p timing, if given, receives the timing of a response that
+     * came over the network; it is left untouched for a cached one.
+     * @p failure, if given, receives the kind of a failure.
      */
     Result<nlohmann::json> send_api_request(
-        nlohmann::json const & request);
+        nlohmann::json const & request,
+        std::stop_token stop,
+        HttpTiming * timing = nullptr,
+        Failure * failure = nullptr);
+
+    /**
+     * send_api_request() to each of the router's candidate models in
+     * turn, until one succeeds; for ModelTier::fast, the fast model is
+     * tried first.  Only a Failure::model moves on to the next model
+     * and counts against the one that failed; any other failure is
+     * returned as it is, since every model would fail it the same way.
+     */
+    Result<nlohmann::json> send_routed(
+        nlohmann::json request,
+        std::stop_token stop,
+        ModelTier tier);
 
     /**
      * Convert messages to OpenAI format.
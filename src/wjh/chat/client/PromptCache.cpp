@@ -0,0 +1,87 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/PromptCache.hpp"
+
+#include <string>
+
+namespace wjh::chat::client {
+
+namespace {
+
+nlohmann::json
+cache_marker()
+{
+    return {{"type", "ephemeral"}};
+}
+
+/// Attach a marker to a message's content, converting plain string
+/// content to a one-element text block array.  Returns false if the
+/// message has no text content that can carry a marker.
+bool
+mark_content(nlohmann::json & message)
+{
+    if (not message.is_object() or not message.contains("content")) {
+        return false;
+    }
+
+    auto & content = message["content"];
+    if (content.is_string()) {
+        auto text = content.get<std::string>();
+        if (text.empty()) {
+            return false;
+        }
+        content = nlohmann::json::array({
+            {{"type", "text"},
+             {"text", std::move(text)},
+             {"cache_control", cache_marker()}}});
+        return true;
+    }
+
+    if (content.is_array() and not content.empty()
+        and content.back().is_object())
+    {
+        content.back()["cache_control"] = cache_marker();
+        return true;
+    }
+
+    return false;
+}
+
+} // anonymous namespace
+
+void
+add_cache_breakpoints(nlohmann::json & request)
+{
+    if (request.contains("tools") and request["tools"].is_array()
+        and not request["tools"].empty())
+    {
+        request["tools"].back()["cache_control"] = cache_marker();
+    }
+
+    if (not request.contains("messages")
+        or not request["messages"].is_array())
+    {
+        return;
+    }
+
+    auto & messages = request["messages"];
+    std::size_t first = 0;
+    if (not messages.empty() and messages[0].value("role", "") == "system")
+    {
+        mark_content(messages[0]);
+        first = 1;
+    }
+
+    // Rolling checkpoint: the newest message that can carry a marker.
+    for (auto i = messages.size(); i > first; --i) {
+        if (mark_content(messages[i - 1])) {
+            break;
+        }
+    }
+}
+
+} // namespace wjh::chat::client
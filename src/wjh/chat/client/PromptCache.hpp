@@ -0,0 +1,34 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_8C2F4E61B7D94A0E9F3A5D12C6B87E40
+#define WJH_CHAT_8C2F4E61B7D94A0E9F3A5D12C6B87E40
+
+#include <nlohmann/json.hpp>
+
+namespace wjh::chat::client {
+
+/**
+ * Insert prompt-cache breakpoints into an OpenAI-format request.
+ *
+ * Marks the stable prefix boundaries with Anthropic-style
+ * `cache_control` markers, which OpenRouter forwards to providers
+ * that support explicit caching:
+ *   1. the last tool definition,
+ *   2. the system message,
+ *   3. the last message with text content (the rolling history
+ *      checkpoint that the next request reads back from the cache).
+ *
+ * String content is rewritten as a single text block so that it can
+ * carry a marker; the provider sees identical text either way.  Only
+ * the given request is modified, so callers that keep their message
+ * list separately preserve a byte-stable prefix across iterations.
+ */
+void add_cache_breakpoints(nlohmann::json & request);
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_8C2F4E61B7D94A0E9F3A5D12C6B87E40
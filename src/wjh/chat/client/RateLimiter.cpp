@@ -0,0 +1,271 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/RateLimiter.hpp"
+
+#include "wjh/chat/client/RetryPolicy.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::client {
+
+namespace {
+
+std::optional<std::uint32_t>
+header_count(HttpHeaders const & headers, std::string_view name)
+{
+    auto const value = headers.find(name);
+    if (not value) {
+        return std::nullopt;
+    }
+    std::uint32_t result = 0;
+    auto const * end = value->data() + value->size();
+    auto [ptr, ec] = std::from_chars(value->data(), end, result);
+    if (ec != std::errc{} or ptr != end) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::string
+describe_limit(std::uint32_t limit, std::string_view unit)
+{
+    return limit == 0u
+        ? std::format("unlimited {}", unit)
+        : std::format("{} {}", limit, unit);
+}
+
+} // anonymous namespace
+
+RateLimiter::
+RateLimiter(RateLimiterConfig config)
+: config_(config)
+, requests_{
+      .capacity = static_cast<double>(config.requests),
+      .level = static_cast<double>(config.requests)}
+, tokens_{
+      .capacity = static_cast<double>(config.tokens),
+      .level = static_cast<double>(config.tokens)}
+, refilled_(Clock::now())
+, blocked_until_(refilled_)
+{ }
+
+void
+RateLimiter::
+refill(Clock::time_point now)
+{
+    auto const fraction =
+        std::chrono::duration<double>(now - refilled_).count()
+        / std::chrono::duration<double>(config_.window).count();
+    for (auto * bucket : {&requests_, &tokens_}) {
+        bucket->level = std::min(
+            bucket->capacity,
+            bucket->level + bucket->capacity * fraction);
+    }
+    refilled_ = now;
+}
+
+RateLimiter::Clock::duration
+RateLimiter::
+shortfall(std::uint32_t tokens, Clock::time_point now) const
+{
+    auto wait = std::max(Clock::duration::zero(), blocked_until_ - now);
+    auto const need = [&](Bucket const & bucket, double amount) {
+        if (bucket.capacity <= 0.0) {
+            return;
+        }
+        // A single request larger than the whole bucket only waits
+        // for a full bucket.
+        auto const deficit = std::min(amount, bucket.capacity) - bucket.level;
+        if (deficit > 0.0) {
+            wait = std::max(
+                wait,
+                std::chrono::duration_cast<Clock::duration>(
+                    config_.window * (deficit / bucket.capacity)));
+        }
+    };
+    need(requests_, 1.0);
+    need(tokens_, static_cast<double>(tokens));
+    return wait;
+}
+
+void
+RateLimiter::
+advance()
+{
+    ++serving_;
+    while (abandoned_.erase(serving_) > 0) {
+        ++serving_;
+    }
+    cv_.notify_all();
+}
+
+bool
+RateLimiter::
+acquire(std::uint32_t tokens, std::stop_token stop)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto const ticket = next_ticket_++;
+    auto const arrived = Clock::now();
+
+    while (not stop.stop_requested()) {
+        if (serving_ != ticket) {
+            cv_.wait(lock, stop, [&] { return serving_ == ticket; });
+            continue;
+        }
+
+        auto const now = Clock::now();
+        refill(now);
+        auto const wait = shortfall(tokens, now);
+        if (wait <= Clock::duration::zero()) {
+            if (requests_.capacity > 0.0) {
+                requests_.level -= 1.0;
+            }
+            if (tokens_.capacity > 0.0) {
+                tokens_.level -= std::min(
+                    static_cast<double>(tokens), tokens_.capacity);
+            }
+
+            auto const waited =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now - arrived);
+            ++stats_.requests;
+            if (waited.count() > 0) {
+                ++stats_.delayed;
+                stats_.waited += waited;
+            }
+            advance();
+            return true;
+        }
+
+        auto const seen = generation_;
+        cv_.wait_for(lock, stop, wait, [&] { return generation_ != seen; });
+    }
+
+    if (serving_ == ticket) {
+        advance();
+    } else {
+        abandoned_.insert(ticket);
+    }
+    return false;
+}
+
+void
+RateLimiter::
+reconcile(std::uint32_t estimated, std::uint32_t actual)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto const error = static_cast<std::int64_t>(actual)
+        - static_cast<std::int64_t>(estimated);
+    stats_.estimate_error += error;
+    if (tokens_.capacity > 0.0) {
+        tokens_.level = std::min(
+            tokens_.capacity,
+            tokens_.level - static_cast<double>(error));
+    }
+    ++generation_;
+    cv_.notify_all();
+}
+
+void
+RateLimiter::
+learn(HttpHeaders const & headers)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto const now = Clock::now();
+    refill(now);
+
+    auto const update = [&](
+                            Bucket & bucket,
+                            std::uint32_t configured,
+                            std::string_view limit_header,
+                            std::string_view remaining_header) {
+        if (configured == 0u) {
+            if (auto const limit = header_count(headers, limit_header)) {
+                if (bucket.capacity <= 0.0) {
+                    bucket.level = *limit;
+                }
+                bucket.capacity = *limit;
+            }
+        }
+        if (auto const remaining = header_count(headers, remaining_header)) {
+            if (bucket.capacity > 0.0) {
+                bucket.level = std::min(
+                    bucket.level, static_cast<double>(*remaining));
+            }
+        }
+    };
+    update(
+        requests_,
+        config_.requests,
+        "x-ratelimit-limit-requests",
+        "x-ratelimit-remaining-requests");
+    update(
+        tokens_,
+        config_.tokens,
+        "x-ratelimit-limit-tokens",
+        "x-ratelimit-remaining-tokens");
+
+    // Retry-After, or the reset of whichever limit is exhausted.
+    if (auto const delay = server_retry_delay(headers)) {
+        blocked_until_ = std::max(
+            blocked_until_,
+            now + std::chrono::duration_cast<Clock::duration>(*delay));
+    }
+
+    ++generation_;
+    cv_.notify_all();
+}
+
+std::pair<std::uint32_t, std::uint32_t>
+RateLimiter::
+limits() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return {
+        static_cast<std::uint32_t>(requests_.capacity),
+        static_cast<std::uint32_t>(tokens_.capacity)};
+}
+
+RateLimiterStats
+RateLimiter::
+stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void
+RateLimiter::
+report(std::ostream & out) const
+{
+    auto const s = stats();
+    if (s.requests == 0) {
+        return;
+    }
+    auto const [requests, tokens] = limits();
+
+    out << std::format(
+        "Rate limiter:\n"
+        "  Limits:     {}, {} per {} s\n"
+        "  Delayed:    {} of {} requests ({} ms waiting)\n"
+        "  Estimates:  {:+} tokens off in total\n",
+        describe_limit(requests, "requests"),
+        describe_limit(tokens, "tokens"),
+        std::chrono::duration_cast<std::chrono::seconds>(config_.window)
+            .count(),
+        s.delayed,
+        s.requests,
+        s.waited.count(),
+        s.estimate_error);
+}
+
+} // namespace wjh::chat::client
@@ -0,0 +1,140 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_3F8C2B7D6E1A4C59B0D47A9E2C5F1B83
+#define WJH_CHAT_3F8C2B7D6E1A4C59B0D47A9E2C5F1B83
+
+#include "wjh/chat/client/HttpClient.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <stop_token>
+#include <utility>
+
+namespace wjh::chat::client {
+
+/**
+ * Configuration for the rate limiter.
+ */
+struct RateLimiterConfig
+{
+    /// Requests allowed per window; 0 means unlimited until learned.
+    std::uint32_t requests = 0;
+
+    /// Tokens allowed per window; 0 means unlimited until learned.
+    std::uint32_t tokens = 0;
+
+    /// Period the limits apply to.
+    std::chrono::milliseconds window{60'000};
+};
+
+/**
+ * Counters reported by RateLimiter::stats().
+ */
+struct RateLimiterStats
+{
+    std::size_t requests = 0;
+
+    /// Requests that had to wait for capacity.
+    std::size_t delayed = 0;
+
+    /// Total time requests spent waiting.
+    std::chrono::milliseconds waited{0};
+
+    /// Sum of (actual - estimated) tokens over reconciled requests.
+    std::int64_t estimate_error = 0;
+};
+
+/**
+ * Client-side token buckets for requests and tokens per window.
+ *
+ * Callers acquire() capacity for an estimated token count before each
+ * request and reconcile() the estimate against the usage the API
+ * reports.  Waiters are served strictly in arrival order, so one busy
+ * session cannot starve the others sharing the limiter.
+ *
+ * Limits not set in the configuration are learned from
+ * `x-ratelimit-limit-{requests,tokens}` response headers, and an
+ * exhausted `x-ratelimit-remaining*` blocks everyone until the
+ * matching reset.
+ *
+ * All member functions are thread-safe.
+ */
+class RateLimiter
+{
+public:
+    explicit RateLimiter(RateLimiterConfig config = {});
+
+    /**
+     * Block until one request and @p tokens tokens are available.
+     * @return false if @p stop was requested while waiting
+     */
+    [[nodiscard]]
+    bool acquire(std::uint32_t tokens, std::stop_token stop = {});
+
+    /**
+     * Correct the token bucket once the actual usage is known.
+     */
+    void reconcile(std::uint32_t estimated, std::uint32_t actual);
+
+    /**
+     * Update limits and remaining capacity from response headers.
+     */
+    void learn(HttpHeaders const & headers);
+
+    /**
+     * Current (requests, tokens) limits; 0 means unlimited.
+     */
+    [[nodiscard]]
+    std::pair<std::uint32_t, std::uint32_t> limits() const;
+
+    [[nodiscard]]
+    RateLimiterStats stats() const;
+
+    /**
+     * Print limits, delays, and estimate accuracy.
+     */
+    void report(std::ostream & out) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Bucket
+    {
+        double capacity = 0.0;
+        double level = 0.0;
+    };
+
+    void refill(Clock::time_point now);
+    [[nodiscard]]
+    Clock::duration shortfall(std::uint32_t tokens, Clock::time_point now)
+        const;
+    void advance();
+
+    RateLimiterConfig config_;
+    mutable std::mutex mutex_;
+    std::condition_variable_any cv_;
+    Bucket requests_;
+    Bucket tokens_;
+    Clock::time_point refilled_;
+    Clock::time_point blocked_until_;
+    std::uint64_t next_ticket_ = 0;
+    std::uint64_t serving_ = 0;
+    std::set<std::uint64_t> abandoned_;
+
+    /// Bumped whenever capacity changes other than by refilling.
+    std::uint64_t generation_ = 0;
+    RateLimiterStats stats_;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_3F8C2B7D6E1A4C59B0D47A9E2C5F1B83
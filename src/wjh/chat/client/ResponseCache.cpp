@@ -0,0 +1,313 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/ResponseCache.hpp"
+
+#include "wjh/chat/tools/Tools.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace wjh::chat::client {
+
+namespace {
+
+/// FNV-1a, 64-bit.
+std::uint64_t
+fnv1a(std::string_view data)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (auto c : data) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+} // anonymous namespace
+
+ResponseCache::
+ResponseCache(ResponseCacheConfig config)
+: config_(std::move(config))
+{
+    if (config_.directory) {
+        std::error_code ec;
+        std::filesystem::create_directories(*config_.directory, ec);
+        enforce_disk_limit();
+    }
+}
+
+std::string
+ResponseCache::
+key_for(std::string_view canonical_request)
+{
+    return std::format(
+        "{:016x}{:08x}",
+        fnv1a(canonical_request),
+        static_cast<std::uint32_t>(canonical_request.size()));
+}
+
+std::optional<std::string>
+ResponseCache::
+lookup(std::string const & key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (auto it = index_.find(key); it != index_.end()) {
+        auto entry = it->second;
+        if (not expired(entry->stored_at)) {
+            lru_.splice(lru_.begin(), lru_, entry);
+            ++stats_.memory_hits;
+            stats_.saved_latency += entry->latency;
+            return entry->body;
+        }
+        lru_.erase(entry);
+        index_.erase(it);
+    }
+
+    if (auto entry = read_disk(key)) {
+        ++stats_.disk_hits;
+        stats_.saved_latency += entry->latency;
+        auto body = entry->body;
+        insert_memory(std::move(*entry));
+        return body;
+    }
+
+    ++stats_.misses;
+    return std::nullopt;
+}
+
+void
+ResponseCache::
+store(
+    std::string const & key,
+    std::string body,
+    std::chrono::milliseconds latency)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto entry = Entry{
+        .key = key,
+        .body = std::move(body),
+        .latency = latency,
+        .stored_at = Clock::now()};
+    write_disk(entry);
+    insert_memory(std::move(entry));
+    ++stats_.stores;
+}
+
+ResponseCacheStats
+ResponseCache::
+stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void
+ResponseCache::
+report(std::ostream & out) const
+{
+    auto const s = stats();
+    auto const hits = s.memory_hits + s.disk_hits;
+    auto const lookups = hits + s.misses;
+    auto const rate = lookups == 0
+        ? 0.0
+        : 100.0 * static_cast<double>(hits) / static_cast<double>(lookups);
+
+    out << std::format(
+        "Response cache{}:\n"
+        "  Hit rate:   {:.1f}% ({} memory + {} disk of {} lookups)\n"
+        "  Stored:     {} ({} evicted)\n"
+        "  Saved:      {} ms of request latency\n",
+        config_.offline ? " (offline)" : "",
+        rate,
+        s.memory_hits,
+        s.disk_hits,
+        lookups,
+        s.stores,
+        s.evictions,
+        s.saved_latency.count());
+}
+
+void
+ResponseCache::
+insert_memory(Entry entry)
+{
+    if (config_.memory_entries == 0) {
+        return;
+    }
+
+    if (auto it = index_.find(entry.key); it != index_.end()) {
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+
+    lru_.push_front(std::move(entry));
+    index_[lru_.front().key] = lru_.begin();
+
+    while (lru_.size() > config_.memory_entries) {
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+        ++stats_.evictions;
+    }
+}
+
+std::optional<ResponseCache::Entry>
+ResponseCache::
+read_disk(std::string const & key)
+{
+    if (not config_.directory) {
+        return std::nullopt;
+    }
+
+    auto const path = *config_.directory / (key + ".json");
+    std::ifstream file(path);
+    if (not file) {
+        return std::nullopt;
+    }
+
+    try {
+        auto const json = nlohmann::json::parse(file);
+        auto entry = Entry{
+            .key = key,
+            .body = json.at("body").get<std::string>(),
+            .latency = std::chrono::milliseconds{
+                json.at("latency_ms").get<std::int64_t>()},
+            .stored_at = Clock::time_point{std::chrono::seconds{
+                json.at("stored_at").get<std::int64_t>()}}};
+        if (not expired(entry.stored_at)) {
+            return entry;
+        }
+    } catch (nlohmann::json::exception const &) {
+        // Corrupt entry: drop it below.
+    }
+
+    file.close();
+    std::error_code ec;
+    auto const size = std::filesystem::file_size(path, ec);
+    auto const sized = not ec;
+    if (std::filesystem::remove(path, ec) and sized) {
+        disk_bytes_ -= std::min(disk_bytes_, size);
+    }
+    return std::nullopt;
+}
+
+void
+ResponseCache::
+write_disk(Entry const & entry)
+{
+    if (not config_.directory) {
+        return;
+    }
+
+    auto const json = nlohmann::json{
+        {"body", entry.body},
+        {"latency_ms", entry.latency.count()},
+        {"stored_at",
+         std::chrono::duration_cast<std::chrono::seconds>(
+             entry.stored_at.time_since_epoch())
+             .count()}};
+
+    // Write to a temporary and rename so readers never see a torn file;
+    // the temporary is this call's own, so processes sharing the
+    // directory cannot write into each other's.
+    auto const path = *config_.directory / (entry.key + ".json");
+    auto const claimed = tools::claim_temp_file(path);
+    if (not claimed) {
+        return;
+    }
+    auto const & tmp = *claimed;
+    auto const text = json.dump();
+    std::error_code ec;
+    {
+        std::ofstream file(tmp, std::ios::trunc);
+        file << text;
+        file.flush();
+        if (not file.good()) {
+            std::filesystem::remove(tmp, ec);
+            return;
+        }
+    }
+
+    auto const replaced = std::filesystem::file_size(path, ec);
+    auto const old_size = ec ? 0 : replaced;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return;
+    }
+
+    disk_bytes_ = disk_bytes_ - std::min(disk_bytes_, old_size) + text.size();
+    if (disk_bytes_ > config_.max_disk_bytes) {
+        enforce_disk_limit();
+    }
+}
+
+void
+ResponseCache::
+enforce_disk_limit()
+{
+    struct FileInfo
+    {
+        std::filesystem::path path;
+        std::uintmax_t size;
+        std::filesystem::file_time_type mtime;
+    };
+
+    std::vector<FileInfo> files;
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for (auto const & de :
+         std::filesystem::directory_iterator(*config_.directory, ec))
+    {
+        if (de.path().extension() != ".json") {
+            continue;
+        }
+        auto size = de.file_size(ec);
+        if (ec) {
+            continue;
+        }
+        files.push_back({de.path(), size, de.last_write_time(ec)});
+        total += size;
+    }
+
+    // Also picks up what other processes sharing the directory wrote.
+    disk_bytes_ = total;
+    if (total <= config_.max_disk_bytes) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](auto const & a, auto const & b) {
+        return a.mtime < b.mtime;
+    });
+    for (auto const & f : files) {
+        if (total <= config_.max_disk_bytes) {
+            break;
+        }
+        if (std::filesystem::remove(f.path, ec)) {
+            total -= f.size;
+            ++stats_.evictions;
+        }
+    }
+    disk_bytes_ = total;
+}
+
+bool
+ResponseCache::
+expired(Clock::time_point stored_at) const
+{
+    return Clock::now() - stored_at > config_.ttl;
+}
+
+} // namespace wjh::chat::client
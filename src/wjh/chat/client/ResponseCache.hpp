@@ -0,0 +1,142 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_5A7E0C93D14B4F6A8E2B9C61F03D7A28
+#define WJH_CHAT_5A7E0C93D14B4F6A8E2B9C61F03D7A28
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace wjh::chat::client {
+
+/**
+ * Configuration for the response cache.
+ */
+struct ResponseCacheConfig
+{
+    /// Directory for the on-disk tier; memory-only when empty.
+    std::optional<std::filesystem::path> directory{};
+
+    /// Maximum number of entries held in the in-memory LRU tier.
+    std::size_t memory_entries = 128;
+
+    /// Entries older than this are treated as misses and removed.
+    std::chrono::seconds ttl = std::chrono::hours{24};
+
+    /// Upper bound on the total size of the on-disk tier.
+    std::uintmax_t max_disk_bytes = 512u * 1024u * 1024u;
+
+    /// Fail fast on a miss instead of contacting the API.
+    bool offline = false;
+};
+
+/**
+ * Counters reported by ResponseCache::stats().
+ */
+struct ResponseCacheStats
+{
+    std::size_t memory_hits = 0;
+    std::size_t disk_hits = 0;
+    std::size_t misses = 0;
+    std::size_t stores = 0;
+    std::size_t evictions = 0;
+
+    /// Sum of the original request latencies of every cache hit.
+    std::chrono::milliseconds saved_latency{0};
+};
+
+/**
+ * Content-addressed cache of raw API response bodies.
+ *
+ * Keys are a fast 64-bit hash of the canonical serialized request
+ * (nlohmann::json::dump() emits object keys in sorted order), so
+ * byte-identical requests map to the same entry.  Lookups go to an
+ * in-memory LRU tier first and then to one-file-per-entry storage on
+ * disk; disk hits are promoted into memory.
+ *
+ * All member functions are thread-safe.
+ */
+class ResponseCache
+{
+public:
+    explicit ResponseCache(ResponseCacheConfig config);
+
+    /**
+     * Compute the cache key for a canonical serialized request.
+     */
+    [[nodiscard]]
+    static std::string key_for(std::string_view canonical_request);
+
+    /**
+     * Look up a response body, counting a hit or a miss.
+     */
+    [[nodiscard]]
+    std::optional<std::string> lookup(std::string const & key);
+
+    /**
+     * Store a response body along with the latency it took to fetch.
+     */
+    void store(
+        std::string const & key,
+        std::string body,
+        std::chrono::milliseconds latency);
+
+    [[nodiscard]]
+    bool offline() const
+    {
+        return config_.offline;
+    }
+
+    [[nodiscard]]
+    ResponseCacheStats stats() const;
+
+    /**
+     * Print hit rate and saved latency.
+     */
+    void report(std::ostream & out) const;
+
+private:
+    using Clock = std::chrono::system_clock;
+
+    struct Entry
+    {
+        std::string key;
+        std::string body;
+        std::chrono::milliseconds latency;
+        Clock::time_point stored_at;
+    };
+
+    void insert_memory(Entry entry);
+    std::optional<Entry> read_disk(std::string const & key);
+    void write_disk(Entry const & entry);
+    void enforce_disk_limit();
+    [[nodiscard]]
+    bool expired(Clock::time_point stored_at) const;
+
+    ResponseCacheConfig config_;
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    ResponseCacheStats stats_;
+
+    /// Size of the disk tier: counted by enforce_disk_limit(), which
+    /// only runs again once this cache's own writes take it over the
+    /// limit.
+    std::uintmax_t disk_bytes_ = 0;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_5A7E0C93D14B4F6A8E2B9C61F03D7A28
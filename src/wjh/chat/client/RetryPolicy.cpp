@@ -0,0 +1,307 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/client/RetryPolicy.hpp"
+
+#include "wjh/chat/json_convert.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <ctime>
+#include <format>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace wjh::chat::client {
+
+namespace {
+
+using std::chrono::milliseconds;
+
+std::string_view
+trim(std::string_view s)
+{
+    auto const first = s.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    auto const last = s.find_last_not_of(" \t");
+    return s.substr(first, last - first + 1);
+}
+
+std::optional<double>
+parse_number(std::string_view s)
+{
+    double value = 0.0;
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (ec != std::errc{} or ptr != s.data() + s.size() or value < 0.0) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+milliseconds
+from_seconds(double seconds)
+{
+    return milliseconds{static_cast<milliseconds::rep>(seconds * 1000.0)};
+}
+
+milliseconds
+until(std::chrono::system_clock::time_point when,
+      std::chrono::system_clock::time_point now)
+{
+    return std::max(
+        milliseconds{0},
+        std::chrono::duration_cast<milliseconds>(when - now));
+}
+
+/// RFC 9110 IMF-fixdate, e.g. "Wed, 21 Oct 2015 07:28:00 GMT".
+std::optional<std::chrono::system_clock::time_point>
+parse_http_date(std::string_view s)
+{
+    std::tm tm{};
+    std::istringstream in{std::string(s)};
+    in >> std::get_time(&tm, "%a, %d %b %Y %H:%M:%S");
+    if (in.fail()) {
+        return std::nullopt;
+    }
+    return std::chrono::system_clock::from_time_t(timegm(&tm));
+}
+
+/// Go-style duration as sent by OpenAI, e.g. "6m0s", "1.5s", "20ms".
+std::optional<milliseconds>
+parse_duration(std::string_view s)
+{
+    double total = 0.0;
+    while (not s.empty()) {
+        auto const unit = s.find_first_not_of("0123456789.");
+        if (unit == 0 or unit == std::string_view::npos) {
+            return std::nullopt;
+        }
+        auto const value = parse_number(s.substr(0, unit));
+        if (not value) {
+            return std::nullopt;
+        }
+        s.remove_prefix(unit);
+        if (s.starts_with("ms")) {
+            total += *value / 1000.0;
+            s.remove_prefix(2);
+        } else if (s.starts_with('h')) {
+            total += *value * 3600.0;
+            s.remove_prefix(1);
+        } else if (s.starts_with('m')) {
+            total += *value * 60.0;
+            s.remove_prefix(1);
+        } else if (s.starts_with('s')) {
+            total += *value;
+            s.remove_prefix(1);
+        } else {
+            return std::nullopt;
+        }
+    }
+    return from_seconds(total);
+}
+
+/// An `x-ratelimit-reset*` value: an epoch timestamp in milliseconds
+/// or seconds (OpenRouter), a number of seconds, or a duration.
+std::optional<milliseconds>
+parse_reset(std::string_view s, std::chrono::system_clock::time_point now)
+{
+    if (auto const value = parse_number(s)) {
+        using namespace std::chrono;
+        if (*value >= 1e12) {
+            return until(
+                system_clock::time_point{
+                    milliseconds{static_cast<milliseconds::rep>(*value)}},
+                now);
+        }
+        if (*value >= 1e9) {
+            return until(
+                system_clock::time_point{
+                    seconds{static_cast<seconds::rep>(*value)}},
+                now);
+        }
+        return from_seconds(*value);
+    }
+    return parse_duration(s);
+}
+
+} // anonymous namespace
+
+ErrorClass
+classify_status(HttpStatusCode status)
+{
+    auto const code = json_value(status);
+    if (code < 400) {
+        return ErrorClass::none;
+    }
+    switch (code) {
+    case 408: // Request Timeout
+    case 425: // Too Early
+    case 429: // Too Many Requests
+    case 500:
+    case 502:
+    case 503:
+    case 504:
+        return ErrorClass::retryable;
+    default:
+        // Cloudflare-style origin errors; 529 is Anthropic "overloaded".
+        return code >= 520 and code <= 529
+            ? ErrorClass::retryable
+            : ErrorClass::fatal;
+    }
+}
+
+std::optional<milliseconds>
+server_retry_delay(
+    HttpHeaders const & headers,
+    std::chrono::system_clock::time_point now)
+{
+    if (auto const value = headers.find("retry-after-ms")) {
+        if (auto const ms = parse_number(trim(*value))) {
+            return milliseconds{static_cast<milliseconds::rep>(*ms)};
+        }
+    }
+
+    if (auto const value = headers.find("retry-after")) {
+        auto const text = trim(*value);
+        if (auto const seconds = parse_number(text)) {
+            return from_seconds(*seconds);
+        }
+        if (auto const when = parse_http_date(text)) {
+            return until(*when, now);
+        }
+    }
+
+    std::optional<milliseconds> result;
+    for (std::string_view suffix : {"", "-requests", "-tokens"}) {
+        auto const reset =
+            headers.find(std::format("x-ratelimit-reset{}", suffix));
+        if (not reset) {
+            continue;
+        }
+        auto const remaining =
+            headers.find(std::format("x-ratelimit-remaining{}", suffix));
+        if (remaining and trim(*remaining) != "0") {
+            continue;
+        }
+        if (auto const delay = parse_reset(trim(*reset), now)) {
+            result = std::max(result.value_or(milliseconds{0}), *delay);
+        }
+    }
+    return result;
+}
+
+RetryPolicy::
+RetryPolicy(RetryPolicyConfig config)
+: config_(std::move(config))
+, rng_(std::random_device{}())
+{
+    if (not config_.sleep) {
+        config_.sleep = [](milliseconds delay, std::stop_token stop) {
+            std::mutex mutex;
+            std::condition_variable_any never_notified;
+            std::unique_lock<std::mutex> lock(mutex);
+            never_notified.wait_for(lock, stop, delay, [] { return false; });
+        };
+    }
+}
+
+std::optional<milliseconds>
+RetryPolicy::
+next_delay(std::uint32_t retry, HttpHeaders const * headers)
+{
+    if (retry >= config_.max_retries) {
+        return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (budget_used_ >= config_.session_budget) {
+        ++stats_.budget_exhausted;
+        return std::nullopt;
+    }
+
+    auto delay = headers ? server_retry_delay(*headers) : std::nullopt;
+    if (delay) {
+        if (*delay > config_.max_delay) {
+            return std::nullopt;
+        }
+    } else {
+        auto const ceiling = retry >= 30
+            ? config_.max_delay
+            : std::min(
+                  config_.max_delay,
+                  config_.base_delay * (milliseconds::rep{1} << retry));
+        delay = milliseconds{
+            std::uniform_int_distribution<milliseconds::rep>(
+                0, ceiling.count())(rng_)};
+    }
+
+    ++budget_used_;
+    ++stats_.retries;
+    return delay;
+}
+
+bool
+RetryPolicy::
+wait(milliseconds delay, std::stop_token stop)
+{
+    config_.sleep(delay, stop);
+    if (stop.stop_requested()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.backoff += delay;
+    return true;
+}
+
+void
+RetryPolicy::
+record(std::uint32_t retries, bool succeeded)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.requests;
+    if (retries > 0) {
+        ++(succeeded ? stats_.recovered : stats_.gave_up);
+    }
+}
+
+RetryStats
+RetryPolicy::
+stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void
+RetryPolicy::
+report(std::ostream & out) const
+{
+    auto const s = stats();
+    if (s.requests == 0) {
+        return;
+    }
+
+    out << std::format(
+        "Retries:\n"
+        "  Requests:   {} ({} retried: {} recovered, {} gave up)\n"
+        "  Retries:    {} of {} budget ({} refused)\n"
+        "  Backoff:    {} ms\n",
+        s.requests,
+        s.recovered + s.gave_up,
+        s.recovered,
+        s.gave_up,
+        s.retries,
+        config_.session_budget,
+        s.budget_exhausted,
+        s.backoff.count());
+}
+
+} // namespace wjh::chat::client
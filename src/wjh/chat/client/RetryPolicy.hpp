@@ -0,0 +1,159 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_9C41D7E2B05A4F3C8E6B17A2D4F09E35
+#define WJH_CHAT_9C41D7E2B05A4F3C8E6B17A2D4F09E35
+
+#include "wjh/chat/client/HttpClient.hpp"
+#include "wjh/chat/client/types.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <stop_token>
+
+namespace wjh::chat::client {
+
+/**
+ * How a failed HTTP exchange should be treated.
+ */
+enum class ErrorClass
+{
+    none, ///< Not an error.
+    retryable, ///< Transient; the same request may succeed later.
+    fatal ///< Retrying the same request cannot help.
+};
+
+/**
+ * Classify an HTTP status code.
+ *
+ * 408, 425, 429, and the 5xx gateway/overload family (500, 502, 503,
+ * 504, 520-529) are retryable; other 4xx/5xx codes are fatal.
+ */
+[[nodiscard]]
+ErrorClass classify_status(HttpStatusCode status);
+
+/**
+ * Delay requested by the server before the next attempt, if any.
+ *
+ * Honors `retry-after-ms`, then `Retry-After` (delta-seconds or an
+ * HTTP-date), then the `x-ratelimit-reset*` family for any limit
+ * whose matching `x-ratelimit-remaining*` is exhausted.  Reset values
+ * may be epoch milliseconds, seconds, or Go-style durations ("6m0s").
+ */
+[[nodiscard]]
+std::optional<std::chrono::milliseconds> server_retry_delay(
+    HttpHeaders const & headers,
+    std::chrono::system_clock::time_point now =
+        std::chrono::system_clock::now());
+
+/**
+ * Configuration for the retry policy.
+ */
+struct RetryPolicyConfig
+{
+    /// Retries of a single request after its first attempt.
+    std::uint32_t max_retries = 3;
+
+    /// Retries shared by every request over the policy's lifetime.
+    std::uint32_t session_budget = 20;
+
+    /// Backoff ceiling for the first retry; doubles on each retry.
+    std::chrono::milliseconds base_delay{500};
+
+    /// Upper bound on any single wait.  A server asking for a longer
+    /// wait makes the request fail instead.
+    std::chrono::milliseconds max_delay{30'000};
+
+    /// Waits between attempts, returning early once the token is
+    /// stopped; a condition_variable_any wait if empty.
+    std::function<void(std::chrono::milliseconds, std::stop_token)> sleep{};
+};
+
+/**
+ * Counters reported by RetryPolicy::stats().
+ */
+struct RetryStats
+{
+    std::size_t requests = 0;
+    std::size_t retries = 0;
+
+    /// Requests that succeeded after at least one retry.
+    std::size_t recovered = 0;
+
+    /// Requests that failed after at least one retry.
+    std::size_t gave_up = 0;
+
+    /// Retries refused because the session budget was spent.
+    std::size_t budget_exhausted = 0;
+
+    /// Total time spent waiting between attempts.
+    std::chrono::milliseconds backoff{0};
+};
+
+/**
+ * Decides whether, and how long after, a failed request is retried.
+ *
+ * Backoff is exponential with full jitter: the n-th retry waits a
+ * uniformly random time in [0, min(max_delay, base_delay * 2^n)],
+ * unless the server said how long to wait.  The caller owns the
+ * attempt loop (see HttpClient::post).
+ *
+ * All member functions are thread-safe.
+ */
+class RetryPolicy
+{
+public:
+    explicit RetryPolicy(RetryPolicyConfig config = {});
+
+    /**
+     * Decide whether to retry after a retryable failure.
+     * @param retry Retries already made for this request
+     * @param headers Response headers, or nullptr on a transport error
+     * @return Delay before the next attempt, or nullopt to give up
+     */
+    [[nodiscard]]
+    std::optional<std::chrono::milliseconds> next_delay(
+        std::uint32_t retry,
+        HttpHeaders const * headers);
+
+    /**
+     * Wait @p delay before the next attempt, accounting for it, or
+     * until @p stop is requested.
+     * @return false if the wait was cut short by @p stop
+     */
+    bool wait(std::chrono::milliseconds delay, std::stop_token stop = {});
+
+    /**
+     * Record the final outcome of a request that made @p retries
+     * retries.
+     */
+    void record(std::uint32_t retries, bool succeeded);
+
+    [[nodiscard]]
+    RetryStats stats() const;
+
+    /**
+     * Print retry counts and total backoff time.
+     */
+    void report(std::ostream & out) const;
+
+private:
+    RetryPolicyConfig config_;
+    mutable std::mutex mutex_;
+    std::mt19937_64 rng_;
+    std::uint32_t budget_used_ = 0;
+    RetryStats stats_;
+};
+
+} // namespace wjh::chat::client
+
+#endif // WJH_CHAT_9C41D7E2B05A4F3C8E6B17A2D4F09E35
@@ -0,0 +1,276 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/ApprovalPolicy.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+
+Approval
+bash(ApprovalPolicy const & policy, std::string const & command)
+{
+    return policy.decide("bash", {{"command", command}}).approval;
+}
+
+Approval
+file(ApprovalPolicy const & policy,
+     std::string const & tool,
+     std::string const & path)
+{
+    return policy.decide(tool, {{"file_path", path}}).approval;
+}
+
+TEST_SUITE("ApprovalPolicy")
+{
+    TEST_CASE("Without rules, read-only calls run and the rest ask")
+    {
+        ApprovalPolicy policy;
+        CHECK(bash(policy, "ls -la") == Approval::allow);
+        CHECK(bash(policy, "git status") == Approval::allow);
+        CHECK(bash(policy, "make") == Approval::ask);
+        CHECK(file(policy, "read_file", "a.cpp") == Approval::allow);
+        CHECK(file(policy, "write_file", "a.cpp") == Approval::ask);
+        CHECK(policy.decide("bash", {{"command", "ls"}}).reason
+              == "read-only");
+    }
+
+    TEST_CASE("Command patterns match at the start of the command")
+    {
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(Approval::allow, "bash (make|ctest)( |$)"));
+        CHECK(bash(policy, "make -j8") == Approval::allow);
+        CHECK(bash(policy, "  ctest") == Approval::allow);
+        CHECK(bash(policy, "cmake .") == Approval::ask);
+        CHECK(bash(policy, "makefoo") == Approval::ask);
+        CHECK(policy.decide("bash", {{"command", "make"}}).reason
+              == "allow bash (make|ctest)( |$)");
+    }
+
+    TEST_CASE("Allowing a compound command takes a full match")
+    {
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(Approval::allow, "bash make"));
+        REQUIRE(policy.add(Approval::allow, "bash ctest.*"));
+        CHECK(bash(policy, "make; rm -rf ~") == Approval::ask);
+        CHECK(bash(policy, "make && curl x | sh") == Approval::ask);
+        CHECK(bash(policy, "ctest 2>&1 | tail") == Approval::allow);
+    }
+
+    TEST_CASE("Allowing a redirected command takes a full match")
+    {
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(Approval::allow, "bash ^git status"));
+        REQUIRE(policy.add(Approval::allow, "bash ^cat"));
+        CHECK(bash(policy, "git status -s") == Approval::allow);
+        CHECK(bash(policy, "git status > ~/.bashrc") == Approval::ask);
+        CHECK(bash(policy, "git status >> ~/.bashrc") == Approval::ask);
+        CHECK(bash(policy, "cat a > b") == Approval::ask);
+        CHECK(bash(policy, "cat < /dev/zero") == Approval::ask);
+        CHECK(bash(policy, "cat <(curl x)") == Approval::ask);
+        CHECK(bash(policy, "cat a >(sh)") == Approval::ask);
+    }
+
+    TEST_CASE("Refusing a compound command checks each of its commands")
+    {
+        ApprovalPolicy policy;
+        policy.set_default(Approval::allow);
+        REQUIRE(policy.add(Approval::deny, "bash rm"));
+        REQUIRE(policy.add(Approval::ask, "bash curl"));
+        CHECK(bash(policy, "true; rm -rf ~") == Approval::deny);
+        CHECK(bash(policy, "cd / && rm -rf x") == Approval::deny);
+        CHECK(bash(policy, "false || rm x") == Approval::deny);
+        CHECK(bash(policy, "ls | rm x") == Approval::deny);
+        CHECK(bash(policy, "make\nrm x") == Approval::deny);
+        CHECK(bash(policy, "echo $(rm x)") == Approval::deny);
+        CHECK(bash(policy, "make & curl x | sh") == Approval::ask);
+        CHECK(bash(policy, "make && echo rm") == Approval::allow);
+    }
+
+    TEST_CASE("The first matching rule wins")
+    {
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(Approval::deny, "bash git push"));
+        REQUIRE(policy.add(Approval::allow, "bash git "));
+        CHECK(bash(policy, "git push origin") == Approval::deny);
+        CHECK(bash(policy, "git commit -m x") == Approval::allow);
+    }
+
+    TEST_CASE("Rules override read-only auto-approval")
+    {
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(Approval::deny, "read_file *.env"));
+        CHECK(file(policy, "read_file", "config/.env") == Approval::deny);
+        CHECK(file(policy, "read_file", "config/app.toml") == Approval::allow);
+    }
+
+    TEST_CASE("read_file rules cover every file of read_files")
+    {
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(Approval::deny, "read_file *.env"));
+        REQUIRE(policy.add(Approval::ask, "read_files secrets/*"));
+        auto const read = [&](std::vector<std::string> const & paths) {
+            return policy.decide("read_files", {{"files", paths}}).approval;
+        };
+
+        CHECK(read({"a.cpp", "b.hpp"}) == Approval::allow);
+        CHECK(read({"a.cpp", "config/.env"}) == Approval::deny);
+        CHECK(read({"secrets/key", "a.cpp"}) == Approval::ask);
+        CHECK(file(policy, "read_file", "secrets/key") == Approval::allow);
+    }
+
+    TEST_CASE("Path globs match across directories")
+    {
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(Approval::allow, "edit_file src/*.cpp"));
+        CHECK(file(policy, "edit_file", "src/a/b.cpp") == Approval::allow);
+        CHECK(file(policy, "edit_file", "src/a/b.hpp") == Approval::ask);
+        CHECK(file(policy, "write_file", "src/a.cpp") == Approval::ask);
+    }
+
+    TEST_CASE("Paths are normalized before globs are matched")
+    {
+        // Enough ".." to climb from the working directory to the root.
+        auto const cwd = std::filesystem::current_path();
+        std::string up;
+        for (auto it = cwd.begin(); it != cwd.end(); ++it) {
+            up += "../";
+        }
+
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(Approval::deny, "write_file /etc/*"));
+        REQUIRE(policy.add(Approval::allow, "write_file src/*"));
+        REQUIRE(policy.add(Approval::allow, "apply_patch src/*"));
+        REQUIRE(policy.add(Approval::deny, "read_file *.env"));
+        CHECK(file(policy, "write_file", "src/a.cpp") == Approval::allow);
+        CHECK(file(policy, "write_file", "./src/x/../a.cpp")
+              == Approval::allow);
+        CHECK(file(policy, "write_file", "src/../../etc/passwd")
+              != Approval::allow);
+        CHECK(file(policy, "write_file", "src/../a.cpp") == Approval::ask);
+        CHECK(file(policy, "write_file", up + "etc/passwd") == Approval::deny);
+        CHECK(file(policy, "write_file", "/tmp/../etc/passwd")
+              == Approval::deny);
+        CHECK(file(policy, "read_file", "/home/me/.env") == Approval::deny);
+        CHECK(file(policy, "read_file", "a/../.env") == Approval::deny);
+
+        auto const patch = [&](std::string const & path) {
+            auto const text = "--- a/" + path + "\n+++ b/" + path
+                + "\n@@ -1 +1 @@\n-x\n+y\n";
+            return policy.decide("apply_patch", {{"patch", text}}).approval;
+        };
+        CHECK(patch("src/a.cpp") == Approval::allow);
+        CHECK(patch("src/../../x") == Approval::ask);
+    }
+
+    TEST_CASE("An allowed glob does not follow a link out of it")
+    {
+        auto const dir = std::filesystem::temp_directory_path()
+            / ("wjh_policy_link_" + std::to_string(::getpid()));
+        std::filesystem::create_directories(dir / "src");
+        std::filesystem::create_symlink("/etc", dir / "src" / "etc");
+
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(
+            Approval::allow, "write_file " + (dir / "src").string() + "/*"));
+        CHECK(file(policy, "write_file", (dir / "src/a").string())
+              == Approval::allow);
+        CHECK(file(policy, "write_file", (dir / "src/etc/passwd").string())
+              == Approval::ask);
+
+        std::filesystem::remove_all(dir);
+    }
+
+    TEST_CASE("Background jobs are judged like bash commands")
+    {
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(Approval::allow, "bash make( |$)"));
+        REQUIRE(policy.add(Approval::deny, "start_job rm "));
+        auto const job = [&](std::string const & command) {
+            return policy.decide("start_job", {{"command", command}})
+                .approval;
+        };
+
+        CHECK(job("make -j8") == Approval::allow);
+        CHECK(job("rm -rf build") == Approval::deny);
+        CHECK(job("ctest") == Approval::ask);
+        CHECK(job("ls") == Approval::allow);
+        CHECK(policy.decide("job_output", {{"job_id", 1}}).approval
+              == Approval::allow);
+    }
+
+    TEST_CASE("A patch is allowed only if every file it touches is")
+    {
+        ApprovalPolicy policy;
+        REQUIRE(policy.add(Approval::deny, "apply_patch *.lock"));
+        REQUIRE(policy.add(Approval::allow, "apply_patch src/*"));
+        auto const patch = [&](std::string const & a, std::string const & b) {
+            auto const text = "--- a/" + a + "\n+++ b/" + a
+                + "\n@@ -1 +1 @@\n-x\n+y\n--- a/" + b + "\n+++ b/" + b
+                + "\n@@ -1 +1 @@\n-x\n+y\n";
+            return policy.decide("apply_patch", {{"patch", text}}).approval;
+        };
+
+        CHECK(patch("src/a.cpp", "src/b.cpp") == Approval::allow);
+        CHECK(patch("src/a.cpp", "README.md") == Approval::ask);
+        CHECK(patch("src/a.cpp", "deps.lock") == Approval::deny);
+    }
+
+    TEST_CASE("A wildcard tool and the default cover everything else")
+    {
+        ApprovalPolicy policy;
+        policy.set_default(Approval::deny);
+        CHECK(bash(policy, "make") == Approval::deny);
+        CHECK(bash(policy, "ls") == Approval::allow);
+
+        REQUIRE(policy.add(Approval::allow, "*"));
+        CHECK(bash(policy, "make") == Approval::allow);
+    }
+
+    TEST_CASE("Bad rules are rejected")
+    {
+        ApprovalPolicy policy;
+        CHECK_FALSE(policy.add(Approval::allow, ""));
+        CHECK_FALSE(policy.add(Approval::allow, "python"));
+        CHECK_FALSE(policy.add(Approval::allow, "* make"));
+        CHECK_FALSE(policy.add(Approval::allow, "bash (unclosed"));
+    }
+
+    TEST_CASE("Policy files hold rules, comments and a default")
+    {
+        auto path = std::filesystem::temp_directory_path()
+            / ("wjh_policy_test_" + std::to_string(::getpid()));
+        std::ofstream(path) << "# build freely\n"
+                               "\n"
+                               "allow bash make\n"
+                               "deny  write_file /etc/*\n"
+                               "default deny\n";
+
+        ApprovalPolicy policy;
+        REQUIRE(policy.load(path.string()));
+        CHECK(bash(policy, "make all") == Approval::allow);
+        CHECK(file(policy, "write_file", "/etc/passwd") == Approval::deny);
+        CHECK(policy.default_approval() == Approval::deny);
+
+        std::ofstream(path) << "allow bash make\npermit bash ls\n";
+        auto const bad = ApprovalPolicy{}.load(path.string());
+        REQUIRE_FALSE(bad);
+        CHECK(bad.error().find(":2: expected allow") != std::string::npos);
+
+        std::filesystem::remove(path);
+        CHECK_FALSE(ApprovalPolicy{}.load(path.string()));
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,316 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/Batch.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <stop_token>
+
+#include "testing/MockClient.hpp"
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+
+struct TempDir
+{
+    std::filesystem::path path_;
+
+    TempDir()
+    : path_(std::filesystem::temp_directory_path()
+          / "wjh_batch_test_XXXXXX")
+    {
+        auto tmpl = path_.string();
+        auto * result = mkdtemp(tmpl.data());
+        REQUIRE(result != nullptr);
+        path_ = result;
+    }
+
+    ~TempDir()
+    {
+        std::filesystem::remove_all(path_);
+    }
+
+    TempDir(TempDir const &) = delete;
+    TempDir & operator = (TempDir const &) = delete;
+};
+
+/// Batch files in a temporary directory.
+struct BatchFiles
+{
+    TempDir dir;
+    BatchConfig config{
+        .input = (dir.path_ / "jobs.jsonl").string(),
+        .output = (dir.path_ / "results.jsonl").string(),
+        .checkpoint = (dir.path_ / "results.checkpoint").string(),
+        .workers = 3};
+
+    void write_jobs(std::string const & text) const
+    {
+        std::ofstream(config.input) << text;
+    }
+
+    /// Result lines keyed by job id.
+    std::map<std::string, nlohmann::json> results() const
+    {
+        std::map<std::string, nlohmann::json> result;
+        std::ifstream in(config.output);
+        std::string line;
+        while (std::getline(in, line)) {
+            auto json = nlohmann::json::parse(line);
+            auto id = json["id"].get<std::string>();
+            result[std::move(id)] = std::move(json);
+        }
+        return result;
+    }
+
+    std::string checkpoint() const
+    {
+        std::ifstream in(config.checkpoint);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+};
+
+/// Answers each job with "answer <id>" and 10 + 5 tokens, except jobs
+/// whose id starts with "bad", which fail.
+BatchClientFactory
+answering_clients(std::atomic<int> & calls)
+{
+    return [&calls](BatchJob const & job) {
+        ++calls;
+        auto client = std::make_unique<testing::MockClient>();
+        if (job.id.starts_with("bad")) {
+            client->queue_error("API error (500): boom");
+        } else {
+            client->queue_response(ChatResponse{
+                .response = AssistantResponse{"answer " + job.id},
+                .usage = TokenUsage{
+                    .prompt_tokens = PromptTokens{10u},
+                    .completion_tokens = CompletionTokens{5u},
+                    .total_tokens = TotalTokens{15u}}});
+        }
+        return std::unique_ptr<client::IClient>(std::move(client));
+    };
+}
+
+TEST_SUITE("Batch")
+{
+    TEST_CASE("Jobs parse system prompt, messages and overrides")
+    {
+        auto job = parse_batch_job(
+            R"({"id": "q1", "system": "Be brief.", "model": "m/small",)"
+            R"( "max_tokens": 64, "temperature": 0.5, "messages": [)"
+            R"({"role": "user", "content": "Hi"},)"
+            R"({"role": "assistant", "content": "Hello"},)"
+            R"({"role": "user", "content": "Bye"}]})",
+            7);
+
+        REQUIRE(job.has_value());
+        CHECK(job->id == "q1");
+        CHECK(job->conversation.system_prompt() == SystemPrompt{"Be brief."});
+        CHECK(job->conversation.size() == 3u);
+        CHECK(job->model == ModelId{"m/small"});
+        CHECK(job->max_tokens == MaxTokens{64u});
+        CHECK(job->temperature.has_value());
+    }
+
+    TEST_CASE("A job without an id is named by its line number")
+    {
+        auto job = parse_batch_job(
+            R"({"messages": [{"role": "user", "content": "Hi"}]})", 12);
+
+        REQUIRE(job.has_value());
+        CHECK(job->id == "12");
+        CHECK_FALSE(job->model.has_value());
+    }
+
+    TEST_CASE("Invalid jobs are rejected")
+    {
+        CHECK_FALSE(parse_batch_job("not json", 1).has_value());
+        CHECK_FALSE(parse_batch_job("[]", 1).has_value());
+        CHECK_FALSE(parse_batch_job(R"({"id": "x"})", 1).has_value());
+        CHECK_FALSE(parse_batch_job(
+                        R"({"messages": [{"role": "tool", "content": ""}]})",
+                        1)
+                        .has_value());
+        CHECK_FALSE(parse_batch_job(
+                        R"({"max_tokens": 0, "messages": [)"
+                        R"({"role": "user", "content": "Hi"}]})",
+                        1)
+                        .has_value());
+    }
+
+    TEST_CASE("Every job gets a result line and successes are checkpointed")
+    {
+        BatchFiles files;
+        std::string jobs;
+        for (int i = 0; i < 20; ++i) {
+            jobs += std::format(
+                R"({{"id": "job{}", "messages": [)"
+                R"({{"role": "user", "content": "q{}"}}]}})"
+                "\n",
+                i,
+                i);
+        }
+        jobs += "\n";
+        jobs += R"({"id": "bad1", )"
+                R"("messages": [{"role": "user", "content": "q"}]})";
+        files.write_jobs(jobs);
+
+        std::atomic<int> calls{0};
+        auto summary = run_batch(files.config, answering_clients(calls));
+
+        REQUIRE(summary.has_value());
+        CHECK(calls == 21);
+        CHECK(summary->succeeded == 20u);
+        CHECK(summary->failed == 1u);
+        CHECK(summary->skipped == 0u);
+        CHECK(summary->prompt_tokens == 200u);
+        CHECK(summary->completion_tokens == 100u);
+
+        auto const results = files.results();
+        REQUIRE(results.size() == 21u);
+        CHECK(results.at("job7")["response"] == "answer job7");
+        CHECK(results.at("job7")["usage"]["total_tokens"] == 15);
+        CHECK(results.at("job7").contains("latency_ms"));
+        CHECK(results.at("bad1")["error"] == "API error (500): boom");
+        CHECK(files.checkpoint().find("job7\n") != std::string::npos);
+        CHECK(files.checkpoint().find("bad1") == std::string::npos);
+    }
+
+    TEST_CASE("A rerun skips checkpointed jobs and retries failed ones")
+    {
+        BatchFiles files;
+        files.write_jobs(
+            R"({"id": "a", "messages": [{"role": "user", "content": "q"}]})"
+            "\n"
+            R"({"id": "bad", "messages": [{"role": "user", "content": "q"}]})"
+            "\n"
+            R"({"id": "c", "messages": [{"role": "user", "content": "q"}]})"
+            "\n");
+        std::ofstream(files.config.checkpoint) << "a\n";
+
+        std::atomic<int> calls{0};
+        auto summary = run_batch(files.config, answering_clients(calls));
+
+        REQUIRE(summary.has_value());
+        CHECK(calls == 2);
+        CHECK(summary->skipped == 1u);
+        CHECK(summary->succeeded == 1u);
+        CHECK(summary->failed == 1u);
+        CHECK(files.checkpoint() == "a\nc\n");
+        CHECK_FALSE(files.results().contains("a"));
+    }
+
+    TEST_CASE("A job that throws fails alone and is retried next run")
+    {
+        BatchFiles files;
+        files.write_jobs(
+            R"({"id": "a", "messages": [{"role": "user", "content": "q"}]})"
+            "\n"
+            R"({"id": "x", "messages": [{"role": "user", "content": "q"}]})"
+            "\n");
+
+        std::atomic<int> calls{0};
+        auto const answering = answering_clients(calls);
+        auto const throwing = [&](BatchJob const & job) {
+            if (job.id == "x") {
+                throw std::runtime_error("malformed response");
+            }
+            return answering(job);
+        };
+        auto summary = run_batch(files.config, throwing);
+
+        REQUIRE(summary.has_value());
+        CHECK(summary->succeeded == 1u);
+        CHECK(summary->failed == 1u);
+        CHECK(files.checkpoint() == "a\n");
+        auto const results = files.results();
+        REQUIRE(results.contains("x"));
+        CHECK(results.at("x")["error"] == "malformed response");
+    }
+
+    TEST_CASE("A stopped batch starts no jobs")
+    {
+        BatchFiles files;
+        files.write_jobs(
+            R"({"id": "a", "messages": [{"role": "user", "content": "q"}]})");
+        std::stop_source source;
+        source.request_stop();
+
+        std::atomic<int> calls{0};
+        auto summary = run_batch(
+            files.config, answering_clients(calls), source.get_token());
+
+        REQUIRE(summary.has_value());
+        CHECK(calls == 0);
+        CHECK(summary->cancelled == 1u);
+    }
+
+    TEST_CASE("A malformed input line fails the whole batch up front")
+    {
+        BatchFiles files;
+        files.write_jobs(
+            R"({"id": "a", "messages": [{"role": "user", "content": "q"}]})"
+            "\n{oops\n");
+
+        std::atomic<int> calls{0};
+        auto summary = run_batch(files.config, answering_clients(calls));
+
+        REQUIRE_FALSE(summary.has_value());
+        CHECK(summary.error().find("jobs.jsonl:2:") != std::string::npos);
+        CHECK(calls == 0);
+    }
+
+    TEST_CASE("Duplicate job ids are rejected")
+    {
+        BatchFiles files;
+        files.write_jobs(
+            R"({"id": "a", "messages": [{"role": "user", "content": "q"}]})"
+            "\n"
+            R"({"id": "a", "messages": [{"role": "user", "content": "q"}]})"
+            "\n");
+
+        std::atomic<int> calls{0};
+        auto summary = run_batch(files.config, answering_clients(calls));
+
+        REQUIRE_FALSE(summary.has_value());
+        CHECK(summary.error().find("duplicate job id 'a'")
+              != std::string::npos);
+    }
+
+    TEST_CASE("The summary reports counts and throughput")
+    {
+        auto const summary = BatchSummary{
+            .succeeded = 3,
+            .failed = 1,
+            .skipped = 2,
+            .prompt_tokens = 30,
+            .completion_tokens = 15,
+            .elapsed = std::chrono::milliseconds{2000}};
+        std::ostringstream out;
+        summary.report(out);
+
+        CHECK(out.str().find("3 succeeded, 1 failed, 2 skipped")
+              != std::string::npos);
+        CHECK(out.str().find("30 prompt + 15 completion") != std::string::npos);
+        CHECK(out.str().find("2.00 jobs/s") != std::string::npos);
+    }
+}
+
+} // anonymous namespace
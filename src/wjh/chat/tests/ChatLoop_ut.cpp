@@ -8,13 +8,18 @@
 #include "wjh/chat/ChatLoop.hpp"
 #include "wjh/chat/TokenUsage.hpp"
 
+#include <chrono>
+#include <csignal>
+#include <cstdint>
 #include <sstream>
+#include <thread>
 
 #include "testing/MockClient.hpp"
 #include "testing/doctest.hpp"
 
 namespace {
 using namespace wjh::chat;
+using namespace std::chrono_literals;
 
 Config
 makeTestConfig()
@@ -28,6 +33,50 @@ makeTestConfig()
         .show_config = ShowConfig{false}};
 }
 
+/// What InterruptedClient saw; outlives the client.
+struct InterruptedCalls
+{
+    std::vector<std::size_t> sizes;
+    bool saw_stop = false;
+};
+
+/// Presses Ctrl-C during its first turn and waits for the stop, then
+/// answers normally; records the conversation size of each call.
+class InterruptedClient
+: public client::IClient
+{
+public:
+    explicit InterruptedClient(InterruptedCalls & calls)
+    : calls_(calls)
+    { }
+
+private:
+    Result<ChatResponse> do_send_message(
+        conversation::Conversation const & conversation,
+        std::stop_token stop,
+        client::ModelTier) override
+    {
+        calls_.sizes.push_back(conversation.size());
+        if (calls_.sizes.size() > 1) {
+            return ChatResponse{
+                .response = AssistantResponse{"Answered"},
+                .usage = std::nullopt};
+        }
+
+        std::raise(SIGINT);
+        auto const deadline = std::chrono::steady_clock::now() + 2s;
+        while (not stop.stop_requested()
+               and std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+        calls_.saw_stop = stop.stop_requested();
+        return make_error("HTTP request cancelled");
+    }
+
+    InterruptedCalls & calls_;
+};
+
 TEST_SUITE("ChatLoop")
 {
     TEST_CASE("Normal conversation flow")
@@ -236,6 +285,82 @@ TEST_SUITE("ChatLoop")
         CHECK(output.find("20") != std::string::npos);
     }
 
+    TEST_CASE("/usage all breaks tool-using turns down per request")
+    {
+        auto const usage = [](std::uint32_t prompt, std::uint32_t completion) {
+            return TokenUsage{
+                .prompt_tokens = PromptTokens{prompt},
+                .completion_tokens = CompletionTokens{completion},
+                .total_tokens = TotalTokens{prompt + completion}};
+        };
+
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(ChatResponse{
+            .response = AssistantResponse{"Done"},
+            .usage = usage(300u, 30u),
+            .iterations = {
+                IterationStats{
+                    .usage = usage(100u, 20u),
+                    .latency = 1200ms,
+                    .tools = {{.name = "bash", .elapsed = 340ms}}},
+                IterationStats{.usage = usage(200u, 10u), .latency = 800ms}}});
+        mock->queue_response(ChatResponse{
+            .response = AssistantResponse{"Hi"},
+            .usage = usage(10u, 2u),
+            .iterations = {IterationStats{.usage = usage(10u, 2u)}}});
+
+        std::istringstream in("Build it\nHello\n/usage all\n/usage\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        auto const output = out.str();
+        CHECK(output.find("     1       300          30      330")
+              != std::string::npos);
+        CHECK(output.find(
+                  "   1.1       100          20      120         0"
+                  "  1200 ms, tools: bash 340 ms")
+              != std::string::npos);
+        CHECK(output.find("   1.2       200          10      210         0"
+                          "  800 ms\n")
+              != std::string::npos);
+        CHECK(output.find("   2.1") == std::string::npos);
+        CHECK(output.find("(2 turns, 3 model requests)") != std::string::npos);
+    }
+
+    TEST_CASE("/usage reports prompt cache hit rate")
+    {
+        auto mock = std::make_unique<testing::MockClient>();
+        mock->queue_response(ChatResponse{
+            .response = AssistantResponse{"Reply 1"},
+            .usage = TokenUsage{
+                .prompt_tokens = PromptTokens{100u},
+                .completion_tokens = CompletionTokens{5u},
+                .total_tokens = TotalTokens{105u},
+                .cached_tokens = CachedTokens{0u},
+                .cache_write_tokens = CacheWriteTokens{90u}}});
+        mock->queue_response(ChatResponse{
+            .response = AssistantResponse{"Reply 2"},
+            .usage = TokenUsage{
+                .prompt_tokens = PromptTokens{100u},
+                .completion_tokens = CompletionTokens{5u},
+                .total_tokens = TotalTokens{105u},
+                .cached_tokens = CachedTokens{90u},
+                .cache_write_tokens = CacheWriteTokens{0u}}});
+
+        std::istringstream in("Hello\nWorld\n/usage\n/usage all\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        auto output = out.str();
+        CHECK(output.find("Cache hit:  45.0% (90 read, 90 written)")
+              != std::string::npos);
+        CHECK(output.find("45.0% hit rate") != std::string::npos);
+    }
+
     TEST_CASE("/clear resets usage history")
     {
         auto mock = std::make_unique<testing::MockClient>();
@@ -271,6 +396,63 @@ TEST_SUITE("ChatLoop")
         CHECK(output.find("/usage all") != std::string::npos);
     }
 
+    TEST_CASE("/stats without client statistics")
+    {
+        auto mock = std::make_unique<testing::MockClient>();
+
+        std::istringstream in("/stats\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        CHECK(out.str().find("No client statistics available.")
+              != std::string::npos);
+    }
+
+    TEST_CASE("/status without endpoint status")
+    {
+        auto mock = std::make_unique<testing::MockClient>();
+
+        std::istringstream in("/status\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        CHECK(out.str().find("No endpoint status available.")
+              != std::string::npos);
+    }
+
+    TEST_CASE("Ctrl-C cancels the turn and keeps the session")
+    {
+        struct sigaction before{};
+        ::sigaction(SIGINT, nullptr, &before);
+
+        InterruptedCalls calls;
+        auto client = std::make_unique<InterruptedClient>(calls);
+
+        std::istringstream in("Slow question\nNext question\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(client), in, out);
+
+        CHECK(result == ExitCode::success);
+        CHECK(calls.saw_stop);
+        auto output = out.str();
+        CHECK(output.find("[Cancelled]") != std::string::npos);
+        CHECK(output.find("Answered") != std::string::npos);
+
+        // The cancelled message is not part of the next request.
+        REQUIRE(calls.sizes.size() == 2);
+        CHECK(calls.sizes[0] == 1);
+        CHECK(calls.sizes[1] == 1);
+
+        struct sigaction after{};
+        ::sigaction(SIGINT, nullptr, &after);
+        CHECK(after.sa_handler == before.sa_handler);
+    }
+
     TEST_CASE("Response with no usage field is handled")
     {
         auto mock = std::make_unique<testing::MockClient>();
@@ -289,6 +471,74 @@ TEST_SUITE("ChatLoop")
               != std::string::npos);
     }
 
+    TEST_CASE("/tier without a fast model reports tiers are off")
+    {
+        auto mock = std::make_unique<testing::MockClient>();
+        std::istringstream in("/tier fast\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(makeTestConfig(), std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        CHECK(out.str().find("Model tiers are off") != std::string::npos);
+    }
+
+    TEST_CASE("/usage breaks turns down by model tier")
+    {
+        auto config = makeTestConfig();
+        config.fast_model = FastModel{"small-model"};
+
+        auto mock = std::make_unique<testing::MockClient>();
+        for (auto tokens : {15u, 40u}) {
+            mock->queue_response(ChatResponse{
+                .response = AssistantResponse{"Reply"},
+                .usage = TokenUsage{.total_tokens = TotalTokens{tokens}}});
+        }
+
+        std::istringstream in(
+            "What is RAII?\nPlease fix the build\n/usage\n/exit\n");
+        std::ostringstream out;
+
+        auto result = run(config, std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        auto const output = out.str();
+        CHECK(output.find("By tier:") != std::string::npos);
+        CHECK(output.find("fast    1 turn,") != std::string::npos);
+        CHECK(output.find(", 15 tokens") != std::string::npos);
+        CHECK(output.find("strong  1 turn,") != std::string::npos);
+        CHECK(output.find(", 40 tokens") != std::string::npos);
+    }
+
+    TEST_CASE("/tier overrides the classifier until set back to auto")
+    {
+        auto config = makeTestConfig();
+        config.fast_model = FastModel{"small-model"};
+
+        auto mock = std::make_unique<testing::MockClient>();
+        for (int i = 0; i < 2; ++i) {
+            mock->queue_response(ChatResponse{
+                .response = AssistantResponse{"Reply"},
+                .usage = TokenUsage{.total_tokens = TotalTokens{10u}}});
+        }
+
+        std::istringstream in(
+            "/tier strong\nHi\n/tier auto\nHi again\n/usage\n/tier bogus\n"
+            "/exit\n");
+        std::ostringstream out;
+
+        auto result = run(config, std::move(mock), in, out);
+
+        CHECK(result == ExitCode::success);
+        auto const output = out.str();
+        CHECK(output.find("Model tier: strong (fast model: small-model)")
+              != std::string::npos);
+        CHECK(output.find("Model tier: auto") != std::string::npos);
+        CHECK(output.find("strong  1 turn,") != std::string::npos);
+        CHECK(output.find("fast    1 turn,") != std::string::npos);
+        CHECK(output.find("Usage: /tier") != std::string::npos);
+    }
+
     TEST_CASE("/usage after single turn shows singular")
     {
         auto mock = std::make_unique<testing::MockClient>();
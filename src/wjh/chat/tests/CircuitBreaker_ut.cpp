@@ -0,0 +1,169 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/CircuitBreaker.hpp"
+#include "wjh/chat/client/HttpClient.hpp"
+
+#include <sstream>
+#include <thread>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+using namespace std::chrono_literals;
+
+std::string const endpoint = "api.example.com:443";
+
+CircuitBreakerConfig const half_open_config{
+    .consecutive_timeouts = 1,
+    .open_duration = 20ms};
+
+/// Open the circuit and wait until a probe is allowed.
+void
+trip_and_wait(CircuitBreaker & breaker)
+{
+    REQUIRE(breaker.allow(endpoint));
+    breaker.record(endpoint, CallOutcome::timeout);
+    REQUIRE(breaker.state(endpoint) == CircuitState::open);
+    std::this_thread::sleep_for(30ms);
+}
+
+TEST_SUITE("CircuitBreaker")
+{
+    TEST_CASE("Consecutive timeouts open the circuit")
+    {
+        CircuitBreaker breaker(CircuitBreakerConfig{
+            .failure_rate = 0,
+            .consecutive_timeouts = 3});
+
+        for (int i = 0; i < 2; ++i) {
+            REQUIRE(breaker.allow(endpoint));
+            breaker.record(endpoint, CallOutcome::timeout);
+        }
+        CHECK(breaker.state(endpoint) == CircuitState::closed);
+
+        // A success resets the run.
+        REQUIRE(breaker.allow(endpoint));
+        breaker.record(endpoint, CallOutcome::success);
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(breaker.allow(endpoint));
+            breaker.record(endpoint, CallOutcome::timeout);
+        }
+        CHECK(breaker.state(endpoint) == CircuitState::open);
+        CHECK_FALSE(breaker.allow(endpoint));
+        CHECK(breaker.stats().trips == 1);
+        CHECK(breaker.stats().rejected == 1);
+    }
+
+    TEST_CASE("Failure rate opens the circuit once enough calls are seen")
+    {
+        CircuitBreaker breaker(CircuitBreakerConfig{
+            .failure_rate = 50,
+            .window = 10,
+            .min_calls = 4,
+            .consecutive_timeouts = 0});
+
+        for (auto outcome :
+             {CallOutcome::failure, CallOutcome::success, CallOutcome::failure})
+        {
+            REQUIRE(breaker.allow(endpoint));
+            breaker.record(endpoint, outcome);
+        }
+        CHECK(breaker.state(endpoint) == CircuitState::closed);
+
+        REQUIRE(breaker.allow(endpoint));
+        breaker.record(endpoint, CallOutcome::success);
+        CHECK(breaker.state(endpoint) == CircuitState::open);
+    }
+
+    TEST_CASE("Endpoints have independent circuits")
+    {
+        CircuitBreaker breaker(CircuitBreakerConfig{.consecutive_timeouts = 1});
+        REQUIRE(breaker.allow(endpoint));
+        breaker.record(endpoint, CallOutcome::timeout);
+
+        CHECK_FALSE(breaker.allow(endpoint));
+        CHECK(breaker.allow("backup.example.com:443"));
+    }
+
+    TEST_CASE("A failed half-open probe reopens the circuit")
+    {
+        CircuitBreaker breaker(half_open_config);
+        trip_and_wait(breaker);
+
+        REQUIRE(breaker.allow(endpoint));
+        CHECK(breaker.state(endpoint) == CircuitState::half_open);
+
+        // Only one probe at a time.
+        CHECK_FALSE(breaker.allow(endpoint));
+        breaker.record(endpoint, CallOutcome::failure);
+        CHECK(breaker.state(endpoint) == CircuitState::open);
+        CHECK(breaker.stats().trips == 2);
+    }
+
+    TEST_CASE("A successful half-open probe closes the circuit")
+    {
+        CircuitBreaker breaker(half_open_config);
+        trip_and_wait(breaker);
+
+        REQUIRE(breaker.allow(endpoint));
+        breaker.record(endpoint, CallOutcome::success);
+        CHECK(breaker.state(endpoint) == CircuitState::closed);
+        CHECK(breaker.allow(endpoint));
+    }
+
+    TEST_CASE("A cancelled half-open probe lets another through")
+    {
+        CircuitBreaker breaker(half_open_config);
+        trip_and_wait(breaker);
+
+        REQUIRE(breaker.allow(endpoint));
+        breaker.record(endpoint, CallOutcome::cancelled);
+        CHECK(breaker.allow(endpoint));
+    }
+
+    TEST_CASE("Status lists every endpoint")
+    {
+        CircuitBreaker breaker(CircuitBreakerConfig{.consecutive_timeouts = 1});
+        REQUIRE(breaker.allow("a.example.com:443"));
+        breaker.record("a.example.com:443", CallOutcome::success);
+        REQUIRE(breaker.allow(endpoint));
+        breaker.record(endpoint, CallOutcome::timeout);
+
+        std::ostringstream out;
+        breaker.status(out);
+        CHECK(
+            out.str().find("a.example.com:443  closed") != std::string::npos);
+        CHECK(out.str().find(endpoint + "  open") != std::string::npos);
+    }
+
+    TEST_CASE("HttpClient fails fast while the circuit is open")
+    {
+        auto breaker = std::make_shared<CircuitBreaker>(
+            CircuitBreakerConfig{
+                .consecutive_timeouts = 0,
+                .open_duration = 60s});
+        HttpClient client(Hostname{"127.0.0.1"}, PortNumber{1});
+        client.set_connection_timeout(TimeoutSeconds{1});
+        client.set_circuit_breaker(breaker);
+
+        // Connection refused counts as a failure; five of them trip the
+        // default 50% over 5 calls.
+        for (int i = 0; i < 5; ++i) {
+            CHECK_FALSE(
+                client.post(HttpPath{"/"}, HttpBody{"{}"}, HttpHeaders{}));
+        }
+        REQUIRE(breaker->state("127.0.0.1:1") == CircuitState::open);
+
+        auto result = client.post(HttpPath{"/"}, HttpBody{"{}"}, HttpHeaders{});
+        REQUIRE_FALSE(result.has_value());
+        CHECK(result.error().find("failing fast") != std::string::npos);
+    }
+}
+
+} // anonymous namespace
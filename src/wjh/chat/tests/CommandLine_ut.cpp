@@ -194,6 +194,240 @@ TEST_SUITE("CommandLine")
         CHECK(*result->max_tokens == MaxTokens{1024u});
     }
 
+    TEST_CASE("No prompt cache flag")
+    {
+        char const * args[] = {"chat_app", "--no-prompt-cache"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        REQUIRE(result->prompt_caching.has_value());
+        CHECK(*result->prompt_caching == PromptCaching{false});
+    }
+
+    TEST_CASE("Response cache flags")
+    {
+        char const * args[] = {
+            "chat_app", "--response-cache", "/tmp/cache", "--offline"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        REQUIRE(result->response_cache_dir.has_value());
+        CHECK(*result->response_cache_dir == ResponseCacheDir{"/tmp/cache"});
+        REQUIRE(result->offline.has_value());
+        CHECK(*result->offline == OfflineMode{true});
+    }
+
+    TEST_CASE("Missing argument for --response-cache")
+    {
+        char const * args[] = {"chat_app", "--response-cache"};
+        auto result = parse_args(args);
+
+        CHECK_FALSE(result.has_value());
+    }
+
+    TEST_CASE("Retry flags")
+    {
+        char const * args[] = {
+            "chat_app", "--max-retries", "5", "--retry-budget", "0"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        REQUIRE(result->max_retries.has_value());
+        CHECK(*result->max_retries == MaxRetries{5u});
+        REQUIRE(result->retry_budget.has_value());
+        CHECK(*result->retry_budget == RetryBudget{0u});
+    }
+
+    TEST_CASE("Invalid number for --max-retries")
+    {
+        char const * args[] = {"chat_app", "--max-retries", "many"};
+        auto result = parse_args(args);
+
+        CHECK_FALSE(result.has_value());
+    }
+
+    TEST_CASE("Hedge flags")
+    {
+        char const * args[] = {
+            "chat_app", "--hedge", "--hedge-provider", "Fireworks"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        REQUIRE(result->hedge.has_value());
+        CHECK(*result->hedge == HedgeRequests{true});
+        REQUIRE(result->hedge_provider.has_value());
+        CHECK(*result->hedge_provider == HedgeProvider{"Fireworks"});
+    }
+
+    TEST_CASE("Rate limit flags")
+    {
+        char const * args[] = {
+            "chat_app", "--rpm", "20", "--tpm", "40000"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        REQUIRE(result->requests_per_minute.has_value());
+        CHECK(*result->requests_per_minute == RequestsPerMinute{20u});
+        REQUIRE(result->tokens_per_minute.has_value());
+        CHECK(*result->tokens_per_minute == TokensPerMinute{40000u});
+    }
+
+    TEST_CASE("Circuit breaker flags")
+    {
+        char const * args[] = {
+            "chat_app",
+            "--circuit-failure-rate", "25",
+            "--circuit-timeouts", "0",
+            "--fallback-host", "eu.openrouter.ai"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        REQUIRE(result->circuit_failure_rate.has_value());
+        CHECK(*result->circuit_failure_rate == CircuitFailureRate{25u});
+        REQUIRE(result->circuit_timeouts.has_value());
+        CHECK(*result->circuit_timeouts == CircuitTimeouts{0u});
+        REQUIRE(result->fallback_host.has_value());
+        CHECK(*result->fallback_host == FallbackHost{"eu.openrouter.ai"});
+    }
+
+    TEST_CASE("Base URL flag")
+    {
+        char const * args[] = {
+            "chat_app", "--base-url", "http://localhost:8080/v1"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        REQUIRE(result->base_url.has_value());
+        CHECK(*result->base_url == ApiBaseUrl{"http://localhost:8080/v1"});
+    }
+
+    TEST_CASE("No-prewarm flag")
+    {
+        char const * args[] = {"chat_app", "--no-prewarm"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        REQUIRE(result->prewarm.has_value());
+        CHECK(*result->prewarm == PrewarmConnections{false});
+    }
+
+    TEST_CASE("Routing flags")
+    {
+        char const * args[] = {
+            "chat_app",
+            "--fallback-models", "a/fast,b/cheap",
+            "--provider-sort", "latency",
+            "--provider-only", "Groq,Together",
+            "--provider-ignore", "Slowpoke",
+            "--ttft-slo", "1500",
+            "--route-log", "/tmp/route.jsonl"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->fallback_models == FallbackModels{"a/fast,b/cheap"});
+        CHECK(result->provider_sort == ProviderSort{"latency"});
+        CHECK(result->provider_only == ProviderOnly{"Groq,Together"});
+        CHECK(result->provider_ignore == ProviderIgnore{"Slowpoke"});
+        CHECK(result->ttft_slo == TtftSlo{1500u});
+        CHECK(result->route_log == RouteLogPath{"/tmp/route.jsonl"});
+    }
+
+    TEST_CASE("Batch flags")
+    {
+        char const * args[] = {
+            "chat_app",
+            "--batch", "jobs.jsonl",
+            "--batch-output", "out.jsonl",
+            "--batch-checkpoint", "done.txt",
+            "--batch-workers", "16"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->batch_input == BatchInput{"jobs.jsonl"});
+        CHECK(result->batch_output == BatchOutput{"out.jsonl"});
+        CHECK(result->batch_checkpoint == BatchCheckpoint{"done.txt"});
+        CHECK(result->batch_workers == BatchWorkers{16u});
+    }
+
+    TEST_CASE("Agent loop limit flags")
+    {
+        char const * args[] = {
+            "chat_app",
+            "--max-iterations", "8",
+            "--turn-deadline", "120",
+            "--turn-token-budget", "50000"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->max_iterations == AgentMaxIterations{8u});
+        CHECK(result->turn_deadline == TurnDeadline{120u});
+        CHECK(result->turn_token_budget == TurnTokenBudget{50000u});
+    }
+
+    TEST_CASE("Tool approval flags")
+    {
+        char const * args[] = {
+            "chat_app",
+            "--tool-policy", "tools.policy",
+            "--allow-tool", "bash make",
+            "--deny-tool", "bash git push",
+            "--allow-tool", "edit_file src/*",
+            "--tool-default", "deny"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->tool_policy == ToolPolicyFile{"tools.policy"});
+        REQUIRE(result->allow_tools.size() == 2u);
+        CHECK(result->allow_tools[0] == ToolRule{"bash make"});
+        CHECK(result->allow_tools[1] == ToolRule{"edit_file src/*"});
+        REQUIRE(result->deny_tools.size() == 1u);
+        CHECK(result->deny_tools[0] == ToolRule{"bash git push"});
+        CHECK(result->tool_default == ToolDefault{"deny"});
+    }
+
+    TEST_CASE("Tool limit flags")
+    {
+        char const * args[] = {
+            "chat_app",
+            "--tool-cpus", "2",
+            "--tool-memory", "4096",
+            "--tool-pids", "512"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->tool_cpus == ToolCpus{2u});
+        CHECK(result->tool_memory == ToolMemoryMb{4096u});
+        CHECK(result->tool_pids == ToolPids{512u});
+
+        char const * bad[] = {"chat_app", "--tool-memory", "4G"};
+        CHECK_FALSE(parse_args(bad).has_value());
+    }
+
+    TEST_CASE("Watch directory flag")
+    {
+        char const * none[] = {"chat_app"};
+        auto unset = parse_args(none);
+        REQUIRE(unset.has_value());
+        CHECK_FALSE(unset->watch_dir.has_value());
+
+        char const * args[] = {"chat_app", "--watch-dir", "/src/project"};
+        auto result = parse_args(args);
+        REQUIRE(result.has_value());
+        CHECK(result->watch_dir == WatchDir{"/src/project"});
+
+        char const * missing[] = {"chat_app", "--watch-dir"};
+        CHECK_FALSE(parse_args(missing).has_value());
+    }
+
+    TEST_CASE("Fast model flag")
+    {
+        char const * args[] = {"chat_app", "--fast-model", "small/model"};
+        auto result = parse_args(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->fast_model == FastModel{"small/model"});
+    }
+
     TEST_CASE("Unknown argument")
     {
         char const * args[] = {"chat_app", "--unknown"};
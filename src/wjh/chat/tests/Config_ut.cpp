@@ -242,6 +242,627 @@ TEST_SUITE("Config")
         CHECK_FALSE(result.has_value());
     }
 
+    TEST_CASE("resolve_config: prompt caching defaults on")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard cache_guard("PROMPT_CACHE", nullptr);
+        CommandLineArgs args;
+        auto result = resolve_config(args);
+
+        REQUIRE(result.has_value());
+        CHECK(result->prompt_caching == PromptCaching{true});
+    }
+
+    TEST_CASE("resolve_config: prompt caching from env and CLI")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+
+        SUBCASE("env disables") {
+            EnvGuard cache_guard("PROMPT_CACHE", "off");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->prompt_caching == PromptCaching{false});
+        }
+
+        SUBCASE("CLI overrides env") {
+            EnvGuard cache_guard("PROMPT_CACHE", "1");
+            CommandLineArgs args;
+            args.prompt_caching = PromptCaching{false};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->prompt_caching == PromptCaching{false});
+        }
+
+        SUBCASE("invalid value") {
+            EnvGuard cache_guard("PROMPT_CACHE", "sometimes");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            CHECK_FALSE(result.has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: response cache")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard dir_guard("RESPONSE_CACHE_DIR", nullptr);
+        EnvGuard offline_guard("RESPONSE_CACHE_OFFLINE", nullptr);
+
+        SUBCASE("disabled by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK_FALSE(result->response_cache_dir.has_value());
+            CHECK(result->offline == OfflineMode{false});
+        }
+
+        SUBCASE("directory from env") {
+            EnvGuard guard("RESPONSE_CACHE_DIR", "/tmp/cache");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            REQUIRE(result->response_cache_dir.has_value());
+            CHECK(*result->response_cache_dir
+                  == ResponseCacheDir{"/tmp/cache"});
+        }
+
+        SUBCASE("offline requires a directory") {
+            CommandLineArgs args;
+            args.offline = OfflineMode{true};
+            auto result = resolve_config(args);
+
+            CHECK_FALSE(result.has_value());
+        }
+
+        SUBCASE("offline with directory") {
+            CommandLineArgs args;
+            args.offline = OfflineMode{true};
+            args.response_cache_dir = ResponseCacheDir{"/tmp/cache"};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->offline == OfflineMode{true});
+        }
+    }
+
+    TEST_CASE("resolve_config: retry limits")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard retries_guard("MAX_RETRIES", nullptr);
+        EnvGuard budget_guard("RETRY_BUDGET", nullptr);
+
+        SUBCASE("defaults") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->max_retries == MaxRetries{3u});
+            CHECK(result->retry_budget == RetryBudget{20u});
+        }
+
+        SUBCASE("CLI overrides env") {
+            EnvGuard guard("MAX_RETRIES", "1");
+            EnvGuard budget("RETRY_BUDGET", "7");
+            CommandLineArgs args;
+            args.max_retries = MaxRetries{0u};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->max_retries == MaxRetries{0u});
+            CHECK(result->retry_budget == RetryBudget{7u});
+        }
+
+        SUBCASE("invalid value") {
+            EnvGuard guard("RETRY_BUDGET", "-1");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            CHECK_FALSE(result.has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: request hedging")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard hedge_guard("HEDGE_REQUESTS", nullptr);
+        EnvGuard provider_guard("HEDGE_PROVIDER", nullptr);
+
+        SUBCASE("off by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->hedge == HedgeRequests{false});
+            CHECK_FALSE(result->hedge_provider.has_value());
+        }
+
+        SUBCASE("from env") {
+            EnvGuard guard("HEDGE_REQUESTS", "on");
+            EnvGuard provider("HEDGE_PROVIDER", "Together");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->hedge == HedgeRequests{true});
+            REQUIRE(result->hedge_provider.has_value());
+            CHECK(*result->hedge_provider == HedgeProvider{"Together"});
+        }
+
+        SUBCASE("invalid value") {
+            EnvGuard guard("HEDGE_REQUESTS", "maybe");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            CHECK_FALSE(result.has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: rate limits")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard rpm_guard("RATE_LIMIT_RPM", nullptr);
+        EnvGuard tpm_guard("RATE_LIMIT_TPM", nullptr);
+
+        SUBCASE("unlimited by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->requests_per_minute == RequestsPerMinute{0u});
+            CHECK(result->tokens_per_minute == TokensPerMinute{0u});
+        }
+
+        SUBCASE("CLI overrides env") {
+            EnvGuard rpm("RATE_LIMIT_RPM", "60");
+            EnvGuard tpm("RATE_LIMIT_TPM", "100000");
+            CommandLineArgs args;
+            args.requests_per_minute = RequestsPerMinute{10u};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->requests_per_minute == RequestsPerMinute{10u});
+            CHECK(result->tokens_per_minute == TokensPerMinute{100000u});
+        }
+
+        SUBCASE("invalid value") {
+            EnvGuard guard("RATE_LIMIT_TPM", "lots");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            CHECK_FALSE(result.has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: circuit breaker")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard rate_guard("CIRCUIT_FAILURE_RATE", nullptr);
+        EnvGuard timeouts_guard("CIRCUIT_TIMEOUTS", nullptr);
+        EnvGuard fallback_guard("FALLBACK_HOST", nullptr);
+
+        SUBCASE("defaults") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->circuit_failure_rate == CircuitFailureRate{50u});
+            CHECK(result->circuit_timeouts == CircuitTimeouts{3u});
+            CHECK_FALSE(result->fallback_host.has_value());
+        }
+
+        SUBCASE("from env") {
+            EnvGuard rate("CIRCUIT_FAILURE_RATE", "0");
+            EnvGuard fallback("FALLBACK_HOST", "backup.example.com");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->circuit_failure_rate == CircuitFailureRate{0u});
+            REQUIRE(result->fallback_host.has_value());
+            CHECK(*result->fallback_host
+                  == FallbackHost{"backup.example.com"});
+        }
+
+        SUBCASE("rate above 100% is rejected") {
+            CommandLineArgs args;
+            args.circuit_failure_rate = CircuitFailureRate{150u};
+            auto result = resolve_config(args);
+
+            CHECK_FALSE(result.has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: API base URL")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard url_guard("API_BASE_URL", nullptr);
+
+        SUBCASE("OpenRouter by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK_FALSE(result->base_url.has_value());
+        }
+
+        SUBCASE("from env") {
+            EnvGuard guard("API_BASE_URL", "unix:///run/gateway.sock");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            REQUIRE(result->base_url.has_value());
+            CHECK(*result->base_url == ApiBaseUrl{"unix:///run/gateway.sock"});
+        }
+
+        SUBCASE("malformed URL is rejected") {
+            CommandLineArgs args;
+            args.base_url = ApiBaseUrl{"ftp://example.com"};
+            auto result = resolve_config(args);
+
+            CHECK_FALSE(result.has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: connection pre-warming")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard prewarm_guard("PREWARM_CONNECTIONS", nullptr);
+
+        SUBCASE("on by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->prewarm == PrewarmConnections{true});
+        }
+
+        SUBCASE("env can turn it off") {
+            EnvGuard guard("PREWARM_CONNECTIONS", "off");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->prewarm == PrewarmConnections{false});
+        }
+
+        SUBCASE("CLI overrides env") {
+            EnvGuard guard("PREWARM_CONNECTIONS", "on");
+            CommandLineArgs args;
+            args.prewarm = PrewarmConnections{false};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->prewarm == PrewarmConnections{false});
+        }
+
+        SUBCASE("invalid env value is rejected") {
+            EnvGuard guard("PREWARM_CONNECTIONS", "sometimes");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            CHECK_FALSE(result.has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: model and provider routing")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard models_guard("LLM_FALLBACK_MODELS", nullptr);
+        EnvGuard sort_guard("PROVIDER_SORT", nullptr);
+        EnvGuard slo_guard("TTFT_SLO_MS", nullptr);
+
+        SUBCASE("no routing by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK_FALSE(result->fallback_models.has_value());
+            CHECK_FALSE(result->provider_sort.has_value());
+            CHECK(result->ttft_slo == TtftSlo{0u});
+        }
+
+        SUBCASE("from env") {
+            EnvGuard models("LLM_FALLBACK_MODELS", "a/fast,b/cheap");
+            EnvGuard sort("PROVIDER_SORT", "throughput");
+            EnvGuard slo("TTFT_SLO_MS", "2000");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->fallback_models == FallbackModels{"a/fast,b/cheap"});
+            CHECK(result->provider_sort == ProviderSort{"throughput"});
+            CHECK(result->ttft_slo == TtftSlo{2000u});
+        }
+
+        SUBCASE("unknown provider sort is rejected") {
+            CommandLineArgs args;
+            args.provider_sort = ProviderSort{"fastest"};
+            auto result = resolve_config(args);
+
+            CHECK_FALSE(result.has_value());
+        }
+
+        SUBCASE("invalid SLO is rejected") {
+            EnvGuard slo("TTFT_SLO_MS", "soon");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            CHECK_FALSE(result.has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: fast model")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard fast_guard("LLM_FAST_MODEL", nullptr);
+
+        SUBCASE("no fast model by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK_FALSE(result->fast_model.has_value());
+        }
+
+        SUBCASE("CLI overrides env") {
+            EnvGuard fast("LLM_FAST_MODEL", "env/small");
+            CommandLineArgs args;
+            args.fast_model = FastModel{"cli/small"};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->fast_model == FastModel{"cli/small"});
+        }
+
+        SUBCASE("empty value disables it") {
+            EnvGuard fast("LLM_FAST_MODEL", "");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK_FALSE(result->fast_model.has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: agent loop limits")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard iterations_guard("AGENT_MAX_ITERATIONS", nullptr);
+        EnvGuard deadline_guard("TURN_DEADLINE_SECONDS", nullptr);
+        EnvGuard budget_guard("TURN_TOKEN_BUDGET", nullptr);
+
+        SUBCASE("20 steps and no deadline or budget by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->max_iterations == AgentMaxIterations{20u});
+            CHECK(result->turn_deadline == TurnDeadline{0u});
+            CHECK(result->turn_token_budget == TurnTokenBudget{0u});
+        }
+
+        SUBCASE("from env") {
+            EnvGuard iterations("AGENT_MAX_ITERATIONS", "6");
+            EnvGuard deadline("TURN_DEADLINE_SECONDS", "90");
+            EnvGuard budget("TURN_TOKEN_BUDGET", "20000");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->max_iterations == AgentMaxIterations{6u});
+            CHECK(result->turn_deadline == TurnDeadline{90u});
+            CHECK(result->turn_token_budget == TurnTokenBudget{20000u});
+        }
+
+        SUBCASE("CLI overrides env") {
+            EnvGuard iterations("AGENT_MAX_ITERATIONS", "6");
+            CommandLineArgs args;
+            args.max_iterations = AgentMaxIterations{3u};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->max_iterations == AgentMaxIterations{3u});
+        }
+
+        SUBCASE("zero iterations is rejected") {
+            EnvGuard iterations("AGENT_MAX_ITERATIONS", "0");
+            CommandLineArgs args;
+            CHECK_FALSE(resolve_config(args).has_value());
+        }
+
+        SUBCASE("invalid deadline is rejected") {
+            EnvGuard deadline("TURN_DEADLINE_SECONDS", "1m");
+            CommandLineArgs args;
+            CHECK_FALSE(resolve_config(args).has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: tool approval")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard policy_guard("TOOL_POLICY", nullptr);
+        EnvGuard default_guard("TOOL_DEFAULT", nullptr);
+
+        SUBCASE("no rules by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK_FALSE(result->tool_policy.has_value());
+            CHECK(result->allow_tools.empty());
+            CHECK_FALSE(result->tool_default.has_value());
+        }
+
+        SUBCASE("from env, with CLI rules") {
+            EnvGuard policy("TOOL_POLICY", "/etc/chat.policy");
+            EnvGuard fallback("TOOL_DEFAULT", "deny");
+            CommandLineArgs args;
+            args.allow_tools.emplace_back("bash make");
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->tool_policy == ToolPolicyFile{"/etc/chat.policy"});
+            CHECK(result->tool_default == ToolDefault{"deny"});
+            REQUIRE(result->allow_tools.size() == 1u);
+        }
+
+        SUBCASE("CLI overrides env") {
+            EnvGuard fallback("TOOL_DEFAULT", "deny");
+            CommandLineArgs args;
+            args.tool_default = ToolDefault{"allow"};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->tool_default == ToolDefault{"allow"});
+        }
+
+        SUBCASE("an unknown default is rejected") {
+            EnvGuard fallback("TOOL_DEFAULT", "maybe");
+            CommandLineArgs args;
+            CHECK_FALSE(resolve_config(args).has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: tool limits")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard cpus_guard("TOOL_CPUS", nullptr);
+        EnvGuard memory_guard("TOOL_MEMORY_MB", nullptr);
+        EnvGuard pids_guard("TOOL_PIDS", nullptr);
+
+        SUBCASE("no limits by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->tool_cpus == ToolCpus{0u});
+            CHECK(result->tool_memory == ToolMemoryMb{0u});
+            CHECK(result->tool_pids == ToolPids{0u});
+        }
+
+        SUBCASE("from env, CLI overrides") {
+            EnvGuard cpus("TOOL_CPUS", "4");
+            EnvGuard memory("TOOL_MEMORY_MB", "2048");
+            CommandLineArgs args;
+            args.tool_cpus = ToolCpus{1u};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->tool_cpus == ToolCpus{1u});
+            CHECK(result->tool_memory == ToolMemoryMb{2048u});
+            CHECK(result->tool_pids == ToolPids{0u});
+        }
+
+        SUBCASE("invalid env is rejected") {
+            EnvGuard pids("TOOL_PIDS", "lots");
+            CommandLineArgs args;
+            CHECK_FALSE(resolve_config(args).has_value());
+        }
+    }
+
+    TEST_CASE("resolve_config: watch directory")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard dir_guard("WATCH_DIR", nullptr);
+
+        SUBCASE("off by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK_FALSE(result->watch_dir.has_value());
+        }
+
+        SUBCASE("from env") {
+            EnvGuard dir("WATCH_DIR", "/src/project");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->watch_dir == WatchDir{"/src/project"});
+        }
+
+        SUBCASE("CLI overrides env") {
+            EnvGuard dir("WATCH_DIR", "/src/project");
+            CommandLineArgs args;
+            args.watch_dir = WatchDir{"/src/other"};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->watch_dir == WatchDir{"/src/other"});
+        }
+    }
+
+    TEST_CASE("resolve_config: batch mode")
+    {
+        EnvGuard key_guard(
+            "OPENROUTER_API_KEY", "sk-test");
+        EnvGuard workers_guard("BATCH_WORKERS", nullptr);
+
+        SUBCASE("off by default") {
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK_FALSE(result->batch_input.has_value());
+            CHECK(result->batch_workers == BatchWorkers{4u});
+        }
+
+        SUBCASE("output and checkpoint default next to the input") {
+            CommandLineArgs args;
+            args.batch_input = BatchInput{"/data/jobs.jsonl"};
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->batch_output
+                  == BatchOutput{"/data/jobs.results.jsonl"});
+            CHECK(result->batch_checkpoint
+                  == BatchCheckpoint{"/data/jobs.results.checkpoint"});
+        }
+
+        SUBCASE("workers from env") {
+            EnvGuard workers("BATCH_WORKERS", "12");
+            CommandLineArgs args;
+            auto result = resolve_config(args);
+
+            REQUIRE(result.has_value());
+            CHECK(result->batch_workers == BatchWorkers{12u});
+        }
+
+        SUBCASE("zero workers is rejected") {
+            CommandLineArgs args;
+            args.batch_workers = BatchWorkers{0u};
+            CHECK_FALSE(resolve_config(args).has_value());
+        }
+
+        SUBCASE("output without --batch is rejected") {
+            CommandLineArgs args;
+            args.batch_output = BatchOutput{"out.jsonl"};
+            CHECK_FALSE(resolve_config(args).has_value());
+        }
+    }
+
     TEST_CASE("append_agents_file: no file leaves config "
               "unchanged")
     {
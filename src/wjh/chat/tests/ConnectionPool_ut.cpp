@@ -0,0 +1,187 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/ConnectionPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include <httplib.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+using namespace std::chrono_literals;
+
+/// Creates clients without connecting, counting how many were made.
+struct CountingFactory
+{
+    std::shared_ptr<std::atomic<int>> made =
+        std::make_shared<std::atomic<int>>(0);
+
+    ConnectionPool::Connection operator () () const
+    {
+        ++*made;
+        return std::make_unique<httplib::Client>("localhost", 1);
+    }
+};
+
+/// Poll @p done for up to two seconds.
+template <typename F>
+bool
+eventually(F done)
+{
+    auto const deadline = std::chrono::steady_clock::now() + 2s;
+    while (not done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+ConnectionPoolConfig
+fast_config()
+{
+    return ConnectionPoolConfig{
+        .max_idle = 2,
+        .ping_interval = 5ms,
+        .keep_warm = 10s};
+}
+
+TEST_SUITE("ConnectionPool")
+{
+    TEST_CASE("Released connections are reused")
+    {
+        ConnectionPool pool;
+        CountingFactory factory;
+
+        auto first = pool.acquire("api:443", factory);
+        REQUIRE(first != nullptr);
+        auto const * raw = first.get();
+        pool.release("api:443", std::move(first));
+        CHECK(pool.idle("api:443") == 1);
+
+        auto second = pool.acquire("api:443", factory);
+        CHECK(second.get() == raw);
+        CHECK(*factory.made == 1);
+        CHECK(pool.idle("api:443") == 0);
+
+        auto const stats = pool.stats();
+        CHECK(stats.opened == 1);
+        CHECK(stats.reused == 1);
+    }
+
+    TEST_CASE("Endpoints do not share connections")
+    {
+        ConnectionPool pool;
+        CountingFactory factory;
+
+        pool.release("a:443", pool.acquire("a:443", factory));
+        auto other = pool.acquire("b:443", factory);
+        CHECK(*factory.made == 2);
+        CHECK(pool.idle("a:443") == 1);
+        CHECK(pool.idle("b:443") == 0);
+    }
+
+    TEST_CASE("Connections beyond max_idle are dropped")
+    {
+        ConnectionPool pool(fast_config());
+        CountingFactory factory;
+
+        auto a = pool.acquire("api:443", factory);
+        auto b = pool.acquire("api:443", factory);
+        auto c = pool.acquire("api:443", factory);
+        pool.release("api:443", std::move(a));
+        pool.release("api:443", std::move(b));
+        pool.release("api:443", std::move(c));
+        CHECK(pool.idle("api:443") == 2);
+    }
+
+    TEST_CASE("warm_up opens a connection and keeps pinging it")
+    {
+        ConnectionPool pool(fast_config());
+        CountingFactory factory;
+        auto pings = std::make_shared<std::atomic<int>>(0);
+
+        pool.warm_up("api:443", factory, [pings](httplib::Client &) {
+            ++*pings;
+            return true;
+        });
+
+        CHECK(eventually([&] { return pool.idle("api:443") == 1; }));
+        CHECK(eventually([&] { return *pings >= 3; }));
+        CHECK(*factory.made == 1);
+
+        auto connection = pool.acquire("api:443", factory);
+        CHECK(*factory.made == 1);
+
+        auto const stats = pool.stats();
+        CHECK(stats.warmed == 1);
+        CHECK(stats.reused == 1);
+        CHECK(stats.pings >= 2);
+        CHECK(stats.ping_failures == 0);
+    }
+
+    TEST_CASE("Connections failing a ping are dropped")
+    {
+        ConnectionPool pool(fast_config());
+        CountingFactory factory;
+
+        pool.warm_up("api:443", factory, [](httplib::Client &) {
+            return false;
+        });
+
+        CHECK(eventually([&] { return pool.stats().ping_failures >= 2; }));
+        CHECK(pool.idle("api:443") == 0);
+        CHECK(pool.stats().warmed == 0);
+    }
+
+    TEST_CASE("Pinging stops once keep_warm passes")
+    {
+        auto config = fast_config();
+        config.keep_warm = 20ms;
+        ConnectionPool pool(config);
+        CountingFactory factory;
+        auto pings = std::make_shared<std::atomic<int>>(0);
+
+        pool.warm_up("api:443", factory, [pings](httplib::Client &) {
+            ++*pings;
+            return true;
+        });
+
+        std::this_thread::sleep_for(100ms);
+        auto const settled = pings->load();
+        std::this_thread::sleep_for(50ms);
+        CHECK(*pings == settled);
+        CHECK(pool.idle("api:443") == 1);
+    }
+
+    TEST_CASE("Report shows reuse and warm-up counters")
+    {
+        ConnectionPool pool;
+        CountingFactory factory;
+
+        std::ostringstream empty;
+        pool.report(empty);
+        CHECK(empty.str().empty());
+
+        pool.release("api:443", pool.acquire("api:443", factory));
+        pool.release("api:443", pool.acquire("api:443", factory));
+
+        std::ostringstream out;
+        pool.report(out);
+        CHECK(out.str().find("Connections:") != std::string::npos);
+        CHECK(out.str().find("1 of 2 requests") != std::string::npos);
+    }
+}
+
+} // anonymous namespace
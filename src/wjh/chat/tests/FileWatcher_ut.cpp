@@ -0,0 +1,167 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/FileWatcher.hpp"
+#include "wjh/chat/tools/ToolCache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+using namespace std::chrono_literals;
+
+struct TempDir
+{
+    std::filesystem::path path_;
+
+    TempDir()
+    : path_(std::filesystem::temp_directory_path()
+          / "wjh_file_watcher_test_XXXXXX")
+    {
+        auto tmpl = path_.string();
+        auto * result = mkdtemp(tmpl.data());
+        REQUIRE(result != nullptr);
+        path_ = std::filesystem::canonical(result);
+    }
+
+    ~TempDir()
+    {
+        std::filesystem::remove_all(path_);
+    }
+
+    TempDir(TempDir const &) = delete;
+    TempDir & operator = (TempDir const &) = delete;
+};
+
+void
+write(std::filesystem::path const & path, std::string const & content)
+{
+    std::ofstream(path) << content;
+}
+
+/// Poll @p done until it holds or a generous deadline passes.
+template <typename Predicate>
+bool
+eventually(Predicate done)
+{
+    auto const deadline = std::chrono::steady_clock::now() + 5s;
+    while (not done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+/// Take changes from @p feed until @p expected arrives.
+bool
+receives(ChangeFeed & feed, FileChange const & expected)
+{
+    return eventually([&] {
+        auto const changes = feed.take();
+        return std::ranges::find(changes, expected) != changes.end();
+    });
+}
+
+TEST_SUITE("FileWatcher")
+{
+    TEST_CASE("A feed collapses into everything when it loses track")
+    {
+        ChangeFeed feed;
+        CHECK(feed.take().empty());
+
+        feed.push({.kind = ChangeKind::file, .path = "/a"});
+        feed.push({.kind = ChangeKind::tree, .path = "/b"});
+        CHECK(feed.take().size() == 2u);
+        CHECK(feed.take().empty());
+
+        feed.push({.kind = ChangeKind::file, .path = "/a"});
+        feed.push({.kind = ChangeKind::everything});
+        feed.push({.kind = ChangeKind::file, .path = "/c"});
+        CHECK(feed.take()
+              == std::vector<FileChange>{{.kind = ChangeKind::everything}});
+
+        for (std::size_t i = 0; i <= ChangeFeed::max_pending; ++i) {
+            feed.push({.kind = ChangeKind::file, .path = "/a"});
+        }
+        CHECK(feed.take()
+              == std::vector<FileChange>{{.kind = ChangeKind::everything}});
+    }
+
+    TEST_CASE("Coverage is the tree below the root, except .git")
+    {
+        TempDir dir;
+        FileWatcher watcher(dir.path_);
+
+        CHECK(watcher.root() == dir.path_);
+        CHECK(watcher.covers(dir.path_));
+        CHECK(watcher.covers(dir.path_ / "src" / "a.cpp"));
+        CHECK_FALSE(watcher.covers(dir.path_ / ".git" / "index"));
+        CHECK_FALSE(watcher.covers(dir.path_.parent_path() / "other"));
+        CHECK_FALSE(watcher.covers("relative/path"));
+    }
+
+    TEST_CASE("Changes to files and new directories are published")
+    {
+        TempDir dir;
+        FileWatcher watcher(dir.path_);
+        auto const feed = watcher.subscribe();
+
+        // Becoming ready is announced as a change to everything.
+        REQUIRE(eventually([&] { return watcher.ready_epoch() != 0; }));
+        CHECK(feed->take()
+              == std::vector<FileChange>{{.kind = ChangeKind::everything}});
+
+        write(dir.path_ / "a.txt", "one");
+        CHECK(receives(
+            *feed,
+            {.kind = ChangeKind::file, .path = dir.path_ / "a.txt"}));
+
+        std::filesystem::create_directory(dir.path_ / "sub");
+        CHECK(receives(
+            *feed,
+            {.kind = ChangeKind::tree, .path = dir.path_ / "sub"}));
+        write(dir.path_ / "sub" / "b.txt", "two");
+        CHECK(receives(
+            *feed,
+            {.kind = ChangeKind::file, .path = dir.path_ / "sub" / "b.txt"}));
+    }
+
+    TEST_CASE("A watched cache trusts covered files until they change")
+    {
+        TempDir dir;
+        auto const file = dir.path_ / "a.txt";
+        write(file, "one\n");
+        auto watcher = std::make_shared<FileWatcher>(dir.path_);
+        REQUIRE(eventually([&] { return watcher->ready_epoch() != 0; }));
+
+        ToolCache cache;
+        cache.watch(watcher);
+        cache.store_file("k", file, *file_identity(file), "result");
+        cache.store_command("ls", "listing");
+
+        CHECK(cache.lookup("k").has_value());
+        CHECK(cache.stats().unchecked_hits == 1u);
+
+        write(file, "one\ntwo\n");
+        CHECK(eventually([&] { return not cache.lookup("k").has_value(); }));
+        CHECK_FALSE(cache.lookup("ls").has_value());
+    }
+}
+
+} // anonymous namespace
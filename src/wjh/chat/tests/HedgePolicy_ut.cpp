@@ -0,0 +1,139 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/HedgePolicy.hpp"
+#include "wjh/chat/client/RetryPolicy.hpp"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stop_token>
+#include <thread>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+using namespace std::chrono_literals;
+
+TEST_SUITE("HedgePolicy")
+{
+    TEST_CASE("Initial delay until enough samples")
+    {
+        HedgePolicy policy(HedgeConfig{
+            .initial_delay = 5000ms,
+            .min_delay = 10ms,
+            .min_samples = 4});
+
+        CHECK(policy.threshold() == 5000ms);
+        policy.record_latency(100ms);
+        policy.record_latency(200ms);
+        policy.record_latency(300ms);
+        CHECK(policy.threshold() == 5000ms);
+        policy.record_latency(400ms);
+        CHECK(policy.threshold() == 400ms);
+    }
+
+    TEST_CASE("Threshold tracks the configured percentile")
+    {
+        HedgePolicy policy(HedgeConfig{
+            .percentile = 0.5,
+            .min_delay = 10ms,
+            .window = 10,
+            .min_samples = 1});
+
+        for (int i = 1; i <= 10; ++i) {
+            policy.record_latency(std::chrono::milliseconds{i * 100});
+        }
+        CHECK(policy.threshold() == 500ms);
+
+        // The window slides: old fast samples are forgotten.
+        for (int i = 0; i < 10; ++i) {
+            policy.record_latency(2000ms);
+        }
+        CHECK(policy.threshold() == 2000ms);
+    }
+
+    TEST_CASE("Threshold never drops below the minimum")
+    {
+        HedgePolicy policy(HedgeConfig{.min_delay = 1000ms, .min_samples = 1});
+        policy.record_latency(5ms);
+        CHECK(policy.threshold() == 1000ms);
+    }
+
+    TEST_CASE("A fast failure is returned without hedging")
+    {
+        HedgePolicy policy(HedgeConfig{.initial_delay = 10'000ms});
+        HttpClient client(Hostname{"127.0.0.1"}, PortNumber{1});
+        client.set_connection_timeout(TimeoutSeconds{1});
+
+        auto outcome = policy.post(
+            client,
+            HttpPath{"/"},
+            HttpBody{"{}"},
+            HttpBody{"{}"},
+            HttpHeaders{});
+
+        CHECK_FALSE(outcome.response.has_value());
+        CHECK_FALSE(outcome.hedged);
+
+        auto s = policy.stats();
+        CHECK(s.requests == 1);
+        CHECK(s.hedged == 0);
+    }
+
+    TEST_CASE("Cancelling a hedged request stops both copies")
+    {
+        // Each copy fails at once, then waits out a long retry backoff
+        // that only a stop request ends early.
+        HttpClient client(Hostname{"127.0.0.1"}, PortNumber{1});
+        client.set_retry_policy(std::make_shared<RetryPolicy>(
+            RetryPolicyConfig{
+                .max_retries = 1,
+                .sleep = [](std::chrono::milliseconds, std::stop_token stop) {
+                    std::mutex mutex;
+                    std::condition_variable_any cv;
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait_for(lock, stop, 30s, [] { return false; });
+                }}));
+        HedgePolicy policy(HedgeConfig{.initial_delay = 50ms});
+
+        std::stop_source stop;
+        std::jthread canceller([&stop] {
+            std::this_thread::sleep_for(300ms);
+            stop.request_stop();
+        });
+
+        auto const start = std::chrono::steady_clock::now();
+        auto outcome = policy.post(
+            client,
+            HttpPath{"/"},
+            HttpBody{"{}"},
+            HttpBody{"{}"},
+            HttpHeaders{},
+            stop.get_token());
+
+        CHECK(std::chrono::steady_clock::now() - start < 10s);
+        CHECK_FALSE(outcome.response.has_value());
+        CHECK(outcome.hedged);
+        CHECK(policy.stats().hedged == 1);
+    }
+
+    TEST_CASE("Report shows hedge rate and extra cost")
+    {
+        HedgePolicy policy(HedgeConfig{.provider = "Fallback"});
+        policy.charge(1200);
+
+        std::ostringstream out;
+        policy.report(out);
+        CHECK(out.str().find("via Fallback") != std::string::npos);
+        CHECK(out.str().find("1200 prompt tokens") != std::string::npos);
+    }
+}
+
+} // anonymous namespace
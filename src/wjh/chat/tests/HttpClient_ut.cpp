@@ -0,0 +1,76 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/HttpClient.hpp"
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+
+TEST_SUITE("HttpClient")
+{
+    TEST_CASE("parse_base_url: HTTPS with path prefix")
+    {
+        auto endpoint = parse_base_url("https://openrouter.ai/api/v1/");
+
+        REQUIRE(endpoint.has_value());
+        CHECK(endpoint->scheme == HttpScheme::https);
+        CHECK(endpoint->host == Hostname{"openrouter.ai"});
+        CHECK(endpoint->port == PortNumber{443});
+        CHECK(endpoint->path_prefix == "/api/v1");
+    }
+
+    TEST_CASE("parse_base_url: plain HTTP with port")
+    {
+        auto endpoint = parse_base_url("http://localhost:8080");
+
+        REQUIRE(endpoint.has_value());
+        CHECK(endpoint->scheme == HttpScheme::http);
+        CHECK(endpoint->host == Hostname{"localhost"});
+        CHECK(endpoint->port == PortNumber{8080});
+        CHECK(endpoint->path_prefix.empty());
+    }
+
+    TEST_CASE("parse_base_url: IPv6 literal")
+    {
+        auto endpoint = parse_base_url("http://[::1]:9000/v1");
+
+        REQUIRE(endpoint.has_value());
+        CHECK(endpoint->host == Hostname{"::1"});
+        CHECK(endpoint->port == PortNumber{9000});
+        CHECK(endpoint->path_prefix == "/v1");
+    }
+
+    TEST_CASE("parse_base_url: Unix domain sockets")
+    {
+        auto plain = parse_base_url("unix:///run/gateway.sock");
+        REQUIRE(plain.has_value());
+        CHECK(plain->scheme == HttpScheme::unix_socket);
+        CHECK(plain->host == Hostname{"/run/gateway.sock"});
+        CHECK(plain->path_prefix.empty());
+
+        auto encoded = parse_base_url("http+unix://%2Frun%2Fgateway.sock/v1");
+        REQUIRE(encoded.has_value());
+        CHECK(encoded->scheme == HttpScheme::unix_socket);
+        CHECK(encoded->host == Hostname{"/run/gateway.sock"});
+        CHECK(encoded->path_prefix == "/v1");
+    }
+
+    TEST_CASE("parse_base_url: malformed URLs")
+    {
+        CHECK_FALSE(parse_base_url("openrouter.ai").has_value());
+        CHECK_FALSE(parse_base_url("ftp://example.com").has_value());
+        CHECK_FALSE(parse_base_url("http://example.com:0").has_value());
+        CHECK_FALSE(parse_base_url("http://example.com:http").has_value());
+        CHECK_FALSE(parse_base_url("http:///v1").has_value());
+        CHECK_FALSE(parse_base_url("unix://relative.sock").has_value());
+        CHECK_FALSE(parse_base_url("http+unix://%2Frun%2").has_value());
+    }
+}
+
+} // anonymous namespace
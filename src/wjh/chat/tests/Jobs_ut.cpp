@@ -0,0 +1,133 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/Jobs.hpp"
+#include "wjh/chat/tools/Tools.hpp"
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+#include <sys/wait.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+using namespace std::chrono_literals;
+
+TEST_SUITE("Jobs")
+{
+    TEST_CASE("An output ring keeps the newest bytes")
+    {
+        OutputRing ring(8);
+        ring.append("abc");
+        CHECK(ring.since(0).text == "abc");
+        CHECK(ring.since(1).text == "bc");
+
+        ring.append("defghij");
+        CHECK(ring.total() == 10u);
+        auto const slice = ring.since(0);
+        CHECK(slice.text == "cdefghij");
+        CHECK(slice.skipped == 2u);
+        CHECK(ring.since(9).text == "j");
+        CHECK(ring.since(10).text.empty());
+
+        ring.append("0123456789ABCDEF");
+        CHECK(ring.total() == 26u);
+        CHECK(ring.since(20).text == "ABCDEF");
+        CHECK(ring.since(0).text == "89ABCDEF");
+    }
+
+    TEST_CASE("A job's output and exit status are collected")
+    {
+        JobManager jobs;
+        auto const id = jobs.start("echo one; echo two >&2; exit 3");
+        REQUIRE(id.has_value());
+
+        CHECK(jobs.wait(*id, 10s));
+        auto const info = jobs.info(*id);
+        REQUIRE(info.has_value());
+        REQUIRE(info->status.has_value());
+        CHECK(WEXITSTATUS(*info->status) == 3);
+        CHECK(info->unread_bytes == 8u);
+        CHECK(jobs.running() == 0u);
+
+        auto const output = jobs.read(*id);
+        REQUIRE(output.has_value());
+        CHECK(output->text == "one\ntwo\n");
+        CHECK(jobs.read(*id)->text.empty());
+        CHECK(jobs.info(*id)->unread_bytes == 0u);
+
+        CHECK_FALSE(jobs.read(99).has_value());
+        CHECK_FALSE(jobs.wait(99, 0s));
+    }
+
+    TEST_CASE("Waiting gives up after the timeout or on a stop")
+    {
+        JobManager jobs;
+        auto const id = jobs.start("sleep 30");
+        REQUIRE(id.has_value());
+        CHECK(jobs.running() == 1u);
+        CHECK_FALSE(jobs.wait(*id, 50ms));
+
+        std::stop_source stop;
+        stop.request_stop();
+        CHECK_FALSE(jobs.wait(*id, 30s, stop.get_token()));
+    }
+
+    TEST_CASE("Running jobs are killed when the manager goes away")
+    {
+        auto const start = std::chrono::steady_clock::now();
+        {
+            JobManager jobs;
+            REQUIRE(jobs.start("sleep 30 & sleep 30; wait").has_value());
+            REQUIRE(jobs.start("sleep 30").has_value());
+        }
+        // Both sleeps of the first job held its output open: the
+        // whole group was terminated, without waiting for SIGKILL.
+        CHECK(std::chrono::steady_clock::now() - start < 1500ms);
+    }
+
+    TEST_CASE("Only so many jobs run at once")
+    {
+        JobManager jobs(JobConfig{.output_bytes = 1024, .max_running = 1});
+        REQUIRE(jobs.start("sleep 30").has_value());
+        auto const second = jobs.start("true");
+        REQUIRE_FALSE(second.has_value());
+        CHECK(second.error().find("1 jobs are already running")
+              != std::string::npos);
+    }
+
+    TEST_CASE("The job tools report ids, state and new output")
+    {
+        JobManager jobs;
+        CHECK(execute_job_status(jobs, nlohmann::json::object())
+              == "No background jobs");
+
+        auto const started =
+            execute_start_job(jobs, {{"command", "echo built"}});
+        CHECK(started.starts_with("Started job 1 (pid "));
+        CHECK(started.ends_with("): echo built"));
+
+        auto const output = execute_job_output(
+            jobs,
+            {{"job_id", 1}, {"wait_seconds", 10}});
+        CHECK(output.starts_with("built\n[job 1: exit code 0 after "));
+        CHECK(execute_job_output(jobs, {{"job_id", 1}})
+                  .starts_with("[no new output]\n[job 1: exit code 0"));
+
+        auto const status = execute_job_status(jobs, {{"job_id", 1}});
+        CHECK(status.starts_with("job 1 (pid "));
+        CHECK(status.find("6 bytes of output, 0 unread\n  echo built")
+              != std::string::npos);
+        CHECK(execute_job_status(jobs, {{"job_id", 7}})
+              == "Error: no job 7");
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,79 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/LiveOutput.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+using namespace std::chrono_literals;
+
+TEST_SUITE("LiveOutput")
+{
+    TEST_CASE("Everything written is rendered in order by finish")
+    {
+        std::ostringstream out;
+        LiveOutput live(out, {.interval = 1h});
+        live.write("one ");
+        live.write("two ");
+        live.write("three");
+        live.finish();
+
+        CHECK(out.str() == "one two three");
+        CHECK(live.dropped() == 0u);
+    }
+
+    TEST_CASE("Writes after finish go straight to the stream")
+    {
+        std::ostringstream out;
+        LiveOutput live(out);
+        live.finish();
+        live.write("late");
+        CHECK(out.str() == "late");
+    }
+
+    TEST_CASE("A backlog keeps the newest bytes and notes the rest")
+    {
+        std::ostringstream out;
+        LiveOutput live(out, {.interval = 1h, .max_pending = 8});
+        live.write("abcdef");
+        live.write("ghijkl");
+        live.finish();
+
+        CHECK(live.dropped() == 4u);
+        CHECK(out.str() == "\n[... 4 bytes not shown ...]\nefghijkl");
+    }
+
+    TEST_CASE("A single write larger than the backlog keeps its tail")
+    {
+        std::ostringstream out;
+        LiveOutput live(out, {.interval = 1h, .max_pending = 4});
+        live.write("ab");
+        live.write("0123456789");
+        live.finish();
+
+        CHECK(live.dropped() == 8u);
+        CHECK(out.str().ends_with("...]\n6789"));
+    }
+
+    TEST_CASE("The destructor renders what is pending")
+    {
+        std::ostringstream out;
+        {
+            LiveOutput live(out, {.interval = 1h});
+            live.write("bye");
+        }
+        CHECK(out.str() == "bye");
+    }
+}
+
+} // anonymous namespace
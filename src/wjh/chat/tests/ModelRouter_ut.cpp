@@ -0,0 +1,166 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/ModelRouter.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+using namespace std::chrono_literals;
+
+using Models = std::vector<std::string>;
+
+/// A network response whose first byte took @p ttft.
+RouteObservation
+observation(
+    std::string model,
+    std::chrono::milliseconds ttft,
+    std::string provider = "Fast")
+{
+    return RouteObservation{
+        .model = std::move(model),
+        .provider = std::move(provider),
+        .timing = HttpTiming{
+            .wait = ttft,
+            .receive = 500ms,
+            .total = ttft + 500ms},
+        .completion_tokens = 100};
+}
+
+TEST_SUITE("ModelRouter")
+{
+    TEST_CASE("split_list trims and drops empty entries")
+    {
+        CHECK(split_list("a, b ,,c") == Models{"a", "b", "c"});
+        CHECK(split_list("").empty());
+        CHECK(split_list(" , ").empty());
+    }
+
+    TEST_CASE("Provider preferences become the provider object")
+    {
+        auto const prefs = ProviderPreferences{
+            .sort = "latency", .only = {"A", "B"}, .ignore = {"C"}};
+        auto const json = prefs.to_json();
+
+        CHECK(json["sort"] == "latency");
+        CHECK(json["only"] == nlohmann::json{"A", "B"});
+        CHECK(json["ignore"] == nlohmann::json{"C"});
+        CHECK(ProviderPreferences{}.empty());
+        CHECK(ProviderPreferences{}.to_json().empty());
+        CHECK(is_provider_sort("throughput"));
+        CHECK_FALSE(is_provider_sort("fastest"));
+    }
+
+    TEST_CASE("Failed models move behind the healthy ones")
+    {
+        ModelRouter router(RouterConfig{.models = {"big", "mid", "small"}});
+        CHECK(router.candidates() == Models{"big", "mid", "small"});
+
+        router.record_failure("big", "API error (503)");
+        CHECK(router.candidates() == Models{"mid", "small", "big"});
+
+        router.record_failure("mid", "API error (503)");
+        CHECK(router.candidates() == Models{"small", "big", "mid"});
+    }
+
+    TEST_CASE("Cooldown expires")
+    {
+        ModelRouter router(
+            RouterConfig{.models = {"big", "small"}, .cooldown = 0ms});
+        router.record_failure("big", "timeout");
+        CHECK(router.candidates() == Models{"big", "small"});
+    }
+
+    TEST_CASE("Repeated SLO breaches demote a model")
+    {
+        ModelRouter router(RouterConfig{
+            .models = {"big", "small"},
+            .ttft_slo = 1000ms,
+            .breach_limit = 2});
+
+        router.record_success(observation("big", 3000ms));
+        CHECK(router.candidates().front() == "big");
+
+        // A fast response resets the count.
+        router.record_success(observation("big", 200ms));
+        router.record_success(observation("big", 3000ms));
+        CHECK(router.candidates().front() == "big");
+
+        router.record_success(observation("big", 3000ms));
+        CHECK(router.candidates() == Models{"small", "big"});
+
+        auto const stats = router.stats();
+        REQUIRE(stats.contains("big via Fast"));
+        CHECK(stats.at("big via Fast").requests == 4);
+        CHECK(stats.at("big via Fast").slo_breaches == 3);
+    }
+
+    TEST_CASE("Statistics are kept per model and provider")
+    {
+        ModelRouter router(RouterConfig{.models = {"big"}});
+        router.record_success(observation("big", 100ms, "Fast"));
+        router.record_success(observation("big", 900ms, "Slow"));
+        router.record_failure("big", "boom");
+
+        auto const stats = router.stats();
+        CHECK(stats.size() == 3);
+        CHECK(stats.at("big via Fast").ttft.max() == 100ms);
+        CHECK(stats.at("big via Slow").completion_tokens == 100);
+        CHECK(stats.at("big via -").failures == 1);
+
+        std::ostringstream out;
+        router.report(out);
+        CHECK(out.str().find("Routing") != std::string::npos);
+        CHECK(out.str().find("big via Slow") != std::string::npos);
+    }
+
+    TEST_CASE("Decisions are appended to the route log")
+    {
+        auto const path = std::filesystem::temp_directory_path()
+            / "wjh_chat_route_log_ut.jsonl";
+        std::filesystem::remove(path);
+        {
+            ModelRouter router(RouterConfig{
+                .models = {"big", "small"},
+                .ttft_slo = 1000ms,
+                .breach_limit = 1,
+                .log_path = path.string()});
+            router.record_failure("small", "API error (500)");
+            router.record_success(observation("big", 2000ms));
+        }
+
+        std::ifstream in(path);
+        std::vector<nlohmann::json> entries;
+        for (std::string line; std::getline(in, line);) {
+            entries.push_back(nlohmann::json::parse(line));
+        }
+        std::filesystem::remove(path);
+
+        REQUIRE(entries.size() == 3);
+        CHECK(entries[0]["event"] == "failure");
+        CHECK(entries[0]["model"] == "small");
+        CHECK(entries[1]["event"] == "success");
+        CHECK(entries[1]["slo_breach"] == true);
+        CHECK(entries[2]["event"] == "demoted");
+        CHECK(entries[2].contains("time_ms"));
+    }
+
+    TEST_CASE("Report is empty before any request")
+    {
+        ModelRouter router(RouterConfig{.models = {"big"}});
+        std::ostringstream out;
+        router.report(out);
+        CHECK(out.str().empty());
+    }
+}
+
+} // anonymous namespace
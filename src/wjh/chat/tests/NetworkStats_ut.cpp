@@ -0,0 +1,94 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/NetworkStats.hpp"
+
+#include <sstream>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+using namespace std::chrono_literals;
+
+TEST_SUITE("NetworkStats")
+{
+    TEST_CASE("Histogram buckets double in width")
+    {
+        LatencyHistogram h;
+        h.record(500us);
+        h.record(1ms);
+        h.record(3ms);
+        h.record(3999us);
+        h.record(10min);
+
+        CHECK(h.buckets()[0] == 1);
+        CHECK(h.buckets()[1] == 1);
+        CHECK(h.buckets()[2] == 2);
+        CHECK(h.buckets().back() == 1);
+        CHECK(h.count() == 5);
+        CHECK(h.max() == 10min);
+    }
+
+    TEST_CASE("Percentiles are interpolated within buckets")
+    {
+        LatencyHistogram h;
+        for (int i = 0; i < 90; ++i) {
+            h.record(100ms);
+        }
+        for (int i = 0; i < 10; ++i) {
+            h.record(3000ms);
+        }
+
+        // 100 ms lands in [64, 128) ms.
+        CHECK(h.percentile(0.5) > 64ms);
+        CHECK(h.percentile(0.5) < 128ms);
+        CHECK(h.percentile(0.9) == 128ms);
+
+        // Never above the largest value seen.
+        CHECK(h.percentile(0.99) == 3000ms);
+        CHECK(LatencyHistogram{}.percentile(0.5) == 0us);
+    }
+
+    TEST_CASE("Timings are aggregated per phase")
+    {
+        NetworkStats stats;
+        stats.record(HttpTiming{
+            .dns = 2ms,
+            .connect = 40ms,
+            .wait = 900ms,
+            .total = 950ms,
+            .request_bytes = 2048,
+            .response_bytes = 512});
+        stats.record(HttpTiming{.wait = 1200ms, .total = 1300ms});
+
+        CHECK(stats.histogram(NetworkPhase::wait).count() == 2);
+        CHECK(stats.histogram(NetworkPhase::wait).max() == 1200ms);
+        CHECK(stats.histogram(NetworkPhase::dns).max() == 2ms);
+
+        auto const totals = stats.totals();
+        CHECK(totals.requests == 2);
+        CHECK(totals.request_bytes == 2048);
+        CHECK(totals.response_bytes == 512);
+
+        std::ostringstream out;
+        stats.report(out);
+        CHECK(out.str().find("2 requests, 2.0 KiB sent, 512 B received")
+              != std::string::npos);
+        CHECK(out.str().find("wait") != std::string::npos);
+        CHECK(out.str().find("< 1024 ms") != std::string::npos);
+    }
+
+    TEST_CASE("Nothing is reported before the first request")
+    {
+        std::ostringstream out;
+        NetworkStats{}.report(out);
+        CHECK(out.str().empty());
+    }
+}
+
+} // anonymous namespace
@@ -7,8 +7,15 @@
 #define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
 #include "wjh/chat/client/OpenRouterClient.hpp"
 
+#include "wjh/chat/client/ResponseCache.hpp"
 #include "wjh/chat/conversation/Conversation.hpp"
 
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <utility>
+
 #include "testing/doctest.hpp"
 
 namespace {
@@ -360,6 +367,104 @@ TEST_SUITE("OpenRouterClient")
         }
     }
 
+    TEST_CASE("Token usage parsing")
+    {
+        SUBCASE("Basic counters") {
+            auto usage = parse_token_usage(nlohmann::json::parse(R"({
+                "prompt_tokens": 50,
+                "completion_tokens": 10,
+                "total_tokens": 60
+            })"));
+
+            CHECK(usage.prompt_tokens == PromptTokens{50u});
+            CHECK(usage.completion_tokens == CompletionTokens{10u});
+            CHECK(usage.total_tokens == TotalTokens{60u});
+            CHECK(usage.cached_tokens == CachedTokens{0u});
+            CHECK(usage.cache_write_tokens == CacheWriteTokens{0u});
+        }
+
+        SUBCASE("OpenRouter prompt_tokens_details") {
+            auto usage = parse_token_usage(nlohmann::json::parse(R"({
+                "prompt_tokens": 1200,
+                "completion_tokens": 30,
+                "total_tokens": 1230,
+                "prompt_tokens_details": {
+                    "cached_tokens": 1000,
+                    "cache_write_tokens": 150
+                }
+            })"));
+
+            CHECK(usage.cached_tokens == CachedTokens{1000u});
+            CHECK(usage.cache_write_tokens == CacheWriteTokens{150u});
+        }
+
+        SUBCASE("Anthropic-native field names") {
+            auto usage = parse_token_usage(nlohmann::json::parse(R"({
+                "prompt_tokens": 900,
+                "completion_tokens": 5,
+                "total_tokens": 905,
+                "cache_read_input_tokens": 800,
+                "cache_creation_input_tokens": 64
+            })"));
+
+            CHECK(usage.cached_tokens == CachedTokens{800u});
+            CHECK(usage.cache_write_tokens == CacheWriteTokens{64u});
+        }
+
+        SUBCASE("Null details are ignored") {
+            auto usage = parse_token_usage(nlohmann::json::parse(R"({
+                "prompt_tokens": 10,
+                "prompt_tokens_details": null
+            })"));
+
+            CHECK(usage.prompt_tokens == PromptTokens{10u});
+            CHECK(usage.cached_tokens == CachedTokens{0u});
+        }
+    }
+
+    TEST_CASE("Agent loop limits")
+    {
+        using std::chrono::milliseconds;
+        auto const limits = AgentLimits{
+            .max_iterations = 5,
+            .deadline = milliseconds{30'000},
+            .token_budget = 1000};
+
+        SUBCASE("Within every limit") {
+            CHECK_FALSE(
+                agent_limit_reached(limits, 4, milliseconds{29'999}, 999)
+                    .has_value());
+        }
+
+        SUBCASE("Iteration limit") {
+            auto const limit =
+                agent_limit_reached(limits, 5, milliseconds{0}, 0);
+            REQUIRE(limit.has_value());
+            CHECK(*limit == "the limit of 5 tool-calling steps");
+        }
+
+        SUBCASE("Deadline") {
+            auto const limit =
+                agent_limit_reached(limits, 1, milliseconds{30'000}, 0);
+            REQUIRE(limit.has_value());
+            CHECK(*limit == "the time limit of 30 s");
+        }
+
+        SUBCASE("Token budget") {
+            auto const limit =
+                agent_limit_reached(limits, 1, milliseconds{0}, 1200);
+            REQUIRE(limit.has_value());
+            CHECK(*limit == "the budget of 1000 tokens (1200 used)");
+        }
+
+        SUBCASE("Zero deadline and budget mean none") {
+            auto const unbounded = AgentLimits{.max_iterations = 5};
+            CHECK_FALSE(agent_limit_reached(
+                            unbounded, 4, milliseconds{10'000'000}, 1'000'000)
+                            .has_value());
+        }
+    }
+
     TEST_CASE("Agent loop message structures")
     {
         SUBCASE("Tool result message format") {
@@ -536,6 +641,109 @@ TEST_SUITE("OpenRouterClient")
             CHECK(parsed == assistant_msg);
         }
     }
+
+    TEST_CASE("A garbled response fails the request without throwing")
+    {
+        auto const cache = std::make_shared<ResponseCache>(
+            ResponseCacheConfig{.offline = true});
+        auto config = makeTestConfig();
+        config.temperature = Temperature{0.0f};
+        config.response_cache = cache;
+        OpenRouterClient client(std::move(config));
+        Conversation conversation;
+        conversation.add_message(UserInput{"List the files"});
+
+        // The offline cache names the request it has no response for.
+        auto const miss = client.send_message(conversation);
+        REQUIRE_FALSE(miss.has_value());
+        auto const key = miss.error().substr(miss.error().rfind(' ') + 1);
+        auto const reply = [&](std::string const & body) {
+            cache->store(key, body, std::chrono::milliseconds{0});
+            return client.send_message(conversation);
+        };
+
+        auto const garbled = reply(
+            R"({"choices": [{"message": {"role": "assistant", )"
+            R"("tool_calls": [{"id": "call_1", "type": "function", )"
+            R"("function": {"name": "bash", "arguments": "{ls"}}]}}]})");
+        REQUIRE_FALSE(garbled.has_value());
+        CHECK(garbled.error().starts_with("Malformed tool call"));
+
+        auto const nameless = reply(
+            R"({"choices": [{"message": {"tool_calls": [{"id": "c", )"
+            R"("function": {"arguments": "{}"}}]}}]})");
+        REQUIRE_FALSE(nameless.has_value());
+        CHECK(nameless.error().starts_with("Malformed tool call"));
+
+        auto const empty = reply(R"({"choices": []})");
+        REQUIRE_FALSE(empty.has_value());
+        CHECK(empty.error() == "API response contains no message");
+    }
+
+    TEST_CASE("Only failures of the model move on to the next one")
+    {
+        Conversation conversation;
+        conversation.add_message(UserInput{"Hello"});
+        auto const routed = [&](bool offline) {
+            auto config = makeTestConfig();
+            config.temperature = Temperature{0.0f};
+            config.response_cache = std::make_shared<ResponseCache>(
+                ResponseCacheConfig{.offline = offline});
+            config.retry.max_retries = 0;
+            config.routing.models = {"first/model", "second/model"};
+            OpenRouterClient client(std::move(config));
+            REQUIRE_FALSE(client.send_message(conversation).has_value());
+            std::ostringstream out;
+            client.report_stats(out);
+            return out.str();
+        };
+
+        // No model has the answer offline; none is to blame for that.
+        auto const offline = routed(true);
+        CHECK(offline.find("first/model") == std::string::npos);
+        CHECK(offline.find("second/model") == std::string::npos);
+
+        // A connection failure is tried on every model, and counts.
+        auto const unreachable = routed(false);
+        CHECK(unreachable.find("first/model") != std::string::npos);
+        CHECK(unreachable.find("second/model") != std::string::npos);
+    }
+
+    TEST_CASE("Only requests with temperature 0 use the response cache")
+    {
+        Conversation conversation;
+        conversation.add_message(UserInput{"Hello"});
+        auto const send = [&](std::optional<Temperature> temperature,
+                              bool offline) {
+            auto const cache = std::make_shared<ResponseCache>(
+                ResponseCacheConfig{.offline = offline});
+            auto config = makeTestConfig();
+            config.temperature = temperature;
+            config.response_cache = cache;
+            config.retry.max_retries = 0;
+            OpenRouterClient client(std::move(config));
+            auto const result = client.send_message(conversation);
+            REQUIRE_FALSE(result.has_value());
+            return std::pair(result.error(), cache->stats());
+        };
+
+        auto const [sampled, sampled_stats] = send(Temperature{0.7f}, true);
+        CHECK(sampled.find("temperature 0") != std::string::npos);
+        CHECK(sampled_stats.misses == 0u);
+
+        auto const [unset, unset_stats] = send(std::nullopt, true);
+        CHECK(unset.find("temperature 0") != std::string::npos);
+        CHECK(unset_stats.misses == 0u);
+
+        auto const [exact, exact_stats] = send(Temperature{0.0f}, true);
+        CHECK(exact.starts_with("Offline mode: no cached response"));
+        CHECK(exact_stats.misses == 1u);
+
+        // Online, a sampled request goes straight to the API.
+        auto const online_stats = send(Temperature{1.0f}, false).second;
+        CHECK(online_stats.misses == 0u);
+        CHECK(online_stats.stores == 0u);
+    }
 }
 
 } // anonymous namespace
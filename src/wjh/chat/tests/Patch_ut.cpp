@@ -0,0 +1,226 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/Patch.hpp"
+
+#include <string>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+
+std::string
+numbered(int first, int last)
+{
+    std::string text;
+    for (int i = first; i <= last; ++i) {
+        text += "line " + std::to_string(i) + "\n";
+    }
+    return text;
+}
+
+FilePatch
+only_file(std::string_view diff)
+{
+    auto patches = parse_patch(diff);
+    REQUIRE(patches.has_value());
+    REQUIRE(patches->size() == 1u);
+    return patches->front();
+}
+
+TEST_SUITE("Patch")
+{
+    TEST_CASE("Git diffs parse into files and hunks")
+    {
+        auto const patches = parse_patch(
+            "Commit message, ignored\n"
+            "diff --git a/src/x.cpp b/src/x.cpp\n"
+            "index 123..456 100644\n"
+            "--- a/src/x.cpp\n"
+            "+++ b/src/x.cpp\n"
+            "@@ -3,3 +3,3 @@ int main()\n"
+            " keep\n"
+            "-old\n"
+            "+new\n"
+            " keep\n"
+            "@@ -20 +20,2 @@\n"
+            " tail\n"
+            "+more\n"
+            "--- /dev/null\n"
+            "+++ b/new.txt\t2025-01-01 00:00:00\n"
+            "@@ -0,0 +1 @@\n"
+            "+hello\n");
+
+        REQUIRE(patches.has_value());
+        REQUIRE(patches->size() == 2u);
+        auto const & x = (*patches)[0];
+        CHECK(x.old_path == "src/x.cpp");
+        CHECK(x.new_path == "src/x.cpp");
+        REQUIRE(x.hunks.size() == 2u);
+        CHECK(x.hunks[0].old_start == 3u);
+        CHECK(x.hunks[0].lines.size() == 4u);
+        CHECK(x.hunks[1].old_start == 20u);
+        CHECK((*patches)[1].old_path.empty());
+        CHECK((*patches)[1].new_path == "new.txt");
+    }
+
+    TEST_CASE("Text without file sections is rejected")
+    {
+        CHECK_FALSE(parse_patch("just some prose\n").has_value());
+        CHECK_FALSE(parse_patch("--- a/x\n+++ b/x\n").has_value());
+    }
+
+    TEST_CASE("A hunk applies where its header says")
+    {
+        auto const patch = only_file(
+            "--- a/f\n+++ b/f\n"
+            "@@ -4,3 +4,3 @@\n"
+            " line 4\n"
+            "-line 5\n"
+            "+LINE FIVE\n"
+            " line 6\n");
+        auto const result = apply_file_patch(numbered(1, 10), patch);
+
+        REQUIRE(result.applied());
+        CHECK(result.hunks[0].line == 4u);
+        CHECK(result.hunks[0].offset == 0);
+        CHECK(result.hunks[0].fuzz == 0u);
+        CHECK(result.contents
+              == numbered(1, 4) + "LINE FIVE\n" + numbered(6, 10));
+    }
+
+    TEST_CASE("A hunk whose lines moved is found at an offset")
+    {
+        auto const patch = only_file(
+            "--- a/f\n+++ b/f\n"
+            "@@ -4,3 +4,2 @@\n"
+            " line 14\n"
+            "-line 15\n"
+            " line 16\n");
+        auto const result = apply_file_patch(numbered(1, 30), patch);
+
+        REQUIRE(result.applied());
+        CHECK(result.hunks[0].line == 14u);
+        CHECK(result.hunks[0].offset == 10);
+        CHECK(result.contents == numbered(1, 14) + numbered(16, 30));
+    }
+
+    TEST_CASE("Later hunks inherit the earlier offset")
+    {
+        auto const patch = only_file(
+            "--- a/f\n+++ b/f\n"
+            "@@ -1,2 +1,3 @@\n"
+            " line 1\n"
+            "+inserted\n"
+            " line 2\n"
+            "@@ -8,2 +9,1 @@\n"
+            "-line 8\n"
+            " line 9\n");
+        auto const result = apply_file_patch(numbered(1, 10), patch);
+
+        REQUIRE(result.applied());
+        CHECK(result.hunks[1].line == 8u);
+        CHECK(result.contents
+              == "line 1\ninserted\n" + numbered(2, 7) + numbered(9, 10));
+    }
+
+    TEST_CASE("Stale context is tolerated with fuzz")
+    {
+        auto const patch = only_file(
+            "--- a/f\n+++ b/f\n"
+            "@@ -3,5 +3,5 @@\n"
+            " line 3 (edited since)\n"
+            " line 4\n"
+            "-line 5\n"
+            "+five\n"
+            " line 6\n"
+            " line 7\n");
+
+        auto const strict = apply_file_patch(numbered(1, 9), patch, 0);
+        CHECK_FALSE(strict.applied());
+        CHECK(strict.contents == numbered(1, 9));
+
+        auto const fuzzy = apply_file_patch(numbered(1, 9), patch);
+        REQUIRE(fuzzy.applied());
+        CHECK(fuzzy.hunks[0].fuzz == 1u);
+        CHECK(fuzzy.contents == numbered(1, 4) + "five\n" + numbered(6, 9));
+    }
+
+    TEST_CASE("A hunk that matches nowhere fails the file")
+    {
+        auto const patch = only_file(
+            "--- a/f\n+++ b/f\n"
+            "@@ -1,2 +1,2 @@\n"
+            " line 1\n"
+            "-line 2\n"
+            "+two\n"
+            "@@ -5,1 +5,1 @@\n"
+            "-no such line\n"
+            "+x\n");
+        auto const result = apply_file_patch(numbered(1, 6), patch);
+
+        CHECK_FALSE(result.applied());
+        CHECK(result.hunks[0].applied);
+        CHECK_FALSE(result.hunks[1].applied);
+        CHECK(result.contents == numbered(1, 6));
+    }
+
+    TEST_CASE("Miscounted headers and stripped blank lines still apply")
+    {
+        auto const patch = only_file(
+            "--- a/f\n+++ b/f\n"
+            "@@ -1,99 +1,1 @@\n"
+            " a\n"
+            "\n"
+            "-b\n"
+            "+B\n");
+        auto const result = apply_file_patch("a\n\nb\n", patch);
+
+        REQUIRE(result.applied());
+        CHECK(result.contents == "a\n\nB\n");
+    }
+
+    TEST_CASE("New files and missing final newlines")
+    {
+        auto const created = only_file(
+            "--- /dev/null\n+++ b/f\n"
+            "@@ -0,0 +1,2 @@\n"
+            "+one\n"
+            "+two\n"
+            "\\ No newline at end of file\n");
+        auto const result = apply_file_patch("", created);
+        REQUIRE(result.applied());
+        CHECK(result.contents == "one\ntwo");
+
+        auto const terminated = only_file(
+            "--- a/f\n+++ b/f\n"
+            "@@ -1,2 +1,2 @@\n"
+            " one\n"
+            "-two\n"
+            "\\ No newline at end of file\n"
+            "+TWO\n");
+        CHECK(apply_file_patch("one\ntwo", terminated).contents
+              == "one\nTWO\n");
+    }
+
+    TEST_CASE("CRLF files keep their line endings")
+    {
+        auto const patch = only_file(
+            "--- a/f\n+++ b/f\n"
+            "@@ -1,2 +1,2 @@\n"
+            " one\n"
+            "-two\n"
+            "+TWO\n");
+        auto const result = apply_file_patch("one\r\ntwo\r\n", patch);
+
+        REQUIRE(result.applied());
+        CHECK(result.contents == "one\r\nTWO\r\n");
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,114 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/PromptCache.hpp"
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+
+nlohmann::json
+makeRequest()
+{
+    return nlohmann::json::parse(R"({
+        "model": "anthropic/claude-sonnet-4",
+        "messages": [
+            {"role": "system", "content": "You are helpful."},
+            {"role": "user", "content": "List files"},
+            {"role": "assistant", "content": null,
+             "tool_calls": [{"id": "call_1"}]},
+            {"role": "tool", "tool_call_id": "call_1",
+             "content": "README.md"}
+        ],
+        "tools": [
+            {"type": "function", "function": {"name": "bash"}},
+            {"type": "function", "function": {"name": "read_file"}}
+        ]
+    })");
+}
+
+bool
+is_marked_text(nlohmann::json const & message, std::string const & text)
+{
+    auto const & content = message["content"];
+    return content.is_array() and content.size() == 1
+        and content[0]["type"] == "text" and content[0]["text"] == text
+        and content[0]["cache_control"]["type"] == "ephemeral";
+}
+
+TEST_SUITE("PromptCache")
+{
+    TEST_CASE("Breakpoints mark tools, system, and newest message")
+    {
+        auto request = makeRequest();
+        add_cache_breakpoints(request);
+
+        auto const & tools = request["tools"];
+        CHECK_FALSE(tools[0].contains("cache_control"));
+        CHECK(tools[1]["cache_control"]["type"] == "ephemeral");
+
+        auto const & messages = request["messages"];
+        CHECK(is_marked_text(messages[0], "You are helpful."));
+        CHECK(messages[1]["content"] == "List files");
+        CHECK(messages[2]["content"].is_null());
+        CHECK(is_marked_text(messages[3], "README.md"));
+    }
+
+    TEST_CASE("Checkpoint skips messages without text content")
+    {
+        auto request = makeRequest();
+        request["messages"].erase(3);
+        add_cache_breakpoints(request);
+
+        auto const & messages = request["messages"];
+        CHECK(is_marked_text(messages[1], "List files"));
+        CHECK(messages[2]["content"].is_null());
+    }
+
+    TEST_CASE("System prompt is not double-marked as the checkpoint")
+    {
+        auto request = nlohmann::json{
+            {"messages",
+             {{{"role", "system"}, {"content", "sys"}}}}};
+        add_cache_breakpoints(request);
+
+        auto const & content = request["messages"][0]["content"];
+        REQUIRE(content.is_array());
+        CHECK(content.size() == 1);
+    }
+
+    TEST_CASE("Requests without tools or system prompt")
+    {
+        auto request = nlohmann::json{
+            {"messages",
+             {{{"role", "user"}, {"content", "hi"}},
+              {{"role", "user"}, {"content", ""}}}}};
+        add_cache_breakpoints(request);
+
+        CHECK_FALSE(request.contains("tools"));
+        CHECK(is_marked_text(request["messages"][0], "hi"));
+        CHECK(request["messages"][1]["content"] == "");
+    }
+
+    TEST_CASE("Existing prefix bytes are unchanged by a new checkpoint")
+    {
+        auto first = makeRequest();
+        auto second = makeRequest();
+        second["messages"].push_back(
+            {{"role", "user"}, {"content", "next"}});
+
+        add_cache_breakpoints(first);
+        add_cache_breakpoints(second);
+
+        CHECK(first["tools"] == second["tools"]);
+        CHECK(first["messages"][0] == second["messages"][0]);
+        CHECK(first["messages"][1] == second["messages"][1]);
+    }
+}
+
+} // anonymous namespace
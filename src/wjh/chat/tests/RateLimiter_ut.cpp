@@ -0,0 +1,148 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/RateLimiter.hpp"
+
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+HttpHeaders
+headers(std::initializer_list<std::pair<char const *, char const *>> init)
+{
+    HttpHeaders result;
+    for (auto const & [k, v] : init) {
+        result.add(HeaderName{k}, HeaderValue{v});
+    }
+    return result;
+}
+
+TEST_SUITE("RateLimiter")
+{
+    TEST_CASE("Unlimited by default")
+    {
+        RateLimiter limiter;
+        for (int i = 0; i < 100; ++i) {
+            CHECK(limiter.acquire(1'000'000));
+        }
+        CHECK(limiter.stats().delayed == 0);
+    }
+
+    TEST_CASE("Requests beyond the limit wait for a refill")
+    {
+        RateLimiter limiter(RateLimiterConfig{.requests = 2, .window = 200ms});
+        auto const start = Clock::now();
+        CHECK(limiter.acquire(0));
+        CHECK(limiter.acquire(0));
+        CHECK(limiter.acquire(0));
+
+        // One request refills in window / requests.
+        CHECK(Clock::now() - start >= 90ms);
+        auto s = limiter.stats();
+        CHECK(s.requests == 3);
+        CHECK(s.delayed == 1);
+    }
+
+    TEST_CASE("Token estimates are reconciled with actual usage")
+    {
+        RateLimiter limiter(RateLimiterConfig{.tokens = 1000, .window = 60s});
+        CHECK(limiter.acquire(900));
+
+        // Only 100 of the 900 estimated were used, so 900 remain.
+        limiter.reconcile(900, 100);
+        auto const start = Clock::now();
+        CHECK(limiter.acquire(800));
+        CHECK(Clock::now() - start < 1s);
+        CHECK(limiter.stats().estimate_error == -800);
+    }
+
+    TEST_CASE("A cancelled wait gives up its place")
+    {
+        RateLimiter limiter(RateLimiterConfig{.requests = 1, .window = 60s});
+        CHECK(limiter.acquire(0));
+
+        std::stop_source stop;
+        std::thread waiter([&] {
+            CHECK_FALSE(limiter.acquire(0, stop.get_token()));
+        });
+        std::this_thread::sleep_for(20ms);
+        stop.request_stop();
+        waiter.join();
+        CHECK(limiter.stats().requests == 1);
+    }
+
+    TEST_CASE("Waiters are served in arrival order")
+    {
+        RateLimiter limiter(RateLimiterConfig{.requests = 1, .window = 100ms});
+        CHECK(limiter.acquire(0));
+
+        std::mutex mutex;
+        std::vector<int> order;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 3; ++i) {
+            threads.emplace_back([&, i] {
+                CHECK(limiter.acquire(0));
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(i);
+            });
+            std::this_thread::sleep_for(10ms);
+        }
+        for (auto & thread : threads) {
+            thread.join();
+        }
+        CHECK(order == std::vector<int>{0, 1, 2});
+    }
+
+    TEST_CASE("Limits are learned from response headers")
+    {
+        RateLimiter limiter(RateLimiterConfig{.tokens = 5000});
+        limiter.learn(headers({
+            {"x-ratelimit-limit-requests", "50"},
+            {"x-ratelimit-limit-tokens", "90000"},
+            {"x-ratelimit-remaining-requests", "49"}}));
+
+        // The configured token limit wins over the learned one.
+        auto const [requests, tokens] = limiter.limits();
+        CHECK(requests == 50u);
+        CHECK(tokens == 5000u);
+    }
+
+    TEST_CASE("An exhausted limit blocks until its reset")
+    {
+        RateLimiter limiter;
+        limiter.learn(headers({
+            {"x-ratelimit-remaining-requests", "0"},
+            {"x-ratelimit-reset-requests", "150ms"}}));
+
+        auto const start = Clock::now();
+        CHECK(limiter.acquire(0));
+        CHECK(Clock::now() - start >= 100ms);
+    }
+
+    TEST_CASE("Report shows limits and delays")
+    {
+        RateLimiter limiter(RateLimiterConfig{.requests = 30});
+        CHECK(limiter.acquire(10));
+        limiter.reconcile(10, 25);
+
+        std::ostringstream out;
+        limiter.report(out);
+        CHECK(out.str().find("30 requests") != std::string::npos);
+        CHECK(out.str().find("unlimited tokens") != std::string::npos);
+        CHECK(out.str().find("+15 tokens") != std::string::npos);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,243 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/ResponseCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+using namespace std::chrono_literals;
+
+// RAII helper that creates a temporary directory and
+// removes it (with contents) on destruction.
+struct TempDir
+{
+    std::filesystem::path path_;
+
+    TempDir()
+    : path_(std::filesystem::temp_directory_path()
+          / "wjh_cache_test_XXXXXX")
+    {
+        auto tmpl = path_.string();
+        auto * result = mkdtemp(tmpl.data());
+        REQUIRE(result != nullptr);
+        path_ = result;
+    }
+
+    ~TempDir()
+    {
+        std::filesystem::remove_all(path_);
+    }
+
+    TempDir(TempDir const &) = delete;
+    TempDir & operator = (TempDir const &) = delete;
+};
+
+TEST_SUITE("ResponseCache")
+{
+    TEST_CASE("Keys are stable and content-addressed")
+    {
+        auto a = ResponseCache::key_for(R"({"model":"m","temperature":0})");
+        auto b = ResponseCache::key_for(R"({"model":"m","temperature":0})");
+        auto c = ResponseCache::key_for(R"({"model":"m","temperature":1})");
+
+        CHECK(a == b);
+        CHECK(a != c);
+        CHECK(a.size() == 24);
+    }
+
+    TEST_CASE("Memory tier hit and miss accounting")
+    {
+        ResponseCache cache(ResponseCacheConfig{});
+
+        CHECK_FALSE(cache.lookup("k1").has_value());
+        cache.store("k1", "body-1", 250ms);
+
+        auto hit = cache.lookup("k1");
+        REQUIRE(hit.has_value());
+        CHECK(*hit == "body-1");
+
+        auto stats = cache.stats();
+        CHECK(stats.memory_hits == 1);
+        CHECK(stats.misses == 1);
+        CHECK(stats.stores == 1);
+        CHECK(stats.saved_latency == 250ms);
+    }
+
+    TEST_CASE("LRU evicts the least recently used entry")
+    {
+        ResponseCache cache(ResponseCacheConfig{.memory_entries = 2});
+        cache.store("a", "A", 1ms);
+        cache.store("b", "B", 1ms);
+        CHECK(cache.lookup("a").has_value());
+        cache.store("c", "C", 1ms);
+
+        CHECK(cache.lookup("a").has_value());
+        CHECK(cache.lookup("c").has_value());
+        CHECK_FALSE(cache.lookup("b").has_value());
+        CHECK(cache.stats().evictions == 1);
+    }
+
+    TEST_CASE("Disk tier survives a new cache instance")
+    {
+        TempDir dir;
+        {
+            ResponseCache cache(ResponseCacheConfig{.directory = dir.path_});
+            cache.store("key", "persisted", 40ms);
+        }
+
+        ResponseCache cache(ResponseCacheConfig{.directory = dir.path_});
+        auto hit = cache.lookup("key");
+        REQUIRE(hit.has_value());
+        CHECK(*hit == "persisted");
+        CHECK(cache.stats().disk_hits == 1);
+        CHECK(cache.stats().saved_latency == 40ms);
+
+        // Promoted into memory on the first disk hit
+        CHECK(cache.lookup("key").has_value());
+        CHECK(cache.stats().memory_hits == 1);
+    }
+
+    TEST_CASE("Expired entries are misses")
+    {
+        TempDir dir;
+        ResponseCache cache(ResponseCacheConfig{
+            .directory = dir.path_,
+            .ttl = -1s});
+        cache.store("key", "stale", 1ms);
+
+        CHECK_FALSE(cache.lookup("key").has_value());
+        CHECK_FALSE(std::filesystem::exists(dir.path_ / "key.json"));
+    }
+
+    TEST_CASE("Disk tier respects the size limit")
+    {
+        TempDir dir;
+        ResponseCache cache(ResponseCacheConfig{
+            .directory = dir.path_,
+            .memory_entries = 0,
+            .max_disk_bytes = 200});
+        cache.store("one", std::string(120, 'x'), 1ms);
+        cache.store("two", std::string(120, 'y'), 1ms);
+
+        std::size_t files = 0;
+        for (auto const & de : std::filesystem::directory_iterator(dir.path_)) {
+            (void)de;
+            ++files;
+        }
+        CHECK(files == 1);
+        CHECK(cache.lookup("two").has_value());
+    }
+
+    TEST_CASE("The size limit counts entries already on disk")
+    {
+        TempDir dir;
+        {
+            ResponseCache cache(ResponseCacheConfig{.directory = dir.path_});
+            cache.store("one", std::string(120, 'x'), 1ms);
+            cache.store("two", std::string(120, 'y'), 1ms);
+        }
+        auto const count = [&] {
+            auto const files = std::filesystem::directory_iterator(dir.path_);
+            return std::distance(begin(files), end(files));
+        };
+        REQUIRE(count() == 2);
+
+        ResponseCache cache(ResponseCacheConfig{
+            .directory = dir.path_,
+            .memory_entries = 0,
+            .max_disk_bytes = 200});
+        CHECK(count() == 1);
+        CHECK(cache.stats().evictions == 1u);
+    }
+
+    TEST_CASE("Caches sharing a directory do not clobber each other")
+    {
+        TempDir dir;
+        auto const config = ResponseCacheConfig{
+            .directory = dir.path_,
+            .memory_entries = 0};
+        ResponseCache first(config);
+        ResponseCache second(config);
+        ResponseCache reader(config);
+        first.store("key", std::string(10, 'z'), 1ms);
+
+        // Like two processes: separate caches, so separate locks.  Each
+        // body is one letter, so a torn one shows.
+        std::atomic<int> writing{4};
+        std::size_t torn = 0;
+        std::size_t misses = 0;
+        {
+            std::vector<std::jthread> threads;
+            for (auto * cache : {&first, &second, &first, &second}) {
+                threads.emplace_back([cache, &writing] {
+                    for (std::size_t i = 0; i < 50; ++i) {
+                        auto const fill = static_cast<char>('a' + i % 26);
+                        auto const length = 64 * 1024 - 997 * i;
+                        cache->store("key", std::string(length, fill), 1ms);
+                    }
+                    --writing;
+                });
+            }
+            threads.emplace_back([&] {
+                while (writing > 0) {
+                    auto const hit = reader.lookup("key");
+                    if (not hit) {
+                        ++misses;
+                    } else if (
+                        std::ranges::count(*hit, hit->front())
+                        != std::ssize(*hit))
+                    {
+                        ++torn;
+                    }
+                }
+            });
+        }
+
+        CHECK(misses == 0u);
+        CHECK(torn == 0u);
+        auto const hit = reader.lookup("key");
+        REQUIRE(hit.has_value());
+        CHECK(std::ranges::count(*hit, hit->front()) == std::ssize(*hit));
+        std::size_t files = 0;
+        for (auto const & de : std::filesystem::directory_iterator(dir.path_)) {
+            (void)de;
+            ++files;
+        }
+        CHECK(files == 1);
+    }
+
+    TEST_CASE("Report shows hit rate and saved latency")
+    {
+        ResponseCache cache(ResponseCacheConfig{.offline = true});
+        cache.store("k", "v", 1500ms);
+        (void)cache.lookup("k");
+        (void)cache.lookup("missing");
+
+        std::ostringstream out;
+        cache.report(out);
+        auto text = out.str();
+        CHECK(cache.offline());
+        CHECK(text.find("(offline)") != std::string::npos);
+        CHECK(text.find("50.0%") != std::string::npos);
+        CHECK(text.find("1500 ms") != std::string::npos);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,224 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/client/RetryPolicy.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::client;
+using namespace std::chrono_literals;
+
+HttpHeaders
+headers(std::initializer_list<std::pair<char const *, char const *>> init)
+{
+    HttpHeaders result;
+    for (auto const & [k, v] : init) {
+        result.add(HeaderName{k}, HeaderValue{v});
+    }
+    return result;
+}
+
+/// Policy that records its waits instead of sleeping.
+struct RecordingPolicy
+{
+    std::vector<std::chrono::milliseconds> waits;
+    RetryPolicy policy;
+
+    explicit RecordingPolicy(RetryPolicyConfig config = {})
+    : policy([this, &config] {
+        config.sleep = [this](std::chrono::milliseconds d, std::stop_token) {
+            waits.push_back(d);
+        };
+        return config;
+    }())
+    { }
+};
+
+TEST_SUITE("RetryPolicy")
+{
+    TEST_CASE("Status classification")
+    {
+        CHECK(classify_status(HttpStatusCode{200}) == ErrorClass::none);
+        CHECK(classify_status(HttpStatusCode{429}) == ErrorClass::retryable);
+        CHECK(classify_status(HttpStatusCode{502}) == ErrorClass::retryable);
+        CHECK(classify_status(HttpStatusCode{503}) == ErrorClass::retryable);
+        CHECK(classify_status(HttpStatusCode{529}) == ErrorClass::retryable);
+        CHECK(classify_status(HttpStatusCode{400}) == ErrorClass::fatal);
+        CHECK(classify_status(HttpStatusCode{401}) == ErrorClass::fatal);
+        CHECK(classify_status(HttpStatusCode{501}) == ErrorClass::fatal);
+    }
+
+    TEST_CASE("Header lookup ignores case")
+    {
+        auto h = headers({{"Retry-After", "3"}});
+        REQUIRE(h.find("retry-after").has_value());
+        CHECK(*h.find("RETRY-AFTER") == "3");
+        CHECK_FALSE(h.find("retry").has_value());
+    }
+
+    TEST_CASE("Server-requested delays")
+    {
+        auto const now = std::chrono::system_clock::from_time_t(1'445'412'480);
+
+        SUBCASE("Retry-After in seconds") {
+            auto d = server_retry_delay(headers({{"Retry-After", "2"}}), now);
+            REQUIRE(d.has_value());
+            CHECK(*d == 2000ms);
+        }
+
+        SUBCASE("retry-after-ms takes precedence") {
+            auto d = server_retry_delay(
+                headers({{"Retry-After", "2"}, {"retry-after-ms", "150"}}),
+                now);
+            REQUIRE(d.has_value());
+            CHECK(*d == 150ms);
+        }
+
+        SUBCASE("Retry-After as an HTTP date") {
+            // 1445412480 is Wed, 21 Oct 2015 07:28:00 GMT.
+            auto d = server_retry_delay(
+                headers({{"Retry-After", "Wed, 21 Oct 2015 07:28:05 GMT"}}),
+                now);
+            REQUIRE(d.has_value());
+            CHECK(*d == 5000ms);
+        }
+
+        SUBCASE("Exhausted rate limit with epoch-millisecond reset") {
+            auto d = server_retry_delay(
+                headers(
+                    {{"X-RateLimit-Remaining", "0"},
+                     {"X-RateLimit-Reset", "1445412481500"}}),
+                now);
+            REQUIRE(d.has_value());
+            CHECK(*d == 1500ms);
+        }
+
+        SUBCASE("Duration-style reset for the exhausted limit only") {
+            auto d = server_retry_delay(
+                headers(
+                    {{"x-ratelimit-remaining-requests", "12"},
+                     {"x-ratelimit-reset-requests", "6m0s"},
+                     {"x-ratelimit-remaining-tokens", "0"},
+                     {"x-ratelimit-reset-tokens", "1.5s"}}),
+                now);
+            REQUIRE(d.has_value());
+            CHECK(*d == 1500ms);
+        }
+
+        SUBCASE("No hint") {
+            CHECK_FALSE(server_retry_delay(headers({}), now).has_value());
+            CHECK_FALSE(
+                server_retry_delay(headers({{"Retry-After", "soon"}}), now)
+                    .has_value());
+        }
+    }
+
+    TEST_CASE("Backoff is bounded by full jitter")
+    {
+        RetryPolicy policy(RetryPolicyConfig{
+            .max_retries = 10,
+            .session_budget = 1000,
+            .base_delay = 100ms,
+            .max_delay = 1000ms});
+
+        for (int i = 0; i < 50; ++i) {
+            for (std::uint32_t retry = 0; retry < 10; ++retry) {
+                auto d = policy.next_delay(retry, nullptr);
+                REQUIRE(d.has_value());
+                auto const ceiling = std::min(1000ms, 100ms * (1 << retry));
+                CHECK(*d >= 0ms);
+                CHECK(*d <= ceiling);
+            }
+        }
+    }
+
+    TEST_CASE("Per-request limit and session budget")
+    {
+        RetryPolicy policy(RetryPolicyConfig{
+            .max_retries = 2,
+            .session_budget = 3});
+
+        CHECK(policy.next_delay(0, nullptr).has_value());
+        CHECK(policy.next_delay(1, nullptr).has_value());
+        CHECK_FALSE(policy.next_delay(2, nullptr).has_value());
+
+        CHECK(policy.next_delay(0, nullptr).has_value());
+        CHECK_FALSE(policy.next_delay(0, nullptr).has_value());
+
+        auto s = policy.stats();
+        CHECK(s.retries == 3);
+        CHECK(s.budget_exhausted == 1);
+    }
+
+    TEST_CASE("Server delay is honored unless it exceeds the maximum")
+    {
+        RetryPolicy policy(RetryPolicyConfig{.max_delay = 10'000ms});
+
+        auto soon = headers({{"Retry-After", "4"}});
+        auto d = policy.next_delay(0, &soon);
+        REQUIRE(d.has_value());
+        CHECK(*d == 4000ms);
+
+        auto late = headers({{"Retry-After", "60"}});
+        CHECK_FALSE(policy.next_delay(0, &late).has_value());
+    }
+
+    TEST_CASE("Waits and outcomes are reported")
+    {
+        RecordingPolicy p;
+
+        std::ostringstream before;
+        p.policy.report(before);
+        CHECK(before.str().empty());
+
+        p.policy.wait(250ms);
+        p.policy.wait(750ms);
+        p.policy.record(2, true);
+        p.policy.record(0, true);
+        p.policy.record(1, false);
+
+        REQUIRE(p.waits.size() == 2);
+        CHECK(p.waits[1] == 750ms);
+
+        auto s = p.policy.stats();
+        CHECK(s.requests == 3);
+        CHECK(s.recovered == 1);
+        CHECK(s.gave_up == 1);
+        CHECK(s.backoff == 1000ms);
+
+        std::ostringstream after;
+        p.policy.report(after);
+        CHECK(after.str().find("1000 ms") != std::string::npos);
+    }
+
+    TEST_CASE("A stop request cuts the wait short")
+    {
+        RetryPolicy policy;
+        std::stop_source stop;
+        std::jthread stopper([&stop] {
+            std::this_thread::sleep_for(20ms);
+            stop.request_stop();
+        });
+
+        auto const start = std::chrono::steady_clock::now();
+        CHECK_FALSE(policy.wait(30s, stop.get_token()));
+        CHECK(std::chrono::steady_clock::now() - start < 10s);
+        CHECK(policy.stats().backoff == 0ms);
+
+        CHECK(policy.wait(1ms));
+        CHECK(policy.stats().backoff == 1ms);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,129 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/Sandbox.hpp"
+#include "wjh/chat/tools/Jobs.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+using namespace std::chrono_literals;
+
+constexpr std::uint64_t megabyte = 1024 * 1024;
+
+/// Run @p command with its output discarded, returning its wait status.
+int
+run(std::string const & command,
+    Sandbox const * sandbox = nullptr,
+    ResourceUsage * usage = nullptr)
+{
+    auto const null = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+    auto const pid = spawn_shell(command, null, sandbox);
+    ::close(null);
+    REQUIRE(pid > 0);
+    return reap(pid, usage);
+}
+
+bool
+succeeded(int status)
+{
+    return WIFEXITED(status) and WEXITSTATUS(status) == 0;
+}
+
+/// A shell holding a string of @p megabytes in memory.
+std::string
+allocate(std::uint64_t megabytes)
+{
+    return "x=$(head -c " + std::to_string(megabytes * megabyte)
+        + " /dev/zero | tr '\\0' x); echo ${#x}";
+}
+
+TEST_SUITE("Sandbox")
+{
+    TEST_CASE("Usage is formatted for tool results")
+    {
+        CHECK(describe_usage({.cpu_time = 1250ms, .peak_rss = 40 * megabyte})
+              == "cpu 1.25s, peak RSS 40.0 MB");
+
+        UsageTotals totals;
+        totals.add({.cpu_time = 1s, .peak_rss = 10});
+        totals.add({.cpu_time = 2s, .peak_rss = 30});
+        totals.add({.cpu_time = 0s, .peak_rss = 20});
+        CHECK(totals.processes == 3u);
+        CHECK(totals.cpu_time == 3s);
+        CHECK(totals.peak_rss == 30u);
+    }
+
+    TEST_CASE("Reaping reports the CPU time and memory of the whole command")
+    {
+        ResourceUsage usage;
+        auto const status = run(
+            "awk 'BEGIN { for (i = 0; i < 3000000; ++i) s += i }'; "
+                + allocate(40),
+            nullptr,
+            &usage);
+
+        CHECK(succeeded(status));
+        CHECK(usage.cpu_time > 20ms);
+        CHECK(usage.peak_rss > 40 * megabyte);
+    }
+
+    TEST_CASE("Without limits a sandbox does nothing")
+    {
+        Sandbox sandbox({});
+
+        CHECK(sandbox.mode() == SandboxMode::none);
+        CHECK(sandbox.cgroup().empty());
+        CHECK(sandbox.describe() == "no limits");
+        CHECK(succeeded(run("true", &sandbox)));
+    }
+
+    TEST_CASE("A memory limit stops a command that exceeds it")
+    {
+        std::filesystem::path cgroup;
+        {
+            Sandbox sandbox({.memory_bytes = 64 * megabyte});
+            REQUIRE(sandbox.mode() != SandboxMode::none);
+            CHECK(sandbox.describe().ends_with(": 64 MB"));
+            cgroup = sandbox.cgroup();
+
+            CHECK(succeeded(run(allocate(4), &sandbox)));
+            CHECK_FALSE(succeeded(run(allocate(200), &sandbox)));
+            CHECK(succeeded(run(allocate(200))));
+        }
+        if (not cgroup.empty()) {
+            CHECK_FALSE(std::filesystem::exists(cgroup));
+        }
+    }
+
+    TEST_CASE("A pids limit stops a command that forks too much")
+    {
+        Sandbox sandbox({.max_pids = 8});
+        REQUIRE(sandbox.mode() != SandboxMode::none);
+
+        // RLIMIT_NPROC does not bind root.
+        if (sandbox.mode() == SandboxMode::rlimit and ::getuid() == 0) {
+            return;
+        }
+        CHECK(succeeded(run("sleep 0", &sandbox)));
+        // The shell gives up when it cannot fork.
+        CHECK_FALSE(succeeded(run(
+            "for i in 1 2 3 4 5 6 7 8 9 10 11 12; do sleep 2 & done; wait",
+            &sandbox)));
+    }
+}
+
+} // anonymous namespace
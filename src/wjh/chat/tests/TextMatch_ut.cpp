@@ -0,0 +1,130 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/TextMatch.hpp"
+
+#include <string>
+#include <vector>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+
+std::string_view
+matched(std::string_view contents, TextMatch const & match)
+{
+    return contents.substr(match.position, match.length);
+}
+
+TEST_SUITE("TextMatch")
+{
+    TEST_CASE("An exact match wins and reports every occurrence")
+    {
+        std::string_view const text = "a\nfoo  \nb\nfoo  \n";
+        auto const match = find_text(text, "foo  ");
+
+        REQUIRE(match.has_value());
+        CHECK(match->strategy == MatchStrategy::exact);
+        CHECK(match->position == 2u);
+        CHECK(match->lines == std::vector<std::size_t>{2, 4});
+        CHECK(describe(match->strategy).empty());
+    }
+
+    TEST_CASE("Trailing blanks and CRLF are tolerated on whole lines")
+    {
+        std::string_view const text = "int a;\r\nint b;  \r\nint c;\r\n";
+        auto const match = find_text(text, "int a;\nint b;\n");
+
+        REQUIRE(match.has_value());
+        CHECK(match->strategy == MatchStrategy::trailing_whitespace);
+        CHECK(matched(text, *match) == "int a;\r\nint b;  \r\n");
+        CHECK(match->lines == std::vector<std::size_t>{1});
+        CHECK(match->crlf);
+    }
+
+    TEST_CASE("Indentation and inner blanks are tolerated last")
+    {
+        std::string_view const text =
+            "void f()\n{\n\tif (x)  {\n\t\ty();\n\t}\n}\n";
+        auto const match = find_text(text, "    if (x) {\n        y();");
+
+        REQUIRE(match.has_value());
+        CHECK(match->strategy == MatchStrategy::whitespace);
+        CHECK(matched(text, *match) == "\tif (x)  {\n\t\ty();");
+        CHECK(match->lines == std::vector<std::size_t>{3});
+        CHECK_FALSE(match->crlf);
+    }
+
+    TEST_CASE("A loose match can still be ambiguous")
+    {
+        auto const match = find_text("x = 1; \ny\nx = 1;\t\n", "x = 1;\n");
+
+        REQUIRE(match.has_value());
+        CHECK(match->strategy == MatchStrategy::trailing_whitespace);
+        CHECK(match->lines == std::vector<std::size_t>{1, 3});
+    }
+
+    TEST_CASE("Blank or partial-line needles are only matched exactly")
+    {
+        CHECK_FALSE(find_text("a\n\n\nb\n", " \n").has_value());
+        CHECK_FALSE(find_text("call(a,  b);\n", "a, b").has_value());
+        CHECK_FALSE(find_text("abc", "").has_value());
+    }
+
+    TEST_CASE("Near matches point at the first differing line")
+    {
+        std::string_view const text =
+            "int main()\n"
+            "{\n"
+            "    auto total = 0;\n"
+            "    for (auto x : xs) {\n"
+            "        total += x;\n"
+            "    }\n"
+            "    return total;\n"
+            "}\n";
+        auto const near = near_matches(
+            text,
+            "    auto total = 0;\n"
+            "    for (auto const x : xs) {\n"
+            "        total += x;\n"
+            "    }\n");
+
+        REQUIRE(near.size() == 1u);
+        CHECK(near[0].first_line == 3u);
+        CHECK(near[0].last_line == 6u);
+        CHECK(near[0].same_lines == 3u);
+        CHECK(near[0].needle_lines == 4u);
+        CHECK(near[0].differing_line == 4u);
+        CHECK(near[0].text_line == "    for (auto x : xs) {");
+        CHECK(near[0].needle_line == "    for (auto const x : xs) {");
+    }
+
+    TEST_CASE("Near matches are ranked and do not overlap")
+    {
+        std::string_view const text =
+            "alpha();\nbeta();\ngamma();\n"
+            "other();\n"
+            "alpha();\nbeta();\ndelta();\n";
+        auto const near =
+            near_matches(text, "alpha();\nbeta();\ngamma2();\n");
+
+        REQUIRE(near.size() == 2u);
+        CHECK(near[0].first_line == 1u);
+        CHECK(near[1].first_line == 5u);
+        CHECK(near[1].differing_line == 7u);
+        CHECK(near[1].text_line == "delta();");
+    }
+
+    TEST_CASE("Nothing resembling the needle gives no hints")
+    {
+        CHECK(near_matches("one\ntwo\nthree\n", "four\nfive\n").empty());
+        CHECK(near_matches("}\n}\n", "}\n").empty());
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,424 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/ToolCache.hpp"
+#include "wjh/chat/tools/ToolDispatcher.hpp"
+#include "wjh/chat/tools/Tools.hpp"
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+
+// RAII helper that creates a temporary directory and
+// removes it (with contents) on destruction.
+struct TempDir
+{
+    std::filesystem::path path_;
+
+    TempDir()
+    : path_(std::filesystem::temp_directory_path()
+          / "wjh_tool_cache_test_XXXXXX")
+    {
+        auto tmpl = path_.string();
+        auto * result = mkdtemp(tmpl.data());
+        REQUIRE(result != nullptr);
+        path_ = result;
+    }
+
+    ~TempDir()
+    {
+        std::filesystem::remove_all(path_);
+    }
+
+    TempDir(TempDir const &) = delete;
+    TempDir & operator = (TempDir const &) = delete;
+};
+
+void
+write(std::filesystem::path const & path, std::string const & content)
+{
+    std::ofstream(path) << content;
+}
+
+bool
+starts_with_marker(std::string const & result)
+{
+    return result.starts_with(cached_marker);
+}
+
+TEST_SUITE("ToolCache")
+{
+    TEST_CASE("Read-only command classification")
+    {
+        CHECK(is_read_only_command("ls -la src"));
+        CHECK(is_read_only_command("grep -rn foo src | head -20"));
+        CHECK(is_read_only_command("git status"));
+        CHECK(is_read_only_command("git log --oneline | wc -l"));
+        CHECK(is_read_only_command("find . -name '*.cpp'"));
+
+        CHECK_FALSE(is_read_only_command(""));
+        CHECK_FALSE(is_read_only_command("make"));
+        CHECK_FALSE(is_read_only_command("git commit -m x"));
+        CHECK_FALSE(is_read_only_command("git"));
+        CHECK_FALSE(is_read_only_command("cat a > b"));
+        CHECK_FALSE(is_read_only_command("ls; rm -rf x"));
+        CHECK_FALSE(is_read_only_command("ls && touch x"));
+        CHECK_FALSE(is_read_only_command("ls || touch x"));
+        CHECK_FALSE(is_read_only_command("cat $(touch x)"));
+        CHECK_FALSE(is_read_only_command("ls | xargs rm"));
+        CHECK_FALSE(is_read_only_command("find . -name x -delete"));
+        CHECK_FALSE(is_read_only_command("find . -exec rm {} +"));
+    }
+
+    TEST_CASE("Options that write files or run programs are not read-only")
+    {
+        CHECK(is_read_only_command("tree -L 2 src"));
+        CHECK(is_read_only_command("rg --pre-glob '*.gz' foo"));
+        CHECK(is_read_only_command("git diff --stat"));
+        CHECK(is_read_only_command("file src/main.cpp"));
+
+        CHECK_FALSE(is_read_only_command("tree -o listing.txt"));
+        CHECK_FALSE(is_read_only_command("tree -aRo out.html"));
+        CHECK_FALSE(is_read_only_command("rg --pre ./script foo"));
+        CHECK_FALSE(is_read_only_command("rg --pre=./script foo"));
+        CHECK_FALSE(is_read_only_command("git diff --output=patch.txt"));
+        CHECK_FALSE(is_read_only_command("git log -p --output patch.txt"));
+        CHECK_FALSE(is_read_only_command("git show --ext-diff HEAD"));
+        CHECK_FALSE(is_read_only_command("file -C -m magic"));
+        for (auto const * action :
+             {"-fprint out", "-fprint0 out", "-fprintf out %p", "-fls out",
+              "-execdir rm {} +", "-ok rm {} ;", "-okdir rm {} ;"})
+        {
+            CHECK_FALSE(is_read_only_command(
+                std::string("find . -name x ") + action));
+        }
+        CHECK_FALSE(is_read_only_command("find . '-delete'"));
+    }
+
+    TEST_CASE("Keys ignore argument order")
+    {
+        auto a = ToolCache::key_for(
+            "read_file",
+            nlohmann::json::parse(R"({"file_path":"x","limit":3})"));
+        auto b = ToolCache::key_for(
+            "read_file",
+            nlohmann::json::parse(R"({"limit":3,"file_path":"x"})"));
+        auto c = ToolCache::key_for(
+            "bash", nlohmann::json::parse(R"({"file_path":"x","limit":3})"));
+
+        CHECK(a == b);
+        CHECK(a != c);
+    }
+
+    TEST_CASE("File entries are revalidated against the file")
+    {
+        TempDir dir;
+        auto const file = dir.path_ / "a.txt";
+        write(file, "one\n");
+
+        ToolCache cache;
+        auto identity = file_identity(file);
+        REQUIRE(identity.has_value());
+        cache.store_file("k", file, *identity, "result");
+
+        auto hit = cache.lookup("k");
+        REQUIRE(hit.has_value());
+        CHECK(*hit == "result");
+
+        write(file, "one\ntwo\n");
+        CHECK_FALSE(cache.lookup("k").has_value());
+        CHECK(cache.size() == 0);
+
+        auto stats = cache.stats();
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 1);
+        CHECK(stats.invalidations == 1);
+    }
+
+    TEST_CASE("Invalidating a path drops its entries and all commands")
+    {
+        TempDir dir;
+        auto const a = dir.path_ / "a.txt";
+        auto const b = dir.path_ / "b.txt";
+        write(a, "a");
+        write(b, "b");
+
+        ToolCache cache;
+        cache.store_file("a", a, *file_identity(a), "A");
+        cache.store_file("b", b, *file_identity(b), "B");
+        cache.store_command("ls", "listing");
+
+        // Spelled differently, but the same file.
+        cache.invalidate(dir.path_ / "." / "a.txt");
+
+        CHECK_FALSE(cache.lookup("a").has_value());
+        CHECK_FALSE(cache.lookup("ls").has_value());
+        CHECK(cache.lookup("b").has_value());
+    }
+
+    TEST_CASE("Missing files have no identity")
+    {
+        TempDir dir;
+        CHECK_FALSE(file_identity(dir.path_ / "missing").has_value());
+        CHECK_FALSE(file_identity(dir.path_).has_value());
+    }
+}
+
+TEST_SUITE("ToolDispatcher")
+{
+    TEST_CASE("Repeated read_file is served from the cache")
+    {
+        TempDir dir;
+        auto const file = dir.path_ / "a.txt";
+        write(file, "hello\n");
+        auto const args =
+            nlohmann::json{{"file_path", file.string()}};
+
+        ToolDispatcher dispatcher;
+        auto first = dispatcher.dispatch("read_file", args);
+        CHECK_FALSE(starts_with_marker(first));
+        CHECK(first.find("hello") != std::string::npos);
+
+        auto second = dispatcher.dispatch("read_file", args);
+        CHECK(starts_with_marker(second));
+        CHECK(second.ends_with(first));
+
+        write(file, "changed\n");
+        auto third = dispatcher.dispatch("read_file", args);
+        CHECK_FALSE(starts_with_marker(third));
+        CHECK(third.find("changed") != std::string::npos);
+    }
+
+    TEST_CASE("A new turn starts with an empty cache")
+    {
+        TempDir dir;
+        auto const file = dir.path_ / "a.txt";
+        write(file, "hello\n");
+        auto const args =
+            nlohmann::json{{"file_path", file.string()}};
+
+        ToolDispatcher dispatcher;
+        (void)dispatcher.dispatch("read_file", args);
+        dispatcher.begin_turn();
+        CHECK_FALSE(
+            starts_with_marker(dispatcher.dispatch("read_file", args)));
+    }
+
+    TEST_CASE("Unreadable files are not cached")
+    {
+        TempDir dir;
+        auto const args = nlohmann::json{
+            {"file_path", (dir.path_ / "missing").string()}};
+
+        ToolDispatcher dispatcher;
+        (void)dispatcher.dispatch("read_file", args);
+        CHECK(dispatcher.cache().size() == 0);
+    }
+
+    TEST_CASE("read_files shares the read_file cache")
+    {
+        TempDir dir;
+        auto const a = (dir.path_ / "a.txt").string();
+        auto const b = (dir.path_ / "b.txt").string();
+        write(a, "alpha\n");
+        write(b, "beta\n");
+        auto const both = nlohmann::json{{"files", {a, b}}};
+
+        ToolDispatcher dispatcher;
+        (void)dispatcher.dispatch("read_file", {{"file_path", a}});
+        auto const first = dispatcher.dispatch("read_files", both);
+        CHECK(first == std::format(
+            "==> {} <==\n{}     1\talpha\n\n==> {} <==\n     1\tbeta\n",
+            a,
+            cached_marker,
+            b));
+
+        auto const second = dispatcher.dispatch("read_files", both);
+        CHECK(second.find("beta") != std::string::npos);
+        CHECK(dispatcher.cache().stats().hits == 3u);
+
+        (void)dispatcher.dispatch(
+            ToolCall{
+                .name = "write_file",
+                .args = {{"file_path", b}, {"content", "gamma\n"}}},
+            ToolApproval{});
+        auto const third = dispatcher.dispatch("read_files", both);
+        CHECK(third.ends_with(
+            std::format("==> {} <==\n     1\tgamma\n", b)));
+    }
+
+    TEST_CASE("Report is silent until the cache is used")
+    {
+        TempDir dir;
+        auto const file = dir.path_ / "a.txt";
+        write(file, "hello\n");
+        auto const args =
+            nlohmann::json{{"file_path", file.string()}};
+
+        ToolDispatcher dispatcher;
+        std::ostringstream before;
+        dispatcher.report(before);
+        CHECK(before.str().empty());
+
+        (void)dispatcher.dispatch("read_file", args);
+        (void)dispatcher.dispatch("read_file", args);
+        std::ostringstream after;
+        dispatcher.report(after);
+        CHECK(after.str().find("1 hits / 2 lookups") != std::string::npos);
+    }
+
+    TEST_CASE("Report totals what commands used, in their sandbox")
+    {
+        auto policy = std::make_shared<ApprovalPolicy>();
+        REQUIRE(policy->add(Approval::allow, "bash "));
+
+        ToolDispatcher dispatcher;
+        dispatcher.set_policy(policy);
+        dispatcher.set_sandbox(
+            std::make_shared<Sandbox const>(SandboxLimits{.max_pids = 64}));
+        std::istringstream answers;
+        std::ostringstream prompts;
+        dispatcher.set_prompt(answers, prompts);
+
+        auto const result =
+            dispatcher.dispatch("bash", {{"command", "touch /dev/null"}});
+        CHECK(result.find("[exit code: 0; cpu ") != std::string::npos);
+        (void)dispatcher.dispatch("bash", {{"command", "true > /dev/null"}});
+
+        std::ostringstream out;
+        dispatcher.report(out);
+        CHECK(out.str().find("Tool processes: 2 run, cpu ")
+              != std::string::npos);
+        CHECK(out.str().find(": 64 pids)\n") != std::string::npos);
+    }
+
+    TEST_CASE("Results are echoed once an echo stream is set")
+    {
+        TempDir dir;
+        auto const file = dir.path_ / "a.txt";
+        write(file, "hello\n");
+        auto const args =
+            nlohmann::json{{"file_path", file.string()}};
+
+        ToolDispatcher dispatcher;
+        std::ostringstream echo;
+        (void)dispatcher.dispatch("read_file", args);
+        CHECK(echo.str().empty());
+
+        dispatcher.set_echo(&echo);
+        auto const result = dispatcher.dispatch("read_file", args);
+        CHECK(echo.str() == result + "\n");
+    }
+
+    TEST_CASE("One prompt covers every call of a message")
+    {
+        TempDir dir;
+        auto const file = [&](char const * name) {
+            return nlohmann::json{
+                {"file_path", (dir.path_ / name).string()},
+                {"content", "x"}};
+        };
+        auto const calls = std::vector<ToolCall>{
+            {"write_file", file("a")},
+            {"read_file", file("a")},
+            {"write_file", file("b")},
+            {"write_file", file("c")}};
+
+        ToolDispatcher dispatcher;
+        std::istringstream answers("1 3\n");
+        std::ostringstream prompts;
+        dispatcher.set_prompt(answers, prompts);
+        auto const approvals = dispatcher.approve(calls);
+
+        REQUIRE(approvals.size() == 4u);
+        CHECK(approvals[0].approved);
+        CHECK(approvals[1].approved);
+        CHECK_FALSE(approvals[2].approved);
+        CHECK(approvals[2].refusal == "Write skipped by user");
+        CHECK(approvals[3].approved);
+        CHECK(prompts.str().find("3 calls need approval") != std::string::npos);
+
+        CHECK(dispatcher.dispatch(calls[2], approvals[2])
+              == "Write skipped by user");
+        CHECK_FALSE(std::filesystem::exists(dir.path_ / "b"));
+        (void)dispatcher.dispatch(calls[3], approvals[3]);
+        CHECK(std::filesystem::exists(dir.path_ / "c"));
+    }
+
+    TEST_CASE("A stop answers a pending prompt with no")
+    {
+        ToolDispatcher dispatcher;
+        std::istringstream answers("y\n");
+        std::ostringstream prompts;
+        dispatcher.set_prompt(answers, prompts);
+        std::stop_source source;
+        source.request_stop();
+
+        auto const calls = std::vector<ToolCall>{
+            {"bash", {{"command", "echo never"}}},
+            {"bash", {{"command", "ls"}}}};
+        auto const approvals = dispatcher.approve(calls, source.get_token());
+
+        REQUIRE(approvals.size() == 2u);
+        CHECK_FALSE(approvals[0].approved);
+        CHECK(approvals[0].refusal == tool_cancelled);
+        CHECK(approvals[1].approved);
+        std::string unread;
+        CHECK(std::getline(answers, unread));
+        CHECK(unread == "y");
+    }
+
+    TEST_CASE("Policy decisions need no answer")
+    {
+        auto policy = std::make_shared<ApprovalPolicy>();
+        REQUIRE(policy->add(Approval::deny, "bash rm "));
+        REQUIRE(policy->add(Approval::allow, "bash echo "));
+
+        ToolDispatcher dispatcher;
+        dispatcher.set_policy(policy);
+        std::istringstream answers;
+        std::ostringstream prompts;
+        dispatcher.set_prompt(answers, prompts);
+
+        auto const denied =
+            dispatcher.dispatch("bash", {{"command", "rm -rf /tmp/x"}});
+        CHECK(denied == "Denied by tool policy (deny bash rm)");
+        auto const allowed =
+            dispatcher.dispatch("bash", {{"command", "echo hi"}});
+        CHECK(allowed.find("hi") != std::string::npos);
+        CHECK(prompts.str().find("[y/n]") == std::string::npos);
+        CHECK(prompts.str().find("allowed: allow bash echo")
+              != std::string::npos);
+    }
+
+    TEST_CASE("A declined command is skipped")
+    {
+        ToolDispatcher dispatcher;
+        std::istringstream answers("n\n");
+        std::ostringstream prompts;
+        dispatcher.set_prompt(answers, prompts);
+
+        CHECK(dispatcher.dispatch("bash", {{"command", "echo never"}})
+              == bash_skipped);
+        CHECK(prompts.str().find("bash: echo never\n[y/n]> ")
+              != std::string::npos);
+    }
+}
+
+} // anonymous namespace
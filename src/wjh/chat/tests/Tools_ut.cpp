@@ -0,0 +1,472 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/tools/Tools.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat::tools;
+using namespace std::chrono_literals;
+
+/// A scratch file, removed when done.
+struct ScratchFile
+{
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path()
+        / ("wjh_tools_test_" + std::to_string(::getpid()) + ".txt");
+
+    explicit ScratchFile(std::string const & contents)
+    {
+        std::ofstream(path, std::ios::binary) << contents;
+    }
+
+    ~ScratchFile()
+    {
+        std::filesystem::remove(path);
+    }
+
+    ScratchFile(ScratchFile const &) = delete;
+    ScratchFile & operator = (ScratchFile const &) = delete;
+
+    std::string contents() const
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+};
+
+nlohmann::json
+multi_edit_args(
+    ScratchFile const & file,
+    std::vector<std::pair<std::string, std::string>> const & edits)
+{
+    auto args = nlohmann::json::object();
+    args["file_path"] = file.path.string();
+    args["edits"] = nlohmann::json::array();
+    for (auto const & [old_string, new_string] : edits) {
+        args["edits"].push_back(
+            {{"old_string", old_string}, {"new_string", new_string}});
+    }
+    return args;
+}
+
+TEST_SUITE("Tools")
+{
+    TEST_CASE("execute_bash captures output, exit code and usage")
+    {
+        ResourceUsage usage;
+        auto const result = execute_bash(
+            "echo hello; echo oops >&2; exit 3", {}, nullptr, nullptr, &usage);
+
+        CHECK(result.find("hello") != std::string::npos);
+        CHECK(result.find("oops") != std::string::npos);
+        CHECK(result.ends_with(
+            std::format("\n[exit code: 3; {}]", describe_usage(usage))));
+        CHECK(usage.peak_rss > 0u);
+    }
+
+    TEST_CASE("execute_bash reports a command killed by a signal")
+    {
+        auto const result = execute_bash("kill -9 $$");
+
+        CHECK(result.starts_with("\n[killed by signal 9; cpu "));
+    }
+
+    TEST_CASE("execute_bash kills the process group on stop")
+    {
+        std::stop_source source;
+        std::jthread canceller([&source] {
+            std::this_thread::sleep_for(100ms);
+            source.request_stop();
+        });
+
+        auto const start = std::chrono::steady_clock::now();
+        auto const result = execute_bash(
+            "echo started; sleep 30 | cat; echo finished",
+            source.get_token());
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+
+        CHECK(elapsed < 10s);
+        CHECK(result.find("started") != std::string::npos);
+        CHECK(result.find("finished") == std::string::npos);
+        CHECK(result.find(tool_cancelled) != std::string::npos);
+    }
+
+    TEST_CASE("execute_bash gives up on output held outside the group")
+    {
+        auto const pid_file = std::filesystem::temp_directory_path()
+            / ("wjh_setsid_test_" + std::to_string(::getpid()));
+        std::stop_source source;
+        std::jthread canceller([&source] {
+            std::this_thread::sleep_for(300ms);
+            source.request_stop();
+        });
+
+        // The sleep has a session of its own, so killing the group
+        // leaves it holding the pipe.
+        auto const start = std::chrono::steady_clock::now();
+        auto const result = execute_bash(
+            "setsid sh -c 'echo $$ > " + pid_file.string()
+                + "; exec sleep 30' & echo started; wait",
+            source.get_token());
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+
+        CHECK(elapsed < 10s);
+        CHECK(result.find("started") != std::string::npos);
+        CHECK(result.find(tool_cancelled) != std::string::npos);
+
+        int pid = 0;
+        std::ifstream(pid_file) >> pid;
+        if (pid > 0) {
+            ::kill(pid, SIGKILL);
+        }
+        std::filesystem::remove(pid_file);
+    }
+
+    TEST_CASE("execute_bash does not start after a stop")
+    {
+        std::stop_source source;
+        source.request_stop();
+
+        CHECK(execute_bash("echo never", source.get_token())
+              == tool_cancelled);
+    }
+
+    TEST_CASE("execute_bash streams output live and keeps running past the cap")
+    {
+        std::ostringstream live;
+        auto const result = execute_bash(
+            "echo first; head -c 150000 /dev/zero | tr '\\0' x; echo; "
+            "echo last; exit 2",
+            {},
+            &live);
+
+        CHECK(result.find("first") != std::string::npos);
+        CHECK(result.find("[truncated at 100KB]") != std::string::npos);
+        CHECK(result.find("last") == std::string::npos);
+        CHECK(result.find("\n[exit code: 2; cpu ") != std::string::npos);
+        CHECK(result.ends_with(" MB]"));
+        CHECK(live.str().find("last\n") != std::string::npos);
+        CHECK(live.str().find("\n[exit code: 2; cpu ") != std::string::npos);
+        CHECK(live.str().ends_with(" MB]\n"));
+    }
+
+    TEST_CASE("execute_bash reports a cancelled start on the live stream")
+    {
+        std::stop_source source;
+        source.request_stop();
+        std::ostringstream live;
+        CHECK(execute_bash("echo never", source.get_token(), &live)
+              == tool_cancelled);
+        CHECK(live.str() == std::string(tool_cancelled) + "\n");
+    }
+
+    TEST_CASE("read_files returns each file under a header")
+    {
+        ScratchFile file("one\ntwo\nthree\n");
+        auto const path = file.path.string();
+        auto const other = path + ".b";
+        std::ofstream(other) << "bee\n";
+
+        auto const result = execute_read_files({{"files", {
+            path,
+            {{"file_path", other}},
+            {{"file_path", path}, {"offset", 2}, {"limit", 1}},
+            "/nonexistent/file"}}});
+        std::filesystem::remove(other);
+
+        CHECK(result == std::format(
+            "==> {0} <==\n     1\tone\n     2\ttwo\n     3\tthree\n"
+            "\n==> {1} <==\n     1\tbee\n"
+            "\n==> {0} <==\n     2\ttwo\n"
+            "\n==> /nonexistent/file <==\n"
+            "Error: Cannot open file: /nonexistent/file",
+            path,
+            other));
+    }
+
+    TEST_CASE("read_files rejects malformed file lists")
+    {
+        CHECK(execute_read_files({{"files", nlohmann::json::array()}})
+              == "Error: files must be a non-empty array");
+        CHECK(execute_read_files(nlohmann::json::object())
+              == "Error: files must be a non-empty array");
+        CHECK(execute_read_files({{"files", {{{"offset", 3}}}}})
+              == "Error: each file needs a file_path");
+        CHECK(execute_read_files(
+                  {{"files", {{{"file_path", "a"}, {"limit", "10"}}}}})
+              == "Error: limit of a must be an integer");
+
+        auto const many = nlohmann::json{
+            {"files", std::vector<std::string>(max_read_files + 1, "a")}};
+        CHECK(execute_read_files(many).starts_with("Error: 33 files"));
+    }
+
+    TEST_CASE("combine_reads keeps small files whole within the budget")
+    {
+        std::string big;
+        for (auto line = 1; line <= 100; ++line) {
+            big += std::format("{:>6}\t{}\n", line, std::string(12, 'x'));
+        }
+        auto const small = std::string("     1\tsmall\n");
+        auto const reads = std::vector<nlohmann::json>{
+            {{"file_path", "big"}}, {{"file_path", "small"}}};
+
+        // small takes 13 bytes, leaving 987: 49 of big's 20-byte lines.
+        auto const combined = combine_reads(reads, {big, small}, 1000);
+        CHECK(combined == std::format(
+            "==> big <==\n{}... [truncated to fit the size budget; "
+            "read_file from offset 50 for the rest]\n"
+            "\n==> small <==\n{}",
+            big.substr(0, 49 * 20),
+            small));
+
+        CHECK(combine_reads(reads, {big, small}, 4)
+              == "==> big <==\n[omitted to fit the size budget; read it on "
+                 "its own]\n\n==> small <==\n[omitted to fit the size "
+                 "budget; read it on its own]\n");
+    }
+
+    TEST_CASE("edit_file falls back to matching modulo whitespace")
+    {
+        ScratchFile file("int f()\r\n{\r\n\treturn 1;  \r\n}\r\n");
+        auto const result = execute_edit_file(
+            {{"file_path", file.path.string()},
+             {"old_string", "{\n    return 1;\n"},
+             {"new_string", "{\n\treturn 2;\n"}});
+
+        CHECK(result.ends_with("(matched ignoring whitespace differences)"));
+        CHECK(file.contents() == "int f()\r\n{\r\n\treturn 2;\r\n}\r\n");
+    }
+
+    TEST_CASE("edit_file does not double the CR of CRLF in new_string")
+    {
+        ScratchFile file("a\r\nb  \r\nc\r\n");
+        (void)execute_edit_file(
+            {{"file_path", file.path.string()},
+             {"old_string", "a\nb\n"},
+             {"new_string", "\nA\r\nB\n"}});
+
+        CHECK(file.contents() == "\r\nA\r\nB\r\nc\r\n");
+    }
+
+    TEST_CASE("edit_file reports where an inexact old_string nearly is")
+    {
+        ScratchFile file("a();\nfirst(1, 2);\nsecond(3);\nthird();\n");
+        auto const result = execute_edit_file(
+            {{"file_path", file.path.string()},
+             {"old_string", "first(1, 2);\nsecond(4);\nthird();\n"},
+             {"new_string", "x"}});
+
+        CHECK(result.starts_with("Error: old_string not found in "));
+        CHECK(result.find("Closest match at lines 2-4 (2 of 3 lines match")
+              != std::string::npos);
+        CHECK(result.find("first difference at line 3:\n"
+                          "  file:       second(3);\n"
+                          "  old_string: second(4);")
+              != std::string::npos);
+        CHECK(file.contents() == "a();\nfirst(1, 2);\nsecond(3);\nthird();\n");
+    }
+
+    TEST_CASE("edit_file lists the lines of an ambiguous old_string")
+    {
+        ScratchFile file("x;\ny;\nx;\n");
+        auto const result = execute_edit_file(
+            {{"file_path", file.path.string()},
+             {"old_string", "x;"},
+             {"new_string", "z;"}});
+
+        CHECK(result.find("found 2 occurrences, at lines 1, 3")
+              != std::string::npos);
+    }
+
+    TEST_CASE("multi_edit applies every edit against the original")
+    {
+        ScratchFile file("alpha beta\ngamma delta\nepsilon\n");
+        auto const result = execute_multi_edit(multi_edit_args(
+            file,
+            {{"epsilon", "EPSILON"},
+             {"alpha", "beta"},
+             {"beta\n", "BETA\n"}}));
+
+        CHECK(result == "Applied 3 edits to " + file.path.string());
+        CHECK(file.contents() == "beta BETA\ngamma delta\nEPSILON\n");
+    }
+
+    TEST_CASE("multi_edit applies nothing when any edit fails")
+    {
+        auto const original = std::string("one two\nthree two\n");
+        ScratchFile file(original);
+
+        SUBCASE("missing") {
+            auto const result = execute_multi_edit(
+                multi_edit_args(file, {{"one", "1"}, {"four", "4"}}));
+            CHECK(result.starts_with("Error: edit 2: old_string not found"));
+        }
+        SUBCASE("not unique") {
+            auto const result = execute_multi_edit(
+                multi_edit_args(file, {{"one", "1"}, {"two", "2"}}));
+            CHECK(result.find("edit 2: old_string is not unique")
+                  != std::string::npos);
+            CHECK(result.find("found 2 occurrences") != std::string::npos);
+        }
+        SUBCASE("overlapping") {
+            auto const result = execute_multi_edit(multi_edit_args(
+                file, {{"one two", "x"}, {"two\nthree", "y"}}));
+            CHECK(result.starts_with("Error: edits 1 and 2 overlap"));
+        }
+        SUBCASE("empty") {
+            CHECK(execute_multi_edit(multi_edit_args(file, {}))
+                      .starts_with("Error:"));
+            CHECK(execute_multi_edit(multi_edit_args(file, {{"", "x"}}))
+                      .starts_with("Error: edit 1: old_string is empty"));
+        }
+        CHECK(file.contents() == original);
+    }
+
+    TEST_CASE("multi_edit keeps the file's permissions")
+    {
+        ScratchFile file("mode\n");
+        std::filesystem::permissions(
+            file.path, std::filesystem::perms::owner_all);
+        (void)execute_multi_edit(multi_edit_args(file, {{"mode", "MODE"}}));
+
+        CHECK(file.contents() == "MODE\n");
+        CHECK(std::filesystem::status(file.path).permissions()
+              == std::filesystem::perms::owner_all);
+    }
+
+    TEST_CASE("Concurrent edits of one file do not share a temporary file")
+    {
+        ScratchFile file("x\n");
+        std::atomic<int> failures{0};
+        {
+            std::vector<std::jthread> threads;
+            for (int t = 0; t < 8; ++t) {
+                threads.emplace_back([&] {
+                    for (int n = 0; n < 25; ++n) {
+                        auto const result = execute_multi_edit(
+                            multi_edit_args(file, {{"x", "x"}}));
+                        if (not result.starts_with("Applied")) {
+                            ++failures;
+                        }
+                    }
+                });
+            }
+        }
+
+        CHECK(failures == 0);
+        CHECK(file.contents() == "x\n");
+        auto const prefix = file.path.filename().string() + ".tmp.";
+        for (auto const & entry : std::filesystem::directory_iterator(
+                 file.path.parent_path()))
+        {
+            CHECK_FALSE(entry.path().filename().string().starts_with(prefix));
+        }
+    }
+
+    TEST_CASE("apply_patch changes, creates and deletes files")
+    {
+        ScratchFile file("one\ntwo\nthree\n");
+        auto const dir = file.path.parent_path();
+        auto const name = file.path.filename().string();
+        auto const created = dir / (name + ".new");
+        auto const doomed = dir / (name + ".old");
+        std::ofstream(doomed) << "bye\n";
+
+        auto const result = execute_apply_patch({{"patch", std::format(
+            "--- a/{0}\n+++ b/{0}\n"
+            "@@ -2,2 +2,2 @@\n two\n-three\n+THREE\n"
+            "--- /dev/null\n+++ b/{1}\n"
+            "@@ -0,0 +1 @@\n+fresh\n"
+            "--- a/{2}\n+++ /dev/null\n"
+            "@@ -1 +0,0 @@\n-bye\n",
+            file.path.string(),
+            created.string(),
+            doomed.string())}});
+
+        CHECK(result.starts_with("Patched 3 files"));
+        CHECK(result.find("hunk 1: applied at line 2") != std::string::npos);
+        CHECK(file.contents() == "one\ntwo\nTHREE\n");
+        CHECK_FALSE(std::filesystem::exists(doomed));
+        REQUIRE(std::filesystem::exists(created));
+        std::filesystem::remove(created);
+    }
+
+    TEST_CASE("apply_patch counts a renamed file once")
+    {
+        ScratchFile file("one\ntwo\n");
+        auto const renamed = file.path.string() + ".renamed";
+        auto const result = execute_apply_patch({{"patch", std::format(
+            "--- a/{0}\n+++ b/{1}\n"
+            "@@ -1,2 +1,2 @@\n one\n-two\n+TWO\n",
+            file.path.string(),
+            renamed)}});
+
+        CHECK(result.starts_with("Patched 1 files"));
+        CHECK_FALSE(std::filesystem::exists(file.path));
+        REQUIRE(std::filesystem::exists(renamed));
+        CHECK(std::filesystem::file_size(renamed) == 8u);
+        std::filesystem::rename(renamed, file.path);
+    }
+
+    TEST_CASE("apply_patch reports files it could not write")
+    {
+        ScratchFile file("one\n");
+        // A directory cannot be created beneath a regular file.
+        auto const blocked = file.path / "sub" / "new";
+        auto const result = execute_apply_patch({{"patch", std::format(
+            "--- a/{0}\n+++ b/{0}\n"
+            "@@ -1 +1 @@\n-one\n+ONE\n"
+            "--- /dev/null\n+++ b/{1}\n"
+            "@@ -0,0 +1 @@\n+fresh\n",
+            file.path.string(),
+            blocked.string())}});
+
+        CHECK(result.starts_with("Error: patch partly applied"));
+        CHECK(result.find(blocked.string() + ": FAILED, cannot create")
+              != std::string::npos);
+        CHECK(file.contents() == "ONE\n");
+    }
+
+    TEST_CASE("apply_patch writes nothing when a hunk fails")
+    {
+        ScratchFile file("one\ntwo\n");
+        auto const created = file.path.string() + ".new";
+        auto const result = execute_apply_patch({{"patch", std::format(
+            "--- /dev/null\n+++ {1}\n"
+            "@@ -0,0 +1 @@\n+fresh\n"
+            "--- {0}\n+++ {0}\n"
+            "@@ -1,2 +1,2 @@\n one\n-missing\n+x\n",
+            file.path.string(),
+            created)}});
+
+        CHECK(result.starts_with(
+            "Error: patch not applied; no files were changed"));
+        CHECK(result.find("hunk 1: FAILED, context not found")
+              != std::string::npos);
+        CHECK(file.contents() == "one\ntwo\n");
+        CHECK_FALSE(std::filesystem::exists(created));
+    }
+}
+
+} // anonymous namespace
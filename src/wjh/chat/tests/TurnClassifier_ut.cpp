@@ -0,0 +1,76 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#define DOCTEST_CONFIG_ASSERTS_RETURN_VALUES
+#include "wjh/chat/TurnClassifier.hpp"
+
+#include <string>
+
+#include "testing/doctest.hpp"
+
+namespace {
+using namespace wjh::chat;
+using client::ModelTier;
+
+TEST_SUITE("TurnClassifier")
+{
+    TEST_CASE("Short questions go to the fast tier")
+    {
+        auto const decision = classify_turn("What does RAII stand for?", 0);
+        CHECK(decision.tier == ModelTier::fast);
+        CHECK(decision.reason == "short question");
+        CHECK(classify_turn("Thanks!", 2).tier == ModelTier::fast);
+    }
+
+    TEST_CASE("Code fences go to the strong tier")
+    {
+        auto const decision =
+            classify_turn("Why?\n```\nint x;\n```", 0);
+        CHECK(decision.tier == ModelTier::strong);
+        CHECK(decision.reason == "contains code");
+    }
+
+    TEST_CASE("Tool words and paths go to the strong tier")
+    {
+        CHECK(classify_turn("Please FIX the crash", 0).tier
+              == ModelTier::strong);
+        CHECK(classify_turn("Run the tests.", 0).tier == ModelTier::strong);
+        CHECK(classify_turn("What is in src/main?", 0).tier
+              == ModelTier::strong);
+        CHECK(classify_turn("Explain Config.cpp", 0).tier
+              == ModelTier::strong);
+
+        auto const decision = classify_turn("can you build it", 0);
+        CHECK(decision.reason.find("\"build\"") != std::string::npos);
+    }
+
+    TEST_CASE("URLs and words containing tool words stay fast")
+    {
+        CHECK(classify_turn("What is https://example.com?", 0).tier
+              == ModelTier::fast);
+        CHECK(classify_turn("Who is the greatest writer?", 0).tier
+              == ModelTier::fast);
+    }
+
+    TEST_CASE("Long prompts and deep conversations go to the strong tier")
+    {
+        auto const config = TurnClassifierConfig{
+            .max_fast_chars = 20, .max_fast_depth = 4};
+
+        auto const long_prompt =
+            classify_turn("Why is the sky blue at noon?", 0, config);
+        CHECK(long_prompt.tier == ModelTier::strong);
+        CHECK(long_prompt.reason == "long prompt (28 chars)");
+
+        auto const deep = classify_turn("Why?", 5, config);
+        CHECK(deep.tier == ModelTier::strong);
+        CHECK(deep.reason == "deep conversation (5 messages)");
+
+        CHECK(classify_turn("Why?", 4, config).tier == ModelTier::fast);
+    }
+}
+
+} // anonymous namespace
@@ -0,0 +1,357 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/ApprovalPolicy.hpp"
+
+#include "wjh/chat/tools/Patch.hpp"
+#include "wjh/chat/tools/ToolCache.hpp"
+#include "wjh/chat/tools/Tools.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+
+#include <fnmatch.h>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+constexpr std::string_view blanks = " \t\r";
+
+std::string_view
+trim(std::string_view text)
+{
+    auto const first = text.find_first_not_of(blanks);
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    auto const last = text.find_last_not_of(blanks);
+    return text.substr(first, last - first + 1);
+}
+
+/// Split off the first blank-separated word.
+std::pair<std::string_view, std::string_view>
+next_word(std::string_view text)
+{
+    text = trim(text);
+    auto const end = text.find_first_of(blanks);
+    if (end == std::string_view::npos) {
+        return {text, {}};
+    }
+    return {text.substr(0, end), trim(text.substr(end))};
+}
+
+/// Runs more than one command, uses the output of one, or redirects
+/// its input or output.
+bool
+is_compound(std::string_view command)
+{
+    return has_shell_operators(command)
+        or command.find('|') != std::string_view::npos;
+}
+
+/// The commands a compound command runs, split at sequencing,
+/// pipes, substitution and grouping; too many rather than too few.
+std::vector<std::string_view>
+command_segments(std::string_view command)
+{
+    std::vector<std::string_view> segments;
+    while (not command.empty()) {
+        auto const end = command.find_first_of(";&|`(){}\n");
+        auto const segment = trim(command.substr(0, end));
+        if (not segment.empty()) {
+            segments.push_back(segment);
+        }
+        if (end == std::string_view::npos) {
+            break;
+        }
+        command.remove_prefix(end + 1);
+    }
+    return segments;
+}
+
+bool
+is_known_tool(std::string_view tool)
+{
+    return tool == "*" or tool == "bash" or tool == "read_file"
+        or tool == "read_files" or tool == "write_file" or tool == "edit_file"
+        or tool == "multi_edit" or tool == "apply_patch"
+        or tool == "start_job" or tool == "job_status"
+        or tool == "job_output";
+}
+
+/// A path a file tool was given, in the forms rules are matched
+/// against.
+struct CandidatePath
+{
+    /// Absolute against the working directory, `.` and `..` removed.
+    std::string lexical;
+
+    /// Also with symbolic links resolved, as far as the path exists.
+    std::string resolved;
+
+    /// The last component.
+    std::string name;
+};
+
+CandidatePath
+candidate(std::string const & path)
+{
+    if (path.empty()) {
+        return {};
+    }
+    std::error_code ec;
+    auto const lexical = std::filesystem::absolute(path, ec).lexically_normal();
+    auto resolved = std::filesystem::weakly_canonical(lexical, ec);
+    if (ec) {
+        resolved = lexical;
+    }
+    return {
+        .lexical = lexical.string(),
+        .resolved = resolved.string(),
+        .name = lexical.filename().string()};
+}
+
+/// A rule's glob made absolute like CandidatePath, so "src/*" only
+/// covers what is under ./src.
+std::string
+anchor_glob(std::string const & pattern)
+{
+    std::error_code ec;
+    if (pattern.starts_with('/')) {
+        auto const resolved = std::filesystem::weakly_canonical(pattern, ec);
+        return ec ? std::filesystem::path(pattern).lexically_normal().string()
+                  : resolved.string();
+    }
+    // The working directory is a literal prefix, not a glob.
+    std::string cwd;
+    for (auto c : std::filesystem::current_path(ec).string()) {
+        if (std::string_view("*?[\\").find(c) != std::string_view::npos) {
+            cwd += '\\';
+        }
+        cwd += c;
+    }
+    return (std::filesystem::path(cwd) / pattern).lexically_normal().string();
+}
+
+bool
+glob_matches(std::string const & glob, std::string const & text)
+{
+    return not text.empty() and ::fnmatch(glob.c_str(), text.c_str(), 0) == 0;
+}
+
+/// Every path a patch touches; none if it does not parse.
+std::vector<std::string>
+patch_paths(nlohmann::json const & args)
+{
+    std::vector<std::string> paths;
+    auto const patches = parse_patch(args.value("patch", std::string{}));
+    if (patches) {
+        for (auto const & patch : *patches) {
+            for (auto const * path : {&patch.old_path, &patch.new_path}) {
+                if (not path->empty()) {
+                    paths.push_back(*path);
+                }
+            }
+        }
+    }
+    return paths;
+}
+
+/// Every path a batch read names.
+std::vector<std::string>
+read_paths(nlohmann::json const & args)
+{
+    std::vector<std::string> paths;
+    auto const reads = parse_read_files(args);
+    if (reads) {
+        for (auto const & read : *reads) {
+            paths.push_back(read["file_path"].get<std::string>());
+        }
+    }
+    return paths;
+}
+
+} // anonymous namespace
+
+std::optional<Approval>
+parse_approval(std::string_view text)
+{
+    for (auto approval : {Approval::allow, Approval::deny, Approval::ask}) {
+        if (text == to_string(approval)) {
+            return approval;
+        }
+    }
+    return std::nullopt;
+}
+
+Result<void>
+ApprovalPolicy::
+add(Approval approval, std::string_view rule)
+{
+    auto const [tool, pattern] = next_word(rule);
+    if (tool.empty()) {
+        return make_error("empty tool rule");
+    }
+    if (not is_known_tool(tool)) {
+        return make_error("unknown tool '{}' in rule '{}'", tool, rule);
+    }
+    if (tool == "*" and not pattern.empty()) {
+        return make_error("rule '{}': '*' takes no pattern", rule);
+    }
+
+    auto entry = Rule{
+        .approval = approval,
+        .tool = std::string(tool),
+        .pattern = std::string(pattern),
+        .text = std::format("{} {}", to_string(approval), trim(rule))};
+    if ((tool == "bash" or tool == "start_job") and not pattern.empty()) {
+        try {
+            entry.command.emplace(entry.pattern);
+        } catch (std::regex_error const & e) {
+            return make_error("rule '{}': bad regex: {}", rule, e.what());
+        }
+    }
+    rules_.push_back(std::move(entry));
+    return {};
+}
+
+Result<void>
+ApprovalPolicy::
+load(std::string const & path)
+{
+    std::ifstream in(path);
+    if (not in) {
+        return make_error("Cannot open tool policy '{}'", path);
+    }
+    std::string line;
+    for (std::size_t line_number = 1; std::getline(in, line); ++line_number) {
+        auto const text = trim(line);
+        if (text.empty() or text.starts_with('#')) {
+            continue;
+        }
+        auto const [keyword, rest] = next_word(text);
+        if (keyword == "default") {
+            auto const approval = parse_approval(rest);
+            if (not approval) {
+                return make_error(
+                    "{}:{}: default must be allow, deny or ask",
+                    path,
+                    line_number);
+            }
+            default_ = *approval;
+            continue;
+        }
+        auto const approval = parse_approval(keyword);
+        if (not approval) {
+            return make_error(
+                "{}:{}: expected allow, deny, ask or default, got '{}'",
+                path,
+                line_number,
+                keyword);
+        }
+        if (auto added = add(*approval, rest); not added) {
+            return make_error("{}:{}: {}", path, line_number, added.error());
+        }
+    }
+    return {};
+}
+
+PolicyDecision
+ApprovalPolicy::
+decide(std::string_view name, nlohmann::json const & args) const
+{
+    // A background command is judged like a foreground one.
+    auto const is_bash = name == "bash" or name == "start_job";
+    // And reading many files like reading each.
+    auto const is_read = name == "read_file" or name == "read_files";
+    auto const subject =
+        args.value(is_bash ? "command" : "file_path", std::string{});
+    auto const command = trim(subject);
+    auto const segments = is_bash ? command_segments(command)
+                                  : std::vector<std::string_view>{};
+    auto const paths = name == "apply_patch" ? patch_paths(args)
+        : name == "read_files" ? read_paths(args)
+        : std::vector<std::string>{subject};
+    std::vector<CandidatePath> candidates;
+    if (not is_bash) {
+        std::ranges::transform(
+            paths, std::back_inserter(candidates), candidate);
+    }
+
+    for (auto const & rule : rules_) {
+        auto const applies = rule.tool == "*" or rule.tool == name
+            or (is_bash and rule.tool == "bash")
+            or (is_read and rule.tool == "read_file");
+        if (not applies) {
+            continue;
+        }
+        if (rule.pattern.empty()) {
+            return {rule.approval, rule.text};
+        }
+        if (is_bash) {
+            // Allowing a compound command takes a match of the whole
+            // thing, so "make" does not allow "make; rm -rf ~", but a
+            // prefix of any one of its commands is enough to refuse or
+            // ask, so "rm" catches "cd / && rm -rf x".
+            auto const starts = [&](std::string_view text) {
+                return std::regex_search(
+                    text.begin(),
+                    text.end(),
+                    *rule.command,
+                    std::regex_constants::match_continuous);
+            };
+            auto const matched = rule.approval != Approval::allow
+                ? std::ranges::any_of(segments, starts)
+                : is_compound(command)
+                ? std::regex_match(
+                      command.begin(), command.end(), *rule.command)
+                : starts(command);
+            if (matched) {
+                return {rule.approval, rule.text};
+            }
+        } else if (candidates.empty()) {
+            continue;
+        } else {
+            // A file is allowed only if however it is named it is under
+            // the glob, so "src/*" does not allow "src/../../etc/passwd"
+            // or a link out of src; it is refused or questioned if any
+            // name matches, and a glob without a directory also matches
+            // bare file names, so "*.env" catches "/home/me/.env".
+            auto const glob = anchor_glob(rule.pattern);
+            auto const bare = rule.pattern.find('/') == std::string::npos;
+            auto const allowed = [&](CandidatePath const & path) {
+                return glob_matches(glob, path.lexical)
+                    and glob_matches(glob, path.resolved);
+            };
+            auto const caught = [&](CandidatePath const & path) {
+                return glob_matches(glob, path.lexical)
+                    or glob_matches(glob, path.resolved)
+                    or (bare and glob_matches(rule.pattern, path.name));
+            };
+            // A patch or batch read is allowed only if all its files
+            // are, but refused or questioned if any one is.
+            auto const matched = rule.approval == Approval::allow
+                ? std::ranges::all_of(candidates, allowed)
+                : std::ranges::any_of(candidates, caught);
+            if (matched) {
+                return {rule.approval, rule.text};
+            }
+        }
+    }
+
+    if (is_read or name == "job_status" or name == "job_output"
+        or (is_bash and is_read_only_command(command)))
+    {
+        return {Approval::allow, "read-only"};
+    }
+    return {default_, "default"};
+}
+
+} // namespace wjh::chat::tools
@@ -0,0 +1,147 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_6F15CB1789984CCBB59ACF26319A1403
+#define WJH_CHAT_6F15CB1789984CCBB59ACF26319A1403
+
+#include "wjh/chat/Result.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+/**
+ * What happens to a tool call.
+ */
+enum class Approval
+{
+    allow, ///< Runs without asking.
+    deny, ///< Refused without asking.
+    ask ///< The user is prompted.
+};
+
+[[nodiscard]]
+constexpr std::string_view
+to_string(Approval approval)
+{
+    switch (approval) {
+    case Approval::allow:
+        return "allow";
+    case Approval::deny:
+        return "deny";
+    case Approval::ask:
+        break;
+    }
+    return "ask";
+}
+
+/**
+ * Parse "allow", "deny" or "ask".
+ */
+[[nodiscard]]
+std::optional<Approval> parse_approval(std::string_view text);
+
+/**
+ * A policy's verdict on one call, and what produced it.
+ */
+struct PolicyDecision
+{
+    Approval approval;
+
+    /// The matching rule ("allow bash ^make\b"), "read-only", or
+    /// "default".
+    std::string reason;
+};
+
+/**
+ * Decides which tool calls may run without a prompt.
+ *
+ * A rule names a tool ("bash", "read_file", "read_files",
+ * "write_file", "edit_file", "multi_edit", "apply_patch", "start_job",
+ * "job_status", "job_output", or "*" for any) and optionally a
+ * pattern; `bash` rules also cover `start_job`, which runs the same
+ * commands in the background, and `read_file` rules cover
+ * `read_files`.  For commands the pattern is a regular expression
+ * matched at the start of the command, so "git (status|diff)" allows
+ * `git status -s` but not `rm x; git status`; a command using any
+ * shell operator, redirection included, is allowed only by a match
+ * of the whole command, while deny and ask rules are matched at the
+ * start of each command in it, so "rm" denies `cd / && rm -rf x`.
+ * For the file tools the pattern is a glob, where `*` also matches
+ * `/`, matched against the path made absolute against the working
+ * directory with `..` and symbolic links resolved; relative globs are
+ * anchored there too, so a glob under src covers neither
+ * `src/../../etc/passwd` nor a link out of src.  A glob without a `/`
+ * is also matched against the file name when denying or asking, so
+ * "*.env" catches any .env file.  An `apply_patch` or `read_files`
+ * call is allowed by a glob only if every file it touches matches, and
+ * denied if any does.  Rules are checked in the order they were added
+ * and the first match wins.
+ *
+ * Calls no rule matches are allowed when they are read-only
+ * (`read_file`, `read_files`, `job_status`, `job_output`, and
+ * commands is_read_only_command() accepts); everything else gets the
+ * default, normally Approval::ask.
+ */
+class ApprovalPolicy
+{
+public:
+    /**
+     * Add a rule, "<tool> [pattern]", e.g. "bash ^make( |$)".
+     */
+    [[nodiscard]]
+    Result<void> add(Approval approval, std::string_view rule);
+
+    /**
+     * Add the rules in a policy file: one "<allow|deny|ask> <tool>
+     * [pattern]" per line, plus an optional "default <allow|deny|ask>".
+     * Blank lines and lines starting with '#' are ignored.
+     */
+    [[nodiscard]]
+    Result<void> load(std::string const & path);
+
+    void set_default(Approval approval)
+    {
+        default_ = approval;
+    }
+
+    [[nodiscard]]
+    Approval default_approval() const
+    {
+        return default_;
+    }
+
+    /**
+     * Decide a call of tool @p name with arguments @p args.
+     */
+    [[nodiscard]]
+    PolicyDecision decide(
+        std::string_view name,
+        nlohmann::json const & args) const;
+
+private:
+    struct Rule
+    {
+        Approval approval;
+        std::string tool;
+        std::string pattern;
+        std::optional<std::regex> command{};
+        std::string text{};
+    };
+
+    std::vector<Rule> rules_;
+    Approval default_ = Approval::ask;
+};
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_6F15CB1789984CCBB59ACF26319A1403
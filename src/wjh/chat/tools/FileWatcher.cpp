@@ -0,0 +1,311 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/FileWatcher.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+constexpr std::uint32_t watch_mask = IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB
+    | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF
+    | IN_MOVE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+
+/// Rewritten by git on every status, and never read through the tools.
+bool
+is_skipped(std::filesystem::path const & name)
+{
+    return name == ".git";
+}
+
+std::filesystem::path
+canonical_or_absolute(std::filesystem::path const & path)
+{
+    std::error_code ec;
+    auto result = std::filesystem::canonical(path, ec);
+    if (ec) {
+        result = std::filesystem::absolute(path, ec);
+    }
+    return ec ? path : result;
+}
+
+} // anonymous namespace
+
+std::vector<FileChange>
+ChangeFeed::
+take()
+{
+    if (not pending_.load(std::memory_order_acquire)) {
+        return {};
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.store(false, std::memory_order_relaxed);
+    return std::exchange(changes_, {});
+}
+
+void
+ChangeFeed::
+push(FileChange change)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Everything subsumes whatever came before or after it.
+    auto const lost_track = change.kind == ChangeKind::everything
+        or changes_.size() >= max_pending;
+    if (lost_track) {
+        changes_.assign(1, FileChange{.kind = ChangeKind::everything});
+    } else if (
+        changes_.empty() or changes_.front().kind != ChangeKind::everything)
+    {
+        changes_.push_back(std::move(change));
+    }
+    pending_.store(true, std::memory_order_release);
+}
+
+FileWatcher::
+FileWatcher(std::filesystem::path const & root, FileWatcherConfig config)
+: root_(canonical_or_absolute(root))
+, config_(config)
+{
+    inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotify_fd_ < 0 or wake_fd_ < 0) {
+        // Never ready; subscribers validate for themselves.
+        return;
+    }
+    thread_ = std::jthread([this](std::stop_token stop) { watch(stop); });
+}
+
+FileWatcher::
+~FileWatcher()
+{
+    if (thread_.joinable()) {
+        thread_.request_stop();
+        std::uint64_t const one = 1;
+        [[maybe_unused]] auto const n = ::write(wake_fd_, &one, sizeof one);
+        thread_.join();
+    }
+    for (auto fd : {inotify_fd_, wake_fd_}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+std::shared_ptr<ChangeFeed>
+FileWatcher::
+subscribe()
+{
+    auto feed = std::make_shared<ChangeFeed>();
+    std::lock_guard<std::mutex> lock(feeds_mutex_);
+    feeds_.push_back(feed);
+    return feed;
+}
+
+bool
+FileWatcher::
+covers(std::filesystem::path const & path) const
+{
+    auto const relative = path.lexically_relative(root_);
+    if (relative.empty() or *relative.begin() == "..") {
+        return false;
+    }
+    return std::ranges::none_of(relative, is_skipped);
+}
+
+void
+FileWatcher::
+watch(std::stop_token stop)
+{
+    if (not rescan(stop)) {
+        return;
+    }
+
+    // Large enough for a burst of events from a build.
+    alignas(inotify_event) char buffer[64 * 1024];
+    pollfd fds[] = {
+        {.fd = inotify_fd_, .events = POLLIN, .revents = 0},
+        {.fd = wake_fd_, .events = POLLIN, .revents = 0}};
+    while (not stop.stop_requested()) {
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents != 0) {
+            break;
+        }
+        for (;;) {
+            auto const n = ::read(inotify_fd_, buffer, sizeof buffer);
+            if (n <= 0) {
+                break;
+            }
+            handle_events(buffer, static_cast<std::size_t>(n), stop);
+        }
+        if (needs_rescan_ and not rescan(stop)) {
+            break;
+        }
+    }
+    set_ready(false);
+}
+
+bool
+FileWatcher::
+rescan(std::stop_token const & stop)
+{
+    set_ready(false);
+    needs_rescan_ = false;
+
+    // Paths of moved directories are stale; start over.
+    for (auto const & [wd, path] : directories_) {
+        ::inotify_rm_watch(inotify_fd_, wd);
+    }
+    directories_.clear();
+    if (not add_tree(root_, stop)) {
+        publish({.kind = ChangeKind::everything});
+        return false;
+    }
+
+    // Publish before becoming ready, so a subscriber that sees the new
+    // epoch also sees this.
+    publish({.kind = ChangeKind::everything});
+    set_ready(true);
+    return true;
+}
+
+bool
+FileWatcher::
+add_tree(std::filesystem::path const & top, std::stop_token const & stop)
+{
+    auto const add = [this](std::filesystem::path const & dir) {
+        if (directories_.size() >= config_.max_directories) {
+            return false;
+        }
+        auto const wd =
+            ::inotify_add_watch(inotify_fd_, dir.c_str(), watch_mask);
+        if (wd < 0) {
+            // A directory that vanished meanwhile needs no watch.
+            return errno != ENOSPC and errno != ENOMEM;
+        }
+        directories_[wd] = dir;
+        return true;
+    };
+
+    if (not add(top)) {
+        return false;
+    }
+    std::error_code ec;
+    auto it = std::filesystem::recursive_directory_iterator(
+        top,
+        std::filesystem::directory_options::skip_permission_denied,
+        ec);
+    for (; not ec and it != std::filesystem::recursive_directory_iterator();
+         it.increment(ec))
+    {
+        if (stop.stop_requested()) {
+            return false;
+        }
+        std::error_code type_ec;
+        if (it->is_symlink(type_ec) or not it->is_directory(type_ec)) {
+            continue;
+        }
+        if (is_skipped(it->path().filename())) {
+            it.disable_recursion_pending();
+            continue;
+        }
+        if (not add(it->path())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+FileWatcher::
+handle_events(
+    char const * buffer,
+    std::size_t size,
+    std::stop_token const & stop)
+{
+    for (std::size_t offset = 0; offset < size;) {
+        auto const * event =
+            reinterpret_cast<inotify_event const *>(buffer + offset);
+        offset += sizeof(inotify_event) + event->len;
+
+        if (event->mask & IN_Q_OVERFLOW) {
+            needs_rescan_ = true;
+            continue;
+        }
+        auto const dir = directories_.find(event->wd);
+        if (dir == directories_.end()) {
+            continue;
+        }
+        if (event->mask & IN_IGNORED) {
+            directories_.erase(dir);
+            continue;
+        }
+        if (event->mask & IN_MOVE_SELF) {
+            needs_rescan_ = true;
+            continue;
+        }
+        if (event->len == 0) {
+            continue;
+        }
+
+        auto path = dir->second / event->name;
+        if (not (event->mask & IN_ISDIR)) {
+            publish({.kind = ChangeKind::file, .path = std::move(path)});
+            continue;
+        }
+        if (is_skipped(path.filename())) {
+            continue;
+        }
+        if (event->mask & IN_MOVED_FROM) {
+            // Watches below it now report under the wrong path.
+            needs_rescan_ = true;
+        }
+        if ((event->mask & (IN_CREATE | IN_MOVED_TO))
+            and not add_tree(path, stop))
+        {
+            needs_rescan_ = true;
+        }
+        publish({.kind = ChangeKind::tree, .path = std::move(path)});
+    }
+}
+
+void
+FileWatcher::
+publish(FileChange const & change)
+{
+    std::lock_guard<std::mutex> lock(feeds_mutex_);
+    std::erase_if(feeds_, [&](std::weak_ptr<ChangeFeed> const & weak) {
+        auto feed = weak.lock();
+        if (feed) {
+            feed->push(change);
+        }
+        return not feed;
+    });
+}
+
+void
+FileWatcher::
+set_ready(bool ready)
+{
+    ready_epoch_.store(ready ? ++epochs_ : 0, std::memory_order_release);
+}
+
+} // namespace wjh::chat::tools
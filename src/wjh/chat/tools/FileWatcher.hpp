@@ -0,0 +1,189 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_CC3831BC83C64DA5BB2120DAF4196D45
+#define WJH_CHAT_CC3831BC83C64DA5BB2120DAF4196D45
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+/**
+ * What a FileChange covers.
+ */
+enum class ChangeKind
+{
+    file, ///< The file at path.
+    tree, ///< Anything at or below path.
+    everything ///< Anything at all; the watcher lost track.
+};
+
+/**
+ * One change published by a FileWatcher.
+ */
+struct FileChange
+{
+    ChangeKind kind;
+
+    /// Absolute and canonical; empty for ChangeKind::everything.
+    std::filesystem::path path{};
+
+    friend bool operator == (FileChange const &, FileChange const &) =
+        default;
+};
+
+/**
+ * Changes published to one subscriber, until it takes them.
+ *
+ * The watcher thread pushes and the subscriber takes, each on its own
+ * thread; take() costs one atomic load when nothing is pending.
+ */
+class ChangeFeed
+{
+public:
+    /// Pending changes beyond this are collapsed into one
+    /// ChangeKind::everything, so an idle subscriber costs bounded
+    /// memory during a build.
+    static constexpr std::size_t max_pending = 1024;
+
+    /**
+     * Changes published since the last call, oldest first.
+     */
+    [[nodiscard]]
+    std::vector<FileChange> take();
+
+    void push(FileChange change);
+
+private:
+    std::mutex mutex_;
+    std::atomic<bool> pending_{false};
+    std::vector<FileChange> changes_;
+};
+
+/**
+ * How FileWatcher covers a workspace.
+ */
+struct FileWatcherConfig
+{
+    /// Directories watched at most; beyond this, or the kernel's
+    /// inotify limit, the watcher covers nothing.
+    std::size_t max_directories = 16384;
+};
+
+/**
+ * Publishes changes to the files under a workspace directory.
+ *
+ * A background thread watches every directory in the tree with
+ * inotify(7), skipping `.git`, whose contents git rewrites on every
+ * status.  Changes are pushed to each subscriber's ChangeFeed as they
+ * happen, so a cache that subscribes can trust its entries for covered
+ * files without stat'ing them on every hit.
+ *
+ * Whenever the watcher may have missed something (before the initial
+ * scan finishes, after the kernel's event queue overflows, or after a
+ * directory is moved) it stops covering anything, rescans the tree,
+ * publishes ChangeKind::everything and only then covers it again.
+ * ready_epoch() lets a subscriber tell whether that happened while it
+ * was looking.
+ *
+ * If inotify is unavailable or the tree is too large, the watcher
+ * never becomes ready and subscribers keep validating for themselves.
+ */
+class FileWatcher
+{
+public:
+    explicit FileWatcher(
+        std::filesystem::path const & root,
+        FileWatcherConfig config = {});
+
+    /**
+     * Stop watching and join the thread.
+     */
+    ~FileWatcher();
+
+    FileWatcher(FileWatcher const &) = delete;
+    FileWatcher & operator = (FileWatcher const &) = delete;
+
+    /**
+     * A new feed receiving every change published from now on.  The
+     * watcher keeps only a weak reference to it.
+     */
+    [[nodiscard]]
+    std::shared_ptr<ChangeFeed> subscribe();
+
+    /**
+     * 0 while the watcher does not cover the tree; otherwise a number
+     * that is different each time it starts covering it again.
+     *
+     * A subscriber reads this, takes its pending changes, and may then
+     * trust what it knows about covered files if the epoch is still
+     * the same and non-zero.
+     */
+    [[nodiscard]]
+    std::uint64_t ready_epoch() const
+    {
+        return ready_epoch_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Whether changes to @p path, absolute and canonical, are
+     * published while the watcher is ready.
+     */
+    [[nodiscard]]
+    bool covers(std::filesystem::path const & path) const;
+
+    [[nodiscard]]
+    std::filesystem::path const & root() const
+    {
+        return root_;
+    }
+
+private:
+    void watch(std::stop_token stop);
+    bool rescan(std::stop_token const & stop);
+    bool add_tree(
+        std::filesystem::path const & top,
+        std::stop_token const & stop);
+    void handle_events(
+        char const * buffer,
+        std::size_t size,
+        std::stop_token const & stop);
+    void publish(FileChange const & change);
+    void set_ready(bool ready);
+
+    std::filesystem::path root_;
+    FileWatcherConfig config_;
+
+    int inotify_fd_ = -1;
+    int wake_fd_ = -1;
+
+    /// Watch descriptor to directory; watcher thread only.
+    std::unordered_map<int, std::filesystem::path> directories_;
+
+    /// Set when a moved directory leaves directories_ stale.
+    bool needs_rescan_ = false;
+
+    std::atomic<std::uint64_t> ready_epoch_{0};
+    std::uint64_t epochs_ = 0;
+
+    std::mutex feeds_mutex_;
+    std::vector<std::weak_ptr<ChangeFeed>> feeds_;
+
+    std::jthread thread_;
+};
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_CC3831BC83C64DA5BB2120DAF4196D45
@@ -0,0 +1,328 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/Jobs.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <mutex>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+} // anonymous namespace
+
+int
+spawn_shell(
+    std::string const & command,
+    int output_fd,
+    Sandbox const * sandbox)
+{
+    auto const pid = ::fork();
+    if (pid == 0) {
+        // Own process group, so the whole pipeline can be killed and
+        // Ctrl-C at the terminal reaches only the chat loop.
+        ::setpgid(0, 0);
+        if (sandbox) {
+            sandbox->enter();
+        }
+        auto const null = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+        ::dup2(null, STDIN_FILENO);
+        ::dup2(output_fd, STDOUT_FILENO);
+        ::dup2(output_fd, STDERR_FILENO);
+        ::execl("/bin/sh", "sh", "-c", command.c_str(), nullptr);
+        ::_exit(127);
+    }
+    if (pid > 0) {
+        ::setpgid(pid, pid);
+    }
+    return pid;
+}
+
+bool
+capture_output(
+    int pid,
+    int fd,
+    std::stop_token stop,
+    std::function<void(std::string_view)> const & sink)
+{
+    std::array<char, 4096> buffer;
+    std::optional<Clock::time_point> terminated;
+    for (;;) {
+        if (stop.stop_requested()) {
+            auto const now = Clock::now();
+            if (not terminated) {
+                ::kill(-pid, SIGTERM);
+                terminated = now;
+            } else if (now - *terminated > std::chrono::seconds{2}) {
+                ::kill(-pid, SIGKILL);
+            }
+            // Something that left the group may hold the pipe open.
+            if (now - *terminated > std::chrono::seconds{3}) {
+                break;
+            }
+        }
+
+        pollfd pfd{.fd = fd, .events = POLLIN, .revents = 0};
+        auto const ready = ::poll(&pfd, 1, 100);
+        if (ready < 0 and errno != EINTR) {
+            break;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        auto const n = ::read(fd, buffer.data(), buffer.size());
+        if (n < 0 and errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        sink(std::string_view(buffer.data(), static_cast<std::size_t>(n)));
+    }
+    return terminated.has_value();
+}
+
+OutputRing::
+OutputRing(std::size_t capacity)
+: buffer_(std::max<std::size_t>(capacity, 1))
+{
+}
+
+void
+OutputRing::
+append(std::string_view text)
+{
+    auto const capacity = buffer_.size();
+    if (text.size() > capacity) {
+        total_ += text.size() - capacity;
+        text.remove_prefix(text.size() - capacity);
+    }
+    while (not text.empty()) {
+        auto const at = static_cast<std::size_t>(total_ % capacity);
+        auto const n = std::min(text.size(), capacity - at);
+        std::copy_n(text.data(), n, buffer_.data() + at);
+        text.remove_prefix(n);
+        total_ += n;
+    }
+}
+
+OutputSlice
+OutputRing::
+since(std::uintmax_t from) const
+{
+    auto const capacity = buffer_.size();
+    auto const oldest = total_ > capacity ? total_ - capacity : 0;
+    auto result = OutputSlice{};
+    if (from < oldest) {
+        result.skipped = oldest - from;
+        from = oldest;
+    }
+    result.text.reserve(static_cast<std::size_t>(total_ - from));
+    for (auto offset = from; offset < total_;) {
+        auto const at = static_cast<std::size_t>(offset % capacity);
+        auto const n = std::min(
+            static_cast<std::size_t>(total_ - offset),
+            capacity - at);
+        result.text.append(buffer_.data() + at, n);
+        offset += n;
+    }
+    return result;
+}
+
+struct JobManager::Job
+{
+    Job(std::size_t job_id, std::string job_command, std::size_t capacity)
+    : id(job_id)
+    , command(std::move(job_command))
+    , output(capacity)
+    {
+    }
+
+    std::size_t const id;
+    std::string const command;
+    int pid = -1;
+    Clock::time_point const started = Clock::now();
+
+    mutable std::mutex mutex;
+    std::condition_variable_any finished;
+    OutputRing output;
+    std::uintmax_t read = 0;
+    std::optional<int> status{};
+    ResourceUsage usage{};
+    Clock::time_point ended{};
+
+    /// Declared last: joined before the members it uses go away.
+    std::jthread supervisor{};
+
+    JobInfo info() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return JobInfo{
+            .id = id,
+            .command = command,
+            .pid = pid,
+            .status = status,
+            .usage = usage,
+            .elapsed = (status ? ended : Clock::now()) - started,
+            .output_bytes = output.total(),
+            .unread_bytes = output.total() - read};
+    }
+
+    /// Capture output until the job closes it, then reap the job.  A
+    /// stop terminates the process group.
+    void supervise(int fd, std::stop_token stop)
+    {
+        capture_output(pid, fd, stop, [this](std::string_view chunk) {
+            std::lock_guard<std::mutex> lock(mutex);
+            output.append(chunk);
+        });
+        ::close(fd);
+
+        ResourceUsage job_usage;
+        auto const wait_status = reap(pid, &job_usage);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            status = wait_status;
+            usage = job_usage;
+            ended = Clock::now();
+        }
+        finished.notify_all();
+    }
+};
+
+JobManager::
+JobManager(JobConfig config)
+: config_(config)
+{
+}
+
+JobManager::
+~JobManager()
+{
+    // Stop every job before joining any, so they wind down together.
+    for (auto & [id, job] : jobs_) {
+        job->supervisor.request_stop();
+    }
+    jobs_.clear();
+}
+
+Result<std::size_t>
+JobManager::
+start(std::string const & command)
+{
+    if (running() >= config_.max_running) {
+        return make_error(
+            "{} jobs are already running; wait for one to finish",
+            config_.max_running);
+    }
+
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC) != 0) {
+        return make_error("failed to start job");
+    }
+    auto job =
+        std::make_unique<Job>(next_id_, command, config_.output_bytes);
+    job->pid = spawn_shell(command, fds[1], sandbox_.get());
+    ::close(fds[1]);
+    if (job->pid < 0) {
+        ::close(fds[0]);
+        return make_error("failed to start job");
+    }
+    job->supervisor = std::jthread(
+        [raw = job.get(), fd = fds[0]](std::stop_token stop) {
+            raw->supervise(fd, stop);
+        });
+
+    auto const id = next_id_++;
+    jobs_.emplace(id, std::move(job));
+    return id;
+}
+
+JobManager::Job const *
+JobManager::
+find(std::size_t id) const
+{
+    auto const it = jobs_.find(id);
+    return it == jobs_.end() ? nullptr : it->second.get();
+}
+
+std::optional<JobInfo>
+JobManager::
+info(std::size_t id) const
+{
+    auto const * job = find(id);
+    if (not job) {
+        return std::nullopt;
+    }
+    return job->info();
+}
+
+std::vector<JobInfo>
+JobManager::
+list() const
+{
+    std::vector<JobInfo> result;
+    result.reserve(jobs_.size());
+    for (auto const & [id, job] : jobs_) {
+        result.push_back(job->info());
+    }
+    return result;
+}
+
+std::size_t
+JobManager::
+running() const
+{
+    return static_cast<std::size_t>(
+        std::ranges::count_if(jobs_, [](auto const & kv) {
+            std::lock_guard<std::mutex> lock(kv.second->mutex);
+            return not kv.second->status.has_value();
+        }));
+}
+
+bool
+JobManager::
+wait(std::size_t id, Clock::duration timeout, std::stop_token stop)
+{
+    auto const it = jobs_.find(id);
+    if (it == jobs_.end()) {
+        return false;
+    }
+    auto & job = *it->second;
+    std::unique_lock<std::mutex> lock(job.mutex);
+    return job.finished.wait_for(lock, stop, timeout, [&] {
+        return job.status.has_value();
+    });
+}
+
+std::optional<OutputSlice>
+JobManager::
+read(std::size_t id)
+{
+    auto const it = jobs_.find(id);
+    if (it == jobs_.end()) {
+        return std::nullopt;
+    }
+    auto & job = *it->second;
+    std::lock_guard<std::mutex> lock(job.mutex);
+    auto slice = job.output.since(job.read);
+    job.read = job.output.total();
+    return slice;
+}
+
+} // namespace wjh::chat::tools
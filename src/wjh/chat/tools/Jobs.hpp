@@ -0,0 +1,215 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_E0B7DFAACD704F7DB8B5347A15478858
+#define WJH_CHAT_E0B7DFAACD704F7DB8B5347A15478858
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/tools/Sandbox.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+/**
+ * Start `/bin/sh -c command` in its own process group, with stdin from
+ * /dev/null and stdout and stderr on @p output_fd, and inside
+ * @p sandbox if there is one.
+ *
+ * @return the child's pid, which is also its process group, or -1.
+ */
+[[nodiscard]]
+int spawn_shell(
+    std::string const & command,
+    int output_fd,
+    Sandbox const * sandbox = nullptr);
+
+/**
+ * Pass what the process group @p pid writes to @p fd to @p sink, chunk
+ * by chunk, until the pipe is closed.  A stop sends the group SIGTERM,
+ * then SIGKILL after 2 s, and gives up on the pipe after 3 s, since
+ * something that left the group may still hold it open.
+ *
+ * @return whether a stop was requested.
+ */
+bool capture_output(
+    int pid,
+    int fd,
+    std::stop_token stop,
+    std::function<void(std::string_view)> const & sink);
+
+/**
+ * Part of an OutputRing's contents.
+ */
+struct OutputSlice
+{
+    std::string text;
+
+    /// Bytes between the requested offset and text that the ring no
+    /// longer holds.
+    std::uintmax_t skipped = 0;
+};
+
+/**
+ * The newest bytes of a stream, in a fixed-size buffer.
+ */
+class OutputRing
+{
+public:
+    explicit OutputRing(std::size_t capacity);
+
+    void append(std::string_view text);
+
+    /**
+     * Bytes appended since the ring was created.
+     */
+    [[nodiscard]]
+    std::uintmax_t total() const
+    {
+        return total_;
+    }
+
+    /**
+     * Everything from stream offset @p from on that is still held.
+     */
+    [[nodiscard]]
+    OutputSlice since(std::uintmax_t from) const;
+
+private:
+    std::vector<char> buffer_;
+    std::uintmax_t total_ = 0;
+};
+
+/**
+ * Limits on JobManager.
+ */
+struct JobConfig
+{
+    /// Output kept per job; older output is dropped.
+    std::size_t output_bytes = 100'000;
+
+    /// Jobs running at once.
+    std::size_t max_running = 8;
+};
+
+/**
+ * A snapshot of one background job.
+ */
+struct JobInfo
+{
+    std::size_t id;
+    std::string command;
+    int pid;
+
+    /// waitpid(2) status once the job has finished.
+    std::optional<int> status;
+
+    /// What the job consumed; zero until it has finished.
+    ResourceUsage usage;
+
+    /// Run time so far, or until it finished.
+    std::chrono::steady_clock::duration elapsed;
+
+    std::uintmax_t output_bytes;
+
+    /// Output produced since the last read().
+    std::uintmax_t unread_bytes;
+};
+
+/**
+ * Shell commands running in the background while the agent loop goes
+ * on.
+ *
+ * Each job runs in its own process group, in the sandbox if one is
+ * set, and is supervised by a
+ * thread that captures its output into an OutputRing and reaps it.
+ * Destroying the manager (the session ending) terminates every job
+ * still running, SIGTERM first and SIGKILL after a grace period.
+ *
+ * Jobs are started and queried from one thread; waiting on one may be
+ * cut short by a stop token.
+ */
+class JobManager
+{
+public:
+    explicit JobManager(JobConfig config = {});
+    ~JobManager();
+
+    JobManager(JobManager const &) = delete;
+    JobManager & operator = (JobManager const &) = delete;
+
+    /**
+     * Start later jobs inside @p sandbox.
+     */
+    void set_sandbox(std::shared_ptr<Sandbox const> sandbox)
+    {
+        sandbox_ = std::move(sandbox);
+    }
+
+    /**
+     * Start @p command, returning its job id.
+     */
+    [[nodiscard]]
+    Result<std::size_t> start(std::string const & command);
+
+    [[nodiscard]]
+    std::optional<JobInfo> info(std::size_t id) const;
+
+    /**
+     * Every job started, oldest first.
+     */
+    [[nodiscard]]
+    std::vector<JobInfo> list() const;
+
+    /**
+     * Jobs not yet finished.
+     */
+    [[nodiscard]]
+    std::size_t running() const;
+
+    /**
+     * Wait until job @p id finishes, @p timeout passes or @p stop is
+     * requested.
+     *
+     * @return whether the job has finished; false for an unknown id.
+     */
+    bool wait(
+        std::size_t id,
+        std::chrono::steady_clock::duration timeout,
+        std::stop_token stop = {});
+
+    /**
+     * Output job @p id produced since the last call, which is then
+     * marked read; std::nullopt for an unknown id.
+     */
+    [[nodiscard]]
+    std::optional<OutputSlice> read(std::size_t id);
+
+private:
+    struct Job;
+
+    [[nodiscard]]
+    Job const * find(std::size_t id) const;
+
+    JobConfig config_;
+    std::shared_ptr<Sandbox const> sandbox_;
+    std::map<std::size_t, std::unique_ptr<Job>> jobs_;
+    std::size_t next_id_ = 1;
+};
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_E0B7DFAACD704F7DB8B5347A15478858
@@ -0,0 +1,107 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/LiveOutput.hpp"
+
+#include <format>
+#include <utility>
+
+namespace wjh::chat::tools {
+
+LiveOutput::
+LiveOutput(std::ostream & out, LiveOutputConfig config)
+: out_(out)
+, config_(config)
+, renderer_([this](std::stop_token stop) { render(stop); })
+{
+}
+
+LiveOutput::
+~LiveOutput()
+{
+    finish();
+}
+
+void
+LiveOutput::
+write(std::string_view text)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (finished_) {
+        out_ << text << std::flush;
+        return;
+    }
+
+    // Keep the newest bytes: the end of a build log is what matters.
+    auto const total = pending_.size() + text.size();
+    if (total > config_.max_pending) {
+        auto const excess = total - config_.max_pending;
+        dropped_ += excess;
+        unreported_ += excess;
+        if (excess >= pending_.size()) {
+            pending_.assign(text.substr(excess - pending_.size()));
+            return;
+        }
+        pending_.erase(0, excess);
+    }
+    pending_ += text;
+}
+
+void
+LiveOutput::
+finish()
+{
+    if (renderer_.joinable()) {
+        renderer_.request_stop();
+        renderer_.join();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (not finished_) {
+        flush_pending(lock);
+        finished_ = true;
+    }
+}
+
+std::size_t
+LiveOutput::
+dropped() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+void
+LiveOutput::
+render(std::stop_token stop)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (not stop.stop_requested()) {
+        wake_.wait_for(lock, stop, config_.interval, [] { return false; });
+        flush_pending(lock);
+    }
+}
+
+void
+LiveOutput::
+flush_pending(std::unique_lock<std::mutex> & lock)
+{
+    if (pending_.empty() and unreported_ == 0) {
+        return;
+    }
+    auto text = std::move(pending_);
+    pending_.clear();
+    auto const skipped = std::exchange(unreported_, 0);
+
+    // Write without the lock, so the producer keeps going meanwhile.
+    lock.unlock();
+    if (skipped > 0) {
+        out_ << std::format("\n[... {} bytes not shown ...]\n", skipped);
+    }
+    out_ << text << std::flush;
+    lock.lock();
+}
+
+} // namespace wjh::chat::tools
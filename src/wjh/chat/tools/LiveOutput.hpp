@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_C73E1436BECD45D29C08C93777268360
+#define WJH_CHAT_C73E1436BECD45D29C08C93777268360
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace wjh::chat::tools {
+
+/**
+ * How LiveOutput renders.
+ */
+struct LiveOutputConfig
+{
+    /// Time between flushes to the terminal.
+    std::chrono::milliseconds interval{50};
+
+    /// Unrendered bytes kept when the terminal falls behind; the oldest
+    /// beyond this are dropped, with a note saying how many.
+    std::size_t max_pending = 64 * 1024;
+};
+
+/**
+ * Streams a running tool's output to the terminal as it is produced.
+ *
+ * write() only appends to a buffer, so a producer never waits on a slow
+ * terminal; a separate thread renders the buffer every interval.  When
+ * the terminal cannot keep up, what it misses is dropped rather than
+ * queued without bound, and the drop is noted in the stream.
+ */
+class LiveOutput
+{
+public:
+    explicit LiveOutput(std::ostream & out, LiveOutputConfig config = {});
+
+    /**
+     * Flush whatever is pending and stop rendering.
+     */
+    ~LiveOutput();
+
+    LiveOutput(LiveOutput const &) = delete;
+    LiveOutput & operator = (LiveOutput const &) = delete;
+
+    /**
+     * Queue @p text for rendering.
+     */
+    void write(std::string_view text);
+
+    /**
+     * Render everything queued so far and stop the render thread;
+     * later writes go straight to the stream.
+     */
+    void finish();
+
+    /**
+     * Bytes dropped because the terminal fell behind.
+     */
+    [[nodiscard]]
+    std::size_t dropped() const;
+
+private:
+    void render(std::stop_token stop);
+    void flush_pending(std::unique_lock<std::mutex> & lock);
+
+    std::ostream & out_;
+    LiveOutputConfig config_;
+    mutable std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::string pending_;
+    std::size_t dropped_ = 0;
+    std::size_t unreported_ = 0;
+    bool finished_ = false;
+    std::jthread renderer_;
+};
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_C73E1436BECD45D29C08C93777268360
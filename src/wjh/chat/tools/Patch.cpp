@@ -0,0 +1,353 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/Patch.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <optional>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+std::vector<std::string_view>
+split_lines(std::string_view text)
+{
+    std::vector<std::string_view> lines;
+    while (not text.empty()) {
+        auto const end = text.find('\n');
+        if (end == std::string_view::npos) {
+            lines.push_back(text);
+            break;
+        }
+        lines.push_back(text.substr(0, end));
+        text.remove_prefix(end + 1);
+    }
+    return lines;
+}
+
+std::string_view
+without_cr(std::string_view line)
+{
+    if (line.ends_with('\r')) {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+/// The path on a "--- " or "+++ " line, without timestamp or prefix.
+std::string
+header_path(std::string_view line, std::string_view prefix)
+{
+    line = without_cr(line.substr(4));
+    line = line.substr(0, line.find('\t'));
+    while (line.ends_with(' ')) {
+        line.remove_suffix(1);
+    }
+    if (line == "/dev/null") {
+        return {};
+    }
+    if (line.starts_with(prefix)) {
+        line.remove_prefix(prefix.size());
+    }
+    return std::string(line);
+}
+
+bool
+is_file_header(std::vector<std::string_view> const & lines, std::size_t i)
+{
+    return lines[i].starts_with("--- ") and i + 1 < lines.size()
+        and lines[i + 1].starts_with("+++ ");
+}
+
+/// The "a" of "@@ -a,b +c,d @@"; 0 if there is none.
+std::size_t
+hunk_old_start(std::string_view header)
+{
+    auto const minus = header.find('-');
+    if (minus == std::string_view::npos) {
+        return 0;
+    }
+    std::size_t start = 0;
+    auto const * const first = header.data() + minus + 1;
+    auto const [ptr, ec] =
+        std::from_chars(first, header.data() + header.size(), start);
+    return ec == std::errc{} ? start : 0;
+}
+
+/// File lines equal modulo a CR left by CRLF line endings on one side.
+bool
+same_line(std::string_view file_line, std::string_view patch_line)
+{
+    return without_cr(file_line) == without_cr(patch_line);
+}
+
+/// Where @p pattern occurs at or after @p min_start, nearest to
+/// @p expected first.
+std::optional<std::size_t>
+find_nearest(
+    std::vector<std::string_view> const & lines,
+    std::vector<std::string_view> const & pattern,
+    std::ptrdiff_t expected,
+    std::size_t min_start)
+{
+    if (pattern.size() > lines.size()
+        or min_start > lines.size() - pattern.size())
+    {
+        return std::nullopt;
+    }
+    auto const lo = static_cast<std::ptrdiff_t>(min_start);
+    auto const hi = static_cast<std::ptrdiff_t>(lines.size() - pattern.size());
+    expected = std::clamp(expected, lo, hi);
+
+    auto const matches = [&](std::ptrdiff_t pos) {
+        auto const at = static_cast<std::size_t>(pos);
+        for (std::size_t k = 0; k < pattern.size(); ++k) {
+            if (not same_line(lines[at + k], pattern[k])) {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (std::ptrdiff_t distance = 0;
+         expected - distance >= lo or expected + distance <= hi;
+         ++distance)
+    {
+        if (expected - distance >= lo and matches(expected - distance)) {
+            return static_cast<std::size_t>(expected - distance);
+        }
+        if (distance > 0 and expected + distance <= hi
+            and matches(expected + distance))
+        {
+            return static_cast<std::size_t>(expected + distance);
+        }
+    }
+    return std::nullopt;
+}
+
+/// Lines of one side of a hunk, without their prefix.
+std::vector<std::string_view>
+hunk_side(Hunk const & hunk, char changed)
+{
+    std::vector<std::string_view> side;
+    for (auto const & line : hunk.lines) {
+        if (line[0] == ' ' or line[0] == changed) {
+            side.push_back(std::string_view(line).substr(1));
+        }
+    }
+    return side;
+}
+
+} // anonymous namespace
+
+Result<std::vector<FilePatch>>
+parse_patch(std::string_view text)
+{
+    auto const lines = split_lines(text);
+    std::vector<FilePatch> patches;
+
+    for (std::size_t i = 0; i < lines.size();) {
+        if (not is_file_header(lines, i)) {
+            ++i;
+            continue;
+        }
+        auto patch = FilePatch{
+            .old_path = header_path(lines[i], "a/"),
+            .new_path = header_path(lines[i + 1], "b/")};
+        i += 2;
+
+        while (i < lines.size() and lines[i].starts_with("@@")) {
+            auto hunk = Hunk{.old_start = hunk_old_start(lines[i])};
+            for (++i; i < lines.size(); ++i) {
+                auto const line = lines[i];
+                if (line.starts_with("@@") or is_file_header(lines, i)) {
+                    break;
+                }
+                if (line.empty() or line == "\r") {
+                    hunk.lines.push_back(" ");
+                } else if (line[0] == ' ' or line[0] == '-' or line[0] == '+') {
+                    hunk.lines.emplace_back(line);
+                } else if (line[0] == '\\') {
+                    if (hunk.lines.empty()) {
+                        continue;
+                    }
+                    auto const last = hunk.lines.back()[0];
+                    hunk.old_missing_newline |= last != '+';
+                    hunk.new_missing_newline |= last != '-';
+                } else {
+                    break;
+                }
+            }
+            // Blank lines after a hunk are usually just separators.
+            while (not hunk.lines.empty() and hunk.lines.back() == " ") {
+                hunk.lines.pop_back();
+            }
+            if (std::ranges::any_of(hunk.lines, [](std::string const & l) {
+                    return l[0] != ' ';
+                }))
+            {
+                patch.hunks.push_back(std::move(hunk));
+            }
+        }
+
+        if (patch.hunks.empty()) {
+            return make_error(
+                "no changes for '{}'",
+                patch.new_path.empty() ? patch.old_path : patch.new_path);
+        }
+        patches.push_back(std::move(patch));
+    }
+
+    if (patches.empty()) {
+        return make_error(
+            "no file sections found (expected '--- a/<path>' and "
+            "'+++ b/<path>' lines followed by '@@' hunks)");
+    }
+    return patches;
+}
+
+bool
+PatchedFile::
+applied() const
+{
+    return std::ranges::all_of(hunks, &HunkOutcome::applied);
+}
+
+PatchedFile
+apply_file_patch(
+    std::string_view contents,
+    FilePatch const & patch,
+    std::size_t max_fuzz)
+{
+    auto const lines = split_lines(contents);
+    auto final_newline = contents.empty() or contents.ends_with('\n');
+    auto const crlf = not lines.empty() and lines.front().ends_with('\r');
+
+    struct Splice
+    {
+        std::size_t start;
+        std::size_t length;
+        std::vector<std::string_view> lines;
+    };
+    std::vector<Splice> splices;
+    auto result = PatchedFile{};
+
+    std::size_t min_start = 0;
+    std::ptrdiff_t drift = 0;
+    for (auto const & hunk : patch.hunks) {
+        auto const old_side = hunk_side(hunk, '-');
+        auto const new_side = hunk_side(hunk, '+');
+        auto const is_context = [](std::string const & l) {
+            return l[0] == ' ';
+        };
+        auto const lead = static_cast<std::size_t>(
+            std::ranges::find_if_not(hunk.lines, is_context)
+            - hunk.lines.begin());
+        auto const trail = static_cast<std::size_t>(
+            std::ranges::find_if_not(
+                hunk.lines.rbegin(), hunk.lines.rend(), is_context)
+            - hunk.lines.rbegin());
+
+        // Where the header says the old side starts; a pure insertion's
+        // header names the line it follows.
+        auto const header_index = hunk.old_start == 0
+            ? static_cast<std::ptrdiff_t>(min_start)
+            : static_cast<std::ptrdiff_t>(hunk.old_start)
+                - (old_side.empty() ? 0 : 1);
+
+        auto outcome = HunkOutcome{};
+        for (std::size_t fuzz = 0; fuzz <= max_fuzz; ++fuzz) {
+            auto const drop_lead = std::min(fuzz, lead);
+            auto const drop_trail = std::min(fuzz, trail);
+            // Stop once there is no more context to ignore.
+            if (fuzz > 0 and drop_lead == std::min(fuzz - 1, lead)
+                and drop_trail == std::min(fuzz - 1, trail))
+            {
+                break;
+            }
+            auto const pattern = std::vector<std::string_view>(
+                old_side.begin() + static_cast<std::ptrdiff_t>(drop_lead),
+                old_side.end() - static_cast<std::ptrdiff_t>(drop_trail));
+            if (pattern.empty() and not old_side.empty()) {
+                break;
+            }
+
+            auto const expected =
+                header_index + drift + static_cast<std::ptrdiff_t>(drop_lead);
+            auto const found =
+                find_nearest(lines, pattern, expected, min_start);
+            if (not found) {
+                continue;
+            }
+
+            auto const at = static_cast<std::ptrdiff_t>(*found);
+            outcome = HunkOutcome{
+                .applied = true,
+                .line = *found + 1,
+                .offset = hunk.old_start == 0
+                    ? 0
+                    : at - header_index
+                        - static_cast<std::ptrdiff_t>(drop_lead),
+                .fuzz = fuzz};
+            drift += outcome.offset;
+            splices.push_back(
+                {.start = *found,
+                 .length = pattern.size(),
+                 .lines = std::vector<std::string_view>(
+                     new_side.begin() + static_cast<std::ptrdiff_t>(drop_lead),
+                     new_side.end()
+                         - static_cast<std::ptrdiff_t>(drop_trail))});
+            min_start = *found + pattern.size();
+            if (min_start == lines.size()) {
+                if (hunk.new_missing_newline) {
+                    final_newline = false;
+                } else if (hunk.old_missing_newline) {
+                    final_newline = true;
+                }
+            }
+            break;
+        }
+        result.hunks.push_back(outcome);
+    }
+
+    if (not result.applied()) {
+        result.contents = std::string(contents);
+        return result;
+    }
+
+    std::vector<std::string_view> output;
+    output.reserve(lines.size());
+    std::size_t copied = 0;
+    for (auto const & splice : splices) {
+        output.insert(
+            output.end(),
+            lines.begin() + static_cast<std::ptrdiff_t>(copied),
+            lines.begin() + static_cast<std::ptrdiff_t>(splice.start));
+        output.insert(output.end(), splice.lines.begin(), splice.lines.end());
+        copied = splice.start + splice.length;
+    }
+    output.insert(
+        output.end(),
+        lines.begin() + static_cast<std::ptrdiff_t>(copied),
+        lines.end());
+
+    // Lines from the patch take the file's line endings.
+    for (std::size_t i = 0; i < output.size(); ++i) {
+        result.contents += output[i];
+        if (crlf and not output[i].ends_with('\r')
+            and (i + 1 < output.size() or final_newline))
+        {
+            result.contents += '\r';
+        }
+        if (i + 1 < output.size() or final_newline) {
+            result.contents += '\n';
+        }
+    }
+    return result;
+}
+
+} // namespace wjh::chat::tools
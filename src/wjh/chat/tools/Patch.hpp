@@ -0,0 +1,109 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_1E115F0D479049339A88D581D5DB774C
+#define WJH_CHAT_1E115F0D479049339A88D581D5DB774C
+
+#include "wjh/chat/Result.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+/**
+ * One "@@ -a,b +c,d @@" section of a unified diff.
+ */
+struct Hunk
+{
+    /// 1-based first line of the hunk in the old file; 0 when the
+    /// header gives none, in which case the whole file is searched.
+    std::size_t old_start = 0;
+
+    /// Body lines, each starting with ' ', '-' or '+'.
+    std::vector<std::string> lines{};
+
+    /// "\ No newline at end of file" followed the old or new side's
+    /// last line.
+    bool old_missing_newline = false;
+    bool new_missing_newline = false;
+};
+
+/**
+ * The hunks for one file.
+ */
+struct FilePatch
+{
+    /// Paths with any "a/" or "b/" prefix removed; empty for
+    /// /dev/null, i.e. a created or deleted file.
+    std::string old_path;
+    std::string new_path;
+
+    std::vector<Hunk> hunks{};
+};
+
+/**
+ * Parse a unified diff, as produced by `diff -u` or `git diff`, into
+ * per-file patches.  Text outside the file sections (commit messages,
+ * "diff --git" and "index" lines) is ignored.
+ *
+ * Hunk line counts are not trusted: a hunk runs until the next hunk,
+ * file header or non-diff line, so a miscounted header still parses.
+ * A blank line inside a hunk is read as a blank context line.
+ */
+[[nodiscard]]
+Result<std::vector<FilePatch>> parse_patch(std::string_view text);
+
+/**
+ * How one hunk fared.
+ */
+struct HunkOutcome
+{
+    bool applied = false;
+
+    /// 1-based line the hunk was applied at.
+    std::size_t line = 0;
+
+    /// Lines between where the header put the hunk and where it was
+    /// found.
+    std::ptrdiff_t offset = 0;
+
+    /// Context lines ignored at each end to make it fit.
+    std::size_t fuzz = 0;
+};
+
+/**
+ * Result of applying one FilePatch to a file's contents.
+ */
+struct PatchedFile
+{
+    std::string contents;
+    std::vector<HunkOutcome> hunks;
+
+    [[nodiscard]]
+    bool applied() const;
+};
+
+/**
+ * Apply @p patch's hunks to @p contents, in order.
+ *
+ * A hunk is searched for at the line its header names, adjusted by how
+ * far earlier hunks moved, then at growing distances either side.  If
+ * its context does not match anywhere, up to @p max_fuzz context lines
+ * are ignored at each end and the search repeated.  Hunks never
+ * overlap or reorder.
+ */
+[[nodiscard]]
+PatchedFile apply_file_patch(
+    std::string_view contents,
+    FilePatch const & patch,
+    std::size_t max_fuzz = 2);
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_1E115F0D479049339A88D581D5DB774C
@@ -0,0 +1,435 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/Sandbox.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+/// Controllers the sandbox sets limits with.
+constexpr std::string_view controllers[] = {"cpu", "memory", "pids"};
+
+/// Scheduling period written to cpu.max, in microseconds.
+constexpr std::uint64_t cpu_period = 100'000;
+
+std::chrono::microseconds
+to_duration(timeval const & tv)
+{
+    return std::chrono::seconds{tv.tv_sec}
+        + std::chrono::microseconds{tv.tv_usec};
+}
+
+std::optional<std::string>
+read_file(std::filesystem::path const & path)
+{
+    std::ifstream in(path);
+    if (not in) {
+        return std::nullopt;
+    }
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    return std::move(contents).str();
+}
+
+/// cgroup files take one write(2) each, and report errors from it.
+bool
+write_file(std::filesystem::path const & path, std::string_view text)
+{
+    auto const fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    auto const n = ::write(fd, text.data(), text.size());
+    ::close(fd);
+    return n == static_cast<ssize_t>(text.size());
+}
+
+bool
+has_word(std::string_view text, std::string_view word)
+{
+    std::istringstream in{std::string(text)};
+    for (std::string token; in >> token;) {
+        if (token == word) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Where the cgroup v2 hierarchy is mounted, from mountinfo(5); empty
+/// if it is not.
+std::filesystem::path
+cgroup2_mount()
+{
+    std::ifstream in("/proc/self/mountinfo");
+    for (std::string line; std::getline(in, line);) {
+        auto const separator = line.find(" - ");
+        if (separator == std::string::npos
+            or not line.substr(separator + 3).starts_with("cgroup2 "))
+        {
+            continue;
+        }
+        std::istringstream fields(line.substr(0, separator));
+        std::string id, parent, device, root, mount_point;
+        if (fields >> id >> parent >> device >> root >> mount_point) {
+            return mount_point;
+        }
+    }
+    return {};
+}
+
+/// This process's cgroup v2 directory; empty if there is none.
+std::filesystem::path
+own_cgroup()
+{
+    auto const mount = cgroup2_mount();
+    if (mount.empty()) {
+        return {};
+    }
+    std::ifstream in("/proc/self/cgroup");
+    for (std::string line; std::getline(in, line);) {
+        if (line.starts_with("0::")) {
+            auto const relative =
+                std::filesystem::path(line.substr(3)).relative_path();
+            return (mount / relative).lexically_normal();
+        }
+    }
+    return {};
+}
+
+bool
+enable_controllers(std::filesystem::path const & cgroup)
+{
+    auto const available = read_file(cgroup / "cgroup.controllers");
+    if (not available) {
+        return false;
+    }
+    std::string enable;
+    for (auto name : controllers) {
+        if (has_word(*available, name)) {
+            enable += std::format("+{} ", name);
+        }
+    }
+    return not enable.empty()
+        and write_file(cgroup / "cgroup.subtree_control", enable);
+}
+
+/// The cgroup that sessions' cgroups are created in, with the
+/// controllers enabled for them; empty without delegation.
+std::filesystem::path
+find_parent()
+{
+    auto const own = own_cgroup();
+    if (own.empty()) {
+        return {};
+    }
+    if (enable_controllers(own)) {
+        return own;
+    }
+
+    // Controllers are only enabled for the children of a cgroup with
+    // no processes, so step aside into a leaf, but only when there is
+    // nobody else's process to move.
+    auto const procs = read_file(own / "cgroup.procs");
+    if (not procs) {
+        return {};
+    }
+    auto const self = std::to_string(::getpid());
+    std::istringstream pids(*procs);
+    auto alone = false;
+    for (std::string pid; pids >> pid;) {
+        if (pid != self) {
+            return {};
+        }
+        alone = true;
+    }
+    auto const leaf = own / "wjh-chat";
+    if (not alone
+        or (::mkdir(leaf.c_str(), 0755) != 0 and errno != EEXIST)
+        or not write_file(leaf / "cgroup.procs", self)
+        or not enable_controllers(own))
+    {
+        return {};
+    }
+    return own;
+}
+
+/// Computed once, since it may move the process.
+std::filesystem::path const &
+session_parent()
+{
+    static auto const parent = find_parent();
+    return parent;
+}
+
+/// Tasks (processes and threads) belonging to this real user, which is
+/// what RLIMIT_NPROC counts.
+std::uint64_t
+user_tasks()
+{
+    auto const uid = std::to_string(::getuid());
+    std::uint64_t count = 0;
+    std::error_code ec;
+    for (auto const & entry :
+         std::filesystem::directory_iterator("/proc", ec))
+    {
+        auto const name = entry.path().filename().string();
+        if (name.find_first_not_of("0123456789") != std::string::npos) {
+            continue;
+        }
+        std::ifstream in(entry.path() / "status");
+        auto mine = false;
+        for (std::string line; std::getline(in, line);) {
+            std::istringstream fields(line);
+            std::string key, value;
+            fields >> key >> value;
+            if (key == "Uid:") {
+                mine = value == uid;
+            } else if (key == "Threads:" and mine) {
+                std::uint64_t threads = 0;
+                std::from_chars(
+                    value.data(), value.data() + value.size(), threads);
+                count += threads;
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+std::string
+describe_limits(SandboxLimits const & limits)
+{
+    std::vector<std::string> parts;
+    if (limits.cpus != 0) {
+        parts.push_back(std::format("{} CPUs", limits.cpus));
+    }
+    if (limits.memory_bytes != 0) {
+        parts.push_back(
+            std::format("{} MB", limits.memory_bytes / (1024 * 1024)));
+    }
+    if (limits.max_pids != 0) {
+        parts.push_back(std::format("{} pids", limits.max_pids));
+    }
+    std::string text;
+    for (auto const & part : parts) {
+        text += (text.empty() ? "" : ", ") + part;
+    }
+    return text;
+}
+
+} // anonymous namespace
+
+std::string
+describe_usage(ResourceUsage const & usage)
+{
+    return std::format(
+        "cpu {:.2f}s, peak RSS {:.1f} MB",
+        std::chrono::duration<double>(usage.cpu_time).count(),
+        static_cast<double>(usage.peak_rss) / (1024 * 1024));
+}
+
+void
+UsageTotals::
+add(ResourceUsage const & usage)
+{
+    ++processes;
+    cpu_time += usage.cpu_time;
+    peak_rss = std::max(peak_rss, usage.peak_rss);
+}
+
+int
+reap(int pid, ResourceUsage * usage)
+{
+    int status = 0;
+    rusage accounted{};
+    while (::wait4(pid, &status, 0, &accounted) < 0) {
+        if (errno != EINTR) {
+            return -1;
+        }
+    }
+    if (usage) {
+        // Includes every descendant the process waited for; ru_maxrss
+        // is in kilobytes.
+        usage->cpu_time =
+            to_duration(accounted.ru_utime) + to_duration(accounted.ru_stime);
+        usage->peak_rss =
+            static_cast<std::uint64_t>(accounted.ru_maxrss) * 1024;
+    }
+    return status;
+}
+
+Sandbox::
+Sandbox(SandboxLimits limits)
+: limits_(limits)
+{
+    if (not limits_.any()) {
+        return;
+    }
+
+    if (auto const & parent = session_parent(); not parent.empty()) {
+        static std::atomic<unsigned> sessions{0};
+        auto dir = parent
+            / std::format("wjh-chat-tools-{}-{}", ::getpid(), ++sessions);
+        if (::mkdir(dir.c_str(), 0755) == 0) {
+            auto ok = true;
+            if (limits_.cpus != 0) {
+                ok = ok
+                    and write_file(
+                        dir / "cpu.max",
+                        std::format(
+                            "{} {}", limits_.cpus * cpu_period, cpu_period));
+            }
+            if (limits_.memory_bytes != 0) {
+                ok = ok
+                    and write_file(
+                        dir / "memory.max",
+                        std::to_string(limits_.memory_bytes));
+                // Otherwise the limit pushes the excess into swap.
+                write_file(dir / "memory.swap.max", "0");
+            }
+            if (limits_.max_pids != 0) {
+                ok = ok
+                    and write_file(
+                        dir / "pids.max", std::to_string(limits_.max_pids));
+            }
+            if (ok) {
+                procs_fd_ = ::open(
+                    (dir / "cgroup.procs").c_str(), O_WRONLY | O_CLOEXEC);
+            }
+            if (procs_fd_ >= 0) {
+                mode_ = SandboxMode::cgroup;
+                cgroup_ = std::move(dir);
+                return;
+            }
+            ::rmdir(dir.c_str());
+        }
+    }
+
+    mode_ = SandboxMode::rlimit;
+    if (limits_.memory_bytes != 0) {
+        data_limit_.rlim_cur = limits_.memory_bytes;
+        data_limit_.rlim_max = limits_.memory_bytes;
+    }
+    if (limits_.max_pids != 0) {
+        auto const tasks = user_tasks() + limits_.max_pids;
+        nproc_limit_.rlim_cur = tasks;
+        nproc_limit_.rlim_max = tasks;
+    }
+}
+
+Sandbox::
+~Sandbox()
+{
+    if (mode_ != SandboxMode::cgroup) {
+        return;
+    }
+    ::close(procs_fd_);
+
+    // cgroup.kill is new in Linux 5.14; before that, kill one by one.
+    if (not write_file(cgroup_ / "cgroup.kill", "1")) {
+        if (auto const procs = read_file(cgroup_ / "cgroup.procs")) {
+            std::istringstream pids(*procs);
+            for (int pid; pids >> pid;) {
+                ::kill(pid, SIGKILL);
+            }
+        }
+    }
+    // The cgroup can be removed once the kernel has finished them off.
+    for (int i = 0; i < 100 and ::rmdir(cgroup_.c_str()) != 0; ++i) {
+        if (errno != EBUSY) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+}
+
+void
+Sandbox::
+enter() const noexcept
+{
+    switch (mode_) {
+    case SandboxMode::none:
+        return;
+    case SandboxMode::cgroup: {
+        // "0" is the writer itself.
+        [[maybe_unused]] auto const n = ::write(procs_fd_, "0", 1);
+        return;
+    }
+    case SandboxMode::rlimit:
+        break;
+    }
+    if (limits_.memory_bytes != 0) {
+        ::setrlimit(RLIMIT_DATA, &data_limit_);
+    }
+    if (limits_.max_pids != 0) {
+        ::setrlimit(RLIMIT_NPROC, &nproc_limit_);
+    }
+    if (limits_.cpus != 0) {
+        // No per-process equivalent of a quota; at least yield to the
+        // chat process and other sessions.
+        [[maybe_unused]] auto const niceness = ::nice(10);
+    }
+}
+
+std::uint64_t
+Sandbox::
+oom_kills() const
+{
+    if (mode_ != SandboxMode::cgroup) {
+        return 0;
+    }
+    auto const events = read_file(cgroup_ / "memory.events");
+    if (not events) {
+        return 0;
+    }
+    std::istringstream in(*events);
+    for (std::string key; in >> key;) {
+        std::uint64_t count = 0;
+        in >> count;
+        if (key == "oom_kill") {
+            return count;
+        }
+    }
+    return 0;
+}
+
+std::string
+Sandbox::
+describe() const
+{
+    switch (mode_) {
+    case SandboxMode::none:
+        break;
+    case SandboxMode::cgroup:
+        return std::format(
+            "cgroup {}: {}", cgroup_.string(), describe_limits(limits_));
+    case SandboxMode::rlimit:
+        return std::format("setrlimit: {}", describe_limits(limits_));
+    }
+    return "no limits";
+}
+
+} // namespace wjh::chat::tools
@@ -0,0 +1,177 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_D385A7CBE87E46D59A342AB915376C8E
+#define WJH_CHAT_D385A7CBE87E46D59A342AB915376C8E
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <sys/resource.h>
+
+namespace wjh::chat::tools {
+
+/**
+ * Resources the processes a session's tools start may use; 0 means no
+ * limit.
+ */
+struct SandboxLimits
+{
+    /// CPUs' worth of time per scheduling period.
+    std::uint32_t cpus = 0;
+
+    /// Bytes of memory.
+    std::uint64_t memory_bytes = 0;
+
+    /// Processes and threads at once.
+    std::uint32_t max_pids = 0;
+
+    [[nodiscard]]
+    bool any() const
+    {
+        return cpus != 0 or memory_bytes != 0 or max_pids != 0;
+    }
+};
+
+/**
+ * How a Sandbox enforces its limits.
+ */
+enum class SandboxMode
+{
+    none, ///< No limits were asked for.
+    cgroup, ///< A cgroup v2 of its own, limiting all its processes together.
+    rlimit ///< setrlimit(2) and nice(2) on each process.
+};
+
+/**
+ * What one tool process and the children it waited for consumed.
+ */
+struct ResourceUsage
+{
+    /// User plus system time.
+    std::chrono::microseconds cpu_time{};
+
+    /// Largest resident set of any one of the processes, in bytes.
+    std::uint64_t peak_rss = 0;
+};
+
+/**
+ * "cpu 1.25s, peak RSS 40.0 MB", for tool results.
+ */
+[[nodiscard]]
+std::string describe_usage(ResourceUsage const & usage);
+
+/**
+ * Usage summed over many processes, for the stats report.
+ */
+struct UsageTotals
+{
+    std::size_t processes = 0;
+    std::chrono::microseconds cpu_time{};
+
+    /// The largest ResourceUsage::peak_rss seen.
+    std::uint64_t peak_rss = 0;
+
+    void add(ResourceUsage const & usage);
+};
+
+/**
+ * waitpid(2) for @p pid, retrying on EINTR, and fill @p usage from
+ * what the kernel accounted to it.
+ *
+ * @return the wait status, or -1 if @p pid could not be waited for.
+ */
+int reap(int pid, ResourceUsage * usage = nullptr);
+
+/**
+ * Confines the processes one session's tools start.
+ *
+ * Where the process has a delegated cgroup v2 subtree, the sandbox is
+ * a cgroup of its own under it, with `cpu.max`, `memory.max` and
+ * `pids.max` set from the limits, so a runaway `make -j` or test is
+ * throttled or killed as a whole while the chat process and other
+ * sessions carry on.  If this process shares its cgroup with no other
+ * process, it first moves itself into a leaf next to the sessions'
+ * cgroups, since cgroup v2 only enables controllers for children of a
+ * cgroup with no processes of its own.
+ *
+ * Without delegation, each tool process gets setrlimit(2) limits
+ * instead: RLIMIT_DATA for memory, RLIMIT_NPROC for the process count
+ * (counted for the whole user, so set to this user's current count
+ * plus the limit), and a nice(2) value of 10 in place of a CPU quota.
+ * These apply per process rather than to the session as a whole.
+ *
+ * Processes are placed by enter(), called in the child between fork(2)
+ * and exec; the sandbox must outlive them.  Destroying it kills
+ * whatever is left in its cgroup and removes the cgroup.
+ */
+class Sandbox
+{
+public:
+    explicit Sandbox(SandboxLimits limits);
+    ~Sandbox();
+
+    Sandbox(Sandbox const &) = delete;
+    Sandbox & operator = (Sandbox const &) = delete;
+
+    /**
+     * Put the calling process under the limits.  Only async-signal-safe
+     * calls, so a child may call it before exec.
+     */
+    void enter() const noexcept;
+
+    [[nodiscard]]
+    SandboxMode mode() const
+    {
+        return mode_;
+    }
+
+    [[nodiscard]]
+    SandboxLimits const & limits() const
+    {
+        return limits_;
+    }
+
+    /**
+     * The sandbox's cgroup directory; empty unless SandboxMode::cgroup.
+     */
+    [[nodiscard]]
+    std::filesystem::path const & cgroup() const
+    {
+        return cgroup_;
+    }
+
+    /**
+     * Processes the kernel killed for exceeding the memory limit so
+     * far; always 0 unless SandboxMode::cgroup.
+     */
+    [[nodiscard]]
+    std::uint64_t oom_kills() const;
+
+    /**
+     * "cgroup: 2 CPUs, 4096 MB, 512 pids", for the stats report.
+     */
+    [[nodiscard]]
+    std::string describe() const;
+
+private:
+    SandboxLimits limits_;
+    SandboxMode mode_ = SandboxMode::none;
+    std::filesystem::path cgroup_;
+
+    /// The cgroup's cgroup.procs, open for the child to write.
+    int procs_fd_ = -1;
+
+    rlimit data_limit_{};
+    rlimit nproc_limit_{};
+};
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_D385A7CBE87E46D59A342AB915376C8E
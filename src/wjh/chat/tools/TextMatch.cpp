@@ -0,0 +1,276 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/TextMatch.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+constexpr std::string_view blanks = " \t\f\v\r";
+
+/// A line's byte range, without its line break or a CR before it.
+struct Line
+{
+    std::size_t begin;
+    std::size_t end;
+};
+
+/// A final line break does not start another line.
+std::vector<Line>
+split_lines(std::string_view text)
+{
+    std::vector<Line> lines;
+    for (std::size_t begin = 0; begin < text.size();) {
+        auto end = text.find('\n', begin);
+        auto const next = end == std::string_view::npos ? text.size() : end + 1;
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        if (end > begin and text[end - 1] == '\r') {
+            --end;
+        }
+        lines.push_back({begin, end});
+        begin = next;
+    }
+    return lines;
+}
+
+std::string
+normalize(std::string_view line, MatchStrategy strategy)
+{
+    auto const last = line.find_last_not_of(blanks);
+    line = last == std::string_view::npos ? "" : line.substr(0, last + 1);
+    if (strategy != MatchStrategy::whitespace) {
+        return std::string(line);
+    }
+
+    // Trim the front too, and make every run of blanks one space.
+    std::string result;
+    result.reserve(line.size());
+    auto pending_space = false;
+    for (auto c : line) {
+        if (blanks.find(c) != std::string_view::npos) {
+            pending_space = not result.empty();
+            continue;
+        }
+        if (pending_space) {
+            result += ' ';
+            pending_space = false;
+        }
+        result += c;
+    }
+    return result;
+}
+
+std::vector<std::string>
+normalize_lines(
+    std::string_view text,
+    std::vector<Line> const & lines,
+    MatchStrategy strategy)
+{
+    std::vector<std::string> result;
+    result.reserve(lines.size());
+    for (auto const & line : lines) {
+        result.push_back(normalize(
+            text.substr(line.begin, line.end - line.begin),
+            strategy));
+    }
+    return result;
+}
+
+std::string
+line_text(std::string_view text, Line const & line)
+{
+    return std::string(text.substr(line.begin, line.end - line.begin));
+}
+
+/// Lines too short to say where a needle belongs, like "}" or "".
+bool
+is_distinctive(std::string const & normalized)
+{
+    return normalized.size() >= 3;
+}
+
+} // anonymous namespace
+
+std::optional<TextMatch>
+find_text(std::string_view contents, std::string_view needle)
+{
+    if (needle.empty()) {
+        return std::nullopt;
+    }
+
+    auto match = TextMatch{
+        .strategy = MatchStrategy::exact,
+        .position = std::string_view::npos,
+        .length = needle.size(),
+        .lines = {}};
+    std::size_t line = 1;
+    std::size_t counted = 0;
+    for (auto pos = contents.find(needle); pos != std::string_view::npos;
+         pos = contents.find(needle, pos + needle.size()))
+    {
+        line += static_cast<std::size_t>(std::count(
+            contents.begin() + static_cast<std::ptrdiff_t>(counted),
+            contents.begin() + static_cast<std::ptrdiff_t>(pos),
+            '\n'));
+        counted = pos;
+        if (match.lines.empty()) {
+            match.position = pos;
+        }
+        match.lines.push_back(line);
+    }
+    if (not match.lines.empty()) {
+        return match;
+    }
+    if (needle.find_first_not_of(" \t\f\v\r\n") == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    auto const text_lines = split_lines(contents);
+    auto const needle_lines = split_lines(needle);
+    for (auto strategy :
+         {MatchStrategy::trailing_whitespace, MatchStrategy::whitespace})
+    {
+        auto const text = normalize_lines(contents, text_lines, strategy);
+        auto const want = normalize_lines(needle, needle_lines, strategy);
+        for (std::size_t i = 0; i + want.size() <= text.size(); ++i) {
+            if (not std::equal(
+                    want.begin(),
+                    want.end(),
+                    text.begin() + static_cast<std::ptrdiff_t>(i)))
+            {
+                continue;
+            }
+            if (match.lines.empty()) {
+                auto const begin = text_lines[i].begin;
+                auto end = text_lines[i + want.size() - 1].end;
+                if (needle.ends_with('\n')) {
+                    end = contents.find('\n', end);
+                    end = end == std::string_view::npos ? contents.size()
+                                                        : end + 1;
+                }
+                match.strategy = strategy;
+                match.position = begin;
+                match.length = end - begin;
+                match.crlf =
+                    contents.substr(begin, end - begin).find("\r\n")
+                        != std::string_view::npos
+                    and needle.find('\r') == std::string_view::npos;
+            }
+            match.lines.push_back(i + 1);
+        }
+        if (not match.lines.empty()) {
+            return match;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<NearMatch>
+near_matches(
+    std::string_view contents,
+    std::string_view needle,
+    std::size_t limit)
+{
+    auto const text_lines = split_lines(contents);
+    auto const needle_lines = split_lines(needle);
+    auto const text =
+        normalize_lines(contents, text_lines, MatchStrategy::whitespace);
+    auto const want =
+        normalize_lines(needle, needle_lines, MatchStrategy::whitespace);
+
+    // Each text line equal to needle line k votes for the needle
+    // starting k lines above it: one pass over the text, however long
+    // the needle.
+    std::unordered_map<std::string_view, std::vector<std::size_t>> where;
+    std::size_t distinctive = 0;
+    for (std::size_t k = 0; k < want.size(); ++k) {
+        if (is_distinctive(want[k])) {
+            where[want[k]].push_back(k);
+            ++distinctive;
+        }
+    }
+    if (distinctive == 0) {
+        return {};
+    }
+
+    // Votes are indexed by start + needle size, so a needle starting
+    // above the first line still has a slot.
+    auto const n = want.size();
+    std::vector<std::size_t> votes(text.size() + n, 0);
+    for (std::size_t j = 0; j < text.size(); ++j) {
+        if (auto const found = where.find(text[j]); found != where.end()) {
+            for (auto k : found->second) {
+                ++votes[j + n - k];
+            }
+        }
+    }
+
+    std::vector<std::size_t> slots;
+    for (std::size_t slot = 0; slot < votes.size(); ++slot) {
+        if (votes[slot] > 0 and 2 * votes[slot] >= distinctive) {
+            slots.push_back(slot);
+        }
+    }
+    std::ranges::stable_sort(slots, [&](std::size_t a, std::size_t b) {
+        return votes[a] > votes[b];
+    });
+
+    std::vector<NearMatch> result;
+    std::vector<std::size_t> taken;
+    for (auto slot : slots) {
+        if (result.size() == limit) {
+            break;
+        }
+        if (std::ranges::any_of(taken, [&](std::size_t other) {
+                return (slot > other ? slot - other : other - slot) < n;
+            }))
+        {
+            continue;
+        }
+        taken.push_back(slot);
+
+        auto const start = static_cast<std::ptrdiff_t>(slot)
+            - static_cast<std::ptrdiff_t>(n);
+        auto const lines = static_cast<std::ptrdiff_t>(text.size());
+        auto const first = std::max<std::ptrdiff_t>(start, 0);
+        auto near = NearMatch{
+            .first_line = static_cast<std::size_t>(first) + 1,
+            .last_line = static_cast<std::size_t>(std::min(
+                start + static_cast<std::ptrdiff_t>(n),
+                lines)),
+            .same_lines = 0,
+            .needle_lines = n,
+            .differing_line = 0,
+            .text_line = {},
+            .needle_line = {}};
+        auto differs = false;
+        for (std::size_t k = 0; k < n; ++k) {
+            auto const at = start + static_cast<std::ptrdiff_t>(k);
+            auto const inside = at >= 0 and at < lines;
+            auto const i = static_cast<std::size_t>(at);
+            if (inside and text[i] == want[k]) {
+                ++near.same_lines;
+            } else if (not differs) {
+                differs = true;
+                near.needle_line = line_text(needle, needle_lines[k]);
+                if (inside) {
+                    near.differing_line = i + 1;
+                    near.text_line = line_text(contents, text_lines[i]);
+                }
+            }
+        }
+        result.push_back(std::move(near));
+    }
+    return result;
+}
+
+} // namespace wjh::chat::tools
@@ -0,0 +1,116 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_463A949F24AB486F9EB5919F97B020E7
+#define WJH_CHAT_463A949F24AB486F9EB5919F97B020E7
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+/**
+ * How find_text() matched, from strictest to loosest.
+ */
+enum class MatchStrategy
+{
+    exact, ///< Byte for byte.
+    trailing_whitespace, ///< Whole lines, ignoring trailing blanks and CRs.
+    whitespace ///< Whole lines, ignoring all differences in blanks.
+};
+
+/**
+ * What a strategy ignored, for tool results; empty for exact.
+ */
+[[nodiscard]]
+constexpr std::string_view
+describe(MatchStrategy strategy)
+{
+    switch (strategy) {
+    case MatchStrategy::exact:
+        return "";
+    case MatchStrategy::trailing_whitespace:
+        return "ignoring trailing whitespace and line endings";
+    case MatchStrategy::whitespace:
+        break;
+    }
+    return "ignoring whitespace differences";
+}
+
+/**
+ * Where find_text() found the needle.
+ */
+struct TextMatch
+{
+    MatchStrategy strategy;
+
+    /// Byte range of the first match in the searched text.
+    std::size_t position;
+    std::size_t length;
+
+    /// 1-based first line of every match; more than one means the
+    /// needle is ambiguous.
+    std::vector<std::size_t> lines;
+
+    /// The match has CRLF line endings where the needle has LF.
+    bool crlf = false;
+};
+
+/**
+ * Find @p needle in @p contents, trying each MatchStrategy in turn and
+ * stopping at the first that matches anything.
+ *
+ * The loose strategies compare whole lines, so they only apply when
+ * the needle covers whole lines of the text; a match then spans from
+ * the start of its first line to the end of its last, plus the line
+ * break if the needle ends with one.  A needle with no visible
+ * characters is only matched exactly.
+ */
+[[nodiscard]]
+std::optional<TextMatch> find_text(
+    std::string_view contents,
+    std::string_view needle);
+
+/**
+ * A run of lines that resembles a needle find_text() could not find.
+ */
+struct NearMatch
+{
+    /// 1-based lines the needle would cover if it started here.
+    std::size_t first_line;
+    std::size_t last_line;
+
+    /// Needle lines that match, ignoring whitespace, and its length.
+    std::size_t same_lines;
+    std::size_t needle_lines;
+
+    /// 1-based first line that differs, and both versions of it; the
+    /// line is 0 and its text empty when the needle runs past either
+    /// end of the text there.
+    std::size_t differing_line;
+    std::string text_line;
+    std::string needle_line;
+};
+
+/**
+ * Up to @p limit places in @p contents most like @p needle, best
+ * first, for an error that lets the caller correct its needle in one
+ * try.  Places are scored by how many distinctive needle lines they
+ * share, ignoring whitespace; a place sharing fewer than half of them
+ * is not reported.
+ */
+[[nodiscard]]
+std::vector<NearMatch> near_matches(
+    std::string_view contents,
+    std::string_view needle,
+    std::size_t limit = 3);
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_463A949F24AB486F9EB5919F97B020E7
@@ -0,0 +1,311 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/ToolCache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <sys/stat.h>
+
+namespace {
+
+using namespace std::string_view_literals;
+
+constexpr auto read_only_programs = std::array{
+    "cat"sv, "du"sv, "file"sv, "grep"sv, "head"sv, "ls"sv,
+    "pwd"sv, "rg"sv, "stat"sv, "tail"sv, "tree"sv, "wc"sv,
+    "which"sv};
+
+constexpr auto read_only_git_commands = std::array{
+    "blame"sv, "diff"sv, "log"sv, "ls-files"sv, "rev-parse"sv,
+    "show"sv, "status"sv};
+
+// find can delete files or run arbitrary programs.
+constexpr auto mutating_find_actions = std::array{
+    "-delete"sv, "-exec"sv, "-execdir"sv, "-fprint"sv, "-fprint0"sv,
+    "-fprintf"sv, "-fls"sv, "-ok"sv, "-okdir"sv};
+
+template <std::size_t N>
+bool
+contains(std::array<std::string_view, N> const & words, std::string_view word)
+{
+    return std::ranges::find(words, word) != words.end();
+}
+
+/// Blank-separated words with quote characters dropped, so quoting an
+/// option ("'-delete'") does not hide it.
+std::vector<std::string>
+split_words(std::string_view text)
+{
+    std::vector<std::string> words;
+    auto const is_space = [](char c) { return c == ' ' or c == '\t'; };
+    std::size_t i = 0;
+    while (i < text.size()) {
+        while (i < text.size() and is_space(text[i])) {
+            ++i;
+        }
+        std::string word;
+        for (; i < text.size() and not is_space(text[i]); ++i) {
+            if (text[i] != '\'' and text[i] != '"') {
+                word += text[i];
+            }
+        }
+        if (not word.empty()) {
+            words.push_back(std::move(word));
+        }
+    }
+    return words;
+}
+
+/// Whether @p words has the long option @p name, alone or as
+/// name=value.
+bool
+has_long_option(std::vector<std::string> const & words, std::string_view name)
+{
+    return std::ranges::any_of(words, [name](std::string_view w) {
+        return w.starts_with(name)
+            and (w.size() == name.size() or w[name.size()] == '=');
+    });
+}
+
+/// Whether a cluster of short options in @p words ("-aRo") has @p flag.
+bool
+has_short_option(std::vector<std::string> const & words, char flag)
+{
+    return std::ranges::any_of(words, [flag](std::string_view w) {
+        return w.size() > 1 and w[0] == '-' and w[1] != '-'
+            and w.find(flag) != std::string_view::npos;
+    });
+}
+
+bool
+is_read_only_stage(std::string_view stage)
+{
+    auto const words = split_words(stage);
+    if (words.empty()) {
+        return false;
+    }
+    auto const & program = words.front();
+    if (program == "git") {
+        // diff options, which log and show take too, include writing
+        // the output to a file and running an external diff program.
+        return words.size() > 1 and contains(read_only_git_commands, words[1])
+            and not has_long_option(words, "--output")
+            and not has_long_option(words, "--ext-diff");
+    }
+    if (program == "find") {
+        return std::ranges::none_of(words, [](std::string_view w) {
+            return contains(mutating_find_actions, w);
+        });
+    }
+    if (program == "tree") {
+        // -o writes the listing to a file, and -R writes one into
+        // every directory.
+        return not has_short_option(words, 'o')
+            and not has_short_option(words, 'R');
+    }
+    if (program == "rg") {
+        // --pre runs a program on every file searched.
+        return not has_long_option(words, "--pre");
+    }
+    if (program == "file") {
+        // -C compiles a magic file, writing it out.
+        return not has_short_option(words, 'C')
+            and not has_long_option(words, "--compile");
+    }
+    return contains(read_only_programs, program);
+}
+
+std::filesystem::path
+normalize(std::filesystem::path const & path)
+{
+    std::error_code ec;
+    auto result = std::filesystem::weakly_canonical(path, ec);
+    if (ec) {
+        result = std::filesystem::absolute(path, ec);
+    }
+    return ec ? path : result;
+}
+
+} // anonymous namespace
+
+namespace wjh::chat::tools {
+
+std::optional<FileIdentity>
+file_identity(std::filesystem::path const & path)
+{
+    struct stat st{};
+    if (::stat(path.c_str(), &st) != 0 or not S_ISREG(st.st_mode)) {
+        return std::nullopt;
+    }
+    return FileIdentity{
+        .device = static_cast<std::uintmax_t>(st.st_dev),
+        .inode = static_cast<std::uintmax_t>(st.st_ino),
+        .size = static_cast<std::uintmax_t>(st.st_size),
+        .mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec)
+                * 1'000'000'000
+            + static_cast<std::int64_t>(st.st_mtim.tv_nsec)};
+}
+
+bool
+has_shell_operators(std::string_view command)
+{
+    return command.find_first_of(";&><`$(){}\n\\") != std::string_view::npos;
+}
+
+bool
+is_read_only_command(std::string_view command)
+{
+    if (has_shell_operators(command)) {
+        return false;
+    }
+    std::size_t start = 0;
+    while (true) {
+        auto const bar = command.find('|', start);
+        if (not is_read_only_stage(command.substr(start, bar - start))) {
+            return false;
+        }
+        if (bar == std::string_view::npos) {
+            return true;
+        }
+        start = bar + 1;
+    }
+}
+
+std::string
+ToolCache::
+key_for(std::string_view tool, nlohmann::json const & args)
+{
+    // dump() emits object keys in sorted order, so argument order in
+    // the model's JSON does not matter.
+    auto key = std::string(tool);
+    key += '\0';
+    key += args.dump();
+    return key;
+}
+
+void
+ToolCache::
+watch(std::shared_ptr<FileWatcher> watcher)
+{
+    changes_ = watcher ? watcher->subscribe() : nullptr;
+    watcher_ = std::move(watcher);
+}
+
+std::optional<std::string>
+ToolCache::
+lookup(std::string const & key)
+{
+    // Read the epoch before taking changes: if it is unchanged after,
+    // every change up to now has been applied.
+    auto const epoch = watcher_ ? watcher_->ready_epoch() : 0;
+    apply_changes();
+
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        ++stats_.misses;
+        return std::nullopt;
+    }
+    auto const & entry = it->second;
+    if (entry.path) {
+        auto const trusted = epoch != 0
+            and watcher_->ready_epoch() == epoch
+            and watcher_->covers(*entry.path);
+        if (trusted) {
+            ++stats_.unchecked_hits;
+        } else if (file_identity(*entry.path) != entry.identity) {
+            entries_.erase(it);
+            ++stats_.invalidations;
+            ++stats_.misses;
+            return std::nullopt;
+        }
+    }
+    ++stats_.hits;
+    return entry.result;
+}
+
+void
+ToolCache::
+store_file(
+    std::string key,
+    std::filesystem::path const & path,
+    FileIdentity identity,
+    std::string result)
+{
+    entries_.insert_or_assign(
+        std::move(key),
+        Entry{
+            .result = std::move(result),
+            .path = normalize(path),
+            .identity = identity});
+}
+
+void
+ToolCache::
+store_command(std::string key, std::string result)
+{
+    entries_.insert_or_assign(
+        std::move(key),
+        Entry{.result = std::move(result), .path = {}, .identity = {}});
+}
+
+void
+ToolCache::
+invalidate(std::filesystem::path const & path)
+{
+    drop(normalize(path), false);
+}
+
+void
+ToolCache::
+apply_changes()
+{
+    if (not changes_) {
+        return;
+    }
+    for (auto const & change : changes_->take()) {
+        switch (change.kind) {
+        case ChangeKind::file:
+            drop(change.path, false);
+            break;
+        case ChangeKind::tree:
+            drop(change.path, true);
+            break;
+        case ChangeKind::everything:
+            stats_.invalidations += entries_.size();
+            entries_.clear();
+            break;
+        }
+    }
+}
+
+void
+ToolCache::
+drop(std::filesystem::path const & target, bool tree)
+{
+    auto const below = [&](std::filesystem::path const & path) {
+        auto const [t, p] = std::ranges::mismatch(target, path);
+        return t == target.end() and p != path.end();
+    };
+    stats_.invalidations += std::erase_if(entries_, [&](auto const & kv) {
+        auto const & entry = kv.second;
+        return not entry.path or *entry.path == target
+            or (tree and below(*entry.path));
+    });
+}
+
+void
+ToolCache::
+clear()
+{
+    entries_.clear();
+}
+
+} // namespace wjh::chat::tools
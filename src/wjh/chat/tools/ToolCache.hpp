@@ -0,0 +1,182 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_A4603E22933347B199E0ACB61DA1EA60
+#define WJH_CHAT_A4603E22933347B199E0ACB61DA1EA60
+
+#include "wjh/chat/tools/FileWatcher.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace wjh::chat::tools {
+
+/**
+ * Identity of a file's contents as seen by stat(2).
+ *
+ * Two equal identities mean the file has (almost certainly) not been
+ * replaced or modified in between; any write bumps mtime or size, and
+ * an atomic rename produces a new inode.
+ */
+struct FileIdentity
+{
+    std::uintmax_t device = 0;
+    std::uintmax_t inode = 0;
+    std::uintmax_t size = 0;
+    std::int64_t mtime_ns = 0;
+
+    friend bool operator == (FileIdentity const &, FileIdentity const &) =
+        default;
+};
+
+/**
+ * Stat a regular file, or std::nullopt if it cannot be stat'ed.
+ */
+[[nodiscard]]
+std::optional<FileIdentity> file_identity(std::filesystem::path const & path);
+
+/**
+ * Whether @p command uses shell syntax beyond plain words and pipes:
+ * redirection, substitution, sequencing, grouping, background jobs or
+ * escapes.
+ */
+[[nodiscard]]
+bool has_shell_operators(std::string_view command);
+
+/**
+ * Whether a shell command only reads state and may be memoized.
+ *
+ * Deliberately conservative: every pipeline stage must start with an
+ * allow-listed program, and anything involving redirection, command
+ * substitution, sequencing, or background jobs is rejected, as are the
+ * options that make those programs write files or run others
+ * (`find -exec`, `git diff --output`, `rg --pre`, `tree -o`, ...).
+ */
+[[nodiscard]]
+bool is_read_only_command(std::string_view command);
+
+/**
+ * Counters reported by ToolCache::stats().
+ */
+struct ToolCacheStats
+{
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+
+    /// Entries dropped because their file changed or was written.
+    std::size_t invalidations = 0;
+
+    /// Hits on file entries served on a FileWatcher's word, without
+    /// a stat.
+    std::size_t unchecked_hits = 0;
+};
+
+/**
+ * Memoized results of read-only tool calls.
+ *
+ * File-backed entries remember the FileIdentity of the file they were
+ * produced from and are revalidated against the file on every lookup.
+ * Command entries cannot be revalidated, so any write through a tool
+ * drops all of them.
+ *
+ * With a FileWatcher, changes made outside the tools (by an editor or
+ * a build) are pushed to the cache instead: each drops the entries for
+ * its file, or everything below its directory, along with every
+ * command entry, and entries for files the watcher covers are no
+ * longer stat'ed on a hit.  Not thread-safe; the agent loop that owns
+ * it runs tools sequentially.
+ */
+class ToolCache
+{
+public:
+    /**
+     * Compute the cache key for a tool invocation.
+     */
+    [[nodiscard]]
+    static std::string
+    key_for(std::string_view tool, nlohmann::json const & args);
+
+    /**
+     * Subscribe to @p watcher's changes.
+     */
+    void watch(std::shared_ptr<FileWatcher> watcher);
+
+    /**
+     * Look up a result, counting a hit or a miss.  File-backed entries
+     * whose file no longer matches are removed and reported as misses.
+     */
+    [[nodiscard]]
+    std::optional<std::string> lookup(std::string const & key);
+
+    /**
+     * Store a result produced by reading @p path while it had
+     * identity @p identity.
+     */
+    void store_file(
+        std::string key,
+        std::filesystem::path const & path,
+        FileIdentity identity,
+        std::string result);
+
+    /**
+     * Store the result of a read-only shell command.
+     */
+    void store_command(std::string key, std::string result);
+
+    /**
+     * Drop every entry read from @p path, and every command entry.
+     */
+    void invalidate(std::filesystem::path const & path);
+
+    /**
+     * Drop every entry.
+     */
+    void clear();
+
+    [[nodiscard]]
+    std::size_t size() const
+    {
+        return entries_.size();
+    }
+
+    [[nodiscard]]
+    ToolCacheStats stats() const
+    {
+        return stats_;
+    }
+
+private:
+    struct Entry
+    {
+        std::string result;
+        std::optional<std::filesystem::path> path;
+        FileIdentity identity;
+    };
+
+    /// Drop the watcher's pending changes.
+    void apply_changes();
+
+    /// Drop every command entry, and every file entry whose path is
+    /// @p target or, with @p tree, below it.
+    void drop(std::filesystem::path const & target, bool tree);
+
+    std::unordered_map<std::string, Entry> entries_;
+    ToolCacheStats stats_;
+    std::shared_ptr<FileWatcher> watcher_;
+    std::shared_ptr<ChangeFeed> changes_;
+};
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_A4603E22933347B199E0ACB61DA1EA60
@@ -0,0 +1,419 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/ToolDispatcher.hpp"
+
+#include "wjh/chat/tools/Tools.hpp"
+
+#include <format>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+
+#include <poll.h>
+#include <unistd.h>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+/// Batch jobs share the terminal; their prompts take turns.
+std::mutex prompt_mutex;
+
+/// What the user is asked to approve.
+std::string
+describe(ToolCall const & call)
+{
+    auto const & args = call.args;
+    auto const path = args.value("file_path", std::string{});
+    if (call.name == "bash" or call.name == "start_job") {
+        return call.name + ": " + args.value("command", std::string{});
+    }
+    if (call.name == "write_file") {
+        return std::format(
+            "write_file: {} ({} bytes)",
+            path,
+            args.value("content", std::string{}).size());
+    }
+    if (call.name == "edit_file") {
+        return std::format(
+            "edit_file: {}\n--- old ---\n{}\n--- new ---\n{}",
+            path,
+            args.value("old_string", std::string{}),
+            args.value("new_string", std::string{}));
+    }
+    if (call.name == "apply_patch") {
+        return "apply_patch:\n" + args.value("patch", std::string{});
+    }
+    if (call.name == "read_files") {
+        auto text = std::string("read_files:");
+        if (auto const reads = parse_read_files(args)) {
+            for (auto const & read : *reads) {
+                text += " " + read["file_path"].get<std::string>();
+            }
+        }
+        return text;
+    }
+    if (call.name == "multi_edit" and args.contains("edits")
+        and args["edits"].is_array())
+    {
+        auto const & edits = args["edits"];
+        auto text = std::format(
+            "multi_edit: {} ({} edits)", path, edits.size());
+        for (std::size_t i = 0; i < edits.size(); ++i) {
+            text += std::format(
+                "\n--- old {0} ---\n{1}\n--- new {0} ---\n{2}",
+                i + 1,
+                edits[i].value("old_string", std::string{}),
+                edits[i].value("new_string", std::string{}));
+        }
+        return text;
+    }
+    return call.name + ": " + path;
+}
+
+/// Reads that are allowed too often to be worth announcing.
+bool
+is_query(std::string_view name)
+{
+    return name == "read_file" or name == "read_files"
+        or name == "job_status" or name == "job_output";
+}
+
+/// Result of a call the user declined.
+std::string
+declined(std::string const & name)
+{
+    if (name == "bash" or name == "start_job") {
+        return std::string(bash_skipped);
+    }
+    if (name == "write_file") {
+        return "Write skipped by user";
+    }
+    if (name == "edit_file" or name == "multi_edit") {
+        return "Edit skipped by user";
+    }
+    if (name == "apply_patch") {
+        return "Patch skipped by user";
+    }
+    return "Skipped by user";
+}
+
+/// Which of @p count calls an answer approves: "y" all of them,
+/// "1 3" the first and third, anything else none.
+std::vector<bool>
+parse_answer(std::string const & answer, std::size_t count)
+{
+    std::vector<bool> approved(count, false);
+    if (not answer.empty() and (answer[0] == 'y' or answer[0] == 'Y')) {
+        approved.assign(count, true);
+        return approved;
+    }
+    std::istringstream in(answer);
+    std::size_t number = 0;
+    while (in >> number) {
+        if (number >= 1 and number <= count) {
+            approved[number - 1] = true;
+        }
+    }
+    return approved;
+}
+
+/// The user's answer from @p in, or std::nullopt once @p stop is
+/// requested.  A terminal on std::cin is polled so Ctrl-C ends the
+/// wait; any other stream is read outright.
+std::optional<std::string>
+read_answer(std::istream & in, std::stop_token stop)
+{
+    if (&in == &std::cin and ::isatty(STDIN_FILENO)) {
+        auto ready = false;
+        while (not ready and not stop.stop_requested()) {
+            pollfd input{.fd = STDIN_FILENO, .events = POLLIN, .revents = 0};
+            ready = ::poll(&input, 1, 100) > 0;
+        }
+    }
+    std::string answer;
+    if (not stop.stop_requested()) {
+        std::getline(in, answer);
+    }
+    if (stop.stop_requested()) {
+        return std::nullopt;
+    }
+    return answer;
+}
+
+} // anonymous namespace
+
+std::vector<ToolApproval>
+ToolDispatcher::
+approve(std::vector<ToolCall> const & calls, std::stop_token stop)
+{
+    std::vector<ToolApproval> result(calls.size());
+    std::vector<std::size_t> asking;
+    std::lock_guard<std::mutex> lock(prompt_mutex);
+
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        auto const decision = policy_->decide(calls[i].name, calls[i].args);
+        switch (decision.approval) {
+        case Approval::ask:
+            asking.push_back(i);
+            continue;
+        case Approval::deny:
+            result[i] = {
+                .approved = false,
+                .refusal = "Denied by tool policy (" + decision.reason + ")"};
+            *prompt_out_ << "\n[tool] " << describe(calls[i])
+                         << "\n  denied: " << decision.reason << std::endl;
+            continue;
+        case Approval::allow:
+            if (not is_query(calls[i].name)) {
+                *prompt_out_ << "\n[tool] " << describe(calls[i])
+                             << "\n  allowed: " << decision.reason
+                             << std::endl;
+            }
+            continue;
+        }
+    }
+    if (asking.empty()) {
+        return result;
+    }
+
+    if (asking.size() == 1) {
+        *prompt_out_ << "\n[tool] " << describe(calls[asking[0]])
+                     << "\n[y/n]> " << std::flush;
+    } else {
+        *prompt_out_ << std::format(
+            "\n[tool] {} calls need approval:\n", asking.size());
+        for (std::size_t n = 0; n < asking.size(); ++n) {
+            *prompt_out_ << std::format(
+                "  {}. {}\n", n + 1, describe(calls[asking[n]]));
+        }
+        *prompt_out_ << "Run them? [y]es / [n]o / numbers, e.g. \"1 3\"> "
+                     << std::flush;
+    }
+    auto const answer = read_answer(*prompt_in_, stop);
+    if (not answer) {
+        *prompt_out_ << std::endl;
+        for (auto const i : asking) {
+            result[i] = {
+                .approved = false, .refusal = std::string(tool_cancelled)};
+        }
+        return result;
+    }
+
+    auto const approved = parse_answer(*answer, asking.size());
+    for (std::size_t n = 0; n < asking.size(); ++n) {
+        if (not approved[n]) {
+            auto const i = asking[n];
+            result[i] = {.approved = false, .refusal = declined(calls[i].name)};
+        }
+    }
+    return result;
+}
+
+std::string
+ToolDispatcher::
+dispatch(
+    ToolCall const & call,
+    ToolApproval const & approval,
+    std::stop_token stop)
+{
+    auto shown = false;
+    auto result = approval.approved
+        ? run(call.name, call.args, stop, shown)
+        : approval.refusal;
+    if (echo_ and not shown) {
+        *echo_ << result << std::endl;
+    }
+    return result;
+}
+
+std::string
+ToolDispatcher::
+dispatch(
+    std::string const & name,
+    nlohmann::json const & args,
+    std::stop_token stop)
+{
+    auto const call = ToolCall{.name = name, .args = args};
+    if (stop.stop_requested()) {
+        return dispatch(call, {}, stop);
+    }
+    return dispatch(call, approve({call}, stop).front(), stop);
+}
+
+std::string
+ToolDispatcher::
+run(
+    std::string const & name,
+    nlohmann::json const & args,
+    std::stop_token stop,
+    bool & shown)
+{
+    if (stop.stop_requested()) {
+        return std::string(tool_cancelled);
+    }
+    if (name == "bash") {
+        auto const command = args["command"].get<std::string>();
+        if (not is_read_only_command(command)) {
+            auto result = run_command(command, stop);
+            shown = true;
+            cache_.clear();
+            return result;
+        }
+        // A background job may change what the command sees at any
+        // moment.
+        auto const memoize = jobs_.running() == 0;
+        auto const key = ToolCache::key_for(name, args);
+        if (memoize) {
+            if (auto cached = cache_.lookup(key)) {
+                return std::string(cached_marker) + *cached;
+            }
+        }
+        auto result = run_command(command, stop);
+        shown = true;
+        if (memoize and not stop.stop_requested()) {
+            cache_.store_command(key, result);
+        }
+        return result;
+    }
+    if (name == "read_file") {
+        auto const key = ToolCache::key_for(name, args);
+        if (auto cached = cache_.lookup(key)) {
+            return std::string(cached_marker) + *cached;
+        }
+        // Stat before reading: a write that races the read leaves a
+        // stale identity behind, which simply fails revalidation.
+        auto const path = args["file_path"].get<std::string>();
+        auto const identity = file_identity(path);
+        auto result = execute_read_file(args);
+        if (identity) {
+            cache_.store_file(key, path, *identity, result);
+        }
+        return result;
+    }
+    if (name == "read_files") {
+        auto const reads = parse_read_files(args);
+        if (not reads) {
+            return "Error: " + reads.error();
+        }
+
+        // Each file is cached as the read_file call it amounts to.
+        std::vector<std::string> results(reads->size());
+        std::vector<std::size_t> misses;
+        for (std::size_t i = 0; i < reads->size(); ++i) {
+            auto const key = ToolCache::key_for("read_file", (*reads)[i]);
+            if (auto cached = cache_.lookup(key)) {
+                results[i] = std::string(cached_marker) + *cached;
+            } else {
+                misses.push_back(i);
+            }
+        }
+        std::vector<nlohmann::json> missing;
+        std::vector<std::optional<FileIdentity>> identities;
+        for (auto const i : misses) {
+            missing.push_back((*reads)[i]);
+            identities.push_back(
+                file_identity((*reads)[i]["file_path"].get<std::string>()));
+        }
+        auto fresh = read_in_parallel(missing);
+        for (std::size_t n = 0; n < misses.size(); ++n) {
+            if (identities[n]) {
+                cache_.store_file(
+                    ToolCache::key_for("read_file", missing[n]),
+                    missing[n]["file_path"].get<std::string>(),
+                    *identities[n],
+                    fresh[n]);
+            }
+            results[misses[n]] = std::move(fresh[n]);
+        }
+        return combine_reads(*reads, results);
+    }
+    if (name == "write_file") {
+        auto result = execute_write_file(args);
+        cache_.invalidate(args["file_path"].get<std::string>());
+        return result;
+    }
+    if (name == "edit_file") {
+        auto result = execute_edit_file(args);
+        cache_.invalidate(args["file_path"].get<std::string>());
+        return result;
+    }
+    if (name == "multi_edit") {
+        auto result = execute_multi_edit(args);
+        cache_.invalidate(args["file_path"].get<std::string>());
+        return result;
+    }
+    if (name == "apply_patch") {
+        auto result = execute_apply_patch(args);
+        cache_.clear();
+        return result;
+    }
+    if (name == "start_job") {
+        auto result = execute_start_job(jobs_, args);
+        cache_.clear();
+        return result;
+    }
+    if (name == "job_status") {
+        return execute_job_status(jobs_, args);
+    }
+    if (name == "job_output") {
+        return execute_job_output(jobs_, args, stop);
+    }
+    return "Error: unknown tool: " + name;
+}
+
+std::string
+ToolDispatcher::
+run_command(std::string const & command, std::stop_token stop)
+{
+    ResourceUsage usage;
+    auto result =
+        execute_bash(command, stop, echo_, sandbox_.get(), &usage);
+    command_usage_.add(usage);
+    return result;
+}
+
+void
+ToolDispatcher::
+begin_turn()
+{
+    cache_.clear();
+}
+
+void
+ToolDispatcher::
+report(std::ostream & out) const
+{
+    auto const stats = cache_.stats();
+    auto const lookups = stats.hits + stats.misses;
+    if (lookups != 0) {
+        out << std::format(
+            "Tool cache: {} hits / {} lookups, {} invalidated\n",
+            stats.hits,
+            lookups,
+            stats.invalidations);
+    }
+
+    auto totals = command_usage_;
+    for (auto const & job : jobs_.list()) {
+        if (job.status) {
+            totals.add(job.usage);
+        }
+    }
+    if (totals.processes == 0) {
+        return;
+    }
+    out << std::format(
+        "Tool processes: {} run, {}{}\n",
+        totals.processes,
+        describe_usage(
+            {.cpu_time = totals.cpu_time, .peak_rss = totals.peak_rss}),
+        sandbox_ ? std::format(" ({})", sandbox_->describe()) : "");
+}
+
+} // namespace wjh::chat::tools
@@ -0,0 +1,204 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_2EBF74CFEE004337B59998943827ED29
+#define WJH_CHAT_2EBF74CFEE004337B59998943827ED29
+
+#include "wjh/chat/tools/ApprovalPolicy.hpp"
+#include "wjh/chat/tools/Jobs.hpp"
+#include "wjh/chat/tools/Sandbox.hpp"
+#include "wjh/chat/tools/ToolCache.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <iostream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+/**
+ * Prefix placed on a tool result that was served from the cache.
+ */
+inline constexpr std::string_view cached_marker =
+    "[cached: unchanged since an earlier identical call this turn]\n";
+
+/**
+ * One tool call requested by the model.
+ */
+struct ToolCall
+{
+    std::string name;
+    nlohmann::json args;
+};
+
+/**
+ * Whether a tool call may run.
+ */
+struct ToolApproval
+{
+    bool approved = true;
+
+    /// Result given to the model in place of a refused call's output.
+    std::string refusal{};
+};
+
+/**
+ * Executes tool calls on behalf of the agent loop, memoizing read-only
+ * ones.
+ *
+ * `read_file` results are keyed by their arguments and revalidated
+ * against the file's identity, and `read_files` caches each of its
+ * files as the `read_file` call it amounts to, reading only the rest;
+ * read-only `bash` commands are memoized until the next write.
+ * `write_file`, `edit_file` and `multi_edit` invalidate the path they
+ * touch; `apply_patch` and any other `bash` command flush everything.
+ * Given a FileWatcher, the cache also hears of changes made outside
+ * the tools; see ToolCache.
+ *
+ * `start_job` runs a command in the background; `job_status` and
+ * `job_output` report on it.  Jobs outlive turns but not the
+ * dispatcher, and while any is running `bash` results are not
+ * memoized.
+ *
+ * Given a Sandbox, every command and job runs inside it.  Their CPU
+ * time and peak RSS are reported with each result and totalled in the
+ * stats report.
+ *
+ * Before anything runs, an ApprovalPolicy decides each call; the calls
+ * it leaves to the user are put to them in one prompt per model
+ * message, so a message with five edits needs one answer, not five.
+ *
+ * With an echo stream set, the user sees every result there: `bash`
+ * output is streamed live while the command runs, and everything else
+ * is printed once the tool returns.
+ */
+class ToolDispatcher
+{
+public:
+    /**
+     * Decide every call in @p calls, prompting once for all the calls
+     * the policy leaves to the user.  Once @p stop is requested, the
+     * prompt stops waiting and those calls are refused as cancelled.
+     */
+    [[nodiscard]]
+    std::vector<ToolApproval> approve(
+        std::vector<ToolCall> const & calls,
+        std::stop_token stop = {});
+
+    /**
+     * Run an approved call, or return its cached result; a refused
+     * call returns its refusal.  Once @p stop is requested no tool
+     * starts, and a running command is killed.
+     */
+    [[nodiscard]]
+    std::string dispatch(
+        ToolCall const & call,
+        ToolApproval const & approval,
+        std::stop_token stop = {});
+
+    /**
+     * Approve a single call and run it.
+     */
+    [[nodiscard]]
+    std::string dispatch(
+        std::string const & name,
+        nlohmann::json const & args,
+        std::stop_token stop = {});
+
+    /**
+     * Decide calls with @p policy instead of the default, which asks
+     * about everything but read-only calls.
+     */
+    void set_policy(std::shared_ptr<ApprovalPolicy const> policy)
+    {
+        policy_ = std::move(policy);
+    }
+
+    /**
+     * Read approval answers from @p in and write prompts to @p out;
+     * std::cin and std::cerr by default.
+     */
+    void set_prompt(std::istream & in, std::ostream & out)
+    {
+        prompt_in_ = &in;
+        prompt_out_ = &out;
+    }
+
+    /**
+     * Show tool output on @p out; nullptr shows nothing.
+     */
+    void set_echo(std::ostream * out)
+    {
+        echo_ = out;
+    }
+
+    /**
+     * Run commands and jobs inside @p sandbox.
+     */
+    void set_sandbox(std::shared_ptr<Sandbox const> sandbox)
+    {
+        jobs_.set_sandbox(sandbox);
+        sandbox_ = std::move(sandbox);
+    }
+
+    /**
+     * Invalidate cached results as @p watcher reports changes.
+     */
+    void watch(std::shared_ptr<FileWatcher> watcher)
+    {
+        cache_.watch(std::move(watcher));
+    }
+
+    /**
+     * Start a new agent turn, forgetting everything memoized so far.
+     */
+    void begin_turn();
+
+    [[nodiscard]]
+    ToolCache const & cache() const
+    {
+        return cache_;
+    }
+
+    /**
+     * Print tool cache hit counts and what tool processes consumed.
+     */
+    void report(std::ostream & out) const;
+
+private:
+    std::string run(
+        std::string const & name,
+        nlohmann::json const & args,
+        std::stop_token stop,
+        bool & shown);
+
+    /// execute_bash() inside the sandbox, counting what it used.
+    std::string run_command(
+        std::string const & command,
+        std::stop_token stop);
+
+    ToolCache cache_;
+    std::shared_ptr<Sandbox const> sandbox_;
+    JobManager jobs_;
+
+    /// Foreground commands only; jobs keep their own usage.
+    UsageTotals command_usage_;
+    std::ostream * echo_ = nullptr;
+    std::shared_ptr<ApprovalPolicy const> policy_ =
+        std::make_shared<ApprovalPolicy const>();
+    std::istream * prompt_in_ = &std::cin;
+    std::ostream * prompt_out_ = &std::cerr;
+};
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_2EBF74CFEE004337B59998943827ED29
@@ -0,0 +1,1164 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#include "wjh/chat/tools/Tools.hpp"
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/tools/Jobs.hpp"
+#include "wjh/chat/tools/LiveOutput.hpp"
+#include "wjh/chat/tools/Patch.hpp"
+#include "wjh/chat/tools/TextMatch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace wjh::chat::tools {
+
+namespace {
+
+/// Where an edit goes, once its old_string has been found.
+struct Placement
+{
+    std::size_t position;
+    std::size_t length;
+    std::string text;
+    MatchStrategy strategy;
+};
+
+/// Lines resembling an old_string that was not found, so the model
+/// can correct it without another read.
+std::string
+describe_near_matches(std::string_view contents, std::string_view needle)
+{
+    std::string hints;
+    for (auto const & near : near_matches(contents, needle)) {
+        hints += std::format(
+            "\nClosest match at lines {}-{} ({} of {} lines match "
+            "ignoring whitespace)",
+            near.first_line,
+            near.last_line,
+            near.same_lines,
+            near.needle_lines);
+        if (near.differing_line == 0) {
+            hints += "; old_string runs past the file there:\n";
+        } else {
+            hints += std::format(
+                "; first difference at line {}:\n  file:       {}\n",
+                near.differing_line,
+                near.text_line);
+        }
+        hints += std::format("  old_string: {}", near.needle_line);
+    }
+    return hints;
+}
+
+/// Find @p old_string in @p contents, falling back to whitespace
+/// tolerant matching, and check that it is unique.
+Result<Placement>
+place_edit(
+    std::string_view contents,
+    std::string const & path,
+    std::string const & old_string,
+    std::string new_string)
+{
+    if (old_string.empty()) {
+        return make_error("old_string is empty");
+    }
+    auto const match = find_text(contents, old_string);
+    if (not match) {
+        return make_error(
+            "old_string not found in {}{}",
+            path,
+            describe_near_matches(contents, old_string));
+    }
+
+    auto const how = match->strategy == MatchStrategy::exact
+        ? std::string{}
+        : std::format(" {}", describe(match->strategy));
+    if (match->lines.size() > 1) {
+        constexpr std::size_t max_listed = 10;
+        std::string lines;
+        for (std::size_t i = 0;
+             i < match->lines.size() and i < max_listed;
+             ++i)
+        {
+            lines += std::format("{}{}", i == 0 ? "" : ", ", match->lines[i]);
+        }
+        if (match->lines.size() > max_listed) {
+            lines += ", ...";
+        }
+        return make_error(
+            "old_string is not unique in {} (found {} occurrences{}, at "
+            "lines {}); include more surrounding lines",
+            path,
+            match->lines.size(),
+            how,
+            lines);
+    }
+
+    // A file matched across CRLF line endings keeps them; new_string
+    // may already have some.
+    if (match->crlf) {
+        for (auto pos = new_string.find('\n'); pos != std::string::npos;
+             pos = new_string.find('\n', pos + 1))
+        {
+            if (pos == 0 or new_string[pos - 1] != '\r') {
+                new_string.insert(pos++, 1, '\r');
+            }
+        }
+    }
+    return Placement{
+        .position = match->position,
+        .length = match->length,
+        .text = std::move(new_string),
+        .strategy = match->strategy};
+}
+
+/// Replace @p path's contents in one step: write a temporary file next
+/// to it, then rename it over the original, so readers see either the
+/// old file or the new one, never a partial write.
+Result<void>
+replace_file(std::filesystem::path const & path, std::string_view contents)
+{
+    auto const claimed = claim_temp_file(path);
+    if (not claimed) {
+        return make_error("Cannot write file: {}", path.string());
+    }
+    auto const & temp = *claimed;
+    {
+        std::ofstream out(temp, std::ios::binary);
+        if (not out.is_open()) {
+            std::filesystem::remove(temp);
+            return make_error("Cannot write file: {}", path.string());
+        }
+        out << contents;
+        out.flush();
+        if (not out.good()) {
+            std::filesystem::remove(temp);
+            return make_error("Write failed: {}", path.string());
+        }
+    }
+
+    std::error_code ec;
+    auto const perms = std::filesystem::status(path, ec).permissions();
+    if (not ec) {
+        std::filesystem::permissions(temp, perms, ec);
+    }
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp);
+        return make_error("Cannot replace {}: {}", path.string(), ec.message());
+    }
+    return {};
+}
+
+/// "running for 12s", "exit code 0 after 40s; cpu 31.20s, ...", ...
+std::string
+describe_state(JobInfo const & job)
+{
+    auto const seconds =
+        std::chrono::duration_cast<std::chrono::seconds>(job.elapsed)
+            .count();
+    if (not job.status) {
+        return std::format("running for {}s", seconds);
+    }
+    if (WIFSIGNALED(*job.status)) {
+        return std::format(
+            "killed by signal {} after {}s; {}",
+            WTERMSIG(*job.status),
+            seconds,
+            describe_usage(job.usage));
+    }
+    return std::format(
+        "exit code {} after {}s; {}",
+        WEXITSTATUS(*job.status),
+        seconds,
+        describe_usage(job.usage));
+}
+
+/// The number execute_read_file() put on the last line of @p text.
+std::optional<int>
+last_line_number(std::string_view text)
+{
+    text.remove_suffix(text.ends_with('\n') ? 1 : 0);
+    auto const start = text.rfind('\n');
+    auto line = text.substr(start == std::string_view::npos ? 0 : start + 1);
+    line.remove_prefix(std::min(line.find_first_not_of(' '), line.size()));
+    auto number = 0;
+    auto const [end, ec] =
+        std::from_chars(line.data(), line.data() + line.size(), number);
+    if (ec != std::errc{} or end == line.data() + line.size() or *end != '\t')
+    {
+        return std::nullopt;
+    }
+    return number;
+}
+
+} // anonymous namespace
+
+std::optional<std::filesystem::path>
+claim_temp_file(std::filesystem::path const & path)
+{
+    static std::atomic<unsigned> calls{0};
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        auto temp = path;
+        temp += std::format(".tmp.{}.{}", ::getpid(), ++calls);
+        auto const fd = ::open(
+            temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+        if (fd >= 0) {
+            ::close(fd);
+            return temp;
+        }
+        if (errno != EEXIST) {
+            break;
+        }
+    }
+    return std::nullopt;
+}
+
+nlohmann::json
+make_tools_json()
+{
+    auto bash_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "bash"},
+          {"description",
+           "Execute a bash command. Use this to run "
+           "shell commands, compile code, run tests, "
+           "and other terminal operations."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"command",
+               {{"type", "string"},
+                {"description",
+                 "The bash command to execute"}}}}},
+            {"required", {"command"}}}}}}};
+
+    auto read_file_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "read_file"},
+          {"description",
+           "Read the contents of a file. Returns "
+           "lines with line numbers. Use this "
+           "instead of bash cat/head/tail."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"file_path",
+               {{"type", "string"},
+                {"description",
+                 "Path to the file to read"}}},
+              {"offset",
+               {{"type", "integer"},
+                {"description",
+                 "1-indexed line number to start "
+                 "from (optional)"}}},
+              {"limit",
+               {{"type", "integer"},
+                {"description",
+                 "Maximum number of lines to read "
+                 "(optional)"}}}}},
+            {"required", {"file_path"}}}}}}};
+
+    auto read_files_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "read_files"},
+          {"description",
+           "Read several files in one call, each as "
+           "read_file would, returned together with a "
+           "header per file. Prefer this to a read_file "
+           "per file when you know which files you need."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"files",
+               {{"type", "array"},
+                {"description",
+                 std::format(
+                     "Files to read, at most {}",
+                     max_read_files)},
+                {"items",
+                 read_file_tool["function"]["parameters"]}}}}},
+            {"required", {"files"}}}}}}};
+
+    auto write_file_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "write_file"},
+          {"description",
+           "Write content to a file. Creates parent "
+           "directories if needed. Use this instead "
+           "of bash echo/cat with redirects."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"file_path",
+               {{"type", "string"},
+                {"description",
+                 "Path to the file to write"}}},
+              {"content",
+               {{"type", "string"},
+                {"description",
+                 "The content to write to the "
+                 "file"}}}}},
+            {"required",
+             {"file_path", "content"}}}}}}};
+
+    auto edit_file_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "edit_file"},
+          {"description",
+           "Make a targeted edit to a file by "
+           "replacing an exact string. The old_string"
+           " must appear exactly once in the file; "
+           "whole lines that differ only in "
+           "whitespace also match. "
+           "Use this instead of bash sed."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"file_path",
+               {{"type", "string"},
+                {"description",
+                 "Path to the file to edit"}}},
+              {"old_string",
+               {{"type", "string"},
+                {"description",
+                 "The exact string to find and "
+                 "replace (must be unique)"}}},
+              {"new_string",
+               {{"type", "string"},
+                {"description",
+                 "The replacement string"}}}}},
+            {"required",
+             {"file_path", "old_string",
+              "new_string"}}}}}}};
+
+    auto multi_edit_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "multi_edit"},
+          {"description",
+           "Make several edits to one file in a single "
+           "call. Each old_string must appear exactly "
+           "once in the original file and edits must "
+           "not overlap; either every edit is applied "
+           "or none is. Prefer this to repeated "
+           "edit_file calls on the same file."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"file_path",
+               {{"type", "string"},
+                {"description",
+                 "Path to the file to edit"}}},
+              {"edits",
+               {{"type", "array"},
+                {"description",
+                 "Replacements, each matched "
+                 "against the original file"},
+                {"items",
+                 {{"type", "object"},
+                  {"properties",
+                   {{"old_string",
+                     {{"type", "string"},
+                      {"description",
+                       "The exact string to replace "
+                       "(must be unique)"}}},
+                    {"new_string",
+                     {{"type", "string"},
+                      {"description",
+                       "The replacement string"}}}}},
+                  {"required",
+                   {"old_string", "new_string"}}}}}}}},
+            {"required",
+             {"file_path", "edits"}}}}}}};
+
+    auto apply_patch_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "apply_patch"},
+          {"description",
+           "Apply a unified diff (as from diff -u or "
+           "git diff) that may touch many files. "
+           "Hunks are located by their context even "
+           "when line numbers are off. If any hunk "
+           "fails, no file is changed; the result "
+           "reports every hunk. Use /dev/null as the "
+           "old path to create a file and as the new "
+           "path to delete one."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"patch",
+               {{"type", "string"},
+                {"description",
+                 "The unified diff, with '--- a/path'"
+                 " and '+++ b/path' headers"}}}}},
+            {"required", {"patch"}}}}}}};
+
+    auto start_job_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "start_job"},
+          {"description",
+           "Start a shell command in the background "
+           "and return its job id at once. Use it for "
+           "builds and test suites that take a while, "
+           "and keep working meanwhile; check on the "
+           "job with job_status and job_output. Jobs "
+           "are killed when the session ends."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"command",
+               {{"type", "string"},
+                {"description",
+                 "The bash command to run"}}}}},
+            {"required", {"command"}}}}}}};
+
+    auto job_status_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "job_status"},
+          {"description",
+           "Show whether background jobs are still "
+           "running, their exit codes, and how much "
+           "output they have produced."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"job_id",
+               {{"type", "integer"},
+                {"description",
+                 "One job to show; all jobs when "
+                 "omitted"}}}}}}}}}};
+
+    auto job_output_tool = nlohmann::json{
+        {"type", "function"},
+        {"function",
+         {{"name", "job_output"},
+          {"description",
+           "Get the output a background job has "
+           "produced since the last job_output call "
+           "for it, followed by its state. Set "
+           "wait_seconds to first wait for the job "
+           "to finish."},
+          {"parameters",
+           {{"type", "object"},
+            {"properties",
+             {{"job_id",
+               {{"type", "integer"},
+                {"description", "The job's id"}}},
+              {"wait_seconds",
+               {{"type", "integer"},
+                {"description",
+                 "Wait up to this long (at most "
+                 "600) for the job to finish; "
+                 "default 0"}}}}},
+            {"required", {"job_id"}}}}}}};
+
+    return {bash_tool, read_file_tool, read_files_tool,
+            write_file_tool, edit_file_tool,
+            multi_edit_tool, apply_patch_tool,
+            start_job_tool, job_status_tool, job_output_tool};
+}
+
+std::string
+execute_bash(
+    std::string const & command,
+    std::stop_token stop,
+    std::ostream * live,
+    Sandbox const * sandbox,
+    ResourceUsage * usage)
+{
+    // Whatever the result, the live stream shows it too.
+    auto const give_up = [live](std::string_view text) {
+        if (live) {
+            *live << text << std::endl;
+        }
+        return std::string(text);
+    };
+
+    if (stop.stop_requested()) {
+        return give_up(tool_cancelled);
+    }
+
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC) != 0) {
+        return give_up("Error: failed to execute command");
+    }
+
+    auto const oom_kills = sandbox ? sandbox->oom_kills() : 0;
+    auto const pid = spawn_shell(command, fds[1], sandbox);
+    ::close(fds[1]);
+    if (pid < 0) {
+        ::close(fds[0]);
+        return give_up("Error: failed to execute command");
+    }
+
+    std::optional<LiveOutput> echo;
+    if (live) {
+        *live << "[running; Ctrl-C stops it]\n" << std::flush;
+        echo.emplace(*live);
+    }
+
+    std::string result;
+    auto truncated = false;
+    auto const cancelled =
+        capture_output(pid, fds[0], stop, [&](std::string_view chunk) {
+            if (echo) {
+                echo->write(chunk);
+            }
+            // Past the cap the command keeps running and streaming;
+            // only the model's copy stops growing.
+            if (not truncated) {
+                result += chunk;
+                if (result.size() > 100'000) {
+                    result += "\n... [truncated at 100KB]";
+                    truncated = true;
+                }
+            }
+        });
+
+    ::close(fds[0]);
+    ResourceUsage used;
+    auto const status = reap(pid, &used);
+    if (usage) {
+        *usage = used;
+    }
+
+    std::string trailer;
+    if (cancelled) {
+        trailer = "\n[" + std::string(tool_cancelled) + "]";
+    } else if (WIFSIGNALED(status)) {
+        // Another process in the sandbox may have been the one killed,
+        // but this one dying by SIGKILL meanwhile is telling.
+        auto const memory = WTERMSIG(status) == SIGKILL and sandbox
+            and sandbox->oom_kills() != oom_kills;
+        trailer = std::format(
+            "\n[killed by signal {}{}; {}]",
+            WTERMSIG(status),
+            memory ? " at the memory limit" : "",
+            describe_usage(used));
+    } else {
+        trailer = std::format(
+            "\n[exit code: {}; {}]",
+            WEXITSTATUS(status),
+            describe_usage(used));
+    }
+    if (echo) {
+        echo->finish();
+        *live << trailer << std::endl;
+    }
+    return result + trailer;
+}
+
+std::string
+execute_read_file(nlohmann::json const & args)
+{
+    auto path =
+        args["file_path"].get<std::string>();
+
+    std::ifstream file(path);
+    if (not file.is_open()) {
+        return "Error: Cannot open file: " + path;
+    }
+
+    int offset = 1;
+    int limit = std::numeric_limits<int>::max();
+    if (args.contains("offset")) {
+        offset = args["offset"].get<int>();
+    }
+    if (args.contains("limit")) {
+        limit = args["limit"].get<int>();
+    }
+
+    std::string result;
+    std::string line;
+    int line_num = 0;
+    int lines_read = 0;
+
+    while (std::getline(file, line)) {
+        ++line_num;
+        if (line_num < offset) {
+            continue;
+        }
+        if (lines_read >= limit) {
+            break;
+        }
+        result += std::format(
+            "{:>6}\t{}\n", line_num, line);
+        ++lines_read;
+        if (result.size() > 100'000) {
+            result += "\n... [truncated at 100KB]";
+            break;
+        }
+    }
+
+    if (result.empty()) {
+        return "File is empty or offset is past end";
+    }
+    return result;
+}
+
+Result<std::vector<nlohmann::json>>
+parse_read_files(nlohmann::json const & args)
+{
+    auto const files = args.find("files");
+    if (files == args.end() or not files->is_array() or files->empty()) {
+        return make_error("files must be a non-empty array");
+    }
+    if (files->size() > max_read_files) {
+        return make_error(
+            "{} files requested; at most {} per call",
+            files->size(),
+            max_read_files);
+    }
+
+    std::vector<nlohmann::json> reads;
+    reads.reserve(files->size());
+    for (auto const & file : *files) {
+        // Only what read_file takes, so the cache keys match.
+        auto read = nlohmann::json::object();
+        if (file.is_string()) {
+            read["file_path"] = file;
+        } else if (
+            file.is_object() and file.contains("file_path")
+            and file["file_path"].is_string())
+        {
+            read["file_path"] = file["file_path"];
+            for (auto const * key : {"offset", "limit"}) {
+                if (not file.contains(key)) {
+                    continue;
+                }
+                if (not file[key].is_number_integer()) {
+                    return make_error(
+                        "{} of {} must be an integer",
+                        key,
+                        file["file_path"].get<std::string>());
+                }
+                read[key] = file[key];
+            }
+        } else {
+            return make_error("each file needs a file_path");
+        }
+        reads.push_back(std::move(read));
+    }
+    return reads;
+}
+
+std::vector<std::string>
+read_in_parallel(std::vector<nlohmann::json> const & reads)
+{
+    std::vector<std::string> results(reads.size());
+    if (reads.size() == 1) {
+        results[0] = execute_read_file(reads[0]);
+        return results;
+    }
+
+    // Enough readers to overlap the waits on a cold cache or a network
+    // file system, without a thread per file.
+    constexpr std::size_t max_readers = 8;
+    std::atomic<std::size_t> next{0};
+    {
+        std::vector<std::jthread> readers;
+        for (std::size_t n = 0; n < std::min(reads.size(), max_readers); ++n)
+        {
+            readers.emplace_back([&] {
+                for (auto i = next++; i < reads.size(); i = next++) {
+                    results[i] = execute_read_file(reads[i]);
+                }
+            });
+        }
+    }
+    return results;
+}
+
+std::string
+combine_reads(
+    std::vector<nlohmann::json> const & reads,
+    std::vector<std::string> const & results,
+    std::size_t budget)
+{
+    // Water-fill the budget: files smaller than an even share are kept
+    // whole, and what they leave is shared among the larger ones.
+    std::vector<std::size_t> order(results.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::ranges::stable_sort(order, {}, [&](std::size_t i) {
+        return results[i].size();
+    });
+    std::vector<std::size_t> shares(results.size());
+    auto remaining = budget;
+    for (std::size_t n = 0; n < order.size(); ++n) {
+        auto const i = order[n];
+        auto const share = remaining / (order.size() - n);
+        shares[i] = std::min(results[i].size(), share);
+        remaining -= shares[i];
+    }
+
+    std::string combined;
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        auto const path = reads[i]["file_path"].get<std::string>();
+        combined += std::format("{}==> {} <==\n", i == 0 ? "" : "\n", path);
+
+        auto const & result = results[i];
+        if (shares[i] == result.size()) {
+            combined += result;
+            continue;
+        }
+        // Cut after the last whole line that fits.
+        auto const cut = result.rfind('\n', shares[i] - (shares[i] > 0));
+        if (shares[i] == 0 or cut == std::string::npos) {
+            combined += "[omitted to fit the size budget; read it on its "
+                        "own]\n";
+            continue;
+        }
+        auto const kept = std::string_view(result).substr(0, cut + 1);
+        combined += kept;
+        if (auto const line = last_line_number(kept)) {
+            combined += std::format(
+                "... [truncated to fit the size budget; read_file from "
+                "offset {} for the rest]\n",
+                *line + 1);
+        } else {
+            combined += "... [truncated to fit the size budget]\n";
+        }
+    }
+    return combined;
+}
+
+std::string
+execute_read_files(nlohmann::json const & args)
+{
+    auto const reads = parse_read_files(args);
+    if (not reads) {
+        return "Error: " + reads.error();
+    }
+    return combine_reads(*reads, read_in_parallel(*reads));
+}
+
+std::string
+execute_write_file(nlohmann::json const & args)
+{
+    auto path =
+        args["file_path"].get<std::string>();
+    auto content =
+        args["content"].get<std::string>();
+
+    auto parent =
+        std::filesystem::path(path).parent_path();
+    if (not parent.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(
+            parent, ec);
+        if (ec) {
+            return "Error: Cannot create directory: "
+                + parent.string();
+        }
+    }
+
+    std::ofstream file(path);
+    if (not file.is_open()) {
+        return "Error: Cannot open file for "
+               "writing: " + path;
+    }
+
+    file << content;
+    if (not file.good()) {
+        return "Error: Write failed";
+    }
+
+    return "Wrote " + std::to_string(content.size())
+        + " bytes to " + path;
+}
+
+std::string
+execute_edit_file(nlohmann::json const & args)
+{
+    auto path =
+        args["file_path"].get<std::string>();
+    auto old_string =
+        args["old_string"].get<std::string>();
+    auto new_string =
+        args["new_string"].get<std::string>();
+
+    // Read the entire file
+    std::ifstream file(path);
+    if (not file.is_open()) {
+        return "Error: Cannot open file: " + path;
+    }
+    std::string contents(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    file.close();
+
+    // Check uniqueness before changing anything
+    auto const placed =
+        place_edit(contents, path, old_string, std::move(new_string));
+    if (not placed) {
+        return "Error: " + placed.error();
+    }
+
+    // Apply the replacement
+    contents.replace(placed->position, placed->length, placed->text);
+
+    // Write back
+    std::ofstream out(path);
+    if (not out.is_open()) {
+        return "Error: Cannot write file: " + path;
+    }
+    out << contents;
+    if (not out.good()) {
+        return "Error: Write failed";
+    }
+
+    if (placed->strategy != MatchStrategy::exact) {
+        return std::format(
+            "Applied edit to {} (matched {})",
+            path,
+            describe(placed->strategy));
+    }
+    return "Applied edit to " + path;
+}
+
+std::string
+execute_multi_edit(nlohmann::json const & args)
+{
+    auto const path = args["file_path"].get<std::string>();
+    auto const & edits = args["edits"];
+    if (not edits.is_array() or edits.empty()) {
+        return "Error: edits must be a non-empty array";
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (not file.is_open()) {
+        return "Error: Cannot open file: " + path;
+    }
+    std::string const contents(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    file.close();
+
+    // Every edit is located in the original, so one edit's new text
+    // can never be matched by a later one.
+    struct Replacement
+    {
+        std::size_t position;
+        std::size_t length;
+        std::string text;
+        std::size_t number;
+    };
+    std::vector<Replacement> replacements;
+    replacements.reserve(edits.size());
+    std::vector<std::string> loose;
+    for (std::size_t i = 0; i < edits.size(); ++i) {
+        auto const number = i + 1;
+        auto placed = place_edit(
+            contents,
+            path,
+            edits[i]["old_string"].get<std::string>(),
+            edits[i]["new_string"].get<std::string>());
+        if (not placed) {
+            return std::format("Error: edit {}: {}", number, placed.error());
+        }
+        if (placed->strategy != MatchStrategy::exact) {
+            loose.push_back(
+                std::format("edit {} {}", number, describe(placed->strategy)));
+        }
+        replacements.push_back(
+            {.position = placed->position,
+             .length = placed->length,
+             .text = std::move(placed->text),
+             .number = number});
+    }
+
+    std::ranges::sort(replacements, {}, &Replacement::position);
+    for (std::size_t i = 1; i < replacements.size(); ++i) {
+        auto const & before = replacements[i - 1];
+        if (before.position + before.length > replacements[i].position) {
+            return std::format(
+                "Error: edits {} and {} overlap in {}",
+                before.number,
+                replacements[i].number,
+                path);
+        }
+    }
+
+    // Splice the untouched spans and the replacements in one pass.
+    auto size = contents.size();
+    for (auto const & r : replacements) {
+        size = size - r.length + r.text.size();
+    }
+    std::string result;
+    result.reserve(size);
+    std::size_t copied = 0;
+    for (auto const & r : replacements) {
+        result.append(contents, copied, r.position - copied);
+        result += r.text;
+        copied = r.position + r.length;
+    }
+    result.append(contents, copied);
+
+    if (auto written = replace_file(path, result); not written) {
+        return "Error: " + written.error();
+    }
+    auto summary =
+        std::format("Applied {} edits to {}", replacements.size(), path);
+    for (std::size_t i = 0; i < loose.size(); ++i) {
+        summary += (i == 0 ? " (matched " : "; ") + loose[i];
+    }
+    if (not loose.empty()) {
+        summary += ")";
+    }
+    return summary;
+}
+
+std::string
+execute_apply_patch(nlohmann::json const & args)
+{
+    auto const patches = parse_patch(args["patch"].get<std::string>());
+    if (not patches) {
+        return "Error: " + patches.error();
+    }
+
+    // Everything is patched in memory first, so a failed hunk anywhere
+    // leaves every file as it was.
+    struct Planned
+    {
+        std::string contents{};
+        bool remove = false;
+
+        /// Removed only because the file was renamed, so not counted.
+        bool renamed = false;
+    };
+    std::map<std::string, Planned> planned;
+    std::string report;
+    auto failed = false;
+
+    for (auto const & patch : *patches) {
+        auto const & path =
+            patch.new_path.empty() ? patch.old_path : patch.new_path;
+        if (path.empty()) {
+            return "Error: a file section has /dev/null on both sides";
+        }
+
+        std::string original;
+        if (not patch.old_path.empty()) {
+            if (auto it = planned.find(patch.old_path); it != planned.end()) {
+                original = it->second.contents;
+            } else {
+                std::ifstream in(patch.old_path, std::ios::binary);
+                if (not in.is_open()) {
+                    report += std::format(
+                        "{}: FAILED, cannot open file\n", patch.old_path);
+                    failed = true;
+                    continue;
+                }
+                original.assign(
+                    std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+            }
+        } else if (std::filesystem::exists(path) or planned.contains(path)) {
+            report += std::format("{}: FAILED, file already exists\n", path);
+            failed = true;
+            continue;
+        }
+
+        auto patched = apply_file_patch(original, patch);
+        report += std::format(
+            "{} {}\n",
+            patch.old_path.empty() ? 'A'
+                : patch.new_path.empty() ? 'D'
+                : 'M',
+            path);
+        for (std::size_t i = 0; i < patched.hunks.size(); ++i) {
+            auto const & hunk = patched.hunks[i];
+            if (not hunk.applied) {
+                report += std::format(
+                    "  hunk {}: FAILED, context not found{}\n",
+                    i + 1,
+                    patch.hunks[i].old_start == 0
+                        ? std::string{}
+                        : std::format(
+                              " (expected near line {})",
+                              patch.hunks[i].old_start));
+                continue;
+            }
+            report += std::format(
+                "  hunk {}: applied at line {}", i + 1, hunk.line);
+            if (hunk.offset != 0 or hunk.fuzz != 0) {
+                report += std::format(
+                    " (offset {:+} lines, fuzz {})", hunk.offset, hunk.fuzz);
+            }
+            report += '\n';
+        }
+        if (not patched.applied()) {
+            failed = true;
+            continue;
+        }
+        if (patch.new_path.empty() and not patched.contents.empty()) {
+            report += "  FAILED, lines remain after the deletion\n";
+            failed = true;
+            continue;
+        }
+
+        if (not patch.old_path.empty() and patch.old_path != path) {
+            planned[patch.old_path] = Planned{.remove = true, .renamed = true};
+        }
+        planned[path] = Planned{
+            .contents = std::move(patched.contents),
+            .remove = patch.new_path.empty()};
+    }
+
+    if (failed) {
+        return "Error: patch not applied; no files were changed\n" + report;
+    }
+
+    // Past the planning stage, a failure cannot be undone, so carry on
+    // with the other files and say exactly which ones were not changed.
+    std::string failures;
+    std::size_t files = 0;
+    for (auto const & [path, plan] : planned) {
+        files += plan.renamed ? 0 : 1;
+        std::error_code ec;
+        if (plan.remove) {
+            if (not std::filesystem::remove(path, ec) and ec) {
+                failures += std::format(
+                    "{}: FAILED, cannot remove: {}\n", path, ec.message());
+            }
+            continue;
+        }
+        auto const parent = std::filesystem::path(path).parent_path();
+        if (not parent.empty()) {
+            std::filesystem::create_directories(parent, ec);
+            if (ec) {
+                failures += std::format(
+                    "{}: FAILED, cannot create {}: {}\n",
+                    path,
+                    parent.string(),
+                    ec.message());
+                continue;
+            }
+        }
+        if (auto written = replace_file(path, plan.contents); not written) {
+            failures += std::format("{}: FAILED, {}\n", path, written.error());
+        }
+    }
+    if (not failures.empty()) {
+        return std::format(
+            "Error: patch partly applied; the files below were not changed, "
+            "the others were\n{}{}",
+            failures,
+            report);
+    }
+    return std::format("Patched {} files\n{}", files, report);
+}
+
+std::string
+execute_start_job(JobManager & jobs, nlohmann::json const & args)
+{
+    auto const command = args["command"].get<std::string>();
+    auto const id = jobs.start(command);
+    if (not id) {
+        return "Error: " + id.error();
+    }
+    return std::format(
+        "Started job {} (pid {}): {}",
+        *id,
+        jobs.info(*id)->pid,
+        command);
+}
+
+std::string
+execute_job_status(JobManager const & jobs, nlohmann::json const & args)
+{
+    std::vector<JobInfo> shown;
+    if (args.contains("job_id")) {
+        auto const id = args["job_id"].get<std::size_t>();
+        auto info = jobs.info(id);
+        if (not info) {
+            return std::format("Error: no job {}", id);
+        }
+        shown.push_back(std::move(*info));
+    } else {
+        shown = jobs.list();
+    }
+    if (shown.empty()) {
+        return "No background jobs";
+    }
+
+    std::string result;
+    for (auto const & job : shown) {
+        result += std::format(
+            "job {} (pid {}): {}; {} bytes of output, {} unread\n  {}\n",
+            job.id,
+            job.pid,
+            describe_state(job),
+            job.output_bytes,
+            job.unread_bytes,
+            job.command);
+    }
+    result.pop_back();
+    return result;
+}
+
+std::string
+execute_job_output(
+    JobManager & jobs,
+    nlohmann::json const & args,
+    std::stop_token stop)
+{
+    auto const id = args["job_id"].get<std::size_t>();
+    auto const wait_seconds =
+        std::clamp(args.value("wait_seconds", 0), 0, 600);
+    if (wait_seconds > 0) {
+        jobs.wait(id, std::chrono::seconds{wait_seconds}, stop);
+    }
+
+    auto const output = jobs.read(id);
+    if (not output) {
+        return std::format("Error: no job {}", id);
+    }
+    std::string result;
+    if (output->skipped > 0) {
+        result += std::format(
+            "[... {} bytes of earlier output not kept ...]\n",
+            output->skipped);
+    }
+    result += output->text;
+    if (result.empty()) {
+        result = "[no new output]\n";
+    } else if (not result.ends_with('\n')) {
+        result += '\n';
+    }
+    return result
+        + std::format("[job {}: {}]", id, describe_state(*jobs.info(id)));
+}
+
+} // namespace wjh::chat::tools
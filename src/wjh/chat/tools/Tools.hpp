@@ -0,0 +1,200 @@
+// ----------------------------------------------------------------------
+// Copyright 2025 Jody Hagins
+// Distributed under the MIT Software License
+// See accompanying file LICENSE or copy at
+// https://opensource.org/licenses/MIT
+// ----------------------------------------------------------------------
+#ifndef WJH_CHAT_52C2A3CEA25147869B06CE516F5520F7
+#define WJH_CHAT_52C2A3CEA25147869B06CE516F5520F7
+
+#include "wjh/chat/Result.hpp"
+#include "wjh/chat/tools/Jobs.hpp"
+#include "wjh/chat/tools/Sandbox.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wjh::chat::tools {
+
+/**
+ * Result of a `bash` call the user declined to run.
+ */
+inline constexpr std::string_view bash_skipped = "Command skipped by user";
+
+/**
+ * Result of a tool call abandoned because the turn was cancelled.
+ */
+inline constexpr std::string_view tool_cancelled = "Cancelled by user";
+
+/**
+ * Files one `read_files` call may ask for.
+ */
+inline constexpr std::size_t max_read_files = 32;
+
+/**
+ * Bytes of file contents one `read_files` result holds at most.
+ */
+inline constexpr std::size_t read_files_budget = 100'000;
+
+/**
+ * Create an empty temporary file next to @p path that no other call,
+ * in this process or another, is using, to be renamed over @p path
+ * once written.  Created with O_EXCL and the usual 0666 less umask,
+ * which a new file keeps.
+ *
+ * @return the file's path, or std::nullopt if none could be created.
+ */
+[[nodiscard]]
+std::optional<std::filesystem::path> claim_temp_file(
+    std::filesystem::path const & path);
+
+/**
+ * Build the OpenAI-format `tools` array advertised to the model.
+ */
+[[nodiscard]]
+nlohmann::json make_tools_json();
+
+/**
+ * Run a shell command.  Approval is the caller's job (see
+ * ToolDispatcher).
+ *
+ * Output (stdout and stderr) is captured, truncated at 100KB, and
+ * followed by the exit code (or the signal that killed the command)
+ * and the CPU time and peak RSS it used, which are also stored in
+ * @p usage.  The command runs in its own process group with stdin
+ * from /dev/null, inside @p sandbox if given; @p stop terminates the
+ * whole group (SIGTERM, then SIGKILL after a grace period) and returns
+ * the output so far.
+ *
+ * With @p live, output is also streamed there as it arrives (see
+ * LiveOutput), in full even past the 100KB the result keeps, followed
+ * by the exit code; a command that never runs reports why there.
+ */
+[[nodiscard]]
+std::string execute_bash(
+    std::string const & command,
+    std::stop_token stop = {},
+    std::ostream * live = nullptr,
+    Sandbox const * sandbox = nullptr,
+    ResourceUsage * usage = nullptr);
+
+/**
+ * Read a file, returning numbered lines honoring the optional
+ * `offset` and `limit` arguments.
+ */
+[[nodiscard]]
+std::string execute_read_file(nlohmann::json const & args);
+
+/**
+ * The arguments execute_read_file() takes for each entry of a
+ * `read_files` call's `files`: a path, or an object with `file_path`
+ * and optional `offset` and `limit`.
+ */
+[[nodiscard]]
+Result<std::vector<nlohmann::json>> parse_read_files(
+    nlohmann::json const & args);
+
+/**
+ * execute_read_file() for each of @p reads, on up to 8 threads; the
+ * results are in the same order.
+ */
+[[nodiscard]]
+std::vector<std::string> read_in_parallel(
+    std::vector<nlohmann::json> const & reads);
+
+/**
+ * Join the results of @p reads, each under a "==> path <==" header,
+ * within @p budget bytes.
+ *
+ * Files smaller than an even share of the budget are kept whole and
+ * the rest share what is left, each cut after its last whole line
+ * with a note of the offset to continue reading from, so one large
+ * file cannot crowd out the small ones.
+ */
+[[nodiscard]]
+std::string combine_reads(
+    std::vector<nlohmann::json> const & reads,
+    std::vector<std::string> const & results,
+    std::size_t budget = read_files_budget);
+
+/**
+ * Read every file a `read_files` call names, in parallel, and combine
+ * the results (see combine_reads()).
+ */
+[[nodiscard]]
+std::string execute_read_files(nlohmann::json const & args);
+
+/**
+ * Write a file, creating parent directories as needed.
+ */
+[[nodiscard]]
+std::string execute_write_file(nlohmann::json const & args);
+
+/**
+ * Replace a unique string in a file.
+ *
+ * If `old_string` is not in the file verbatim, whole lines matching it
+ * modulo whitespace and line endings are accepted instead (see
+ * find_text()), and the result says so.  When nothing matches, the
+ * error quotes the nearest candidates and their first differing line.
+ */
+[[nodiscard]]
+std::string execute_edit_file(nlohmann::json const & args);
+
+/**
+ * Apply an ordered list of `edits` ({old_string, new_string}) to one
+ * file.  Each old_string must occur exactly once in the original
+ * contents, matched as by execute_edit_file(), and no two may
+ * overlap; the file is rewritten once, through a temporary file
+ * renamed over it, so either every edit lands or none does.
+ */
+[[nodiscard]]
+std::string execute_multi_edit(nlohmann::json const & args);
+
+/**
+ * Apply the unified diff in `patch` (see parse_patch() and
+ * apply_file_patch()), reporting each hunk's line, offset and fuzz.
+ *
+ * Every file is patched in memory before any is written; if a hunk
+ * fails, nothing is written.  Each file is then replaced through a
+ * temporary file renamed over it.
+ */
+[[nodiscard]]
+std::string execute_apply_patch(nlohmann::json const & args);
+
+/**
+ * Start `command` as a background job of @p jobs, reporting its id.
+ */
+[[nodiscard]]
+std::string execute_start_job(JobManager & jobs, nlohmann::json const & args);
+
+/**
+ * Describe the job `job_id`, or every job when it is absent.
+ */
+[[nodiscard]]
+std::string execute_job_status(
+    JobManager const & jobs,
+    nlohmann::json const & args);
+
+/**
+ * Return the output job `job_id` produced since the last call,
+ * followed by its state, after waiting up to `wait_seconds` (at most
+ * 600) for it to finish.  @p stop cuts the wait short.
+ */
+[[nodiscard]]
+std::string execute_job_output(
+    JobManager & jobs,
+    nlohmann::json const & args,
+    std::stop_token stop = {});
+
+} // namespace wjh::chat::tools
+
+#endif // WJH_CHAT_52C2A3CEA25147869B06CE516F5520F7
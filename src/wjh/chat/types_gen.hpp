@@ -1,5 +1,5 @@
-#ifndef WJH_CHAT_E081316532FC94BF490341FD08BC0474961D2AF6
-#define WJH_CHAT_E081316532FC94BF490341FD08BC0474961D2AF6
+#ifndef WJH_CHAT_218E6B2272D7CDA0CFAD0FDE919CD83BBD8DBDB8
+#define WJH_CHAT_218E6B2272D7CDA0CFAD0FDE919CD83BBD8DBDB8
 
 // ======================================================================
 // NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE  NOTICE
@@ -3135,4 +3135,4885 @@ public:
 } // namespace chat
 } // namespace wjh
 
-#endif // WJH_CHAT_E081316532FC94BF490341FD08BC0474961D2AF6
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: CachedTokens
+ * - description: std::uint32_t; +, <=>
+ * - default_value: "0u"
+ */
+class CachedTokens
+: private atlas::strong_type_tag<CachedTokens>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit CachedTokens() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit CachedTokens(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(CachedTokens const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(CachedTokens & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(CachedTokens && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+    /**
+     * Apply + assignment to the wrapped objects.
+     */
+    friend constexpr CachedTokens & operator += (
+        CachedTokens & lhs,
+        CachedTokens const & rhs)
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunevaluated-expression"
+#endif
+    noexcept(noexcept(std::declval<std::uint32_t &>() += std::declval<std::uint32_t const &>()))
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+    {
+        lhs.value += rhs.value;
+        return lhs;
+    }
+    /**
+     * Apply the binary operator + to the wrapped object.
+     */
+    friend constexpr CachedTokens operator + (
+        CachedTokens lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(lhs += rhs))
+    {
+        lhs += rhs;
+        return lhs;
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        CachedTokens const &,
+        CachedTokens const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        CachedTokens const &,
+        CachedTokens const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        CachedTokens const & lhs,
+        CachedTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: CacheWriteTokens
+ * - description: std::uint32_t; +, <=>
+ * - default_value: "0u"
+ */
+class CacheWriteTokens
+: private atlas::strong_type_tag<CacheWriteTokens>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit CacheWriteTokens() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit CacheWriteTokens(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(CacheWriteTokens const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(CacheWriteTokens & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(CacheWriteTokens && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+    /**
+     * Apply + assignment to the wrapped objects.
+     */
+    friend constexpr CacheWriteTokens & operator += (
+        CacheWriteTokens & lhs,
+        CacheWriteTokens const & rhs)
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunevaluated-expression"
+#endif
+    noexcept(noexcept(std::declval<std::uint32_t &>() += std::declval<std::uint32_t const &>()))
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif
+    {
+        lhs.value += rhs.value;
+        return lhs;
+    }
+    /**
+     * Apply the binary operator + to the wrapped object.
+     */
+    friend constexpr CacheWriteTokens operator + (
+        CacheWriteTokens lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(lhs += rhs))
+    {
+        lhs += rhs;
+        return lhs;
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        CacheWriteTokens const &,
+        CacheWriteTokens const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        CacheWriteTokens const &,
+        CacheWriteTokens const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        CacheWriteTokens const & lhs,
+        CacheWriteTokens const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for bool
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: PromptCaching
+ * - description: bool; ==, bool
+ * - default_value: "true"
+ */
+class PromptCaching
+: private atlas::strong_type_tag<PromptCaching>
+{
+    bool value = static_cast<bool>(true);
+
+public:
+    using atlas_value_type = bool;
+
+    constexpr explicit PromptCaching() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<bool, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit PromptCaching(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr bool const & atlas_value_for(PromptCaching const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr bool & atlas_value_for(PromptCaching & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(PromptCaching && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<bool>::value,
+            bool>::type
+    {
+        return std::move(self.value);
+    }
+
+    /**
+     * Return the result of casting the wrapped object to bool.
+     */
+    constexpr explicit operator bool () const
+    noexcept(noexcept(static_cast<bool>(
+        std::declval<bool const&>())))
+    {
+        return static_cast<bool>(value);
+    }
+
+    /**
+     * Is @p lhs.value == @p rhs.value?
+     */
+    friend constexpr bool operator == (
+        PromptCaching const & lhs,
+        PromptCaching const & rhs)
+    noexcept(noexcept(std::declval<bool const&>() == std::declval<bool const&>()))
+    {
+        return lhs.value == rhs.value;
+    }
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ResponseCacheDir
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class ResponseCacheDir
+: private atlas::strong_type_tag<ResponseCacheDir>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit ResponseCacheDir() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ResponseCacheDir(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(ResponseCacheDir const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(ResponseCacheDir & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ResponseCacheDir && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ResponseCacheDir const &,
+        ResponseCacheDir const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ResponseCacheDir const & lhs,
+        ResponseCacheDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ResponseCacheDir const & lhs,
+        ResponseCacheDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ResponseCacheDir const & lhs,
+        ResponseCacheDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ResponseCacheDir const & lhs,
+        ResponseCacheDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ResponseCacheDir const &,
+        ResponseCacheDir const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ResponseCacheDir const & lhs,
+        ResponseCacheDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ResponseCacheDir const & lhs,
+        ResponseCacheDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for bool
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: OfflineMode
+ * - description: bool; ==, bool
+ * - default_value: "false"
+ */
+class OfflineMode
+: private atlas::strong_type_tag<OfflineMode>
+{
+    bool value = static_cast<bool>(false);
+
+public:
+    using atlas_value_type = bool;
+
+    constexpr explicit OfflineMode() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<bool, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit OfflineMode(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr bool const & atlas_value_for(OfflineMode const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr bool & atlas_value_for(OfflineMode & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(OfflineMode && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<bool>::value,
+            bool>::type
+    {
+        return std::move(self.value);
+    }
+
+    /**
+     * Return the result of casting the wrapped object to bool.
+     */
+    constexpr explicit operator bool () const
+    noexcept(noexcept(static_cast<bool>(
+        std::declval<bool const&>())))
+    {
+        return static_cast<bool>(value);
+    }
+
+    /**
+     * Is @p lhs.value == @p rhs.value?
+     */
+    friend constexpr bool operator == (
+        OfflineMode const & lhs,
+        OfflineMode const & rhs)
+    noexcept(noexcept(std::declval<bool const&>() == std::declval<bool const&>()))
+    {
+        return lhs.value == rhs.value;
+    }
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: MaxRetries
+ * - description: std::uint32_t; <=>
+ * - default_value: "3u"
+ */
+class MaxRetries
+: private atlas::strong_type_tag<MaxRetries>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(3u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit MaxRetries() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit MaxRetries(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(MaxRetries const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(MaxRetries & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(MaxRetries && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        MaxRetries const &,
+        MaxRetries const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        MaxRetries const & lhs,
+        MaxRetries const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        MaxRetries const & lhs,
+        MaxRetries const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        MaxRetries const & lhs,
+        MaxRetries const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        MaxRetries const & lhs,
+        MaxRetries const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        MaxRetries const &,
+        MaxRetries const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        MaxRetries const & lhs,
+        MaxRetries const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        MaxRetries const & lhs,
+        MaxRetries const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: RetryBudget
+ * - description: std::uint32_t; <=>
+ * - default_value: "20u"
+ */
+class RetryBudget
+: private atlas::strong_type_tag<RetryBudget>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(20u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit RetryBudget() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit RetryBudget(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(RetryBudget const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(RetryBudget & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(RetryBudget && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        RetryBudget const &,
+        RetryBudget const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        RetryBudget const & lhs,
+        RetryBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        RetryBudget const & lhs,
+        RetryBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        RetryBudget const & lhs,
+        RetryBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        RetryBudget const & lhs,
+        RetryBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        RetryBudget const &,
+        RetryBudget const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        RetryBudget const & lhs,
+        RetryBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        RetryBudget const & lhs,
+        RetryBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for bool
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: HedgeRequests
+ * - description: bool; ==, bool
+ * - default_value: "false"
+ */
+class HedgeRequests
+: private atlas::strong_type_tag<HedgeRequests>
+{
+    bool value = static_cast<bool>(false);
+
+public:
+    using atlas_value_type = bool;
+
+    constexpr explicit HedgeRequests() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<bool, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit HedgeRequests(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr bool const & atlas_value_for(HedgeRequests const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr bool & atlas_value_for(HedgeRequests & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(HedgeRequests && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<bool>::value,
+            bool>::type
+    {
+        return std::move(self.value);
+    }
+
+    /**
+     * Return the result of casting the wrapped object to bool.
+     */
+    constexpr explicit operator bool () const
+    noexcept(noexcept(static_cast<bool>(
+        std::declval<bool const&>())))
+    {
+        return static_cast<bool>(value);
+    }
+
+    /**
+     * Is @p lhs.value == @p rhs.value?
+     */
+    friend constexpr bool operator == (
+        HedgeRequests const & lhs,
+        HedgeRequests const & rhs)
+    noexcept(noexcept(std::declval<bool const&>() == std::declval<bool const&>()))
+    {
+        return lhs.value == rhs.value;
+    }
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: HedgeProvider
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class HedgeProvider
+: private atlas::strong_type_tag<HedgeProvider>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit HedgeProvider() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit HedgeProvider(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(HedgeProvider const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(HedgeProvider & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(HedgeProvider && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        HedgeProvider const &,
+        HedgeProvider const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        HedgeProvider const & lhs,
+        HedgeProvider const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        HedgeProvider const & lhs,
+        HedgeProvider const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        HedgeProvider const & lhs,
+        HedgeProvider const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        HedgeProvider const & lhs,
+        HedgeProvider const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        HedgeProvider const &,
+        HedgeProvider const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        HedgeProvider const & lhs,
+        HedgeProvider const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        HedgeProvider const & lhs,
+        HedgeProvider const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: RequestsPerMinute
+ * - description: std::uint32_t; <=>
+ * - default_value: "0u"
+ */
+class RequestsPerMinute
+: private atlas::strong_type_tag<RequestsPerMinute>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit RequestsPerMinute() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit RequestsPerMinute(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(RequestsPerMinute const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(RequestsPerMinute & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(RequestsPerMinute && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        RequestsPerMinute const &,
+        RequestsPerMinute const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        RequestsPerMinute const & lhs,
+        RequestsPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        RequestsPerMinute const & lhs,
+        RequestsPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        RequestsPerMinute const & lhs,
+        RequestsPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        RequestsPerMinute const & lhs,
+        RequestsPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        RequestsPerMinute const &,
+        RequestsPerMinute const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        RequestsPerMinute const & lhs,
+        RequestsPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        RequestsPerMinute const & lhs,
+        RequestsPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: TokensPerMinute
+ * - description: std::uint32_t; <=>
+ * - default_value: "0u"
+ */
+class TokensPerMinute
+: private atlas::strong_type_tag<TokensPerMinute>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit TokensPerMinute() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit TokensPerMinute(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(TokensPerMinute const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(TokensPerMinute & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(TokensPerMinute && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        TokensPerMinute const &,
+        TokensPerMinute const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        TokensPerMinute const & lhs,
+        TokensPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        TokensPerMinute const & lhs,
+        TokensPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        TokensPerMinute const & lhs,
+        TokensPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        TokensPerMinute const & lhs,
+        TokensPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        TokensPerMinute const &,
+        TokensPerMinute const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        TokensPerMinute const & lhs,
+        TokensPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        TokensPerMinute const & lhs,
+        TokensPerMinute const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: CircuitFailureRate
+ * - description: std::uint32_t; <=>
+ * - default_value: "50u"
+ */
+class CircuitFailureRate
+: private atlas::strong_type_tag<CircuitFailureRate>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(50u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit CircuitFailureRate() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit CircuitFailureRate(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(CircuitFailureRate const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(CircuitFailureRate & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(CircuitFailureRate && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        CircuitFailureRate const &,
+        CircuitFailureRate const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        CircuitFailureRate const & lhs,
+        CircuitFailureRate const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        CircuitFailureRate const & lhs,
+        CircuitFailureRate const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        CircuitFailureRate const & lhs,
+        CircuitFailureRate const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        CircuitFailureRate const & lhs,
+        CircuitFailureRate const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        CircuitFailureRate const &,
+        CircuitFailureRate const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        CircuitFailureRate const & lhs,
+        CircuitFailureRate const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        CircuitFailureRate const & lhs,
+        CircuitFailureRate const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: CircuitTimeouts
+ * - description: std::uint32_t; <=>
+ * - default_value: "3u"
+ */
+class CircuitTimeouts
+: private atlas::strong_type_tag<CircuitTimeouts>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(3u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit CircuitTimeouts() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit CircuitTimeouts(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(CircuitTimeouts const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(CircuitTimeouts & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(CircuitTimeouts && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        CircuitTimeouts const &,
+        CircuitTimeouts const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        CircuitTimeouts const & lhs,
+        CircuitTimeouts const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        CircuitTimeouts const & lhs,
+        CircuitTimeouts const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        CircuitTimeouts const & lhs,
+        CircuitTimeouts const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        CircuitTimeouts const & lhs,
+        CircuitTimeouts const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        CircuitTimeouts const &,
+        CircuitTimeouts const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        CircuitTimeouts const & lhs,
+        CircuitTimeouts const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        CircuitTimeouts const & lhs,
+        CircuitTimeouts const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: FallbackHost
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class FallbackHost
+: private atlas::strong_type_tag<FallbackHost>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit FallbackHost() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit FallbackHost(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(FallbackHost const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(FallbackHost & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(FallbackHost && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        FallbackHost const &,
+        FallbackHost const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        FallbackHost const & lhs,
+        FallbackHost const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        FallbackHost const & lhs,
+        FallbackHost const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        FallbackHost const & lhs,
+        FallbackHost const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        FallbackHost const & lhs,
+        FallbackHost const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        FallbackHost const &,
+        FallbackHost const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        FallbackHost const & lhs,
+        FallbackHost const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        FallbackHost const & lhs,
+        FallbackHost const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ApiBaseUrl
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class ApiBaseUrl
+: private atlas::strong_type_tag<ApiBaseUrl>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit ApiBaseUrl() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ApiBaseUrl(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(ApiBaseUrl const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(ApiBaseUrl & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ApiBaseUrl && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ApiBaseUrl const &,
+        ApiBaseUrl const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ApiBaseUrl const & lhs,
+        ApiBaseUrl const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ApiBaseUrl const & lhs,
+        ApiBaseUrl const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ApiBaseUrl const & lhs,
+        ApiBaseUrl const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ApiBaseUrl const & lhs,
+        ApiBaseUrl const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ApiBaseUrl const &,
+        ApiBaseUrl const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ApiBaseUrl const & lhs,
+        ApiBaseUrl const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ApiBaseUrl const & lhs,
+        ApiBaseUrl const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for bool
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: PrewarmConnections
+ * - description: bool; ==, bool
+ * - default_value: "true"
+ */
+class PrewarmConnections
+: private atlas::strong_type_tag<PrewarmConnections>
+{
+    bool value = static_cast<bool>(true);
+
+public:
+    using atlas_value_type = bool;
+
+    constexpr explicit PrewarmConnections() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<bool, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit PrewarmConnections(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr bool const & atlas_value_for(PrewarmConnections const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr bool & atlas_value_for(PrewarmConnections & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(PrewarmConnections && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<bool>::value,
+            bool>::type
+    {
+        return std::move(self.value);
+    }
+
+    /**
+     * Return the result of casting the wrapped object to bool.
+     */
+    constexpr explicit operator bool () const
+    noexcept(noexcept(static_cast<bool>(
+        std::declval<bool const&>())))
+    {
+        return static_cast<bool>(value);
+    }
+
+    /**
+     * Is @p lhs.value == @p rhs.value?
+     */
+    friend constexpr bool operator == (
+        PrewarmConnections const & lhs,
+        PrewarmConnections const & rhs)
+    noexcept(noexcept(std::declval<bool const&>() == std::declval<bool const&>()))
+    {
+        return lhs.value == rhs.value;
+    }
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: FallbackModels
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class FallbackModels
+: private atlas::strong_type_tag<FallbackModels>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit FallbackModels() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit FallbackModels(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(FallbackModels const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(FallbackModels & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(FallbackModels && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        FallbackModels const &,
+        FallbackModels const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        FallbackModels const & lhs,
+        FallbackModels const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        FallbackModels const & lhs,
+        FallbackModels const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        FallbackModels const & lhs,
+        FallbackModels const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        FallbackModels const & lhs,
+        FallbackModels const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        FallbackModels const &,
+        FallbackModels const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        FallbackModels const & lhs,
+        FallbackModels const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        FallbackModels const & lhs,
+        FallbackModels const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ProviderSort
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class ProviderSort
+: private atlas::strong_type_tag<ProviderSort>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit ProviderSort() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ProviderSort(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(ProviderSort const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(ProviderSort & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ProviderSort && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ProviderSort const &,
+        ProviderSort const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ProviderSort const & lhs,
+        ProviderSort const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ProviderSort const & lhs,
+        ProviderSort const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ProviderSort const & lhs,
+        ProviderSort const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ProviderSort const & lhs,
+        ProviderSort const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ProviderSort const &,
+        ProviderSort const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ProviderSort const & lhs,
+        ProviderSort const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ProviderSort const & lhs,
+        ProviderSort const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ProviderOnly
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class ProviderOnly
+: private atlas::strong_type_tag<ProviderOnly>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit ProviderOnly() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ProviderOnly(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(ProviderOnly const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(ProviderOnly & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ProviderOnly && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ProviderOnly const &,
+        ProviderOnly const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ProviderOnly const & lhs,
+        ProviderOnly const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ProviderOnly const & lhs,
+        ProviderOnly const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ProviderOnly const & lhs,
+        ProviderOnly const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ProviderOnly const & lhs,
+        ProviderOnly const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ProviderOnly const &,
+        ProviderOnly const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ProviderOnly const & lhs,
+        ProviderOnly const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ProviderOnly const & lhs,
+        ProviderOnly const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ProviderIgnore
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class ProviderIgnore
+: private atlas::strong_type_tag<ProviderIgnore>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit ProviderIgnore() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ProviderIgnore(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(ProviderIgnore const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(ProviderIgnore & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ProviderIgnore && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ProviderIgnore const &,
+        ProviderIgnore const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ProviderIgnore const & lhs,
+        ProviderIgnore const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ProviderIgnore const & lhs,
+        ProviderIgnore const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ProviderIgnore const & lhs,
+        ProviderIgnore const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ProviderIgnore const & lhs,
+        ProviderIgnore const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ProviderIgnore const &,
+        ProviderIgnore const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ProviderIgnore const & lhs,
+        ProviderIgnore const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ProviderIgnore const & lhs,
+        ProviderIgnore const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: TtftSlo
+ * - description: std::uint32_t; <=>
+ * - default_value: "0u"
+ */
+class TtftSlo
+: private atlas::strong_type_tag<TtftSlo>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit TtftSlo() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit TtftSlo(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(TtftSlo const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(TtftSlo & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(TtftSlo && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        TtftSlo const &,
+        TtftSlo const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        TtftSlo const & lhs,
+        TtftSlo const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        TtftSlo const & lhs,
+        TtftSlo const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        TtftSlo const & lhs,
+        TtftSlo const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        TtftSlo const & lhs,
+        TtftSlo const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        TtftSlo const &,
+        TtftSlo const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        TtftSlo const & lhs,
+        TtftSlo const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        TtftSlo const & lhs,
+        TtftSlo const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: RouteLogPath
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class RouteLogPath
+: private atlas::strong_type_tag<RouteLogPath>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit RouteLogPath() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit RouteLogPath(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(RouteLogPath const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(RouteLogPath & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(RouteLogPath && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        RouteLogPath const &,
+        RouteLogPath const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        RouteLogPath const & lhs,
+        RouteLogPath const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        RouteLogPath const & lhs,
+        RouteLogPath const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        RouteLogPath const & lhs,
+        RouteLogPath const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        RouteLogPath const & lhs,
+        RouteLogPath const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        RouteLogPath const &,
+        RouteLogPath const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        RouteLogPath const & lhs,
+        RouteLogPath const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        RouteLogPath const & lhs,
+        RouteLogPath const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: FastModel
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class FastModel
+: private atlas::strong_type_tag<FastModel>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit FastModel() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit FastModel(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(FastModel const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(FastModel & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(FastModel && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        FastModel const &,
+        FastModel const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        FastModel const & lhs,
+        FastModel const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        FastModel const & lhs,
+        FastModel const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        FastModel const & lhs,
+        FastModel const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        FastModel const & lhs,
+        FastModel const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        FastModel const &,
+        FastModel const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        FastModel const & lhs,
+        FastModel const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        FastModel const & lhs,
+        FastModel const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: BatchInput
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class BatchInput
+: private atlas::strong_type_tag<BatchInput>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit BatchInput() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit BatchInput(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(BatchInput const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(BatchInput & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(BatchInput && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        BatchInput const &,
+        BatchInput const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        BatchInput const & lhs,
+        BatchInput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        BatchInput const & lhs,
+        BatchInput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        BatchInput const & lhs,
+        BatchInput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        BatchInput const & lhs,
+        BatchInput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        BatchInput const &,
+        BatchInput const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        BatchInput const & lhs,
+        BatchInput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        BatchInput const & lhs,
+        BatchInput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: BatchOutput
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class BatchOutput
+: private atlas::strong_type_tag<BatchOutput>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit BatchOutput() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit BatchOutput(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(BatchOutput const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(BatchOutput & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(BatchOutput && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        BatchOutput const &,
+        BatchOutput const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        BatchOutput const & lhs,
+        BatchOutput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        BatchOutput const & lhs,
+        BatchOutput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        BatchOutput const & lhs,
+        BatchOutput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        BatchOutput const & lhs,
+        BatchOutput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        BatchOutput const &,
+        BatchOutput const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        BatchOutput const & lhs,
+        BatchOutput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        BatchOutput const & lhs,
+        BatchOutput const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: BatchCheckpoint
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class BatchCheckpoint
+: private atlas::strong_type_tag<BatchCheckpoint>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit BatchCheckpoint() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit BatchCheckpoint(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(BatchCheckpoint const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(BatchCheckpoint & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(BatchCheckpoint && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        BatchCheckpoint const &,
+        BatchCheckpoint const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        BatchCheckpoint const & lhs,
+        BatchCheckpoint const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        BatchCheckpoint const & lhs,
+        BatchCheckpoint const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        BatchCheckpoint const & lhs,
+        BatchCheckpoint const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        BatchCheckpoint const & lhs,
+        BatchCheckpoint const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        BatchCheckpoint const &,
+        BatchCheckpoint const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        BatchCheckpoint const & lhs,
+        BatchCheckpoint const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        BatchCheckpoint const & lhs,
+        BatchCheckpoint const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: BatchWorkers
+ * - description: std::uint32_t; <=>
+ * - default_value: "4u"
+ */
+class BatchWorkers
+: private atlas::strong_type_tag<BatchWorkers>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(4u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit BatchWorkers() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit BatchWorkers(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(BatchWorkers const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(BatchWorkers & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(BatchWorkers && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        BatchWorkers const &,
+        BatchWorkers const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        BatchWorkers const & lhs,
+        BatchWorkers const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        BatchWorkers const & lhs,
+        BatchWorkers const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        BatchWorkers const & lhs,
+        BatchWorkers const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        BatchWorkers const & lhs,
+        BatchWorkers const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        BatchWorkers const &,
+        BatchWorkers const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        BatchWorkers const & lhs,
+        BatchWorkers const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        BatchWorkers const & lhs,
+        BatchWorkers const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: AgentMaxIterations
+ * - description: std::uint32_t; <=>
+ * - default_value: "20u"
+ */
+class AgentMaxIterations
+: private atlas::strong_type_tag<AgentMaxIterations>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(20u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit AgentMaxIterations() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit AgentMaxIterations(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(AgentMaxIterations const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(AgentMaxIterations & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(AgentMaxIterations && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        AgentMaxIterations const &,
+        AgentMaxIterations const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        AgentMaxIterations const & lhs,
+        AgentMaxIterations const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        AgentMaxIterations const & lhs,
+        AgentMaxIterations const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        AgentMaxIterations const & lhs,
+        AgentMaxIterations const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        AgentMaxIterations const & lhs,
+        AgentMaxIterations const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        AgentMaxIterations const &,
+        AgentMaxIterations const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        AgentMaxIterations const & lhs,
+        AgentMaxIterations const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        AgentMaxIterations const & lhs,
+        AgentMaxIterations const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: TurnDeadline
+ * - description: std::uint32_t; <=>
+ * - default_value: "0u"
+ */
+class TurnDeadline
+: private atlas::strong_type_tag<TurnDeadline>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit TurnDeadline() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit TurnDeadline(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(TurnDeadline const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(TurnDeadline & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(TurnDeadline && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        TurnDeadline const &,
+        TurnDeadline const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        TurnDeadline const & lhs,
+        TurnDeadline const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        TurnDeadline const & lhs,
+        TurnDeadline const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        TurnDeadline const & lhs,
+        TurnDeadline const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        TurnDeadline const & lhs,
+        TurnDeadline const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        TurnDeadline const &,
+        TurnDeadline const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        TurnDeadline const & lhs,
+        TurnDeadline const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        TurnDeadline const & lhs,
+        TurnDeadline const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: TurnTokenBudget
+ * - description: std::uint32_t; <=>
+ * - default_value: "0u"
+ */
+class TurnTokenBudget
+: private atlas::strong_type_tag<TurnTokenBudget>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit TurnTokenBudget() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit TurnTokenBudget(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(TurnTokenBudget const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(TurnTokenBudget & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(TurnTokenBudget && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        TurnTokenBudget const &,
+        TurnTokenBudget const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        TurnTokenBudget const & lhs,
+        TurnTokenBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        TurnTokenBudget const & lhs,
+        TurnTokenBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        TurnTokenBudget const & lhs,
+        TurnTokenBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        TurnTokenBudget const & lhs,
+        TurnTokenBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        TurnTokenBudget const &,
+        TurnTokenBudget const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        TurnTokenBudget const & lhs,
+        TurnTokenBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        TurnTokenBudget const & lhs,
+        TurnTokenBudget const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ToolPolicyFile
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class ToolPolicyFile
+: private atlas::strong_type_tag<ToolPolicyFile>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit ToolPolicyFile() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ToolPolicyFile(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(ToolPolicyFile const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(ToolPolicyFile & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ToolPolicyFile && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ToolPolicyFile const &,
+        ToolPolicyFile const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ToolPolicyFile const & lhs,
+        ToolPolicyFile const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ToolPolicyFile const & lhs,
+        ToolPolicyFile const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ToolPolicyFile const & lhs,
+        ToolPolicyFile const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ToolPolicyFile const & lhs,
+        ToolPolicyFile const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ToolPolicyFile const &,
+        ToolPolicyFile const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ToolPolicyFile const & lhs,
+        ToolPolicyFile const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ToolPolicyFile const & lhs,
+        ToolPolicyFile const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ToolRule
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class ToolRule
+: private atlas::strong_type_tag<ToolRule>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit ToolRule() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ToolRule(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(ToolRule const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(ToolRule & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ToolRule && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ToolRule const &,
+        ToolRule const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ToolRule const & lhs,
+        ToolRule const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ToolRule const & lhs,
+        ToolRule const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ToolRule const & lhs,
+        ToolRule const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ToolRule const & lhs,
+        ToolRule const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ToolRule const &,
+        ToolRule const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ToolRule const & lhs,
+        ToolRule const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ToolRule const & lhs,
+        ToolRule const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ToolDefault
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class ToolDefault
+: private atlas::strong_type_tag<ToolDefault>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit ToolDefault() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ToolDefault(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(ToolDefault const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(ToolDefault & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ToolDefault && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ToolDefault const &,
+        ToolDefault const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ToolDefault const & lhs,
+        ToolDefault const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ToolDefault const & lhs,
+        ToolDefault const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ToolDefault const & lhs,
+        ToolDefault const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ToolDefault const & lhs,
+        ToolDefault const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ToolDefault const &,
+        ToolDefault const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ToolDefault const & lhs,
+        ToolDefault const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ToolDefault const & lhs,
+        ToolDefault const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ToolCpus
+ * - description: std::uint32_t; <=>
+ * - default_value: "0u"
+ */
+class ToolCpus
+: private atlas::strong_type_tag<ToolCpus>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit ToolCpus() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ToolCpus(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(ToolCpus const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(ToolCpus & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ToolCpus && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ToolCpus const &,
+        ToolCpus const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ToolCpus const & lhs,
+        ToolCpus const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ToolCpus const & lhs,
+        ToolCpus const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ToolCpus const & lhs,
+        ToolCpus const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ToolCpus const & lhs,
+        ToolCpus const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ToolCpus const &,
+        ToolCpus const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ToolCpus const & lhs,
+        ToolCpus const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ToolCpus const & lhs,
+        ToolCpus const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ToolMemoryMb
+ * - description: std::uint32_t; <=>
+ * - default_value: "0u"
+ */
+class ToolMemoryMb
+: private atlas::strong_type_tag<ToolMemoryMb>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit ToolMemoryMb() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ToolMemoryMb(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(ToolMemoryMb const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(ToolMemoryMb & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ToolMemoryMb && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ToolMemoryMb const &,
+        ToolMemoryMb const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ToolMemoryMb const & lhs,
+        ToolMemoryMb const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ToolMemoryMb const & lhs,
+        ToolMemoryMb const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ToolMemoryMb const & lhs,
+        ToolMemoryMb const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ToolMemoryMb const & lhs,
+        ToolMemoryMb const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ToolMemoryMb const &,
+        ToolMemoryMb const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ToolMemoryMb const & lhs,
+        ToolMemoryMb const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ToolMemoryMb const & lhs,
+        ToolMemoryMb const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::uint32_t
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: ToolPids
+ * - description: std::uint32_t; <=>
+ * - default_value: "0u"
+ */
+class ToolPids
+: private atlas::strong_type_tag<ToolPids>
+{
+    std::uint32_t value = static_cast<std::uint32_t>(0u);
+
+public:
+    using atlas_value_type = std::uint32_t;
+
+    constexpr explicit ToolPids() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::uint32_t, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit ToolPids(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::uint32_t const & atlas_value_for(ToolPids const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::uint32_t & atlas_value_for(ToolPids & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(ToolPids && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::uint32_t>::value,
+            std::uint32_t>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        ToolPids const &,
+        ToolPids const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        ToolPids const & lhs,
+        ToolPids const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        ToolPids const & lhs,
+        ToolPids const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() <=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        ToolPids const & lhs,
+        ToolPids const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        ToolPids const & lhs,
+        ToolPids const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() >=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        ToolPids const &,
+        ToolPids const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        ToolPids const & lhs,
+        ToolPids const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() ==
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        ToolPids const & lhs,
+        ToolPids const & rhs)
+    noexcept(noexcept(std::declval<std::uint32_t const &>() !=
+        std::declval<std::uint32_t const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+
+namespace wjh {
+namespace chat {
+
+/**
+ * @brief Strong type wrapper for std::string
+ *
+ * Generated by Atlas Strong Type Generator.
+ * Generation parameters:
+ * - kind: class
+ * - type_namespace: wjh::chat
+ * - type_name: WatchDir
+ * - description: std::string; <=>
+ * - default_value: ""
+ */
+class WatchDir
+: private atlas::strong_type_tag<WatchDir>
+{
+    std::string value;
+
+public:
+    using atlas_value_type = std::string;
+
+    constexpr explicit WatchDir() = default;
+
+    template <
+        typename... ArgTs,
+        typename std::enable_if<
+            std::is_constructible<std::string, ArgTs...>::value,
+            bool>::type = true>
+    constexpr explicit WatchDir(ArgTs && ... args)
+    : value(std::forward<ArgTs>(args)...)
+    { }
+
+    /**
+     * Access to immediate underlying value via ADL.
+     */
+    friend constexpr std::string const & atlas_value_for(WatchDir const & self) noexcept {
+        return self.value;
+    }
+    friend constexpr std::string & atlas_value_for(WatchDir & self) noexcept {
+        return self.value;
+    }
+    friend constexpr auto atlas_value_for(WatchDir && self) noexcept
+        -> typename std::enable_if<
+            std::is_move_constructible<std::string>::value,
+            std::string>::type
+    {
+        return std::move(self.value);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default three-way comparison (spaceship) operator.
+     */
+    friend constexpr auto operator <=> (
+        WatchDir const &,
+        WatchDir const &) = default;
+#else
+    /**
+     * Comparison operators (C++17 fallback for spaceship operator).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator < (
+        WatchDir const & lhs,
+        WatchDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <
+        std::declval<std::string const &>()))
+    {
+        return lhs.value < rhs.value;
+    }
+
+    friend constexpr bool operator <= (
+        WatchDir const & lhs,
+        WatchDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() <=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value <= rhs.value;
+    }
+
+    friend constexpr bool operator > (
+        WatchDir const & lhs,
+        WatchDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >
+        std::declval<std::string const &>()))
+    {
+        return lhs.value > rhs.value;
+    }
+
+    friend constexpr bool operator >= (
+        WatchDir const & lhs,
+        WatchDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() >=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value >= rhs.value;
+    }
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) && \
+    __cpp_impl_three_way_comparison >= 201907L
+    /**
+     * The default equality comparison operator.
+     * Provided with spaceship operator for optimal performance.
+     */
+    friend constexpr bool operator == (
+        WatchDir const &,
+        WatchDir const &) = default;
+#else
+    /**
+     * Equality comparison operators (C++17 fallback).
+     * In C++20+, these are synthesized from operator<=>.
+     */
+    friend constexpr bool operator == (
+        WatchDir const & lhs,
+        WatchDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() ==
+        std::declval<std::string const &>()))
+    {
+        return lhs.value == rhs.value;
+    }
+
+    friend constexpr bool operator != (
+        WatchDir const & lhs,
+        WatchDir const & rhs)
+    noexcept(noexcept(std::declval<std::string const &>() !=
+        std::declval<std::string const &>()))
+    {
+        return lhs.value != rhs.value;
+    }
+#endif
+};
+} // namespace chat
+} // namespace wjh
+
+#endif // WJH_CHAT_218E6B2272D7CDA0CFAD0FDE919CD83BBD8DBDB8
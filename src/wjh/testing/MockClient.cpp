@@ -13,7 +13,10 @@ MockClient::
 
 wjh::chat::Result<wjh::chat::ChatResponse>
 MockClient::
-do_send_message(wjh::chat::conversation::Conversation const & conversation)
+do_send_message(
+    wjh::chat::conversation::Conversation const & conversation,
+    std::stop_token,
+    wjh::chat::client::ModelTier)
 {
     ++call_count_;
 
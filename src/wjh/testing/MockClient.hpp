@@ -74,7 +74,9 @@ public:
 
 private:
     wjh::chat::Result<wjh::chat::ChatResponse> do_send_message(
-        wjh::chat::conversation::Conversation const & conversation) override;
+        wjh::chat::conversation::Conversation const & conversation,
+        std::stop_token stop,
+        wjh::chat::client::ModelTier tier) override;
 
     std::queue<wjh::chat::Result<wjh::chat::ChatResponse>> results_;
     std::unique_ptr<wjh::chat::conversation::Conversation> last_conversation_;